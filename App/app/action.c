@@ -172,7 +172,7 @@ void ACTION_Monitor(void)
     gMonitor = false;
 
     if (gScanStateDir != SCAN_OFF) {
-        gScanPauseDelayIn_10ms = scan_pause_delay_in_1_10ms;
+        TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_1_10ms);
         gScheduleScanListen    = false;
         gScanPauseMode         = true;
     }
@@ -21,6 +21,8 @@
 #include "driver/bk4819.h"
 #include "driver/crc.h"
 #include "driver/eeprom.h"
+#include "driver/py25q16.h"
+#include "driver/system.h"
 #include "frequencies.h"
 #include "misc.h"
 #include "radio.h"
@@ -29,6 +31,7 @@
 #include "ui/ui.h"
 #include "settings.h"
 #include <stddef.h>
+#include <string.h>
 
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
 #include "k5viewer.h"
@@ -40,8 +43,9 @@ AIRCOPY_State_t gAircopyState;
 uint16_t gAirCopyBlockNumber;
 uint16_t gErrorsDuringAirCopy;
 bool     gAirCopyIsSendMode;
+AIRCOPY_Protocol_t gAircopyProtocol = AIRCOPY_PROTOCOL_V2;
 
-uint16_t g_FSK_Buffer[36];
+uint16_t g_FSK_Buffer[AIRCOPY_V2_FRAME_WORDS];
 
 // ============================================================================
 // Transfer Maps Definition
@@ -160,6 +164,67 @@ static inline const AIRCOPY_Segment_t *AIRCOPY_FindSegmentForOffset(uint16_t off
     return NULL;
 }
 
+// ============================================================================
+// Reception staging
+// ============================================================================
+
+/*
+ * Received blocks go to the flash sector cache (PY25Q16_WriteBuffer() is
+ * write-back), which is written back a segment at a time: when every block
+ * of the segment is in, when a block of another segment comes, when the
+ * sender polls (v2), at the end, or once the frames stop; the idle flush of
+ * the cache is put off meanwhile. A segment costs one sector erase at most,
+ * right after a frame rather than on the flush timer in the middle of the
+ * next one.
+ */
+
+#define AIRCOPY_STAGE_IDLE_10ms 150         // longer than a v1 frame period
+
+static struct {
+    const AIRCOPY_Segment_t *seg;           // NULL: nothing staged
+    uint32_t                 held;          // bit per block of the segment
+    uint8_t                  countdown_10ms;
+} gAircopyStage;
+
+static void AIRCOPY_StageFlush(void)
+{
+    if (gAircopyStage.seg == NULL)
+        return;
+
+    PY25Q16_Flush();
+
+    gAircopyStage.seg            = NULL;
+    gAircopyStage.held           = 0;
+    gAircopyStage.countdown_10ms = 0;
+}
+
+// A block that passed the CRC, at Offset of seg
+static void AIRCOPY_StageBlock(const AIRCOPY_Segment_t *seg, uint16_t Offset, const uint8_t *pData)
+{
+    const uint16_t size   = seg->end_offset - seg->start_offset;
+    const uint16_t from   = Offset - seg->start_offset;
+    const uint16_t blocks = (size + AIRCOPY_BLOCK_SIZE - 1) / AIRCOPY_BLOCK_SIZE;
+
+    if (seg != gAircopyStage.seg) {
+        AIRCOPY_StageFlush();
+        gAircopyStage.seg = seg;
+    }
+
+    EEPROM_WriteRange(Offset, pData, (size - from < AIRCOPY_BLOCK_SIZE) ? size - from : AIRCOPY_BLOCK_SIZE);
+    PY25Q16_DelayFlush(AIRCOPY_STAGE_IDLE_10ms + 10);
+    gAircopyStage.held          |= 1u << (from / AIRCOPY_BLOCK_SIZE);
+    gAircopyStage.countdown_10ms = AIRCOPY_STAGE_IDLE_10ms;
+
+    if (gAircopyStage.held == (uint32_t)((1ull << blocks) - 1))
+        AIRCOPY_StageFlush();
+}
+
+static void AIRCOPY_StageTick(void)
+{
+    if (gAircopyStage.countdown_10ms > 0 && --gAircopyStage.countdown_10ms == 0)
+        AIRCOPY_StageFlush();
+}
+
 static inline void AIRCOPY_CheckComplete(uint16_t *num)
 {
     *num = *num + 1;
@@ -169,6 +234,7 @@ static inline void AIRCOPY_CheckComplete(uint16_t *num)
 
     if (done >= map->total_blocks)
     {
+        AIRCOPY_StageFlush();
         gAircopyState = AIRCOPY_COMPLETE;
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
         K5VIEWER_Update(false);
@@ -183,6 +249,350 @@ void AIRCOPY_Obfuscate(unsigned int count)
     }
 }
 
+static void AIRCOPY_SetComplete(void)
+{
+    AIRCOPY_StageFlush();
+    gAircopyState = AIRCOPY_COMPLETE;
+#ifdef ENABLE_FEAT_F4HWN_K5VIEWER
+    K5VIEWER_Update(false);
+#endif
+}
+
+static void AIRCOPY_SetProtocol(AIRCOPY_Protocol_t Protocol)
+{
+    gAircopyProtocol = Protocol;
+    BK4819_SetFSKFrameLength(2 * (Protocol == AIRCOPY_PROTOCOL_V2 ? AIRCOPY_V2_FRAME_WORDS : AIRCOPY_V1_FRAME_WORDS));
+}
+
+// ============================================================================
+// Protocol v2
+// ============================================================================
+
+/*
+ * Frames of AIRCOPY_V2_FRAME_WORDS words:
+ *
+ *   [0]      0xABCE
+ *   [1]      type << 12 | map index << 8 | blocks in the map
+ *   [2]      first block | second block << 8, 0xFF for none
+ *   [3..66]  the two blocks, or the receiver's bitmap
+ *   [67]     CRC of words 1 to 66
+ *
+ * Words 1 to 67 are obfuscated as in v1. The sender keeps the transmitter
+ * keyed and starts each frame once TX finished says the FIFO has drained
+ * the last one, then polls. The receiver answers with its bitmap, and the
+ * next pass sends only what it lacks. A receiver listens at the v1 length
+ * until it hears a v2 frame: that one is lost, and repaired later.
+ */
+
+#define V2_MAGIC            0xABCEu
+#define V2_NO_BLOCK         0xFFu
+#define V2_HEADER_WORDS     3
+#define V2_BLOCK_WORDS      (AIRCOPY_BLOCK_SIZE / 2)
+#define V2_CRC_BYTES        (2 * (AIRCOPY_V2_FRAME_WORDS - 2))
+
+#define V2_GAP_10ms         2       // between frames, for the receiver to re-arm
+#define V2_TURNAROUND_10ms  5       // poll to bitmap, for the sender to listen
+#define V2_REPLY_10ms       150     // turnaround, 980 ms bitmap frame, margin
+#define V2_TX_10ms          150     // TX finished never seen
+#define V2_POLLS            5       // unanswered before the sender gives up
+
+typedef enum {
+    V2_READY = 0,       // sender: next frame due, receiver: listening
+    V2_ON_AIR,
+    V2_LISTEN,          // sender: poll sent, bitmap awaited
+    V2_REPLY,           // receiver: poll heard, bitmap due
+} AIRCOPY_V2_Step_t;
+
+static struct {
+    AIRCOPY_V2_Step_t   step;
+    AIRCOPY_FrameType_t onAir;
+    uint8_t             countdown_10ms;
+    uint8_t             polls;
+    uint8_t             next;       // sender: how far the pass is
+    bool                keyed;
+    uint8_t             done[AIRCOPY_V2_MAX_BLOCKS / 8];
+    uint8_t             todo[AIRCOPY_V2_MAX_BLOCKS / 8];   // sender: left in the pass
+} gAircopyV2;
+
+static inline bool AIRCOPY_V2_Bit(const uint8_t *pBits, uint16_t Block)
+{
+    return (pBits[Block / 8] >> (Block % 8)) & 1u;
+}
+
+static inline void AIRCOPY_V2_SetBit(uint8_t *pBits, uint16_t Block, bool Value)
+{
+    if (Value)
+        pBits[Block / 8] |= 1u << (Block % 8);
+    else
+        pBits[Block / 8] &= ~(1u << (Block % 8));
+}
+
+// Blocks are numbered through the segments, each rounded up to whole blocks
+// as v1 sends them
+static uint16_t AIRCOPY_V2_BlockOffset(const AIRCOPY_TransferMap_t *map, uint16_t Block)
+{
+    for (uint16_t i = 0; i < map->num_segments; i++)
+    {
+        const AIRCOPY_Segment_t *seg = &map->segments[i];
+        const uint16_t blocks = (seg->end_offset - seg->start_offset + AIRCOPY_BLOCK_SIZE - 1) / AIRCOPY_BLOCK_SIZE;
+
+        if (Block < blocks)
+            return seg->start_offset + Block * AIRCOPY_BLOCK_SIZE;
+        Block -= blocks;
+    }
+
+    return 0xFFFF;
+}
+
+static uint16_t AIRCOPY_V2_NextBlock(const AIRCOPY_TransferMap_t *map)
+{
+    while (gAircopyV2.next < map->total_blocks && !AIRCOPY_V2_Bit(gAircopyV2.todo, gAircopyV2.next))
+        gAircopyV2.next++;
+
+    return gAircopyV2.next;
+}
+
+static void AIRCOPY_V2_Listen(void)
+{
+    if (gAircopyV2.keyed) {
+        BK4819_SetupPowerAmplifier(0, 0);
+        BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+        gAircopyV2.keyed = false;
+    }
+
+    BK4819_PrepareFSKReceive();
+}
+
+static void AIRCOPY_V2_Send(AIRCOPY_FrameType_t Type)
+{
+    const AIRCOPY_TransferMap_t *map = AIRCOPY_GetCurrentMap();
+    uint8_t slots[2] = { V2_NO_BLOCK, V2_NO_BLOCK };
+
+    memset(g_FSK_Buffer, 0, sizeof(g_FSK_Buffer));
+
+    if (Type == AIRCOPY_FRAME_DATA) {
+        for (unsigned int i = 0; i < 2; i++) {
+            const uint16_t block = AIRCOPY_V2_NextBlock(map);
+
+            if (block >= map->total_blocks)
+                break;
+
+            AIRCOPY_V2_SetBit(gAircopyV2.todo, block, false);
+            if (!AIRCOPY_V2_Bit(gAircopyV2.done, block)) {
+                AIRCOPY_V2_SetBit(gAircopyV2.done, block, true);
+                gAirCopyBlockNumber++;
+            }
+
+            slots[i] = block;
+            EEPROM_ReadBuffer(AIRCOPY_V2_BlockOffset(map, block),
+                              &g_FSK_Buffer[V2_HEADER_WORDS + i * V2_BLOCK_WORDS], AIRCOPY_BLOCK_SIZE);
+        }
+    } else if (Type == AIRCOPY_FRAME_BITMAP) {
+        memcpy(&g_FSK_Buffer[V2_HEADER_WORDS], gAircopyV2.done, sizeof(gAircopyV2.done));
+    }
+
+    g_FSK_Buffer[0] = V2_MAGIC;
+    g_FSK_Buffer[1] = (Type << 12) | (gAircopyCurrentMapIndex << 8) | map->total_blocks;
+    g_FSK_Buffer[2] = slots[0] | (slots[1] << 8);
+    g_FSK_Buffer[AIRCOPY_V2_FRAME_WORDS - 1] = CRC_Calculate(&g_FSK_Buffer[1], V2_CRC_BYTES);
+
+    AIRCOPY_Obfuscate(AIRCOPY_V2_FRAME_WORDS - 1);
+
+    // Keyed once a burst, the PA settling as for BK4819_SendFSKData()
+    if (!gAircopyV2.keyed) {
+        RADIO_SetTxParameters();
+        SYSTEM_DelayMs(30);
+        gAircopyV2.keyed = true;
+    }
+
+    BK4819_StartFSKFrame(g_FSK_Buffer, AIRCOPY_V2_FRAME_WORDS);
+
+    gAircopyV2.onAir          = Type;
+    gAircopyV2.step           = V2_ON_AIR;
+    gAircopyV2.countdown_10ms = V2_TX_10ms;
+}
+
+static void AIRCOPY_V2_Start(bool isSendMode)
+{
+    const AIRCOPY_TransferMap_t *map = AIRCOPY_GetCurrentMap();
+
+    if (gAircopyV2.keyed)
+        AIRCOPY_V2_Listen();
+
+    memset(&gAircopyV2, 0, sizeof(gAircopyV2));
+
+    if (isSendMode) {
+        for (uint16_t block = 0; block < map->total_blocks; block++)
+            AIRCOPY_V2_SetBit(gAircopyV2.todo, block, true);
+    }
+}
+
+// Sender: the receiver's bitmap, the blocks it lacks for the next pass
+static void AIRCOPY_V2_Confirm(const uint8_t *pBitmap)
+{
+    const AIRCOPY_TransferMap_t *map = AIRCOPY_GetCurrentMap();
+
+    gAirCopyBlockNumber = 0;
+
+    for (uint16_t block = 0; block < map->total_blocks; block++) {
+        const bool held = AIRCOPY_V2_Bit(pBitmap, block);
+
+        AIRCOPY_V2_SetBit(gAircopyV2.done, block, held);
+        AIRCOPY_V2_SetBit(gAircopyV2.todo, block, !held);
+        gAirCopyBlockNumber += held;
+    }
+
+    gAircopyV2.next           = 0;
+    gAircopyV2.polls          = 0;
+    gAircopyV2.step           = V2_READY;
+    gAircopyV2.countdown_10ms = 0;
+
+    if (gAirCopyBlockNumber >= map->total_blocks)
+        AIRCOPY_SetComplete();
+}
+
+static void AIRCOPY_V2_StorePacket(void)
+{
+    const AIRCOPY_TransferMap_t *map = AIRCOPY_GetCurrentMap();
+    const uint16_t Status = BK4819_ReadRegister(BK4819_REG_0B);
+
+    if ((Status & 0x0010U) != 0 || g_FSK_Buffer[0] != V2_MAGIC) {
+        gErrorsDuringAirCopy++;
+        BK4819_RestartFSKReceive();
+        return;
+    }
+
+    AIRCOPY_Obfuscate(AIRCOPY_V2_FRAME_WORDS - 1);
+
+    if (g_FSK_Buffer[AIRCOPY_V2_FRAME_WORDS - 1] != CRC_Calculate(&g_FSK_Buffer[1], V2_CRC_BYTES) ||
+        (g_FSK_Buffer[1] & 0x0FFF) != ((gAircopyCurrentMapIndex << 8) | map->total_blocks)) {
+        gErrorsDuringAirCopy++;
+        BK4819_RestartFSKReceive();
+        return;
+    }
+
+    const AIRCOPY_FrameType_t Type = g_FSK_Buffer[1] >> 12;
+
+    if (gAirCopyIsSendMode) {
+        if (Type == AIRCOPY_FRAME_BITMAP)
+            AIRCOPY_V2_Confirm((const uint8_t *)&g_FSK_Buffer[V2_HEADER_WORDS]);
+        else
+            BK4819_RestartFSKReceive();
+        return;
+    }
+
+    // The sender waits for the bitmap: time to write back
+    if (Type == AIRCOPY_FRAME_POLL) {
+        AIRCOPY_StageFlush();
+        gAircopyV2.step           = V2_REPLY;
+        gAircopyV2.countdown_10ms = V2_TURNAROUND_10ms;
+        return;
+    }
+
+    // Listening again before a segment is written back: the next frame follows
+    BK4819_RestartFSKReceive();
+
+    if (Type != AIRCOPY_FRAME_DATA)
+        return;
+
+    for (unsigned int i = 0; i < 2; i++) {
+        const uint16_t block = (g_FSK_Buffer[2] >> (i * 8)) & 0xFF;
+
+        if (block >= map->total_blocks || AIRCOPY_V2_Bit(gAircopyV2.done, block))
+            continue;
+
+        const uint16_t Offset = AIRCOPY_V2_BlockOffset(map, block);
+        const uint8_t *pData  = (const uint8_t *)&g_FSK_Buffer[V2_HEADER_WORDS + i * V2_BLOCK_WORDS];
+
+        AIRCOPY_StageBlock(AIRCOPY_FindSegmentForOffset(Offset), Offset, pData);
+
+        AIRCOPY_V2_SetBit(gAircopyV2.done, block, true);
+        gAirCopyBlockNumber++;
+    }
+}
+
+static bool AIRCOPY_V2_Tick(void)
+{
+    if (gAircopyV2.countdown_10ms > 0 && --gAircopyV2.countdown_10ms > 0)
+        return 1;
+
+    switch (gAircopyV2.step) {
+        case V2_ON_AIR:     // TX finished lost: carry on
+            AIRCOPY_TxFinished();
+            return 0;
+
+        case V2_LISTEN:
+            if (++gAircopyV2.polls >= V2_POLLS) {
+                AIRCOPY_SetComplete();
+                return 0;
+            }
+            AIRCOPY_V2_Send(AIRCOPY_FRAME_POLL);
+            return 0;
+
+        case V2_REPLY:
+            AIRCOPY_V2_Send(AIRCOPY_FRAME_BITMAP);
+            return 0;
+
+        default:
+            break;
+    }
+
+    if (!gAirCopyIsSendMode) {
+        return 1;
+    }
+
+    const AIRCOPY_TransferMap_t *map = AIRCOPY_GetCurrentMap();
+
+    AIRCOPY_V2_Send(AIRCOPY_V2_NextBlock(map) < map->total_blocks ? AIRCOPY_FRAME_DATA : AIRCOPY_FRAME_POLL);
+    return 0;
+}
+
+void AIRCOPY_TxFinished(void)
+{
+    if (gAircopyProtocol != AIRCOPY_PROTOCOL_V2 || gAircopyV2.step != V2_ON_AIR) {
+        return;
+    }
+
+    switch (gAircopyV2.onAir) {
+        case AIRCOPY_FRAME_DATA:    // the next one, or the poll, still keyed
+            gAircopyV2.step           = V2_READY;
+            gAircopyV2.countdown_10ms = V2_GAP_10ms;
+            break;
+
+        case AIRCOPY_FRAME_POLL:
+            AIRCOPY_V2_Listen();
+            gAircopyV2.step           = V2_LISTEN;
+            gAircopyV2.countdown_10ms = V2_REPLY_10ms;
+            break;
+
+        default:                    // bitmap
+            AIRCOPY_V2_Listen();
+            gAircopyV2.step = V2_READY;
+            if (gAirCopyBlockNumber >= AIRCOPY_GetCurrentMap()->total_blocks) {
+                AIRCOPY_SetComplete();
+            }
+            break;
+    }
+}
+
+bool AIRCOPY_IsListening(void)
+{
+    if (gAircopyState != AIRCOPY_TRANSFER) {
+        return false;
+    }
+
+    if (gAircopyProtocol == AIRCOPY_PROTOCOL_V1) {
+        return !gAirCopyIsSendMode;
+    }
+
+    return gAircopyV2.step == (gAirCopyIsSendMode ? V2_LISTEN : V2_READY);
+}
+
+bool AIRCOPY_BlockDone(uint16_t Block)
+{
+    return Block < AIRCOPY_V2_MAX_BLOCKS && AIRCOPY_V2_Bit(gAircopyV2.done, Block);
+}
+
 // ============================================================================
 // Send/Receive Functions
 // ============================================================================
@@ -197,6 +607,16 @@ bool AIRCOPY_SendMessage(void)
         return 1;
     }
 
+    AIRCOPY_StageTick();
+
+    if (gAircopyProtocol == AIRCOPY_PROTOCOL_V2) {
+        return AIRCOPY_V2_Tick();
+    }
+
+    if (!gAirCopyIsSendMode) {
+        return 1;
+    }
+
     if (--gAircopySendCountdown) {
         return 1;
     }
@@ -251,12 +671,28 @@ bool AIRCOPY_SendMessage(void)
 
 void AIRCOPY_StorePacket(void)
 {
-    if (gFSKWriteIndex < 36) {
+    const bool v2 = gAircopyProtocol == AIRCOPY_PROTOCOL_V2;
+
+    if (gFSKWriteIndex < (v2 ? AIRCOPY_V2_FRAME_WORDS : AIRCOPY_V1_FRAME_WORDS)) {
         return;
     }
 
     gFSKWriteIndex = 0;
     gUpdateDisplay = true;
+
+    // The receiver follows the sender: a frame of the other protocol, cut
+    // short or padded to this one's length, is lost
+    if (!gAirCopyIsSendMode && g_FSK_Buffer[0] == (v2 ? 0xABCD : V2_MAGIC)) {
+        AIRCOPY_SetProtocol(v2 ? AIRCOPY_PROTOCOL_V1 : AIRCOPY_PROTOCOL_V2);
+        BK4819_PrepareFSKReceive();
+        return;
+    }
+
+    if (v2) {
+        AIRCOPY_V2_StorePacket();
+        return;
+    }
+
     uint16_t Status = BK4819_ReadRegister(BK4819_REG_0B);
     BK4819_PrepareFSKReceive();
 
@@ -285,12 +721,7 @@ void AIRCOPY_StorePacket(void)
         return;
     }
 
-    const uint8_t *pData = (const uint8_t *)&g_FSK_Buffer[2];
-
-    for (unsigned int i = 0; i < 8; i++)
-    {
-        EEPROM_WriteBuffer(Offset + (i * 8), pData + (i * 8));
-    }
+    AIRCOPY_StageBlock(seg, Offset, (const uint8_t *)&g_FSK_Buffer[2]);
 
     AIRCOPY_CheckComplete(&gAirCopyBlockNumber);
 }
@@ -304,6 +735,11 @@ static void AIRCOPY_InitTransfer(bool isSendMode)
     gAirCopyIsSendMode = isSendMode;
 
     AIRCOPY_clear();
+    AIRCOPY_StageFlush();
+    AIRCOPY_V2_Start(isSendMode);
+
+    // Receivers listen for v1 until they hear v2
+    AIRCOPY_SetProtocol(isSendMode ? gAircopyProtocol : AIRCOPY_PROTOCOL_V1);
     
     gAircopyState = AIRCOPY_TRANSFER;
 }
@@ -374,6 +810,16 @@ static void AIRCOPY_Key_MENU()
     g_FSK_Buffer[35] = 0xDCBA;
 }
 
+static void AIRCOPY_Key_F()
+{
+    if (gAircopyState == AIRCOPY_TRANSFER) {
+        gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+        return;
+    }
+
+    gAircopyProtocol = gAircopyProtocol == AIRCOPY_PROTOCOL_V1 ? AIRCOPY_PROTOCOL_V2 : AIRCOPY_PROTOCOL_V1;
+}
+
 static void AIRCOPY_Key_UP_DOWN(int8_t Direction)
 {
     if (!gEeprom.SET_NAV) {
@@ -411,6 +857,9 @@ void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
     case KEY_EXIT:
         AIRCOPY_Key_EXIT();
         break;
+    case KEY_F:
+        AIRCOPY_Key_F();
+        break;
     case KEY_UP:
     case KEY_DOWN:
         AIRCOPY_Key_UP_DOWN(Key == KEY_UP ? 1 : -1);
@@ -31,6 +31,9 @@
 #define AIRCOPY_CHANNEL_SIZE         16       // bytes per channel (freq/name)
 #define AIRCOPY_BANK_SIZE_BYTES      0x1080u  // 0x800 (Freq) + 0x800 (Name) + 0x80 (Attr)
 #define AIRCOPY_BAR_WIDTH            120      // Visible width of the progress gauge
+#define AIRCOPY_V1_FRAME_WORDS       36       // 0xABCD, offset, 1 block, CRC, 0xDCBA
+#define AIRCOPY_V2_FRAME_WORDS       68       // 0xABCE, header, slots, 2 blocks, CRC
+#define AIRCOPY_V2_MAX_BLOCKS        128      // per map, in the v2 bitmap
 
 // ============================================================================
 // Segment write mode
@@ -85,6 +88,29 @@ typedef enum {
     AIRCOPY_COMPLETE
 } AIRCOPY_State_t;
 
+// ============================================================================
+// Protocol
+// ============================================================================
+
+/*
+ * - V1: one block a frame every 300 ms, nothing repaired (older radios)
+ * - V2: two blocks a frame back to back, then the receiver's bitmap of the
+ *       blocks it holds and another pass for the missing ones
+ *
+ * The sender uses the one selected, the receiver the one it hears.
+ */
+typedef enum {
+    AIRCOPY_PROTOCOL_V1 = 0,
+    AIRCOPY_PROTOCOL_V2,
+} AIRCOPY_Protocol_t;
+
+// v2 frame types
+typedef enum {
+    AIRCOPY_FRAME_DATA = 1,
+    AIRCOPY_FRAME_POLL,     // sender: end of a pass, bitmap wanted
+    AIRCOPY_FRAME_BITMAP,   // receiver: blocks held
+} AIRCOPY_FrameType_t;
+
 // ============================================================================
 // Globals
 // ============================================================================
@@ -93,8 +119,9 @@ extern AIRCOPY_State_t gAircopyState;
 extern uint16_t        gAirCopyBlockNumber;
 extern uint16_t        gErrorsDuringAirCopy;
 extern bool            gAirCopyIsSendMode;
+extern AIRCOPY_Protocol_t gAircopyProtocol;
 
-extern uint16_t        g_FSK_Buffer[36];
+extern uint16_t        g_FSK_Buffer[AIRCOPY_V2_FRAME_WORDS];
 
 // ============================================================================
 // API
@@ -102,10 +129,15 @@ extern uint16_t        g_FSK_Buffer[36];
 
 bool AIRCOPY_SendMessage(void);
 void AIRCOPY_StorePacket(void);
+void AIRCOPY_TxFinished(void);
+bool AIRCOPY_IsListening(void);
 void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
 const AIRCOPY_TransferMap_t* AIRCOPY_GetCurrentMap(void);
 
+// v2: block held by the receiver, or sent or confirmed by the sender
+bool AIRCOPY_BlockDone(uint16_t Block);
+
 // XOR-obfuscate `count` words of g_FSK_Buffer starting at index 1.
 // Self-inverse: applying twice restores the original buffer.
 void AIRCOPY_Obfuscate(unsigned int count);
@@ -43,6 +43,9 @@
     #include "app/rxtx_log.h"
 #endif
 #include "app/scanner.h"
+#ifdef ENABLE_SPECTRUM
+    #include "app/spectrum.h"
+#endif
 #if defined(ENABLE_UART) || defined(ENABLE_USB)
     #include "app/uart.h"
     #include "scheduler.h"
@@ -60,6 +63,7 @@
 #include "driver/bk4819.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
+#include "driver/py25q16.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
 #include "dtmf.h"
@@ -352,7 +356,7 @@ static void CheckForIncoming(void)
             return;
         }
 
-        gDualWatchCountdown_10ms = dual_watch_count_after_rx_10ms;
+        TIMER_Start(&gDualWatchTimer, dual_watch_count_after_rx_10ms);
         gScheduleDualWatch       = false;
 
         // let the user see DW is not active
@@ -371,7 +375,7 @@ static void CheckForIncoming(void)
             return;
         }
 
-        gScanPauseDelayIn_10ms = scan_pause_delay_in_3_10ms;
+        TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_3_10ms);
         gScheduleScanListen    = false;
     }
 
@@ -429,7 +433,7 @@ static void HandleIncoming(void)
             if (gRxReceptionMode != RX_MODE_DETECTED) {
                 return;
             }
-            gDualWatchCountdown_10ms = dual_watch_count_after_1_10ms;
+            TIMER_Start(&gDualWatchTimer, dual_watch_count_after_1_10ms);
             gScheduleDualWatch       = false;
 
             gRxReceptionMode = RX_MODE_LISTENING;
@@ -593,7 +597,7 @@ Skip:
                         break;
 
                     case SCAN_RESUME_CO:
-                        gScanPauseDelayIn_10ms = scan_pause_delay_in_7_10ms;
+                        TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_7_10ms);
                         gScheduleScanListen    = false;
                         break;
 
@@ -611,7 +615,7 @@ Skip:
                     }
                     else
                     {
-                        gScanPauseDelayIn_10ms = gEeprom.SCAN_RESUME_MODE * (250 / 10); // 250ms
+                        TIMER_Start(&gScanPauseTimer, gEeprom.SCAN_RESUME_MODE * (250 / 10)); // 250ms
                         gScheduleScanListen    = false;
                     }
                 }
@@ -619,7 +623,7 @@ Skip:
                 /*
                 if(gEeprom.SCAN_RESUME_MODE < 2)
                 {
-                    gScanPauseDelayIn_10ms = scan_pause_delay_in_6_10ms + (scan_pause_delay_in_6_10ms * 24 * gEeprom.SCAN_RESUME_MODE);
+                    TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_6_10ms + (scan_pause_delay_in_6_10ms * 24 * gEeprom.SCAN_RESUME_MODE));
                     gScheduleScanListen    = false;
 
                 }
@@ -633,12 +637,12 @@ Skip:
                 switch (gEeprom.SCAN_RESUME_MODE)
                 {
                     case 0:
-                        gScanPauseDelayIn_10ms = scan_pause_delay_in_6_10ms;
+                        TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_6_10ms);
                         gScheduleScanListen    = false;
                         break;
 
                     case 1:
-                        gScanPauseDelayIn_10ms = scan_pause_delay_in_2_10ms * 5;
+                        TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_2_10ms * 5);
                         gScheduleScanListen    = false;
                         break;
 
@@ -647,7 +651,7 @@ Skip:
                         break;
 
                     //default:
-                    //    gScanPauseDelayIn_10ms = scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 1) * 5;
+                    //    TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 1) * 5);
                     //    break;
                 }
                 */
@@ -743,16 +747,16 @@ void APP_StartListening(FUNCTION_Type_t function)
         gEeprom.DUAL_WATCH != DUAL_WATCH_OFF)
     {   // not scanning, dual watch is enabled
 
-        //gDualWatchCountdown_10ms = dual_watch_count_after_2_10ms;
+        //TIMER_Start(&gDualWatchTimer, dual_watch_count_after_2_10ms);
 
         const bool isMainTxDualRx =
         (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF) &&
         (gEeprom.CROSS_BAND_RX_TX != CROSS_BAND_OFF);
 
         // Use a short hold only for MAIN TX DUAL RX, keep legacy hold otherwise
-        gDualWatchCountdown_10ms = isMainTxDualRx
+        TIMER_Start(&gDualWatchTimer, isMainTxDualRx
             ? dual_watch_count_after_2_10ms / 4 // Short timer = 420 / 4 ...
-            : dual_watch_count_after_2_10ms;
+            : dual_watch_count_after_2_10ms);
 
         gScheduleDualWatch       = false;
 
@@ -854,9 +858,9 @@ static void DualwatchAlternate(void)
     RADIO_SetupRegisters(false);
 
     #ifdef ENABLE_NOAA
-        gDualWatchCountdown_10ms = gIsNoaaMode ? dual_watch_count_noaa_10ms : dual_watch_count_toggle_10ms;
+        TIMER_Start(&gDualWatchTimer, gIsNoaaMode ? dual_watch_count_noaa_10ms : dual_watch_count_toggle_10ms);
     #else
-        gDualWatchCountdown_10ms = dual_watch_count_toggle_10ms;
+        TIMER_Start(&gDualWatchTimer, dual_watch_count_toggle_10ms);
     #endif
 }
 
@@ -961,12 +965,12 @@ static void CheckRadioInterrupts(void)
 
             if (gEeprom.VOX_SWITCH) {
                 if (gCurrentFunction == FUNCTION_POWER_SAVE && !gRxIdleMode) {
-                    gPowerSave_10ms            = power_save2_10ms;
+                    TIMER_Start(&gPowerSaveTimer, power_save2_10ms);
                     gPowerSaveCountdownExpired = 0;
                 }
 
-                if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF && (gScheduleDualWatch || gDualWatchCountdown_10ms < dual_watch_count_after_vox_10ms)) {
-                    gDualWatchCountdown_10ms = dual_watch_count_after_vox_10ms;
+                if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF && (gScheduleDualWatch || TIMER_Remaining(&gDualWatchTimer) < dual_watch_count_after_vox_10ms)) {
+                    TIMER_Start(&gDualWatchTimer, dual_watch_count_after_vox_10ms);
                     gScheduleDualWatch = false;
 
                     // let the user see DW is not active
@@ -996,10 +1000,12 @@ static void CheckRadioInterrupts(void)
         }
 
 #ifdef ENABLE_AIRCOPY
+        if (interrupts.fskTxFinied && gScreenToDisplay == DISPLAY_AIRCOPY)
+            AIRCOPY_TxFinished();
+
         if (interrupts.fskFifoAlmostFull &&
             gScreenToDisplay == DISPLAY_AIRCOPY &&
-            gAircopyState == AIRCOPY_TRANSFER &&
-            gAirCopyIsSendMode == 0)
+            AIRCOPY_IsListening())
         {
             for (unsigned int i = 0; i < 4; i++) {
                 g_FSK_Buffer[gFSKWriteIndex++] = BK4819_ReadRegister(BK4819_REG_5F);
@@ -1089,8 +1095,8 @@ static void HandleVox(void)
 
     if (gVOX_NoiseDetected) {
         if (g_VOX_Lost)
-            gVoxStopCountdown_10ms = vox_stop_count_down_10ms;
-        else if (gVoxStopCountdown_10ms == 0)
+            TIMER_Start(&gVoxStopTimer, vox_stop_count_down_10ms);
+        else if (!TIMER_IsArmed(&gVoxStopTimer))
             gVOX_NoiseDetected = false;
 
         if (gCurrentFunction == FUNCTION_TRANSMIT && !gPttIsPressed && !gVOX_NoiseDetected) {
@@ -1119,6 +1125,23 @@ static void HandleVox(void)
 }
 #endif
 
+#ifdef ENABLE_SPECTRUM
+// The analyzer was left with EXIT: it tuned the BK4819 away from the VFO,
+// so configure it again and go back to the main display
+static void LeaveSpectrum(void)
+{
+    if (gVfoConfigureMode != VFO_CONFIGURE_NONE) {
+        RADIO_ConfigureChannel(gEeprom.TX_VFO, gVfoConfigureMode);
+        gVfoConfigureMode = VFO_CONFIGURE_NONE;
+        RADIO_SelectVfos();
+        RADIO_SetupRegisters(true);
+    }
+
+    GUI_SelectNextDisplay(DISPLAY_MAIN);
+    gUpdateStatus = true;
+}
+#endif
+
 void APP_Update(void)
 {
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
@@ -1127,12 +1150,8 @@ void APP_Update(void)
     K5VIEWER_ParseInput();
 #endif
 
-#ifdef ENABLE_VOICE
-    if (gFlagPlayQueuedVoice) {
-            AUDIO_PlayQueuedVoice();
-            gFlagPlayQueuedVoice = false;
-    }
-#endif
+    if (gFlagAudioStep)
+        AUDIO_Service();
 
 #ifdef ENABLE_USB
     if (UART_IsCommandAvailable(UART_PORT_VCP)) {
@@ -1142,6 +1161,16 @@ void APP_Update(void)
     }
 #endif
 
+#ifdef ENABLE_SPECTRUM
+    // The analyzer has the radio, the display and the keys to itself
+    if (SPECTRUM_IsRunning()) {
+        SPECTRUM_Update();
+        if (!SPECTRUM_IsRunning())
+            LeaveSpectrum();
+        return;
+    }
+#endif
+
 #ifdef ENABLE_FEAT_F4HWN
     if (gCurrentFunction == FUNCTION_TRANSMIT && (gTxTimeoutReachedAlert || SerialConfigInProgress()))
     {
@@ -1193,7 +1222,7 @@ void APP_Update(void)
         gTxTimeoutReached = false;
 
 #ifdef ENABLE_FEAT_F4HWN
-        if(gBacklightCountdown_500ms > 0 || gEeprom.BACKLIGHT_TIME == 61)
+        if(TIMER_IsArmed(&gBacklightTimer) || gEeprom.BACKLIGHT_TIME == 61)
         {
             //BACKLIGHT_TurnOn();
             BACKLIGHT_SetBrightness(gEeprom.BACKLIGHT_MAX);
@@ -1244,21 +1273,13 @@ void APP_Update(void)
         return;
 #endif
 
-#ifdef ENABLE_VOICE
-    if (!SCANNER_IsScanning() && gScanStateDir != SCAN_OFF && gScheduleScanListen && !gPttIsPressed && gVoiceWriteIndex == 0)
-#else
-    if (!SCANNER_IsScanning() && gScanStateDir != SCAN_OFF && gScheduleScanListen && !gPttIsPressed)
-#endif
+    if (!SCANNER_IsScanning() && gScanStateDir != SCAN_OFF && gScheduleScanListen && !gPttIsPressed && !AUDIO_IsPlaying())
     {   // scanning
         CHFRSCANNER_ContinueScanning();
     }
 
 #ifdef ENABLE_NOAA
-#ifdef ENABLE_VOICE
-        if (gEeprom.DUAL_WATCH == DUAL_WATCH_OFF && gIsNoaaMode && gScheduleNOAA && gVoiceWriteIndex == 0)
-#else
-        if (gEeprom.DUAL_WATCH == DUAL_WATCH_OFF && gIsNoaaMode && gScheduleNOAA)
-#endif
+        if (gEeprom.DUAL_WATCH == DUAL_WATCH_OFF && gIsNoaaMode && gScheduleNOAA && !AUDIO_IsPlaying())
         {
             NOAA_IncreaseChannel();
             RADIO_SetupRegisters(false);
@@ -1275,12 +1296,10 @@ void APP_Update(void)
         && gScanStateDir == SCAN_OFF
         && !gPttIsPressed
         && gCurrentFunction != FUNCTION_POWER_SAVE
+        && !AUDIO_IsPlaying()
 #ifdef ENABLE_FEAT_F4HWN_BEAM
         && !gBeamActive
 #endif
-#ifdef ENABLE_VOICE
-        && gVoiceWriteIndex == 0
-#endif
 #ifdef ENABLE_FMRADIO
         && !gFmRadioMode
 #endif
@@ -1316,6 +1335,7 @@ void APP_Update(void)
     if (gSchedulePowerSave) {
         if (gPttIsPressed
             || gKeyBeingHeld
+            || AUDIO_IsPlaying()
             || gEeprom.BATTERY_SAVE == 0
             || gScanStateDir != SCAN_OFF
             || gCssBackgroundScan
@@ -1330,7 +1350,7 @@ void APP_Update(void)
             || (gIsNoaaMode && (IS_NOAA_CHANNEL(gEeprom.ScreenChannel[0]) || IS_NOAA_CHANNEL(gEeprom.ScreenChannel[1])))
 #endif
         ) {
-            gBatterySaveCountdown_10ms = battery_save_count_10ms;
+            TIMER_Start(&gBatterySaveTimer, battery_save_count_10ms);
         } else {
             FUNCTION_Select(FUNCTION_POWER_SAVE);
         }
@@ -1338,11 +1358,7 @@ void APP_Update(void)
         gSchedulePowerSave = false;
     }
 
-    if (gPowerSaveCountdownExpired && gCurrentFunction == FUNCTION_POWER_SAVE
-#ifdef ENABLE_VOICE
-        && gVoiceWriteIndex == 0
-#endif
-    ) {
+    if (gPowerSaveCountdownExpired && gCurrentFunction == FUNCTION_POWER_SAVE && !AUDIO_IsPlaying()) {
         static bool goToSleep;
         // wake up, enable RX then go back to sleep
         if (gRxIdleMode)
@@ -1368,7 +1384,7 @@ void APP_Update(void)
 
             FUNCTION_Init();
 
-            gPowerSave_10ms = power_save1_10ms; // come back here in a bit
+            TIMER_Start(&gPowerSaveTimer, power_save1_10ms); // come back here in a bit
             gRxIdleMode     = false;            // RX is awake
         }
         else if (
@@ -1380,9 +1396,9 @@ void APP_Update(void)
             // go back to sleep
 
 #ifdef ENABLE_FEAT_F4HWN_SLEEP
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * (gWakeUp ? 200 : 10); // deep sleep now indexed on BatSav
+            TIMER_Start(&gPowerSaveTimer, gEeprom.BATTERY_SAVE * (gWakeUp ? 200 : 10)); // deep sleep now indexed on BatSav
 #else
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
+            TIMER_Start(&gPowerSaveTimer, gEeprom.BATTERY_SAVE * 10);
 #endif
             gRxIdleMode     = true;
             goToSleep = false;
@@ -1401,7 +1417,7 @@ void APP_Update(void)
         {
             // toggle between the two VFO's
             DualwatchAlternate();
-            gPowerSave_10ms   = power_save1_10ms;
+            TIMER_Start(&gPowerSaveTimer, power_save1_10ms);
             goToSleep = true;
         }
 
@@ -1576,11 +1592,59 @@ void CheckKeys(void)
     }
 }
 
+// The BK4819 interrupt request has no line to the MCU: REG_0C is polled.
+// An FSK frame comes 4 words at a time through a small FIFO, so while one
+// may come in, REG_0C is read on every SysTick, every 2 ms
+static bool FskReceiving(void)
+{
+#ifdef ENABLE_AIRCOPY
+    if (gScreenToDisplay == DISPLAY_AIRCOPY && AIRCOPY_IsListening())
+        return true;
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_BEAM
+    if (gBeamActive && gBeamMode == BEAM_MODE_RX &&
+        (gBeamStatus == BEAM_STATUS_RX_WAIT || gBeamStatus == BEAM_STATUS_ERROR))
+        return true;
+#endif
+
+    return false;
+}
+
+// Runs on every SysTick: every 2 ms while FSK is received, the spectrum
+// analyzer runs or a beep plays, every 10 ms otherwise
+void APP_TimeSlice2ms(void)
+{
+    const bool fsk = FskReceiving();
+
+    gNextTimeslice2ms = false;
+
+    gFastTick = fsk || AUDIO_IsPlaying()
+#ifdef ENABLE_SPECTRUM
+        || SPECTRUM_IsRunning()
+#endif
+        ;
+
+#ifdef ENABLE_SPECTRUM
+    if (SPECTRUM_IsRunning()) {
+        SPECTRUM_TimeSlice2ms();
+        return;
+    }
+#endif
+
+    if (gReducedService)
+        return;
+
+    if (fsk)
+        CheckRadioInterrupts();
+}
+
 void APP_TimeSlice10ms(void)
 {
     gNextTimeslice = false;
 
     SETTINGS_SaveVfoIndicesFlush();
+    PY25Q16_Task10ms();
 
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG
     RXTX_LOG_Task10ms();
@@ -1590,12 +1654,6 @@ void APP_TimeSlice10ms(void)
 
     gFlashLightBlinkCounter++;
 
-#ifdef ENABLE_AM_FIX
-    if (gRxVfo->Modulation == MODULATION_AM) {
-        AM_fix_10ms(gEeprom.RX_VFO);
-    }
-#endif
-
 #ifdef ENABLE_UART
     if (UART_IsCommandAvailable(UART_PORT_UART)) {
         // SCHEDULER_Disable();
@@ -1604,10 +1662,23 @@ void APP_TimeSlice10ms(void)
     }
 #endif
 
+#ifdef ENABLE_SPECTRUM
+    if (SPECTRUM_IsRunning()) {
+        SPECTRUM_TimeSlice10ms();
+        return;
+    }
+#endif
+
+#ifdef ENABLE_AM_FIX
+    if (gRxVfo->Modulation == MODULATION_AM) {
+        AM_fix_10ms(gEeprom.RX_VFO);
+    }
+#endif
+
     if (gReducedService)
         return;
 
-    if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode)
+    if (!FskReceiving() && (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode))
         CheckRadioInterrupts();
 
     if (gCurrentFunction == FUNCTION_TRANSMIT)
@@ -1775,7 +1846,7 @@ void APP_TimeSlice10ms(void)
 #endif
 
 #ifdef ENABLE_AIRCOPY
-    if (gScreenToDisplay == DISPLAY_AIRCOPY && gAircopyState == AIRCOPY_TRANSFER && gAirCopyIsSendMode == 1) {
+    if (gScreenToDisplay == DISPLAY_AIRCOPY && gAircopyState == AIRCOPY_TRANSFER) {
         if (!AIRCOPY_SendMessage()) {
             GUI_DisplayScreen();
         }
@@ -1804,12 +1875,50 @@ void cancelUserInputModes(void)
     }
 }
 
+// A battery reading every second, not while transmitting
+static void BatteryReadings(void)
+{
+    if (gCurrentFunction != FUNCTION_TRANSMIT)
+    {
+        if ((gBatteryCheckCounter & 1) == 0)
+        {
+            BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[gBatteryVoltageIndex++], &gBatteryCurrent);
+            if (gBatteryVoltageIndex > 3)
+                gBatteryVoltageIndex = 0;
+            BATTERY_GetReadings(true);
+        }
+    }
+}
+
 // this is called once every 500ms
 void APP_TimeSlice500ms(void)
 {
     gNextTimeslice_500ms = false;
     bool exit_menu = false;
 
+#ifdef ENABLE_SPECTRUM
+    if (SPECTRUM_IsRunning()) {
+        SPECTRUM_TimeSlice500ms();
+
+        // The log and the battery watch go on under the analyzer
+#ifdef ENABLE_FEAT_F4HWN_RXTX_LOG
+        RXTX_LOG_Tick500ms();
+#endif
+        if (!gReducedService) {
+            gBatteryCheckCounter++;
+            BatteryReadings();
+            BATTERY_TimeSlice500ms();
+        }
+
+        if (gReducedService) {
+            // battery flat: the analyzer's registers back, then to sleep
+            SPECTRUM_Exit();
+            FUNCTION_Select(FUNCTION_POWER_SAVE);
+        }
+        return;
+    }
+#endif
+
     // Skipped authentic device check
 
     if (gKeypadLocked > 0)
@@ -1895,12 +2004,14 @@ void APP_TimeSlice500ms(void)
 
     const int m = UI_MENU_GetCurrentMenuId();
 
-    if (gBacklightCountdown_500ms > 0 && !gAskToSave && !gCssBackgroundScan
+    const bool backlightCounts = !gAskToSave && !gCssBackgroundScan
         // don't turn off backlight if user is in backlight menu option
-        && !(gScreenToDisplay == DISPLAY_MENU && (m == MENU_ABR || m == MENU_ABR_MAX || m == MENU_ABR_MIN))
-        && --gBacklightCountdown_500ms == 0
-        && gEeprom.BACKLIGHT_TIME < 61
-    ) {
+        && !(gScreenToDisplay == DISPLAY_MENU && (m == MENU_ABR || m == MENU_ABR_MAX || m == MENU_ABR_MIN));
+
+    TIMER_SetGates(1u << TIMER_GATE_BACKLIGHT, backlightCounts << TIMER_GATE_BACKLIGHT);
+
+    if (gBacklightExpired && gEeprom.BACKLIGHT_TIME < 61) {
+        gBacklightExpired = false;
         BACKLIGHT_TurnOff();
 #ifdef ENABLE_FEAT_F4HWN_LOGO_SAV
         ScreenSaverTryDisplay();
@@ -1915,7 +2026,7 @@ void APP_TimeSlice500ms(void)
         ScreenSaverExit();
 #endif
         BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, false);
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
+        TIMER_Start(&gPowerSaveTimer, gEeprom.BATTERY_SAVE * 10);
         gWakeUp = false;
         gUpdateDisplay = true;
         gUpdateStatus = true;
@@ -1931,8 +2042,8 @@ void APP_TimeSlice500ms(void)
     )
     {
         if (gSleepModeCountdown_500ms > 0 && --gSleepModeCountdown_500ms == 0) {
-            gBacklightCountdown_500ms = 0;
-            gPowerSave_10ms = 1;
+            TIMER_Stop(&gBacklightTimer);
+            TIMER_Start(&gPowerSaveTimer, 1);
             gWakeUp = true;
 #ifdef ENABLE_FEAT_F4HWN_LOGO_SAV
             ScreenSaverExit();
@@ -1974,6 +2085,8 @@ void APP_TimeSlice500ms(void)
 
         if (gBatteryCurrent > 500 || gBatteryCalibration[3] < gBatteryCurrentVoltage)
         {
+            PY25Q16_Flush();
+
             #ifdef ENABLE_OVERLAY
                 overlay_FLASH_RebootToBootloader();
             #else
@@ -1988,17 +2101,7 @@ void APP_TimeSlice500ms(void)
 
     // Skipped authentic device check
 
-    if (gCurrentFunction != FUNCTION_TRANSMIT)
-    {
-
-        if ((gBatteryCheckCounter & 1) == 0)
-        {
-            BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[gBatteryVoltageIndex++], &gBatteryCurrent);
-            if (gBatteryVoltageIndex > 3)
-                gBatteryVoltageIndex = 0;
-            BATTERY_GetReadings(true);
-        }
-    }
+    BatteryReadings();
 
     // regular display updates (once every 2 sec) - if need be
     if ((gBatteryCheckCounter & 3) == 0)
@@ -2095,7 +2198,7 @@ void APP_TimeSlice500ms(void)
     }
 
 #ifdef ENABLE_FEAT_F4HWN_LOGO_SAV
-    if (gBacklightCountdown_500ms == 0 &&
+    if (!TIMER_IsArmed(&gBacklightTimer) &&
         gEeprom.BACKLIGHT_TIME > 0 &&
         gEeprom.BACKLIGHT_TIME < 61 &&
         !gAskToSave &&
@@ -2224,7 +2327,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
     if (gCurrentFunction == FUNCTION_POWER_SAVE)
         FUNCTION_Select(FUNCTION_FOREGROUND);
 
-    gBatterySaveCountdown_10ms = battery_save_count_10ms;
+    TIMER_Start(&gBatterySaveTimer, battery_save_count_10ms);
 
     if (gEeprom.AUTO_KEYPAD_LOCK)
         gKeyLockCountdown = gEeprom.AUTO_KEYPAD_LOCK * 30;     // 15 seconds step
@@ -29,6 +29,7 @@ void     APP_StartListening(FUNCTION_Type_t function);
 uint32_t APP_SetFreqByStepAndLimits(VFO_Info_t *pInfo, int8_t direction, uint32_t lower, uint32_t upper);
 uint32_t APP_SetFrequencyByStep(VFO_Info_t *pInfo, int8_t direction);
 void     APP_Update(void);
+void     APP_TimeSlice2ms(void);
 void     APP_TimeSlice10ms(void);
 void     APP_TimeSlice500ms(void);
 bool     APP_IsScreenSaverDisplayed(void);
@@ -798,7 +798,7 @@ void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_directi
     lastFoundFrqOrChanOld = lastFoundFrqOrChan;
 #endif
 
-    gScanPauseDelayIn_10ms = scan_pause_delay_in_2_10ms;
+    TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_2_10ms);
     gScheduleScanListen    = false;
     gRxReceptionMode       = RX_MODE_NONE;
     gScanPauseMode         = false;
@@ -808,9 +808,9 @@ void CHFRSCANNER_ManualResume(const int8_t scan_direction)
 {
     CHFRSCANNER_Start(false, scan_direction);
 
-    gScanPauseDelayIn_10ms = (gRxVfo->SquelchOpenRSSIThresh == 0)
+    TIMER_Start(&gScanPauseTimer, (gRxVfo->SquelchOpenRSSIThresh == 0)
         ? scan_pause_delay_in_3_10ms
-        : 1;
+        : 1);
     gScheduleScanListen    = false;
 }
 
@@ -880,11 +880,11 @@ void CHFRSCANNER_Found(void)
 
     if (gEeprom.SCAN_RESUME_MODE > 80) {
         if (!gScanPauseMode) {
-            gScanPauseDelayIn_10ms = scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 80) * 5;
+            TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 80) * 5);
             gScanPauseMode = true;
         }
     } else {
-        gScanPauseDelayIn_10ms = 0;
+        TIMER_Stop(&gScanPauseTimer);
     }
 
     // gScheduleScanListen is always false...
@@ -895,14 +895,14 @@ void CHFRSCANNER_Found(void)
     {
         if (!gScanPauseMode)
         {
-            gScanPauseDelayIn_10ms = scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 1) * 5;
+            TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_5_10ms * (gEeprom.SCAN_RESUME_MODE - 1) * 5);
             gScheduleScanListen    = false;
             gScanPauseMode         = true;
         }
     }
     else
     {
-        gScanPauseDelayIn_10ms = 0;
+        TIMER_Stop(&gScanPauseTimer);
         gScheduleScanListen    = false;
     }
     */
@@ -913,7 +913,7 @@ void CHFRSCANNER_Found(void)
         case SCAN_RESUME_TO:
             if (!gScanPauseMode)
             {
-                gScanPauseDelayIn_10ms = scan_pause_delay_in_1_10ms;
+                TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_1_10ms);
                 gScheduleScanListen    = false;
                 gScanPauseMode         = true;
             }
@@ -921,7 +921,7 @@ void CHFRSCANNER_Found(void)
 
         case SCAN_RESUME_CO:
         case SCAN_RESUME_SE:
-            gScanPauseDelayIn_10ms = 0;
+            TIMER_Stop(&gScanPauseTimer);
             gScheduleScanListen    = false;
             break;
     }
@@ -996,7 +996,7 @@ static void NextFreqChannel(void)
             if (fastResult == SCAN_FAST_QUIET_BATCH)
             {
                 scanFastLastFullTuneCandidate = false;
-                gScanPauseDelayIn_10ms = 1;
+                TIMER_Start(&gScanPauseTimer, 1);
                 gUpdateDisplay = true;
                 return;
             }
@@ -1031,12 +1031,15 @@ static void NextFreqChannel(void)
 
     RADIO_ApplyOffset(gRxVfo);
     RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
-    RADIO_SetupRegisters(true);
+
+    // Only the frequency changes from one step to the next: the squelch,
+    // tone and audio setup stay armed
+    RADIO_Retune(true);
 
 #ifdef ENABLE_FASTER_CHANNEL_SCAN
-    gScanPauseDelayIn_10ms = 9;   // 90ms
+    TIMER_Start(&gScanPauseTimer, 9);   // 90ms
 #else
-    gScanPauseDelayIn_10ms = scan_pause_delay_in_6_10ms;
+    TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_6_10ms);
 #endif
 
     gUpdateDisplay     = true;
@@ -1163,7 +1166,7 @@ static void NextMemChannel(void)
 
     if (ScanFastEnabled() && !MemChannelFastPrecheck(gNextMrChannel))
     {
-        gScanPauseDelayIn_10ms = 1;
+        TIMER_Start(&gScanPauseTimer, 1);
         gUpdateDisplay = true;
         AdvanceMemScanList(enabled);
         return;
@@ -1188,9 +1191,9 @@ static void NextMemChannel(void)
     }
 
 #ifdef ENABLE_FASTER_CHANNEL_SCAN
-    gScanPauseDelayIn_10ms = 9;  // 90ms .. <= ~60ms it misses signals (squelch response and/or PLL lock time) ?
+    TIMER_Start(&gScanPauseTimer, 9);  // 90ms .. <= ~60ms it misses signals (squelch response and/or PLL lock time) ?
 #else
-    gScanPauseDelayIn_10ms = scan_pause_delay_in_3_10ms;
+    TIMER_Start(&gScanPauseTimer, scan_pause_delay_in_3_10ms);
 #endif
 
 #ifdef ENABLE_FEAT_F4HWN_SCAN_FASTER
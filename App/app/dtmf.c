@@ -140,30 +140,70 @@ bool DTMF_GetContact(const int Index, char *pContact)
         return false;
     }
 
-    EEPROM_ReadBuffer(0x1C00 + (Index * 16), pContact, 16);
+    EEPROM_ReadBuffer(DTMF_CONTACTS_ADDR + (Index * 16), pContact, 16);
 
     // check whether the first character is printable or not
     return (pContact[0] >= ' ' && pContact[0] < 127);
 }
 
-bool DTMF_FindContact(const char *pContact, char *pResult)
+// Contacts index: the records up to the first empty one, sorted by ID
+// (lowest slot first), so the call display's lookups never touch Flash.
+// Read again by every write to the contacts.
+typedef struct {
+    char    name[8];
+    char    id[3];
+    uint8_t slot;
+} ContactEntry_t;
+
+static ContactEntry_t gContacts[MAX_DTMF_CONTACTS];
+static uint8_t        gContactCount;
+
+void DTMF_LoadContacts(void)
 {
-    pResult[0] = 0;
+    gContactCount = 0;
 
     for (unsigned int i = 0; i < MAX_DTMF_CONTACTS; i++) {
         char Contact[16];
         if (!DTMF_GetContact(i, Contact)) {
-            return false;
+            break;
         }
 
-        if (memcmp(pContact, Contact + 8, 3) == 0) {
-            memcpy(pResult, Contact, 8);
-            pResult[8] = 0;
-            return true;
+        // insertion sort, slots arrive in order so ties keep the lowest
+        unsigned int n = gContactCount++;
+        while (n > 0 && memcmp(gContacts[n - 1].id, Contact + 8, 3) > 0) {
+            gContacts[n] = gContacts[n - 1];
+            n--;
         }
+
+        memcpy(gContacts[n].name, Contact, 8);
+        memcpy(gContacts[n].id, Contact + 8, 3);
+        gContacts[n].slot = i;
     }
+}
 
-    return false;
+bool DTMF_FindContact(const char *pContact, char *pResult)
+{
+    pResult[0] = 0;
+
+    // lower bound, so duplicate IDs resolve to the first slot as before
+    unsigned int lo = 0;
+    unsigned int hi = gContactCount;
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi) / 2;
+        if (memcmp(gContacts[mid].id, pContact, 3) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == gContactCount || memcmp(gContacts[lo].id, pContact, 3) != 0) {
+        return false;
+    }
+
+    memcpy(pResult, gContacts[lo].name, 8);
+    pResult[8] = 0;
+    return true;
 }
 
 #endif
@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 #define    MAX_DTMF_CONTACTS   16
+#define    DTMF_CONTACTS_ADDR  0x1C00      // shares the records of channels 448-463
 
 enum DTMF_State_t {
     DTMF_STATE_0 = 0,
@@ -113,6 +114,7 @@ void DTMF_clear_RX(void);
 DTMF_CallMode_t DTMF_CheckGroupCall(const char *pDTMF, const unsigned int size);
 bool DTMF_GetContact(const int Index, char *pContact);
 bool DTMF_FindContact(const char *pContact, char *pResult);
+void DTMF_LoadContacts(void);
 void DTMF_HandleRequest(void);
 
 #endif
@@ -152,7 +152,7 @@ static void processFKeyFunction(const KEY_Code_t Key, const bool beep)
                 if (gScanStateDir != SCAN_OFF) {
                     if (gCurrentFunction != FUNCTION_INCOMING ||
                         gRxReceptionMode == RX_MODE_NONE      ||
-                        gScanPauseDelayIn_10ms == 0)
+                        !TIMER_IsArmed(&gScanPauseTimer))
                     {   // scan is running (not paused)
                         return;
                     }
@@ -248,7 +248,6 @@ static void processFKeyFunction(const KEY_Code_t Key, const bool beep)
                 gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
 #elif defined(ENABLE_SPECTRUM)
                 APP_RunSpectrum();
-                gRequestDisplayScreen = DISPLAY_MAIN;
 #endif
             }
             else {
@@ -755,7 +754,7 @@ static void MAIN_Key_MENU(bool bKeyPressed, bool bKeyHeld)
             // Exclude current scan entry
             if(gScanStateDir != SCAN_OFF)
             {
-                if(FUNCTION_IsRx() || gScanPauseDelayIn_10ms > 9)
+                if(FUNCTION_IsRx() || TIMER_Remaining(&gScanPauseTimer) > 9)
                 {
 #ifdef ENABLE_SCAN_RANGES
                     if(gScanRangeStart && !IS_MR_CHANNEL(gNextMrChannel))
@@ -30,6 +30,7 @@
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
+#include "driver/py25q16.h"
 #include "frequencies.h"
 #include "helper/battery.h"
 #include "misc.h"
@@ -1966,6 +1967,7 @@ static void MENU_Key_MENU(const bool bKeyPressed, const bool bKeyHeld)
                         #endif
 
                         MENU_AcceptSetting();
+                        PY25Q16_Flush();
 
                         #if defined(ENABLE_OVERLAY)
                             overlay_FLASH_RebootToBootloader();
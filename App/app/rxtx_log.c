@@ -30,6 +30,12 @@
 #define RXTX_LOG_FLASH_SIZE          (RXTX_LOG_FLASH_SECTOR_SIZE * RXTX_LOG_FLASH_SECTOR_COUNT)
 #define RXTX_LOG_FLASH_END           (RXTX_LOG_FLASH_BASE + RXTX_LOG_FLASH_SIZE)
 #define RXTX_LOG_SLOT_COUNT          (RXTX_LOG_FLASH_SIZE / sizeof(RXTX_LogFlashEntry_t))
+#define RXTX_LOG_SECTOR_SLOTS        (RXTX_LOG_FLASH_SECTOR_SIZE / sizeof(RXTX_LogFlashEntry_t))
+#define RXTX_LOG_SECTOR_NONE         0xFFu
+#define RXTX_LOG_SLOT_NONE           0xFFFFu
+#define RXTX_LOG_HEADER_MAGIC        0x4C585852u     // "RXXL"
+#define RXTX_LOG_HEADER_COMMIT       0x5Au
+#define RXTX_LOG_NO_SEQUENCE         0xFFFFFFFFu
 #define RXTX_LOG_VIEW_CACHE_COUNT    7u
 #define RXTX_LOG_VIEW_SCAN_BUDGET    8u
 #define RXTX_LOG_VIEW_ANCHOR_STRIDE  32u
@@ -72,8 +78,44 @@ typedef struct __attribute__((packed)) {
     uint8_t  commit;
 } RXTX_LogFlashEntry_t;
 
-static_assert(sizeof(RXTX_LogFlashEntry_t) == 32);
-static_assert(offsetof(RXTX_LogFlashEntry_t, sequence) % 4 == 0);
+// Slot 0 of every sector, written when the log enters the sector. Its
+// commit byte is not RXTX_LOG_ENTRY_COMMIT, so entry scans (older firmware
+// included) skip it. The summary is left blank and programmed over when
+// the log moves on to the next sector: boot then finds the head from the
+// eight headers, and the viewer skips whole sectors by their row counts.
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t sequence;          // flash sequence of the first entry
+    uint32_t trafficSeq;        // next traffic sequence when opened
+    // Summary
+    uint32_t lastTrafficSeq;    // of the newest traffic row, if any
+    uint8_t  used;              // slots written, header included
+    uint8_t  rows[3];           // valid rows per filter (ALL, RX, TX)
+    uint8_t  summaryCrc;
+    uint8_t  crc;
+    uint8_t  reserved[9];
+    uint8_t  commit;
+} RXTX_LogSectorHeader_t;
+
+#define RXTX_LOG_HEADER_SIZE  offsetof(RXTX_LogSectorHeader_t, lastTrafficSeq)
+#define RXTX_LOG_SUMMARY_SIZE (offsetof(RXTX_LogSectorHeader_t, summaryCrc) - RXTX_LOG_HEADER_SIZE)
+
+// RAM copy of the headers, plus the counts of the sector being written
+typedef struct {
+    uint32_t sequence;          // RXTX_LOG_NO_SEQUENCE: no header
+    uint32_t trafficSeq;
+    uint32_t lastTrafficSeq;
+    uint8_t  used;
+    uint8_t  rows[3];
+    bool     counted;           // used / rows / lastTrafficSeq are known
+    bool     summarised;        // summary programmed, or torn: never again
+} RXTX_LogSectorIndex_t;
+
+static_assert(sizeof(RXTX_LogFlashEntry_t) == 32, "an entry takes 32 bytes");
+static_assert(sizeof(RXTX_LogSectorHeader_t) == sizeof(RXTX_LogFlashEntry_t), "the header takes one entry");
+static_assert(offsetof(RXTX_LogFlashEntry_t, sequence) % 4 == 0, "the sequence is word aligned");
+static_assert(offsetof(RXTX_LogSectorHeader_t, lastTrafficSeq) % 4 == 0);
+static_assert(RXTX_LOG_SECTOR_SLOTS <= 0xFF);
 static_assert(RXTX_LOG_VIEW_ANCHOR_COUNT <= 32);
 
 #define RXTX_LOG_ENTRY_COPY_SIZE offsetof(RXTX_LogFlashEntry_t, pad)
@@ -105,6 +147,8 @@ static uint16_t        gViewScanIndex;
 static uint16_t        gViewAnchorSlots[RXTX_LOG_VIEW_ANCHOR_COUNT];
 static uint32_t        gViewAnchorMask;
 static uint8_t         gViewAnchorFilter;
+static RXTX_LogFlashEntry_t gAheadEntry;
+static uint16_t        gAheadSlot = RXTX_LOG_SLOT_NONE;
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_WRAP
 // Wrap-around scrolling state: cycling UP past the first row (or DOWN past
 // the last) requires discovering the total row count with a dedicated scan.
@@ -123,6 +167,8 @@ static bool            gLogHasTraffic;
 static uint32_t        gNextSequence;
 static uint32_t        gNextTrafficSequence;
 static uint32_t        gNextFlashAddress;
+static RXTX_LogSectorIndex_t gSectors[RXTX_LOG_FLASH_SECTOR_COUNT];
+static uint8_t         gHeadSector;    // of the newest entry
 
 static bool            gSessionActive;
 static uint8_t         gSessionFlags;
@@ -257,6 +303,187 @@ static uint16_t RXTX_LOG_NextSlot(uint16_t slot)
     return (uint16_t)(slot + 1u) >= RXTX_LOG_SLOT_COUNT ? 0 : (uint16_t)(slot + 1u);
 }
 
+// Backward scans read one slot and queue the read of the slot before it,
+// which then streams in by DMA while this one is looked at. Scans start
+// with gAheadSlot cleared: a slot read ahead is only trusted within the
+// scan step that read it, with no log write in between.
+static void RXTX_LOG_ReadSlotAhead(uint16_t slot, RXTX_LogFlashEntry_t *flashEntry, bool readAhead)
+{
+    if (slot == gAheadSlot) {
+        PY25Q16_WaitReads();
+        *flashEntry = gAheadEntry;
+    } else {
+        PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(slot), flashEntry, sizeof(*flashEntry));
+    }
+
+    gAheadSlot = RXTX_LOG_SLOT_NONE;
+    if (readAhead) {
+        const uint16_t ahead = RXTX_LOG_PreviousSlot(slot);
+
+        if (PY25Q16_ReadAsync(RXTX_LOG_SlotToAddress(ahead), &gAheadEntry, sizeof(gAheadEntry), NULL, NULL))
+            gAheadSlot = ahead;
+    }
+}
+
+static uint8_t RXTX_LOG_SlotToSector(uint16_t slot)
+{
+    return (uint8_t)(slot / RXTX_LOG_SECTOR_SLOTS);
+}
+
+static uint16_t RXTX_LOG_SectorToSlot(uint8_t sector)
+{
+    return (uint16_t)(sector * RXTX_LOG_SECTOR_SLOTS);
+}
+
+static bool RXTX_LOG_IsValidSectorHeader(const RXTX_LogSectorHeader_t *header)
+{
+    return header->magic == RXTX_LOG_HEADER_MAGIC &&
+           header->commit == RXTX_LOG_HEADER_COMMIT &&
+           header->crc == RXTX_LOG_Crc8(header, RXTX_LOG_HEADER_SIZE);
+}
+
+static void RXTX_LOG_CountEntry(RXTX_LogSectorIndex_t *index, const RXTX_LogFlashEntry_t *entry)
+{
+    index->rows[RXTX_LOG_FILTER_ALL]++;
+
+    if (RXTX_LOG_IsTrafficFlags(entry->flags)) {
+        index->rows[(entry->flags & RXTX_LOG_FLAG_TX) ? RXTX_LOG_FILTER_TX : RXTX_LOG_FILTER_RX]++;
+        index->lastTrafficSeq = entry->trafficSeq;
+    }
+}
+
+static uint8_t RXTX_LOG_TrafficRows(const RXTX_LogSectorIndex_t *index)
+{
+    return index->rows[RXTX_LOG_FILTER_RX] + index->rows[RXTX_LOG_FILTER_TX];
+}
+
+// Counts of a sector without summary, from its entries. Written slots
+// always form a prefix of the sector.
+static void RXTX_LOG_CountSector(uint8_t sector)
+{
+    RXTX_LogSectorIndex_t *index = &gSectors[sector];
+
+    if (index->counted)
+        return;
+
+    index->used = 1;
+    index->lastTrafficSeq = RXTX_LOG_NO_SEQUENCE;
+    memset(index->rows, 0, sizeof(index->rows));
+
+    for (uint16_t slot = 1; slot < RXTX_LOG_SECTOR_SLOTS; slot++) {
+        RXTX_LogFlashEntry_t flashEntry;
+
+        PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(RXTX_LOG_SectorToSlot(sector) + slot), &flashEntry, sizeof(flashEntry));
+        if (RXTX_LOG_IsBlankFlashEntry(&flashEntry))
+            break;
+
+        index->used = (uint8_t)(slot + 1u);
+        if (RXTX_LOG_IsValidFlashEntry(&flashEntry))
+            RXTX_LOG_CountEntry(index, &flashEntry);
+    }
+
+    index->counted = true;
+}
+
+static void RXTX_LOG_ClearIndex(void)
+{
+    for (uint8_t sector = 0; sector < RXTX_LOG_FLASH_SECTOR_COUNT; sector++) {
+        memset(&gSectors[sector], 0, sizeof(gSectors[sector]));
+        gSectors[sector].sequence = RXTX_LOG_NO_SEQUENCE;
+        gSectors[sector].counted  = true;
+    }
+
+    gHeadSector = RXTX_LOG_SECTOR_NONE;
+}
+
+// The eight sector headers. False when a sector holds entries but no
+// header: log written before the headers existed, or a torn header.
+static bool RXTX_LOG_LoadIndex(void)
+{
+    bool usable = true;
+
+    RXTX_LOG_ClearIndex();
+
+    for (uint8_t sector = 0; sector < RXTX_LOG_FLASH_SECTOR_COUNT; sector++) {
+        RXTX_LogSectorIndex_t *index = &gSectors[sector];
+        union {
+            RXTX_LogSectorHeader_t header;
+            RXTX_LogFlashEntry_t   entry;
+        } slot;
+
+        PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(RXTX_LOG_SectorToSlot(sector)), &slot, sizeof(slot));
+
+        if (RXTX_LOG_IsValidSectorHeader(&slot.header)) {
+            const uint8_t *summary = (const uint8_t *)&slot.header.lastTrafficSeq;
+
+            index->sequence   = slot.header.sequence;
+            index->trafficSeq = slot.header.trafficSeq;
+            index->counted    = slot.header.used <= RXTX_LOG_SECTOR_SLOTS &&
+                                slot.header.summaryCrc == RXTX_LOG_Crc8(summary, RXTX_LOG_SUMMARY_SIZE);
+            if (index->counted) {
+                index->lastTrafficSeq = slot.header.lastTrafficSeq;
+                index->used           = slot.header.used;
+                memcpy(index->rows, slot.header.rows, sizeof(index->rows));
+            }
+
+            // Programming over a torn summary would rewrite the sector
+            for (uint8_t i = 0; i <= RXTX_LOG_SUMMARY_SIZE; i++) {
+                if (summary[i] != 0xFFu)
+                    index->summarised = true;
+            }
+        } else if (!RXTX_LOG_IsBlankFlashEntry(&slot.entry)) {
+            index->counted = false;
+            usable = false;
+        }
+    }
+
+    return usable;
+}
+
+// Program the summary of the sector the log leaves and the header of the
+// one it enters, at `address`
+static void RXTX_LOG_OpenSector(uint32_t address)
+{
+    const uint8_t sector = RXTX_LOG_SlotToSector(RXTX_LOG_AddressToSlot(address));
+    RXTX_LogSectorHeader_t header;
+
+    if (gHeadSector != RXTX_LOG_SECTOR_NONE && gHeadSector != sector) {
+        RXTX_LogSectorIndex_t *index = &gSectors[gHeadSector];
+
+        if (index->sequence != RXTX_LOG_NO_SEQUENCE && !index->summarised) {
+            // Entries on the Flash before the summary that counts them
+            PY25Q16_Flush();
+            RXTX_LOG_CountSector(gHeadSector);
+
+            header.lastTrafficSeq = index->lastTrafficSeq;
+            header.used           = index->used;
+            memcpy(header.rows, index->rows, sizeof(header.rows));
+            header.summaryCrc     = RXTX_LOG_Crc8(&header.lastTrafficSeq, RXTX_LOG_SUMMARY_SIZE);
+
+            PY25Q16_WriteBuffer(RXTX_LOG_SlotToAddress(RXTX_LOG_SectorToSlot(gHeadSector)) + RXTX_LOG_HEADER_SIZE,
+                                &header.lastTrafficSeq, RXTX_LOG_SUMMARY_SIZE + 1u, false);
+            index->summarised = true;
+        }
+    }
+
+    memset(&header, 0xFF, sizeof(header));
+    header.magic      = RXTX_LOG_HEADER_MAGIC;
+    header.sequence   = gNextSequence;
+    header.trafficSeq = gNextTrafficSequence;
+    header.crc        = RXTX_LOG_Crc8(&header, RXTX_LOG_HEADER_SIZE);
+    header.commit     = RXTX_LOG_HEADER_COMMIT;
+    PY25Q16_WriteBuffer(address, &header, sizeof(header), false);
+
+    RXTX_LogSectorIndex_t *index = &gSectors[sector];
+    memset(index, 0, sizeof(*index));
+    index->sequence       = header.sequence;
+    index->trafficSeq     = header.trafficSeq;
+    index->lastTrafficSeq = RXTX_LOG_NO_SEQUENCE;
+    index->used           = 1;
+    index->counted        = true;
+    gHeadSector = sector;
+}
+
 static void RXTX_LOG_StartViewCacheScan(uint16_t start, bool circular, bool discoverTotal);
 
 static void RXTX_LOG_StartCursorView(uint16_t cursor)
@@ -357,6 +584,7 @@ static void RXTX_LOG_ResetLogCounters(void)
     gNextSequence        = 0;
     gNextTrafficSequence = 0;
     gNextFlashAddress    = RXTX_LOG_FLASH_BASE;
+    RXTX_LOG_ClearIndex();
     RXTX_LOG_InvalidateViewCache();
 }
 
@@ -461,13 +689,15 @@ static void RXTX_LOG_StepViewCacheScan(void)
     uint8_t budget = RXTX_LOG_VIEW_SCAN_BUDGET;
     bool capReached = false;
 
+    gAheadSlot = RXTX_LOG_SLOT_NONE;
+
     while (gViewScanActive && budget-- > 0 && gViewScanScanned < RXTX_LOG_SLOT_COUNT) {
         RXTX_LogFlashEntry_t flashEntry;
 
         gViewScanSlot = RXTX_LOG_PreviousSlot(gViewScanSlot);
         gViewScanScanned++;
 
-        PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(gViewScanSlot), &flashEntry, sizeof(flashEntry));
+        RXTX_LOG_ReadSlotAhead(gViewScanSlot, &flashEntry, budget > 0 && gViewScanScanned < RXTX_LOG_SLOT_COUNT);
         if (RXTX_LOG_IsBlankFlashEntry(&flashEntry)) {
             gViewScanScanned = RXTX_LOG_SLOT_COUNT;
             break;
@@ -558,10 +788,47 @@ static void RXTX_LOG_StepViewCacheScan(void)
 #endif
 }
 
+// Skip whole sectors, newest first, while row `start` lies past them. The
+// scan then resumes from the returned row and slot. Stops where the scan
+// would: at a sector older than the traffic cap or not full (the rest of
+// the log is blank), and at sectors without header. A traffic row opening
+// a sector took its number before the header was written, hence the cap is
+// checked one row early.
+static uint16_t RXTX_LOG_SeekViewIndex(uint16_t start, uint16_t *slot)
+{
+    uint16_t rowIndex = 0;
+    uint8_t  sector   = gHeadSector;
+
+    *slot = RXTX_LOG_AddressToSlot(gNextFlashAddress);
+
+    for (uint8_t n = 0; n < RXTX_LOG_FLASH_SECTOR_COUNT && sector != RXTX_LOG_SECTOR_NONE; n++) {
+        RXTX_LogSectorIndex_t *index = &gSectors[sector];
+
+        if (index->sequence == RXTX_LOG_NO_SEQUENCE)
+            break;
+
+        RXTX_LOG_CountSector(sector);
+
+        if ((n > 0 && index->used < RXTX_LOG_SECTOR_SLOTS) ||
+            (RXTX_LOG_TrafficRows(index) > 0 &&
+             (gNextTrafficSequence - index->trafficSeq) >= RXTX_LOG_VISIBLE_COUNT) ||
+            rowIndex + index->rows[gLogFilter] > start)
+            break;
+
+        rowIndex += index->rows[gLogFilter];
+        *slot     = RXTX_LOG_SectorToSlot(sector);
+        sector    = (sector == 0) ? RXTX_LOG_FLASH_SECTOR_COUNT - 1u : sector - 1u;
+    }
+
+    return rowIndex;
+}
+
 static void RXTX_LOG_StartViewCacheScan(uint16_t start, bool circular, bool discoverTotal)
 {
     uint16_t anchorIndex;
     uint16_t anchorSlot;
+    uint16_t seekSlot;
+    uint16_t seekIndex;
 
     start = RXTX_LOG_PageStart(start);
     RXTX_LOG_EnsureViewAnchors();
@@ -590,17 +857,21 @@ static void RXTX_LOG_StartViewCacheScan(uint16_t start, bool circular, bool disc
         return;
     }
 
-    if (RXTX_LOG_FindViewAnchor(start, &anchorIndex, &anchorSlot)) {
+    seekIndex = RXTX_LOG_SeekViewIndex(start, &seekSlot);
+
+    if (RXTX_LOG_FindViewAnchor(start, &anchorIndex, &anchorSlot) && anchorIndex >= seekIndex) {
         gViewScanSlot  = RXTX_LOG_NextSlot(anchorSlot);
         gViewScanSkip  = start - anchorIndex;
         gViewScanIndex = anchorIndex;
     } else {
-        gViewScanSlot  = RXTX_LOG_AddressToSlot(gNextFlashAddress);
-        gViewScanSkip  = start;
-        gViewScanIndex = 0;
+        gViewScanSlot  = seekSlot;
+        gViewScanSkip  = start - seekIndex;
+        gViewScanIndex = seekIndex;
     }
 
     gViewScanScanned = 0;
+    if (gViewScanSlot == seekSlot)
+        gViewScanScanned = (RXTX_LOG_AddressToSlot(gNextFlashAddress) + RXTX_LOG_SLOT_COUNT - seekSlot) % RXTX_LOG_SLOT_COUNT;
     gViewScanActive  = true;
 }
 
@@ -656,17 +927,20 @@ static void RXTX_LOG_PrepareNextSlot(void)
     if (gNextFlashAddress >= RXTX_LOG_FLASH_END)
         gNextFlashAddress = RXTX_LOG_FLASH_BASE;
 
-    if (!RXTX_LOG_SlotIsBlank(gNextFlashAddress)) {
-        if ((gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE) != 0) {
-            gNextFlashAddress += RXTX_LOG_FLASH_SECTOR_SIZE - (gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE);
-            if (gNextFlashAddress >= RXTX_LOG_FLASH_END)
-                gNextFlashAddress = RXTX_LOG_FLASH_BASE;
-        }
+    if (!RXTX_LOG_SlotIsBlank(gNextFlashAddress) &&
+        (gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE) != 0) {
+        gNextFlashAddress += RXTX_LOG_FLASH_SECTOR_SIZE - (gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE);
+        if (gNextFlashAddress >= RXTX_LOG_FLASH_END)
+            gNextFlashAddress = RXTX_LOG_FLASH_BASE;
+    }
 
-        if (!RXTX_LOG_SlotIsBlank(gNextFlashAddress)) {
-            const uint32_t sector = gNextFlashAddress - (gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE);
-            PY25Q16_SectorErase(sector);
-        }
+    // Entering a sector: erase it if needed and put its header in slot 0
+    if ((gNextFlashAddress % RXTX_LOG_FLASH_SECTOR_SIZE) == 0) {
+        if (!RXTX_LOG_SlotIsBlank(gNextFlashAddress))
+            PY25Q16_SectorErase(gNextFlashAddress);
+
+        RXTX_LOG_OpenSector(gNextFlashAddress);
+        gNextFlashAddress += sizeof(RXTX_LogFlashEntry_t);
     }
 }
 
@@ -691,6 +965,16 @@ static void RXTX_LOG_WriteEntry(const RXTX_LogEntry_t *src)
 
     PY25Q16_WriteBuffer(gNextFlashAddress, &entry, sizeof(entry), false);
     PY25Q16_WriteBuffer(gNextFlashAddress + sizeof(entry) - 1u, &commit, 1, false);
+
+    const uint16_t slot = RXTX_LOG_AddressToSlot(gNextFlashAddress);
+    RXTX_LogSectorIndex_t *index = &gSectors[RXTX_LOG_SlotToSector(slot)];
+
+    if (index->counted) {
+        index->used = (uint8_t)(slot % RXTX_LOG_SECTOR_SLOTS + 1u);
+        RXTX_LOG_CountEntry(index, &entry);
+    }
+    gHeadSector = RXTX_LOG_SlotToSector(slot);
+
     RXTX_LOG_AdvanceFlashAddress();
 }
 
@@ -815,11 +1099,13 @@ static uint32_t RXTX_LOG_SendK5ViewerRows(uint32_t beforeSeq, uint8_t count,
     if (gLogHasTraffic && beforeSeq > 0) {
         uint16_t slot = RXTX_LOG_AddressToSlot(gNextFlashAddress);
 
+        gAheadSlot = RXTX_LOG_SLOT_NONE;
+
         for (uint16_t scanned = 0; scanned < RXTX_LOG_SLOT_COUNT && rowsSent < count; scanned++) {
             RXTX_LogFlashEntry_t flashEntry;
 
             slot = RXTX_LOG_PreviousSlot(slot);
-            PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(slot), &flashEntry, sizeof(flashEntry));
+            RXTX_LOG_ReadSlotAhead(slot, &flashEntry, scanned + 1u < RXTX_LOG_SLOT_COUNT);
 
             if (RXTX_LOG_IsBlankFlashEntry(&flashEntry))
                 break;
@@ -925,28 +1211,11 @@ static void RXTX_LOG_CaptureSession(uint8_t flags, const VFO_Info_t *vfo)
     RXTX_LOG_UpdateSessionMeters();
 }
 
-void RXTX_LOG_Init(void)
+static void RXTX_LOG_FindHeadLinear(RXTX_LogHead_t *head)
 {
-    uint32_t maxSequence = 0;
-    uint32_t maxAddress = RXTX_LOG_FLASH_BASE;
+    uint32_t maxSequence   = 0;
+    uint32_t maxAddress    = RXTX_LOG_FLASH_BASE;
     uint32_t maxTrafficSeq = 0;
-    uint8_t lastEntryFlags = 0;
-    bool found = false;
-    bool foundTraffic = false;
-
-    gLogCursor        = 0;
-    gLogFilter        = RXTX_LOG_FILTER_ALL;
-    gSessionActive    = false;
-    gSessionSMeter    = RXTX_LOG_SMETER_UNKNOWN;
-    gSessionBattVolt  = RXTX_LOG_BATT_UNKNOWN;
-    gClearActive        = false;
-    gClearConfirmActive = false;
-    gClearSector        = 0;
-    gMenuClearHandled   = false;
-    gLogDetailMode      = RXTX_LOG_DETAIL_DURATION;
-    gLogHasTraffic      = false;
-    gNextFlashAddress   = RXTX_LOG_FLASH_BASE;
-    RXTX_LOG_InvalidateViewCache();
 
     for (uint32_t address = RXTX_LOG_FLASH_BASE; address < RXTX_LOG_FLASH_END; address += sizeof(RXTX_LogFlashEntry_t)) {
         RXTX_LogFlashEntry_t flashEntry;
@@ -956,35 +1225,152 @@ void RXTX_LOG_Init(void)
             continue;
 
         if (RXTX_LOG_IsTrafficFlags(flashEntry.flags)) {
-            gLogHasTraffic = true;
-            if (!foundTraffic || flashEntry.trafficSeq > maxTrafficSeq) {
-                foundTraffic = true;
+            if (!head->hasTraffic || flashEntry.trafficSeq > maxTrafficSeq) {
+                head->hasTraffic = true;
                 maxTrafficSeq = flashEntry.trafficSeq;
             }
         }
 
-        if (!found || flashEntry.sequence > maxSequence) {
-            found = true;
+        if (!head->found || flashEntry.sequence > maxSequence) {
+            head->found = true;
             maxSequence = flashEntry.sequence;
             maxAddress = address;
-            lastEntryFlags = flashEntry.flags;
+            head->lastFlags = flashEntry.flags;
         }
     }
 
-    if (found) {
-        gNextSequence = maxSequence + 1u;
-        gNextFlashAddress = maxAddress + sizeof(RXTX_LogFlashEntry_t);
-        if (gNextFlashAddress >= RXTX_LOG_FLASH_END)
-            gNextFlashAddress = RXTX_LOG_FLASH_BASE;
-    } else {
-        gNextSequence = 0;
+    if (head->found) {
+        head->nextSequence = maxSequence + 1u;
+        head->nextAddress = maxAddress + sizeof(RXTX_LogFlashEntry_t);
+        if (head->nextAddress >= RXTX_LOG_FLASH_END)
+            head->nextAddress = RXTX_LOG_FLASH_BASE;
+    }
+
+    if (head->hasTraffic)
+        head->nextTrafficSequence = maxTrafficSeq + 1u;
+}
+
+// The newest sector is the one whose header carries the highest sequence.
+// Its written slots form a prefix, found by bisection; from there the walk
+// back to the newest entry and to the newest traffic row skips summarised
+// sectors whole.
+static void RXTX_LOG_FindHeadIndexed(RXTX_LogHead_t *head)
+{
+    uint8_t  active = RXTX_LOG_SECTOR_NONE;
+    uint16_t first  = 1;
+    uint16_t last   = RXTX_LOG_SECTOR_SLOTS;
+
+    for (uint8_t sector = 0; sector < RXTX_LOG_FLASH_SECTOR_COUNT; sector++) {
+        if (gSectors[sector].sequence != RXTX_LOG_NO_SEQUENCE &&
+            (active == RXTX_LOG_SECTOR_NONE || gSectors[sector].sequence > gSectors[active].sequence))
+            active = sector;
+    }
+
+    if (active == RXTX_LOG_SECTOR_NONE)
+        return;
+
+    while (first < last) {
+        const uint16_t middle = (first + last) / 2u;
+
+        if (RXTX_LOG_SlotIsBlank(RXTX_LOG_SlotToAddress(RXTX_LOG_SectorToSlot(active) + middle)))
+            last = middle;
+        else
+            first = middle + 1u;
+    }
+
+    uint16_t slot = (uint16_t)(RXTX_LOG_SectorToSlot(active) + first);
+
+    for (uint16_t scanned = 0; scanned < RXTX_LOG_SLOT_COUNT; scanned++) {
+        RXTX_LogFlashEntry_t flashEntry;
+
+        slot = RXTX_LOG_PreviousSlot(slot);
+
+        const uint8_t                sector = RXTX_LOG_SlotToSector(slot);
+        const RXTX_LogSectorIndex_t *index  = &gSectors[sector];
+
+        if (slot % RXTX_LOG_SECTOR_SLOTS == RXTX_LOG_SECTOR_SLOTS - 1u && index->counted) {
+            // Entering a sector from its end: its counts tell whether it
+            // holds what is looked for, and where its entries stop
+            const bool wanted = head->found ? RXTX_LOG_TrafficRows(index) > 0 : index->rows[RXTX_LOG_FILTER_ALL] > 0;
+
+            if (wanted && head->found) {
+                head->hasTraffic = true;
+                head->nextTrafficSequence = index->lastTrafficSeq + 1u;
+                break;
+            }
+
+            if (!wanted) {
+                slot = RXTX_LOG_SectorToSlot(sector);
+                scanned += RXTX_LOG_SECTOR_SLOTS - 1u;
+                continue;
+            }
+
+            slot = (uint16_t)(RXTX_LOG_SectorToSlot(sector) + index->used - 1u);
+            scanned += RXTX_LOG_SECTOR_SLOTS - index->used;
+        }
+
+        PY25Q16_ReadBuffer(RXTX_LOG_SlotToAddress(slot), &flashEntry, sizeof(flashEntry));
+        if (!RXTX_LOG_IsValidFlashEntry(&flashEntry))
+            continue;
+
+        if (!head->found) {
+            head->found        = true;
+            head->nextSequence = flashEntry.sequence + 1u;
+            head->nextAddress  = RXTX_LOG_SlotToAddress(RXTX_LOG_NextSlot(slot));
+            head->lastFlags    = flashEntry.flags;
+        }
+
+        if (RXTX_LOG_IsTrafficFlags(flashEntry.flags)) {
+            head->hasTraffic = true;
+            head->nextTrafficSequence = flashEntry.trafficSeq + 1u;
+            break;
+        }
+    }
+}
+
+void RXTX_LOG_FindHead(RXTX_LogHead_t *head, bool linear)
+{
+    memset(head, 0, sizeof(*head));
+    head->nextAddress = RXTX_LOG_FLASH_BASE;
+
+    if (RXTX_LOG_LoadIndex() && !linear)
+        RXTX_LOG_FindHeadIndexed(head);
+    else
+        RXTX_LOG_FindHeadLinear(head);
+
+    gHeadSector = RXTX_LOG_SECTOR_NONE;
+    if (head->found) {
+        const uint16_t slot = RXTX_LOG_PreviousSlot(RXTX_LOG_AddressToSlot(head->nextAddress));
+        gHeadSector = RXTX_LOG_SlotToSector(slot);
     }
+}
+
+void RXTX_LOG_Init(void)
+{
+    RXTX_LogHead_t head;
+
+    gLogCursor        = 0;
+    gLogFilter        = RXTX_LOG_FILTER_ALL;
+    gSessionActive    = false;
+    gSessionSMeter    = RXTX_LOG_SMETER_UNKNOWN;
+    gSessionBattVolt  = RXTX_LOG_BATT_UNKNOWN;
+    gClearActive        = false;
+    gClearConfirmActive = false;
+    gClearSector        = 0;
+    gMenuClearHandled   = false;
+    gLogDetailMode      = RXTX_LOG_DETAIL_DURATION;
+    RXTX_LOG_InvalidateViewCache();
+
+    RXTX_LOG_FindHead(&head, false);
 
-    gNextTrafficSequence = foundTraffic ? maxTrafficSeq + 1u : 0;
+    gLogHasTraffic       = head.hasTraffic;
+    gNextSequence        = head.nextSequence;
+    gNextTrafficSequence = head.nextTrafficSequence;
+    gNextFlashAddress    = head.nextAddress;
 
     // Skip the marker if the log already ends with one (e.g. repeated
     // reboots with no RX/TX in between) to avoid stacking empty separators.
-    if (!found || (lastEntryFlags & RXTX_LOG_FLAG_SESSION) == 0)
+    if (!head.found || (head.lastFlags & RXTX_LOG_FLAG_SESSION) == 0)
         RXTX_LOG_WriteSessionMarker();
 }
 
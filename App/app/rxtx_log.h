@@ -69,6 +69,20 @@ void RXTX_LOG_SendK5ViewerPacket(void (*send)(const uint8_t *data, uint16_t size
 uint32_t RXTX_LOG_SendK5ViewerHistoryPage(uint32_t beforeSeq, void (*send)(const uint8_t *data, uint16_t size));
 #endif
 
+// Where the log carries on after a reboot
+typedef struct {
+    uint32_t nextAddress;
+    uint32_t nextSequence;
+    uint32_t nextTrafficSequence;
+    uint8_t  lastFlags;         // of the newest entry
+    bool     found;             // any entry at all
+    bool     hasTraffic;
+} RXTX_LogHead_t;
+
+// From the sector headers, or from every slot of the log when `linear` is
+// set or some sector predates the headers
+void RXTX_LOG_FindHead(RXTX_LogHead_t *head, bool linear);
+
 void RXTX_LOG_Init(void);
 void RXTX_LOG_BeginRx(const VFO_Info_t *vfo, FUNCTION_Type_t function);
 void RXTX_LOG_BeginTx(const VFO_Info_t *vfo);
@@ -120,15 +120,64 @@ static uint16_t interlaceStride = 1;
 static uint16_t interlacePhase = 0;
 #endif
 
-// Incremental display: one framebuffer page sent per tick instead of a full
-// BlitFullScreen burst.
+// Sample age: 10 ms slices, and the slice each bin was last measured in
+static uint16_t sweepSlices = 0;
+static uint16_t binSeen[128];
+
+// Optional adaptive dwell for sweeps of up to 128 steps: instead of walking
+// the bins in order, the next bin measured is the one measured the most
+// measurements ago weighted by its activity (1x to 8x), bins past
+// SPECTRUM_STALE_SLICES first. A bin measured over the floor estimate, or
+// holding the peak, gets hot, and cools down by an eighth every
+// HEAT_COOL_SLICES. A sweep is one
+// measurement per bin; a hot bin over the open level is listened to at once.
+// Blacklisted bins are never measured.
+// 1 = enabled, 0 = disabled.
+#ifndef SPECTRUM_ADAPTIVE_SWEEP
+#define SPECTRUM_ADAPTIVE_SWEEP 1
+#endif
+#ifndef SPECTRUM_STALE_SLICES
+#define SPECTRUM_STALE_SLICES 30
+#endif
+#if SPECTRUM_ADAPTIVE_SWEEP
+bool adaptiveSweepEnabled = true;
+static bool adaptiveSweep = false;  // the current sweep is scheduled by activity
+static uint8_t binHeat[128];
+static uint16_t adaptiveMeasured = 0; // measurements in this half sweep
+static uint16_t measureSeq = 0;       // measurement count, and the last one of each bin
+static uint16_t binMeasured[128];
+#define HEAT_COOL_SLICES 8
+#define HEAT_MARGIN_RSSI 12     // 6 dB over the floor estimate
+#endif
+
+// Columns whose bins are older than this while sweeping (wide ranges, or a
+// sweep falling behind) are drawn with a sparse body
+#define SPECTRUM_AGED_SLICES (2 * SPECTRUM_STALE_SLICES)
+
+// Incremental display: one framebuffer page sent per 2 ms slice instead of a
+// full BlitFullScreen burst.
 static uint8_t renderPage = 0;
 
-// Decoupled render timer: Render() fires every RENDER_PERIOD_TICKS ticks
-// regardless of step count, keeping it above the ~9 Hz flutter-fusion
+// Decoupled render timer: Render() fires every RENDER_PERIOD_SLICES 10 ms
+// slices regardless of step count, keeping it above the ~9 Hz flutter-fusion
 // threshold that would cause an audible "tac" if tied to the sweep rate.
-static uint16_t renderTimer = 0;
-#define RENDER_PERIOD_TICKS 20
+static uint8_t renderTimer = 0;
+#define RENDER_PERIOD_SLICES 2
+
+// Keys are read every KEY_POLL_SLICES 10 ms slices, the rate the 20 ms
+// delay per held key used to give; a handler may hold them off longer.
+static uint8_t keyPollTimer = 0;
+static bool keyPollDue = false;
+#define KEY_POLL_SLICES 2
+
+// Status line refreshed every ~4 s even when nothing asks for it
+#define STATUS_PERIOD_SLICES 400
+
+// A measurement waits for the glitch indicator to settle after the receiver
+// restarts, one read per step, so that the main loop carries on meanwhile.
+static bool measurePending = false;
+static uint8_t settleGuard = 0;
+#define SETTLE_GUARD_READS 50
 
 // Disabling automatic DbMax and squelch trigger settings
 static bool manualSetFlag = false;
@@ -174,7 +223,7 @@ KEY_Code_t freqInputArr[10];
 char freqInputString[11];
 
 uint8_t menuState = 0;
-uint16_t listenT = 0;
+uint16_t listenT = 0;    // 10 ms slices to the next listen measurement
 
 RegisterSpec registerSpecs[] = {
     {},
@@ -581,11 +630,22 @@ static void TuneToPeak()
     SetF(scanInfo.f);
 }
 
-static void DeInitSpectrum()
+void SPECTRUM_Exit(void)
 {
+    if (!isInitialized)
+        return;
+
     SetF(initialFreq);
     RestoreRegisters();
     isInitialized = false;
+    measurePending = false;
+}
+
+static void DeInitSpectrum()
+{
+    SPECTRUM_Exit();
+
+    BACKLIGHT_TurnOn();
 }
 
 uint8_t GetBWRegValueForScan()
@@ -593,14 +653,29 @@ uint8_t GetBWRegValueForScan()
     return scanStepBWRegValues[settings.scanStepIndex];
 }
 
-uint16_t GetRssi()
+static void StartMeasure()
 {
-    // Wait for glitch to settle below threshold (not just < 255)
-    uint8_t guard = 50;
-    while (guard-- && (BK4819_ReadRegister(0x63) & 0xFF) >= 200)
+    measurePending = true;
+    settleGuard = SETTLE_GUARD_READS;
+}
+
+// One glitch read per call: true once it has settled below the threshold
+// (not just < 255), or after SETTLE_GUARD_READS reads, and the RSSI can be
+// read.
+static bool MeasureSettled()
+{
+    if (settleGuard && (BK4819_ReadRegister(0x63) & 0xFF) >= 200)
     {
-        SYSTICK_DelayUs(1);
+        settleGuard--;
+        return false;
     }
+
+    measurePending = false;
+    return true;
+}
+
+uint16_t GetRssi()
+{
     // Discard first read (AGC may still be transitioning), keep second
     BK4819_GetRSSI();
     uint16_t rssi = BK4819_GetRSSI();
@@ -655,11 +730,11 @@ static void ToggleRX(bool on)
         // listenPrevRssi = RSSI_MAX_VALUE; // previous behavior
         listenPrevRssi = peak.rssi;
     #ifdef ENABLE_FEAT_F4HWN_SPECTRUM
-        listenT = 25;
+        listenT = 3;
         BK4819_WriteRegister(0x43, listenBWRegValues[settings.listenBw]);
         setTailFoundInterrupt();
     #else
-        listenT = 1000;
+        listenT = 100;
         BK4819_WriteRegister(0x43, listenBWRegValues[settings.listenBw]);
     #endif
     }
@@ -705,8 +780,9 @@ static void InitScanPosition()
 #endif
     if (!startFromLeft && scanInfo.measurementsCount > 1)
     {
+        // The last bin, GetFEnd() is one step further without a scan range
         scanInfo.i = scanInfo.measurementsCount - 1;
-        scanInfo.f = GetFEnd();
+        scanInfo.f = GetFStart() + (uint32_t)scanInfo.i * scanInfo.scanStep;
         scanForward = false;
     }
     else
@@ -716,12 +792,27 @@ static void InitScanPosition()
         scanForward = true;
     }
     scanReturnPending = scanInfo.measurementsCount > 1;
+
+#if SPECTRUM_ADAPTIVE_SWEEP
+    adaptiveSweep = adaptiveSweepEnabled &&
+                    scanInfo.measurementsCount <= ARRAY_SIZE(rssiHistory);
+    adaptiveMeasured = 0;
+#endif
 }
 
 static void InitScan()
 {
     InitScanPosition();
 
+    // Every bin is due on the first pass
+    for (uint8_t i = 0; i < ARRAY_SIZE(binSeen); i++)
+        binSeen[i] = sweepSlices - SPECTRUM_STALE_SLICES;
+#if SPECTRUM_ADAPTIVE_SWEEP
+    memset(binHeat, 0, sizeof(binHeat));
+    memset(binMeasured, 0, sizeof(binMeasured));
+    measureSeq = 0;
+#endif
+
     // Cache the band-select LNA and REG_30 for the upcoming sweep.
     // SetFScan() will use these cached values, saving 3 SPI ops per step.
     // Mask bit 9 (AF DAC enable) so the cached value is always correct for
@@ -882,11 +973,15 @@ static void SetRssiHistory(uint16_t idx, uint16_t rssi)
         return;
     }
 #endif
-    // Attack/decay: instant rise, fast fall for stable display
+    // Attack/decay: instant rise, fast fall for stable display. The gap
+    // halves per 80 ms the sample is old, so bins the adaptive sweep visits
+    // less often fall as fast as the others.
     if (rssi >= prev) {
         rssiHistory[slot] = rssi;              // Attack: instant
     } else {
-        rssiHistory[slot] = (prev + rssi) >> 1; // Decay: halve the gap each sweep
+        uint16_t age = sweepSlices - binSeen[slot];
+        uint8_t shift = (age >= 24) ? 4 : 1 + (age >> 3);
+        rssiHistory[slot] = rssi + ((prev - rssi) >> shift); // Decay
     }
 }
 
@@ -894,6 +989,7 @@ static void Measure()
 {
     uint16_t rssi = scanInfo.rssi = GetRssi();
     SetRssiHistory(scanInfo.i, rssi);
+    binSeen[GetHistorySlot(scanInfo.i)] = sweepSlices;
 }
 
 static void RequestAutoTriggerRecalibration()
@@ -1085,7 +1181,7 @@ static void ResumeSweepInDirection(bool forward)
     {
         scanForward = false;
         scanInfo.i = scanInfo.measurementsCount - 1;
-        scanInfo.f = GetFEnd();
+        scanInfo.f = GetFStart() + (uint32_t)scanInfo.i * scanInfo.scanStep;
     }
 
     newScanStart = false;
@@ -1105,7 +1201,7 @@ static void UpdateFreqChangeStep(bool inc)
     {
         settings.frequencyChangeStep -= diff;
     }
-    SYSTEM_DelayMs(100);
+    keyPollTimer = 10; // 100 ms before the next repeat
     redrawScreen = true;
 }
 
@@ -1402,10 +1498,20 @@ Start:
         goto Back;
 }
 
+static bool IsColumnAged(uint8_t x, uint8_t bars)
+{
+    if (isListening || bars == 0)
+        return false;
+
+    uint8_t i = (bars > 1) ? (uint8_t)(((uint16_t)x * (bars - 1) + 63) / 127) : 0;
+
+    return (uint16_t)(sweepSlices - binSeen[i]) > SPECTRUM_AGED_SLICES;
+}
+
 // Draw the spectrum curve (solid crest + checkerboard body) and the peak hold
 // dotted trace.  Both use the same half-step bridging so the peak hold crest
 // shape mirrors the live crest exactly, just rendered with a dotted pattern.
-static void DrawSpectrumCurve(const uint8_t *topY)
+static void DrawSpectrumCurve(const uint8_t *topY, uint8_t bars)
 {
     // Pass 1: update peakHoldY[] from topY[] before rendering so that the
     // bridging in Pass 2 already sees fully-updated neighbour values.
@@ -1448,9 +1554,10 @@ static void DrawSpectrumCurve(const uint8_t *topY)
             for (uint8_t y = crestTop; y <= crestBot; y++)
                 PutPixel(x, y, true);
 
-            // Checkerboard body below the crest.
+            // Checkerboard body below the crest, sparse for aged samples.
+            uint8_t mask = IsColumnAged(x, bars) ? 3 : 1;
             for (uint8_t y = crestBot + 1; y <= DrawingEndY; y++)
-                if (((x + y) & 1) == 0)
+                if (((x + y) & mask) == 0)
                     PutPixel(x, y, true);
         }
 
@@ -1521,7 +1628,8 @@ static void BuildSpectrumTopY(uint8_t *topY, uint8_t bars)
     }
 }
 
-static void BuildCurrentSpectrumTopY(uint8_t *topY)
+// Returns the number of samples drawn
+static uint8_t BuildCurrentSpectrumTopY(uint8_t *topY)
 {
 #ifdef ENABLE_FEAT_F4HWN
     uint16_t steps = GetStepsCount();
@@ -1539,6 +1647,8 @@ static void BuildCurrentSpectrumTopY(uint8_t *topY)
     // cross the trigger line when the radio opens the squelch.
     if (!manualSetFlag)
         SmoothTopY(topY);
+
+    return bars;
 }
 
 static void DrawStatus()
@@ -1988,10 +2098,10 @@ static void RenderSpectrum()
     uint8_t arrowX = (steps > 1) ? (uint8_t)(128u * peak.i / (steps - 1)) : 0;
     uint8_t topY[128];
 
-    BuildCurrentSpectrumTopY(topY);
+    uint8_t bars = BuildCurrentSpectrumTopY(topY);
     DrawTicks();
     DrawArrow(arrowX);
-    DrawSpectrumCurve(topY);
+    DrawSpectrumCurve(topY, bars);
     DrawF(peak.f);
     DrawNums();
     DrawRssiTriggerLevel(topY);
@@ -2108,7 +2218,8 @@ static void Render()
         break;
     }
 
-    // Display blit is done incrementally (one page per tick) — see Tick().
+    // Display blit is done incrementally (one page per 2 ms slice) — see
+    // SPECTRUM_TimeSlice2ms().
 }
 
 static bool HandleUserInput()
@@ -2122,7 +2233,6 @@ static bool HandleUserInput()
             kbd.counter++;
         else
             kbd.counter -= 3;
-        SYSTEM_DelayMs(20);
     }
     else
     {
@@ -2180,20 +2290,21 @@ static bool HandleUserInput()
     return true;
 }
 
-static void Scan()
+// Tune the current step and start its measurement, false if it is skipped
+static bool Scan()
 {
     uint8_t slot = GetHistorySlot(scanInfo.i);
 
-    if (rssiHistory[slot] != RSSI_MAX_VALUE
+    if (rssiHistory[slot] == RSSI_MAX_VALUE
 #ifdef ENABLE_SCAN_RANGES
-        && !IsBlacklisted(scanInfo.i)
+        || IsBlacklisted(scanInfo.i)
 #endif
     )
-    {
-        SetFScan(scanInfo.f);
-        Measure();
-        UpdateScanInfo();
-    }
+        return false;
+
+    SetFScan(scanInfo.f);
+    StartMeasure();
+    return true;
 }
 
 static void NextScanStep()
@@ -2267,9 +2378,131 @@ static void FinalizeCompletedSweep()
     newScanStart = true;
 }
 
+#if SPECTRUM_ADAPTIVE_SWEEP
+static void UpdateBinHeat()
+{
+    uint16_t floor = (autoNoiseFloor != RSSI_MAX_VALUE) ? autoNoiseFloor : scanInfo.rssiMin;
+
+    if (floor != RSSI_MAX_VALUE && scanInfo.rssi >= floor + HEAT_MARGIN_RSSI)
+        binHeat[scanInfo.i] = 255;
+}
+
+// Least recently measured bin weighted by activity, the first one from the current bin on
+// when several score the same so that equal bins are still swept in order
+static bool NextAdaptiveBin()
+{
+    uint16_t best = scanInfo.measurementsCount;
+    uint32_t bestScore = 0;
+
+    for (uint16_t n = 1; n <= scanInfo.measurementsCount; n++)
+    {
+        uint16_t i = (scanInfo.i + n) % scanInfo.measurementsCount;
+
+        if (rssiHistory[i] == RSSI_MAX_VALUE
+#ifdef ENABLE_SCAN_RANGES
+            || IsBlacklisted(i)
+#endif
+        )
+            continue;
+
+        uint16_t age = sweepSlices - binSeen[i];
+        uint32_t score = (age >= SPECTRUM_STALE_SLICES)
+                             ? 0x80000u + age
+                             : (uint32_t)(uint16_t)(measureSeq - binMeasured[i]) * (1u + (binHeat[i] >> 5));
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = i;
+        }
+    }
+
+    if (best == scanInfo.measurementsCount)
+        return false;
+
+    scanInfo.i = best;
+    scanInfo.f = GetFStart() + (uint32_t)best * scanInfo.scanStep;
+    return true;
+}
+
+static void UpdateScanAdaptive()
+{
+    if (measurePending)
+    {
+        if (!MeasureSettled())
+            return;
+
+        Measure();
+        UpdateScanInfo();
+        UpdateBinHeat();
+        binMeasured[scanInfo.i] = ++measureSeq;
+        ++peak.t;
+
+        bool sweepDone = ++adaptiveMeasured >= scanInfo.measurementsCount;
+
+        // A hot bin is listened to as soon as it opens, the others when the
+        // sweep is done, as on the ordered sweep
+        if (sweepDone || (binHeat[scanInfo.i] && scanInfo.iPeak == scanInfo.i))
+        {
+            if (sweepDone)
+                preventKeypress = false;
+            UpdatePeakInfo();
+            if (IsPeakOverOpenLevel())
+            {
+                ToggleRX(true);
+                TuneToPeak();
+                return;
+            }
+        }
+
+        if (sweepDone)
+        {
+            adaptiveMeasured = 0;
+            if (scanReturnPending)
+            {
+                scanReturnPending = false;
+            }
+            else
+            {
+                // The peak stays hot between sweeps
+                if (peak.f && peak.i < ARRAY_SIZE(binHeat))
+                    binHeat[peak.i] |= 0x80;
+                FinalizeCompletedSweep();
+                return;
+            }
+        }
+    }
+
+    if (NextAdaptiveBin())
+    {
+        SetFScan(scanInfo.f);
+        StartMeasure();
+    }
+}
+#endif
+
 static void UpdateScan()
 {
-    Scan();
+#if SPECTRUM_ADAPTIVE_SWEEP
+    if (adaptiveSweep)
+    {
+        UpdateScanAdaptive();
+        return;
+    }
+#endif
+
+    if (measurePending)
+    {
+        if (!MeasureSettled())
+            return;
+
+        Measure();
+        UpdateScanInfo();
+    }
+    else if (Scan())
+    {
+        // Yield while the receiver settles
+        return;
+    }
 
 #if SPECTRUM_INTERLACE_LARGE_SWEEPS
     if (UseInterlacedSweep())
@@ -2337,6 +2570,11 @@ static void UpdateScan()
 
 static void UpdateStill()
 {
+    if (!measurePending)
+        StartMeasure();
+    if (!MeasureSettled())
+        return;
+
     Measure();
     redrawScreen = true;
     preventKeypress = false;
@@ -2356,42 +2594,36 @@ static void UpdateListening()
 {
     preventKeypress = false;
 
-    // listenT counts down with 1ms delay per tick — no SPI during this phase.
-    if (listenT)
+    if (!measurePending)
     {
-        listenT--;
-        SYSTEM_DelayMs(1);
-        return;
-    }
+        // listenT counts down in the 10 ms slices — no SPI during this phase.
+        if (listenT)
+            return;
 
-    // --- Single SPI burst: all BK4819 accesses happen here, once per
-    // listenT expiry (every 320 ms).  SPI repeats at ~3 Hz — below the
-    // audible range.  Between bursts the bus is completely silent.
+        // --- Single SPI burst: all BK4819 accesses happen here, once per
+        // listenT expiry (every 320 ms).  SPI repeats at ~3 Hz — below the
+        // audible range.  Between bursts the bus is completely silent.
 
 #ifdef ENABLE_FEAT_F4HWN_SPECTRUM
-    bool tailFound = checkIfTailFound();
-    if (tailFound)
-    {
-        ToggleRX(false);
-        ResetScanStats();
-        ResetPeak();
-        RequestAutoTriggerRecalibration();
-        newScanStart = true;
-        redrawStatus = true;
-        return;
-    }
+        bool tailFound = checkIfTailFound();
+        if (tailFound)
+        {
+            ToggleRX(false);
+            ResetScanStats();
+            ResetPeak();
+            RequestAutoTriggerRecalibration();
+            newScanStart = true;
+            redrawStatus = true;
+            return;
+        }
 #endif
 
-    if (currentState == SPECTRUM)
-    {
-        BK4819_WriteRegister(0x43, GetBWRegValueForScan());
-        Measure();
-        BK4819_WriteRegister(0x43, listenBWRegValues[settings.listenBw]);
-    }
-    else
-    {
+        if (currentState == SPECTRUM)
+        {
+            BK4819_WriteRegister(0x43, GetBWRegValueForScan());
+        }
 #ifndef ENABLE_FEAT_F4HWN_SPECTRUM
-        if (currentState == STILL)
+        else if (currentState == STILL)
         {
             ToggleRX(false);
             ResetScanStats();
@@ -2402,9 +2634,17 @@ static void UpdateListening()
             return;
         }
 #endif
-        Measure();
+
+        StartMeasure();
     }
 
+    if (!MeasureSettled())
+        return;
+
+    Measure();
+    if (currentState == SPECTRUM)
+        BK4819_WriteRegister(0x43, listenBWRegValues[settings.listenBw]);
+
     peak.rssi = scanInfo.rssi;
     rssiSmoothed = rssiSmoothed ? (rssiSmoothed * 3 + scanInfo.rssi) >> 2
                                 : scanInfo.rssi;
@@ -2447,7 +2687,7 @@ static void UpdateListening()
 
     if (keepListening)
     {
-        listenT = 320;
+        listenT = 32;
         return;
     }
 
@@ -2459,51 +2699,29 @@ static void UpdateListening()
     redrawStatus = true;
 }
 
-static void Tick()
+// One step of the analyzer from APP_Update(): at most one glitch read while
+// a measurement settles, so the main loop comes back within a few bus
+// transactions whatever the phase.
+void SPECTRUM_Update(void)
 {
-#ifdef ENABLE_FEAT_F4HWN_K5VIEWER
-    // Parse incoming packets on every tick so serial keys are never missed,
-    // regardless of whether the screen needs redrawing.
-    K5VIEWER_ParseInput();
-#endif
-
-    if (gNextTimeslice)
+    if (!measurePending)
     {
-        gNextTimeslice = false;
-#ifdef ENABLE_AM_FIX
-        if (settings.modulationType == MODULATION_AM && !lockAGC)
+        // Between measurements only, a key may retune or change the state
+        if (keyPollDue)
         {
-            AM_fix_10ms(vfo); // allow AM_Fix to apply its AGC action
+            keyPollDue = false;
+            if (!preventKeypress)
+                HandleUserInput();
+            if (!isInitialized)
+                return;
         }
-#endif
-        BACKLIGHT_Update();
-    }
-
-#ifdef ENABLE_SCAN_RANGES
-    if (gNextTimeslice_500ms)
-    {
-        gNextTimeslice_500ms = false;
-
-        // For large scans (>128 steps), refresh display periodically but
-        // wait for the full sweep to complete before triggering listen mode.
-        // This avoids showing stale rssiHistory data from a previous sweep.
-        if (GetStepsCount() > 128 && !isListening)
+        if (newScanStart)
         {
-            redrawScreen = true;
-            preventKeypress = false;
+            InitScanPosition();
+            newScanStart = false;
         }
     }
-#endif
 
-    if (!preventKeypress)
-    {
-        HandleUserInput();
-    }
-    if (newScanStart)
-    {
-        InitScanPosition();
-        newScanStart = false;
-    }
     if (isListening && currentState != FREQ_INPUT)
     {
         UpdateListening();
@@ -2519,17 +2737,12 @@ static void Tick()
             UpdateStill();
         }
     }
-    if (redrawStatus || ++statuslineUpdateTimer > 4096)
+    if (redrawStatus)
     {
         RenderStatus();
         redrawStatus = false;
-        statuslineUpdateTimer = 0;
     }
-    // Render at a fixed rate (RENDER_PERIOD_TICKS) independent of step count,
-    // so the CPU burst from Render() never falls below the ~9 Hz flutter-fusion
-    // threshold regardless of how many steps the scan uses.  redrawScreen can
-    // still force an immediate repaint (key presses, settings changes, etc.).
-    if (redrawScreen || ++renderTimer >= RENDER_PERIOD_TICKS)
+    if (redrawScreen)
     {
         Render();
         // For K5Viewer
@@ -2537,15 +2750,80 @@ static void Tick()
             K5VIEWER_Update(false);
         #endif
         redrawScreen = false;
-        renderTimer = 0;
     }
+}
 
-    // Send one framebuffer page to the display per tick (~47 Hz full refresh).
+// Send one framebuffer page to the display per slice (~60 Hz full refresh).
+void SPECTRUM_TimeSlice2ms(void)
+{
     ST7565_BlitLine(renderPage);
     if (++renderPage >= FRAME_LINES)
         renderPage = 0;
 }
 
+void SPECTRUM_TimeSlice10ms(void)
+{
+#ifdef ENABLE_AM_FIX
+    if (settings.modulationType == MODULATION_AM && !lockAGC)
+    {
+        AM_fix_10ms(vfo); // allow AM_Fix to apply its AGC action
+    }
+#endif
+
+    if (listenT)
+        listenT--;
+
+    sweepSlices++;
+
+#if SPECTRUM_ADAPTIVE_SWEEP
+    if ((sweepSlices % HEAT_COOL_SLICES) == 0)
+    {
+        for (uint8_t i = 0; i < ARRAY_SIZE(binHeat); i++)
+            binHeat[i] -= binHeat[i] >> 3;
+    }
+#endif
+
+    if (keyPollTimer == 0 || --keyPollTimer == 0)
+    {
+        keyPollTimer = KEY_POLL_SLICES;
+        keyPollDue = true;
+    }
+
+    // Render at a fixed rate independent of step count, so the CPU burst
+    // from Render() never falls below the ~9 Hz flutter-fusion threshold
+    // regardless of how many steps the scan uses.  redrawScreen can still
+    // force an immediate repaint (key presses, settings changes, etc.).
+    if (++renderTimer >= RENDER_PERIOD_SLICES)
+    {
+        redrawScreen = true;
+        renderTimer = 0;
+    }
+    if (++statuslineUpdateTimer >= STATUS_PERIOD_SLICES)
+    {
+        redrawStatus = true;
+        statuslineUpdateTimer = 0;
+    }
+}
+
+void SPECTRUM_TimeSlice500ms(void)
+{
+#ifdef ENABLE_SCAN_RANGES
+    // For large scans (>128 steps), refresh display periodically but
+    // wait for the full sweep to complete before triggering listen mode.
+    // This avoids showing stale rssiHistory data from a previous sweep.
+    if (GetStepsCount() > 128 && !isListening)
+    {
+        redrawScreen = true;
+        preventKeypress = false;
+    }
+#endif
+}
+
+bool SPECTRUM_IsRunning(void)
+{
+    return isInitialized;
+}
+
 void APP_RunSpectrum()
 {
     settings.backlightState = gEeprom.BACKLIGHT_TIME == 0 ? false : true;
@@ -2604,12 +2882,9 @@ void APP_RunSpectrum()
 
     RearmRuntimeState();
 
+    // SPECTRUM_Update() carries on from the main loop until KEY_EXIT
+    measurePending = false;
+    keyPollDue = false;
+    keyPollTimer = KEY_POLL_SLICES;
     isInitialized = true;
-
-    while (isInitialized)
-    {
-        Tick();
-    }
-
-    BACKLIGHT_TurnOn();
 }
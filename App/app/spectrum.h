@@ -186,6 +186,15 @@ typedef struct PeakInfo
 
 void APP_RunSpectrum(void);
 
+// The analyzer runs from the main loop once APP_RunSpectrum() has entered
+// it, until it is left with EXIT or SPECTRUM_Exit() gives the radio back
+bool SPECTRUM_IsRunning(void);
+void SPECTRUM_Exit(void);
+void SPECTRUM_Update(void);
+void SPECTRUM_TimeSlice2ms(void);
+void SPECTRUM_TimeSlice10ms(void);
+void SPECTRUM_TimeSlice500ms(void);
+
 #endif /* ifndef SPECTRUM_H */
 
 // vim: ft=c
@@ -15,6 +15,7 @@
  *     limitations under the License.
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #if !defined(ENABLE_OVERLAY)
@@ -31,6 +32,7 @@
 #include "driver/crc.h"
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
+#include "driver/py25q16.h"
 
 #if defined(ENABLE_UART)
 #include "driver/uart.h"
@@ -120,6 +122,55 @@ typedef struct {
     } Data;
 } REPLY_051D_t;
 
+// Bulk transfers: blocks anywhere in the EEPROM address space, each reply
+// naming its block so that a client can keep several requests in flight
+#define BULK_BLOCK_MAX 128
+
+enum {
+    BULK_OK = 0,
+    BULK_LOCKED,
+    BULK_BAD_SIZE,
+};
+
+typedef struct {
+    Header_t Header;
+    uint16_t Offset;
+    uint16_t Size;
+    uint32_t Timestamp;
+} CMD_0541_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint16_t Offset;
+        uint16_t Size;
+        uint16_t Crc;       // of Data: reply frames carry no valid CRC
+        uint8_t  Status;
+        uint8_t  Padding;
+        uint8_t  Data[BULK_BLOCK_MAX];
+    } Data;
+} REPLY_0541_t;
+
+typedef struct {
+    Header_t Header;
+    uint16_t Offset;
+    uint16_t Size;
+    bool     bAllowPassword;
+    uint8_t  Padding[3];
+    uint32_t Timestamp;
+    uint8_t  Data[0];
+} CMD_0543_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint16_t Offset;
+        uint16_t Size;
+        uint8_t  Status;
+        uint8_t  Padding[3];
+    } Data;
+} REPLY_0543_t;
+
 #ifdef ENABLE_EXTRA_UART_CMD
 typedef struct {
     Header_t Header;
@@ -476,6 +527,127 @@ static void CMD_051D(uint32_t Port, const uint8_t *pBuffer)
     SendReply(Port, &Reply, sizeof(Reply));
 }
 
+static bool IsSession(uint32_t Port, uint32_t Timestamp)
+{
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        return Timestamp == UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        return Timestamp == VCP_Timestamp;
+    }
+#endif
+
+    return false;
+}
+
+// bulk read, up to BULK_BLOCK_MAX bytes (a zero-sized read tells a client
+// that bulk transfers are there)
+static void CMD_0541(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0541_t *pCmd = (const CMD_0541_t *)pBuffer;
+    REPLY_0541_t      Reply;
+    uint16_t          Size = pCmd->Size;
+
+    if (!IsSession(Port, pCmd->Timestamp))
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    #ifdef ENABLE_FMRADIO
+        gFmRadioCountdown_500ms = fm_radio_countdown_500ms;
+    #endif
+
+    Reply.Header.ID     = 0x0542;
+    Reply.Data.Offset   = pCmd->Offset;
+    Reply.Data.Status   = BULK_OK;
+    Reply.Data.Padding  = 0;
+
+    if (Size > BULK_BLOCK_MAX || pCmd->Offset + Size > 0x10000u)
+    {
+        Reply.Data.Status = BULK_BAD_SIZE;
+        Size = 0;
+    }
+    else if (bHasCustomAesKey && gIsLocked)
+    {
+        Reply.Data.Status = BULK_LOCKED;
+        Size = 0;
+    }
+    else
+    {
+        EEPROM_ReadBuffer(pCmd->Offset, Reply.Data.Data, Size);
+    }
+
+    Reply.Header.Size = sizeof(Reply.Data) - BULK_BLOCK_MAX + Size;
+    Reply.Data.Size   = Size;
+    Reply.Data.Crc    = CRC_Calculate(Reply.Data.Data, Size);
+
+    SendReply(Port, &Reply, sizeof(Reply.Header) + Reply.Header.Size);
+}
+
+// bulk write, up to BULK_BLOCK_MAX bytes: the frame CRC covers the block,
+// and the block goes to the Flash cache one mapped area at a time
+static void CMD_0543(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0543_t *pCmd = (const CMD_0543_t *)pBuffer;
+    REPLY_0543_t      Reply;
+    const uint16_t    Begin = pCmd->Offset;
+    const uint32_t    End   = (uint32_t)pCmd->Offset + pCmd->Size;
+
+    if (!IsSession(Port, pCmd->Timestamp))
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    #ifdef ENABLE_FMRADIO
+        gFmRadioCountdown_500ms = fm_radio_countdown_500ms;
+    #endif
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0544;
+    Reply.Header.Size = sizeof(Reply.Data);
+    Reply.Data.Offset = pCmd->Offset;
+    Reply.Data.Size   = pCmd->Size;
+    Reply.Data.Status = BULK_OK;
+
+    if (pCmd->Size > BULK_BLOCK_MAX || End > 0x10000u ||
+        pCmd->Header.Size != offsetof(CMD_0543_t, Data) - sizeof(Header_t) + pCmd->Size)
+    {
+        Reply.Data.Status = BULK_BAD_SIZE;
+    }
+    else if (bHasCustomAesKey && gIsLocked)
+    {
+        Reply.Data.Status = BULK_LOCKED;
+    }
+    else
+    {
+        // Same rules as 0x051D: the lock screen password is kept unless
+        // allowed, the AES key reloads the settings
+        if (bIsInLockScreen && !pCmd->bAllowPassword && Begin < 0x0EA0 && End > 0x0E98)
+        {
+            const uint16_t Head = (Begin < 0x0E98) ? 0x0E98 - Begin : 0;
+            const uint16_t Tail = (End > 0x0EA0) ? End - 0x0EA0 : 0;
+
+            EEPROM_WriteRange(Begin, pCmd->Data, Head);
+            EEPROM_WriteRange(0x0EA0, &pCmd->Data[pCmd->Size - Tail], Tail);
+        }
+        else
+        {
+            EEPROM_WriteRange(Begin, pCmd->Data, pCmd->Size);
+        }
+
+        if (Begin < 0x0F40 && End > 0x0F30 && !gIsLocked)
+            SETTINGS_InitEEPROM();
+    }
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
 #ifdef ENABLE_EXTRA_UART_CMD
 // read RSSI
 static void CMD_0527(uint32_t Port)
@@ -818,6 +990,14 @@ void UART_HandleCommand(uint32_t Port)
             CMD_051D(Port, pUART_Command->Buffer);
             break;
 
+        case 0x0541:
+            CMD_0541(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x0543:
+            CMD_0543(Port, pUART_Command->Buffer);
+            break;
+
         case 0x051F:    // Not implementing non-authentic command
             break;
 
@@ -845,6 +1025,11 @@ void UART_HandleCommand(uint32_t Port)
 #endif
 
         case 0x05DD: // reset
+            PY25Q16_Flush();
+            #if defined(ENABLE_UART)
+                UART_Flush();
+            #endif
+
             #if defined(ENABLE_OVERLAY)
                 overlay_FLASH_RebootToBootloader();
             #else
@@ -51,88 +51,317 @@ static const uint16_t BEEP_Classic_array[][3] = { /* Tone    Duration    Repeats
 
 BEEP_Type_t gBeepToPlay = BEEP_NONE;
 
-void AUDIO_PlayBeep(BEEP_Type_t Beep)
+volatile uint16_t gAudioCountdown_2ms;
+volatile bool     gFlagAudioStep;
+
+// The beeps and voice prompts play one after the other from a small queue.
+// Each step is run from the main loop by AUDIO_Service() once the wait
+// before it has been counted down in the 2 ms SysTick slices, so the main
+// loop goes on in between instead of blocking for the whole beep. SysTick
+// only runs every 2 ms while asked to: a beep starts once it does.
+#define AUDIO_QUEUE 4
+
+#ifdef ENABLE_VOICE
+    #define AUDIO_VOICE 0xFF    // queued: the clips of gVoiceID
+#endif
+
+typedef enum {
+    AUDIO_IDLE = 0,
+
+    // Step run next, after the wait of the step before
+    AUDIO_BEEP_START,           // audio path off, 20 ms
+    AUDIO_BEEP_PREPARE,         // tone 1 set up, 2 ms
+    AUDIO_BEEP_PATH_ON,         // 60 ms
+    AUDIO_BEEP_TONE_ON,         // for the beep duration
+    AUDIO_BEEP_TONE_OFF,        // 20 ms, then the next repeat
+    AUDIO_BEEP_PATH_OFF,        // 5 ms
+    AUDIO_BEEP_RX_ON,           // 5 ms
+    AUDIO_BEEP_RESTORE,         // 10 ms with the FM radio
+    AUDIO_BEEP_END,
+#ifdef ENABLE_VOICE
+    AUDIO_VOICE_START,          // 5 ms
+    AUDIO_VOICE_CLIP,           // for the clip length
+    AUDIO_VOICE_END,
+#endif
+} AUDIO_Step_t;
+
+static uint8_t      gAudioQueue[AUDIO_QUEUE];
+static uint8_t      gAudioQueueHead;
+static uint8_t      gAudioQueueCount;
+
+static AUDIO_Step_t gAudioStep;
+static BEEP_Type_t  gAudioBeep;
+static uint8_t      gAudioRepeat;
+static uint16_t     gAudioToneConfig;      // REG_71 before the beep
+static int8_t       gAudioLag_ms;          // behind the exact waits so far
+static bool         gAudioCutting;
+#ifdef ENABLE_FMRADIO
+    static bool     gAudioFmRadio;
+#endif
+
+// The steps come on the 2 ms slices: each wait is rounded up to whole slices
+// less the time the steps are behind already, so the rounding does not add
+// up over the beep
+static void Wait(uint16_t Ms)
 {
-    if (Beep == BEEP_NONE)
+    if (gAudioCutting)
         return;
 
+    int16_t slices = (Ms - gAudioLag_ms + 1) / 2;
+
+    if (slices < 1)
+        slices = 1;
+
+    gAudioLag_ms       += slices * 2 - Ms;
+    gAudioCountdown_2ms = slices;
+}
+
+static bool BeepAllowed(BEEP_Type_t Beep)
+{
+    if (Beep == BEEP_NONE)
+        return false;
+
     if ((Beep == BEEP_1KHZ_60MS_OPTIONAL ||
          Beep == BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL) &&
          !gEeprom.BEEP_CONTROL)
-        return;
-        
+        return false;
+
     if (gCurrentFunction == FUNCTION_RECEIVE)
-        return;
+        return false;
 
     if (gCurrentFunction == FUNCTION_MONITOR)
-        return;
+        return false;
+
+    return Beep < ARRAY_SIZE(BEEP_Classic_array);
+}
 
-    if (Beep >= ARRAY_SIZE(BEEP_Classic_array))
+static void Queue(uint8_t Entry)
+{
+    if (gAudioQueueCount == AUDIO_QUEUE)
         return;
 
+    gAudioQueue[(gAudioQueueHead + gAudioQueueCount++) % AUDIO_QUEUE] = Entry;
+    gFlagAudioStep = true;
+    gFastTick      = true;
+}
+
+void AUDIO_PlayBeep(BEEP_Type_t Beep)
+{
+    if (BeepAllowed(Beep))
+        Queue(Beep);
+}
+
+static void BeepStep(void)
+{
+    switch (gAudioStep) {
+        case AUDIO_BEEP_START:
 #ifdef ENABLE_FMRADIO
-    if (gFmRadioMode)
-        BK1080_Mute(true);
+            if (gFmRadioMode)
+                BK1080_Mute(true);
 #endif
 
-    AUDIO_AudioPathOff();
+            AUDIO_AudioPathOff();
 
-    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-        BK4819_RX_TurnOn();
+            if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+                BK4819_RX_TurnOn();
 
-    SYSTEM_DelayMs(20);
+#ifdef ENABLE_VOX
+            gVoxResumeCountdown = 2000;
+#endif
+
+            gAudioStep = AUDIO_BEEP_PREPARE;
+            Wait(20);
+            break;
 
-    uint16_t ToneConfig = BK4819_ReadRegister(BK4819_REG_71);
+        case AUDIO_BEEP_PREPARE:
+            gAudioToneConfig = BK4819_ReadRegister(BK4819_REG_71);
 
 #ifdef ENABLE_FEAT_F4HWN
-    if(Beep == BEEP_400HZ_30MS || Beep == BEEP_500HZ_30MS || Beep == BEEP_600HZ_30MS)
-    {
-        BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | ((1 & 0x7f) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
-    }
+            if (gAudioBeep == BEEP_400HZ_30MS || gAudioBeep == BEEP_500HZ_30MS || gAudioBeep == BEEP_600HZ_30MS)
+            {
+                BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | ((1 & 0x7f) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
+            }
 #endif
 
-    BK4819_PrepareToPlayTone(true);
+            BK4819_PrepareToPlayTone(true);
 
-    SYSTEM_DelayMs(2);
+            gAudioStep = AUDIO_BEEP_PATH_ON;
+            Wait(2);
+            break;
 
-    AUDIO_AudioPathOn();
+        case AUDIO_BEEP_PATH_ON:
+            AUDIO_AudioPathOn();
 
-    SYSTEM_DelayMs(60);
+            gAudioRepeat = 0;
+            gAudioStep   = BEEP_Classic_array[gAudioBeep][BEEP_REPEATS] ? AUDIO_BEEP_TONE_ON : AUDIO_BEEP_PATH_OFF;
+            Wait(60);
+            break;
 
-    for (uint8_t i = 0; i < BEEP_Classic_array[Beep][BEEP_REPEATS]; i++) {
-        BK4819_PlayToneRaw( BEEP_Classic_array[Beep][BEEP_TONE], 
-                            BEEP_Classic_array[Beep][BEEP_DURATION]);
-        SYSTEM_DelayMs(20);
-    }
+        case AUDIO_BEEP_TONE_ON:
+            BK4819_StartToneRaw(BEEP_Classic_array[gAudioBeep][BEEP_TONE]);
+
+            gAudioStep = AUDIO_BEEP_TONE_OFF;
+            Wait(BEEP_Classic_array[gAudioBeep][BEEP_DURATION]);
+            break;
+
+        case AUDIO_BEEP_TONE_OFF:
+            BK4819_EnterTxMute();
+
+            gAudioStep = ++gAudioRepeat < BEEP_Classic_array[gAudioBeep][BEEP_REPEATS] ? AUDIO_BEEP_TONE_ON : AUDIO_BEEP_PATH_OFF;
+            Wait(20);
+            break;
+
+        case AUDIO_BEEP_PATH_OFF:
+            AUDIO_AudioPathOff();
 
-    AUDIO_AudioPathOff();
+            gAudioStep = AUDIO_BEEP_RX_ON;
+            Wait(5);
+            break;
 
-    SYSTEM_DelayMs(5);
-    BK4819_TurnsOffTones_TurnsOnRX();
-    SYSTEM_DelayMs(5);
-    BK4819_WriteRegister(BK4819_REG_71, ToneConfig);
+        case AUDIO_BEEP_RX_ON:
+            BK4819_TurnsOffTones_TurnsOnRX();
+
+            gAudioStep = AUDIO_BEEP_RESTORE;
+            Wait(5);
+            break;
+
+        case AUDIO_BEEP_RESTORE:
+            BK4819_WriteRegister(BK4819_REG_71, gAudioToneConfig);
+
+            gAudioStep = AUDIO_BEEP_END;
 
 #ifdef ENABLE_FMRADIO
-    const bool isFmRadio = gFmRadioMode;
-    
-    if (isFmRadio)
-        SYSTEM_DelayMs(10);
+            gAudioFmRadio = gFmRadioMode;
+            if (gAudioFmRadio)
+                Wait(10);
 #endif
+            break;
 
-    if (gEnableSpeaker)
-        AUDIO_AudioPathOn();
+        case AUDIO_BEEP_END:
+            if (gEnableSpeaker)
+                AUDIO_AudioPathOn();
 
 #ifdef ENABLE_FMRADIO
-    if (isFmRadio)
-        BK1080_Mute(false);
+            if (gAudioFmRadio)
+                BK1080_Mute(false);
 #endif
 
-    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-        BK4819_Sleep();
+            if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+                BK4819_Sleep();
 
 #ifdef ENABLE_VOX
-    gVoxResumeCountdown = 80;
+            gVoxResumeCountdown = 80;
+#endif
+
+            gAudioStep = AUDIO_IDLE;
+            break;
+
+        default:
+            break;
+    }
+}
+
+#ifdef ENABLE_VOICE
+    static void VoiceStep(void);
+#endif
+
+static void RunStep(void)
+{
+#ifdef ENABLE_VOICE
+    if (gAudioStep >= AUDIO_VOICE_START) {
+        VoiceStep();
+        return;
+    }
+#endif
+
+    BeepStep();
+}
+
+void AUDIO_Service(void)
+{
+    gFlagAudioStep = false;
+
+    while (gAudioCountdown_2ms == 0) {
+        if (gAudioStep == AUDIO_IDLE) {
+            if (gAudioQueueCount == 0 || !gFastTickRunning)
+                return;
+
+            const uint8_t entry = gAudioQueue[gAudioQueueHead];
+
+            gAudioQueueHead = (gAudioQueueHead + 1) % AUDIO_QUEUE;
+            gAudioQueueCount--;
+
+            // The first step comes anywhere in a slice: its wait counts
+            // one slice more
+            gAudioLag_ms = -2;
+
+#ifdef ENABLE_VOICE
+            if (entry == AUDIO_VOICE) {
+                gAudioStep = AUDIO_VOICE_START;
+                continue;
+            }
+#endif
+
+            gAudioBeep = (BEEP_Type_t)entry;
+            gAudioStep = AUDIO_BEEP_START;
+        }
+
+        RunStep();
+    }
+}
+
+void AUDIO_StopBeep(void)
+{
+    gAudioQueueCount = 0;
+
+    switch (gAudioStep) {
+        case AUDIO_BEEP_START:
+#ifdef ENABLE_VOICE
+        case AUDIO_VOICE_START:
+#endif
+            gAudioStep = AUDIO_IDLE;
+            break;
+
+        case AUDIO_BEEP_PREPARE:
+            gAudioStep = AUDIO_BEEP_END;
+            break;
+
+        case AUDIO_BEEP_PATH_ON:
+        case AUDIO_BEEP_TONE_ON:
+        case AUDIO_BEEP_TONE_OFF:
+            gAudioStep = AUDIO_BEEP_PATH_OFF;
+            break;
+
+#ifdef ENABLE_VOICE
+        case AUDIO_VOICE_CLIP:
+            gVoiceReadIndex = gVoiceWriteIndex;
+            break;
 #endif
+
+        default:
+            break;
+    }
+
+    // The rest of the steps at once
+    gAudioCutting = true;
+    while (gAudioStep != AUDIO_IDLE)
+        RunStep();
+    gAudioCutting = false;
+
+    gAudioCountdown_2ms = 0;
+}
+
+bool AUDIO_IsPlaying(void)
+{
+    return gAudioStep != AUDIO_IDLE || gAudioQueueCount > 0;
+}
+
+void AUDIO_Wait(void)
+{
+    while (AUDIO_IsPlaying()) {
+        AUDIO_Service();
+        SYSTEM_DelayMs(1);
+    }
 }
 
 #ifdef ENABLE_VOICE
@@ -145,8 +374,6 @@ uint8_t gVoiceBufLen = 0;
 VOICE_ID_t        gVoiceID[8];
 uint8_t           gVoiceReadIndex;
 uint8_t           gVoiceWriteIndex;
-volatile uint16_t gCountdownToPlayNextVoice_10ms;
-volatile bool     gFlagPlayQueuedVoice;
 VOICE_ID_t        gAnotherVoiceID = VOICE_ID_INVALID;
 
 static const uint16_t VOICE_SAMPLES[256] = 
@@ -246,58 +473,83 @@ static void LoadVoiceSamples()
     gVoiceBufLen++;
 }
 
-void AUDIO_PlaySingleVoice(bool bFlag)
+// Length of the clip in 10 ms, the voice ID in the prompt language to
+// *pVoiceID, false if there is no such clip
+static bool VoiceClip(uint8_t *pVoiceID, uint8_t *pDelay)
 {
-    uint8_t VoiceID;
-    uint8_t Delay;
+    if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_CHINESE)
+    {
+        if (*pVoiceID >= ARRAY_SIZE(VoiceClipLengthChinese))
+            return false;
+
+        *pDelay    = VoiceClipLengthChinese[*pVoiceID];
+        *pVoiceID += VOICE_ID_CHI_BASE;
+    }
+    else
+    {
+        if (*pVoiceID >= ARRAY_SIZE(VoiceClipLengthEnglish))
+            return false;
+
+        *pDelay    = VoiceClipLengthEnglish[*pVoiceID];
+        *pVoiceID += VOICE_ID_ENG_BASE;
+    }
 
-    VoiceID = gVoiceID[0];
+    return true;
+}
 
-    if (gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF && gVoiceWriteIndex > 0)
+static void VoiceStep(void)
+{
+    switch (gAudioStep)
     {
-        if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_CHINESE)
-        {   // Chinese
-            if (VoiceID >= ARRAY_SIZE(VoiceClipLengthChinese))
-                goto Bailout;
+        case AUDIO_VOICE_START:
+            if (FUNCTION_IsRx())   // 1of11
+                BK4819_SetAF(BK4819_AF_MUTE);
 
-            Delay    = VoiceClipLengthChinese[VoiceID];
-            VoiceID += VOICE_ID_CHI_BASE;
-        }
-        else
-        {   // English
-            if (VoiceID >= ARRAY_SIZE(VoiceClipLengthEnglish))
-                goto Bailout;
+            #ifdef ENABLE_FMRADIO
+                if (gFmRadioMode)
+                    BK1080_Mute(true);
+            #endif
 
-            Delay    = VoiceClipLengthEnglish[VoiceID];
-            VoiceID += VOICE_ID_ENG_BASE;
-        }
+            AUDIO_AudioPathOn();
 
-        if (FUNCTION_IsRx())   // 1of11
-            BK4819_SetAF(BK4819_AF_MUTE);
+            #ifdef ENABLE_VOX
+                gVoxResumeCountdown = 2000;
+            #endif
 
-        #ifdef ENABLE_FMRADIO
-            if (gFmRadioMode)
-                BK1080_Mute(true);
-        #endif
+            gAudioStep = AUDIO_VOICE_CLIP;
+            Wait(5);
+            break;
+
+        case AUDIO_VOICE_CLIP:
+            while (gVoiceReadIndex != gVoiceWriteIndex && gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF)
+            {
+                uint8_t VoiceID = gVoiceID[gVoiceReadIndex++];
+                uint8_t Delay;
 
-        AUDIO_AudioPathOn();
+                if (!VoiceClip(&VoiceID, &Delay))
+                    continue;
 
-        #ifdef ENABLE_VOX
-            gVoxResumeCountdown = 2000;
-        #endif
+                if (gVoiceReadIndex == gVoiceWriteIndex)
+                    Delay += 3;
 
-        SYSTEM_DelayMs(5);
-        AUDIO_PlayVoice(VoiceID);
+                AUDIO_PlayVoice(VoiceID);
 
-        if (gVoiceWriteIndex == 1)
-            Delay += 3;
+                #ifdef ENABLE_VOX
+                    gVoxResumeCountdown = 2000;
+                #endif
 
-        if (bFlag)
-        {
-            SYSTEM_DelayMs(Delay * 10);
+                Wait(Delay * 10);
+                return;
+            }
 
-            if (FUNCTION_IsRx())    // 1of11
-                RADIO_SetModulation(gRxVfo->Modulation);
+            gAudioStep = AUDIO_VOICE_END;
+            break;
+
+        case AUDIO_VOICE_END:
+            if (FUNCTION_IsRx())
+            {
+                RADIO_SetModulation(gRxVfo->Modulation); // 1of11
+            }
 
             #ifdef ENABLE_FMRADIO
                 if (gFmRadioMode)
@@ -307,26 +559,50 @@ void AUDIO_PlaySingleVoice(bool bFlag)
             if (!gEnableSpeaker)
                 AUDIO_AudioPathOff();
 
-            gVoiceWriteIndex    = 0;
-            gVoiceReadIndex     = 0;
-
             #ifdef ENABLE_VOX
                 gVoxResumeCountdown = 80;
             #endif
 
-            return;
-        }
+            gVoiceWriteIndex = 0;
+            gVoiceReadIndex  = 0;
 
-        gVoiceReadIndex                = 1;
-        gCountdownToPlayNextVoice_10ms = Delay;
-        gFlagPlayQueuedVoice           = false;
+            gAudioStep = AUDIO_IDLE;
+            break;
 
+        default:
+            break;
+    }
+}
+
+// Queues the clips of gVoiceID behind the beeps and prompts playing, and with
+// bFlag only the first one, waiting for it to finish
+void AUDIO_PlaySingleVoice(bool bFlag)
+{
+    uint8_t VoiceID = gVoiceID[0];
+    uint8_t Delay;
+
+    if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_OFF || gVoiceWriteIndex == 0 || !VoiceClip(&VoiceID, &Delay))
+    {
+        gVoiceReadIndex  = 0;
+        gVoiceWriteIndex = 0;
         return;
     }
 
-Bailout:
-    gVoiceReadIndex  = 0;
-    gVoiceWriteIndex = 0;
+    if (bFlag)
+        gVoiceWriteIndex = 1;
+
+    // A prompt already playing goes on with these clips
+    bool queued = gAudioStep >= AUDIO_VOICE_START;
+
+    for (uint8_t i = 0; i < gAudioQueueCount; i++)
+        queued |= gAudioQueue[(gAudioQueueHead + i) % AUDIO_QUEUE] == AUDIO_VOICE;
+
+    gVoiceReadIndex = 0;
+    if (!queued)
+        Queue(AUDIO_VOICE);
+
+    if (bFlag)
+        AUDIO_Wait();
 }
 
 void AUDIO_SetVoiceID(uint8_t Index, VOICE_ID_t VoiceID)
@@ -383,77 +659,4 @@ Skip:
     return Count + 1U;
 }
 
-void AUDIO_PlayQueuedVoice(void)
-{
-    uint8_t VoiceID;
-    uint8_t Delay;
-    bool    Skip;
-
-    Skip = false;
-
-    if (gVoiceReadIndex != gVoiceWriteIndex && gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF)
-    {
-        VoiceID = gVoiceID[gVoiceReadIndex];
-        if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_CHINESE)
-        {
-            if (VoiceID < ARRAY_SIZE(VoiceClipLengthChinese))
-            {
-                Delay = VoiceClipLengthChinese[VoiceID];
-                VoiceID += VOICE_ID_CHI_BASE;
-            }
-            else
-                Skip = true;
-        }
-        else
-        {
-            if (VoiceID < ARRAY_SIZE(VoiceClipLengthEnglish))
-            {
-                Delay = VoiceClipLengthEnglish[VoiceID];
-                VoiceID += VOICE_ID_ENG_BASE;
-            }
-            else
-                Skip = true;
-        }
-
-        gVoiceReadIndex++;
-
-        if (!Skip)
-        {
-            if (gVoiceReadIndex == gVoiceWriteIndex)
-                Delay += 3;
-
-            AUDIO_PlayVoice(VoiceID);
-
-            gCountdownToPlayNextVoice_10ms = Delay;
-            gFlagPlayQueuedVoice           = false;
-
-            #ifdef ENABLE_VOX
-                gVoxResumeCountdown = 2000;
-            #endif
-
-            return;
-        }
-    }
-
-    if (FUNCTION_IsRx())
-    {
-        RADIO_SetModulation(gRxVfo->Modulation); // 1of11
-    }
-
-    #ifdef ENABLE_FMRADIO
-        if (gFmRadioMode)
-            BK1080_Mute(false);
-    #endif
-
-    if (!gEnableSpeaker)
-        AUDIO_AudioPathOff();
-
-    #ifdef ENABLE_VOX
-        gVoxResumeCountdown = 80;
-    #endif
-
-    gVoiceWriteIndex    = 0;
-    gVoiceReadIndex     = 0;
-}
-
 #endif
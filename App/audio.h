@@ -50,7 +50,22 @@ typedef enum BEEP_Type_t BEEP_Type_t;
 
 extern BEEP_Type_t       gBeepToPlay;
 
+// Wait before the next step of the beep or voice prompt playing, counted
+// down in the 2 ms SysTick slices
+extern volatile uint16_t gAudioCountdown_2ms;
+extern volatile bool     gFlagAudioStep;
+
+// Queues the beep behind the ones playing and returns, the steps run from
+// AUDIO_Service()
 void AUDIO_PlayBeep(BEEP_Type_t Beep);
+// From the main loop: the steps whose wait is over
+void AUDIO_Service(void);
+// Cuts the beep or voice prompt playing short, tones off and receiver back
+// on, and drops the queued ones
+void AUDIO_StopBeep(void);
+bool AUDIO_IsPlaying(void);
+// Until the beeps and voice prompts queued have played
+void AUDIO_Wait(void);
 
 #define AUDIO_AudioPathOn() GPIO_EnableAudioPath()
 
@@ -150,14 +165,11 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep);
     extern VOICE_ID_t        gVoiceID[8];
     extern uint8_t           gVoiceReadIndex;
     extern uint8_t           gVoiceWriteIndex;
-    extern volatile uint16_t gCountdownToPlayNextVoice_10ms;
-    extern volatile bool     gFlagPlayQueuedVoice;
     extern VOICE_ID_t        gAnotherVoiceID;
     
     void    AUDIO_PlaySingleVoice(bool bFlag);
     void    AUDIO_SetVoiceID(uint8_t Index, VOICE_ID_t VoiceID);
     uint8_t AUDIO_SetDigitVoice(uint8_t Index, uint16_t Value);
-    void    AUDIO_PlayQueuedVoice(void);
 #endif
 
 #endif
@@ -56,17 +56,41 @@ static const uint8_t DCS_ExtraIdx[21] = {
     83
 };
 
+// Golay (23,12) check bits of the 12 data bits, 6 at a time: the code is
+// linear, so the halves XOR together. 256 bytes of Flash.
+static const uint16_t DCS_GolayLow[64] = {
+    0x000, 0x475, 0x49F, 0x0EA, 0x54B, 0x13E, 0x1D4, 0x5A1,
+    0x6E3, 0x296, 0x27C, 0x609, 0x3A8, 0x7DD, 0x737, 0x342,
+    0x1B3, 0x5C6, 0x52C, 0x159, 0x4F8, 0x08D, 0x067, 0x412,
+    0x750, 0x325, 0x3CF, 0x7BA, 0x21B, 0x66E, 0x684, 0x2F1,
+    0x366, 0x713, 0x7F9, 0x38C, 0x62D, 0x258, 0x2B2, 0x6C7,
+    0x585, 0x1F0, 0x11A, 0x56F, 0x0CE, 0x4BB, 0x451, 0x024,
+    0x2D5, 0x6A0, 0x64A, 0x23F, 0x79E, 0x3EB, 0x301, 0x774,
+    0x436, 0x043, 0x0A9, 0x4DC, 0x17D, 0x508, 0x5E2, 0x197,
+};
+
+static const uint16_t DCS_GolayHigh[64] = {
+    0x000, 0x6CC, 0x1ED, 0x721, 0x3DA, 0x516, 0x237, 0x4FB,
+    0x7B4, 0x178, 0x659, 0x095, 0x46E, 0x2A2, 0x583, 0x34F,
+    0x31D, 0x5D1, 0x2F0, 0x43C, 0x0C7, 0x60B, 0x12A, 0x7E6,
+    0x4A9, 0x265, 0x544, 0x388, 0x773, 0x1BF, 0x69E, 0x052,
+    0x63A, 0x0F6, 0x7D7, 0x11B, 0x5E0, 0x32C, 0x40D, 0x2C1,
+    0x18E, 0x742, 0x063, 0x6AF, 0x254, 0x498, 0x3B9, 0x575,
+    0x527, 0x3EB, 0x4CA, 0x206, 0x6FD, 0x031, 0x710, 0x1DC,
+    0x293, 0x45F, 0x37E, 0x5B2, 0x149, 0x785, 0x0A4, 0x668,
+};
+
+// The low 9 bits of DCS_Options, one bit each. 64 bytes of Flash.
+static const uint32_t DCS_OptionMap[16] = {
+    0x46680000, 0x1E201A88, 0x16247000, 0x14246428,
+    0x00680420, 0x126A2678, 0x06202240, 0x02304248,
+    0x06080E00, 0x00743460, 0x04484048, 0x00200040,
+    0x06900440, 0x00141000, 0x16080408, 0x00001008,
+};
+
 static uint32_t DCS_CalculateGolay(uint32_t CodeWord)
 {
-    unsigned int i;
-    uint32_t Word = CodeWord;
-    for (i = 0; i < 12; i++)
-    {
-        Word <<= 1;
-        if (Word & 0x1000)
-            Word ^= 0x08EA;
-    }
-    return CodeWord | ((Word & 0x0FFE) << 11);
+    return CodeWord | ((uint32_t)(DCS_GolayLow[CodeWord & 0x3F] ^ DCS_GolayHigh[(CodeWord >> 6) & 0x3F]) << 12);
 }
 
 uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
@@ -77,26 +101,47 @@ uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
     return Code;
 }
 
+static uint8_t DCS_FindOption(uint16_t Code)
+{
+    unsigned int Low  = 0;
+    unsigned int High = ARRAY_SIZE(DCS_Options);
+
+    while (Low < High)
+    {
+        const unsigned int Mid = (Low + High) / 2;
+        if (DCS_Options[Mid] < Code)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+
+    return Low;
+}
+
 uint8_t DCS_GetCdcssCode(uint32_t Code)
 {
-    unsigned int i;
-    for (i = 0; i < 23; i++)
+    unsigned int i = 0;
+
+    // Bits over the 23 of the word sink into it one rotation at a time
+    while (Code > 0x7FFFFFU && i < 23)
     {
-        uint32_t Shift;
-
-        if (((Code >> 9) & 0x7U) == 4)
-        {
-            unsigned int j;
-            for (j = 0; j < ARRAY_SIZE(DCS_Options); j++)
-                if (DCS_Options[j] == (Code & 0x1FF))
-                    if (DCS_GetGolayCodeWord(2, j) == Code)
-                        return j;
-        }
+        Code = (Code >> 1) | ((Code & 1U) << 22);
+        i++;
+    }
+
+    // The code is cyclic: no rotation of a word outside it is a codeword
+    if (DCS_CalculateGolay(Code & 0xFFFU) != Code)
+        return 0xFF;
+
+    // Every rotation is a codeword, one of an option when its data bits are
+    for (; i < 23; i++)
+    {
+        const uint32_t Option = Code & 0x1FFU;
 
-        Shift = Code >> 1;
-        if (Code & 1U)
-            Shift |= 0x400000U;
-        Code = Shift;
+        if (((Code >> 9) & 0x7U) == 4 && (DCS_OptionMap[Option >> 5] & (1U << (Option & 31))))
+            return DCS_FindOption(Option);
+
+        Code = (Code >> 1) | ((Code & 1U) << 22);
     }
 
     return 0xFF;
@@ -104,21 +149,29 @@ uint8_t DCS_GetCdcssCode(uint32_t Code)
 
 uint8_t DCS_GetCtcssCode(int Code)
 {
-    unsigned int i;
-    uint8_t      Result = 0xFF;
-    int          Smallest = ARRAY_SIZE(CTCSS_Options);
+    unsigned int Low  = 0;
+    unsigned int High = ARRAY_SIZE(CTCSS_Options);
 
-    for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++)
+    // First tone not under the code, then the nearer of it and the one before
+    while (Low < High)
     {
-        int Delta = Code - CTCSS_Options[i];
-        if (Delta < 0)
-            Delta = -(Code - CTCSS_Options[i]);
-        if (Smallest > Delta)
-        {
-            Smallest = Delta;
-            Result   = i;
-        }
+        const unsigned int Mid = (Low + High) / 2;
+        if (CTCSS_Options[Mid] < Code)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+
+    uint8_t Result   = 0xFF;
+    int     Smallest = ARRAY_SIZE(CTCSS_Options);
+
+    if (Low > 0 && Code - CTCSS_Options[Low - 1] < Smallest)
+    {
+        Smallest = Code - CTCSS_Options[Low - 1];
+        Result   = Low - 1;
     }
+    if (Low < ARRAY_SIZE(CTCSS_Options) && CTCSS_Options[Low] - Code < Smallest)
+        Result = Low;
 
     return Result;
 }
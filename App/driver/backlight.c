@@ -44,8 +44,14 @@
 
 static uint32_t dutyCycle[DUTY_CYCLE_LEVELS];
 
-// this is decremented once every 500ms
-uint16_t gBacklightCountdown_500ms = 0;
+static void BacklightExpired(void)
+{
+    gBacklightExpired = true;
+}
+
+// Counts while TIMER_GATE_BACKLIGHT is open, see APP_TimeSlice500ms()
+TIMER_t gBacklightTimer = TIMER_INIT(BacklightExpired, TIMER_GATE_BACKLIGHT);
+volatile bool gBacklightExpired;
 bool gUpdateBacklight = false;
 bool backlightOn;
 
@@ -174,12 +180,14 @@ void BACKLIGHT_TurnOn(void)
     switch (gEeprom.BACKLIGHT_TIME) {
         default:
         case 1 ... 60:  // 5 sec * value
-            gBacklightCountdown_500ms = 1 + (gEeprom.BACKLIGHT_TIME * 5) * 2;
+            TIMER_Start(&gBacklightTimer, gEeprom.BACKLIGHT_TIME * 500);
             break;
         case 61:    // always on
-            gBacklightCountdown_500ms = 0;
+            TIMER_Stop(&gBacklightTimer);
             break;
     }
+
+    gBacklightExpired = false;
 }
 
 void BACKLIGHT_TurnOff()
@@ -196,7 +204,8 @@ void BACKLIGHT_TurnOff()
 #else
     BACKLIGHT_SetBrightness(gEeprom.BACKLIGHT_MIN);
 #endif
-    gBacklightCountdown_500ms = 0;
+    TIMER_Stop(&gBacklightTimer);
+    gBacklightExpired = false;
     backlightOn = false;
 }
 
@@ -20,7 +20,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-extern uint16_t gBacklightCountdown_500ms;
+#include "timer.h"
+
+extern TIMER_t gBacklightTimer;         // sets gBacklightExpired
+extern volatile bool gBacklightExpired;
 extern uint8_t gBacklightBrightness;
 
 #ifdef ENABLE_FEAT_F4HWN
@@ -69,6 +69,22 @@ extern bool gRxIdleMode;
 void     BK4819_Init(void);
 uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register);
 void     BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data);
+
+// Writes between BeginUpdate() and EndUpdate() only update the register
+// shadow; EndUpdate() sends the registers left changed, in register order.
+// Writes that must keep their place (block enables, GPIOs, interrupt mask,
+// reset, FIFOs) send the pending ones first.
+void     BK4819_BeginUpdate(void);
+void     BK4819_EndUpdate(void);
+
+// The register no longer holds what was last written or read: the next
+// write goes to the chip whatever its value
+void     BK4819_InvalidateRegister(BK4819_REGISTER_t Register);
+void     BK4819_InvalidateRegisters(void);
+
+// Counts the writes that changed a register (interrupt clears aside) and the
+// invalidations: the same count twice means the chip was left as it was
+uint32_t BK4819_GetChangeCount(void);
 void     BK4819_SetRegValue(RegisterSpec s, uint16_t v);
 void     BK4819_WriteU8(uint8_t Data);
 void     BK4819_WriteU16(uint16_t Data);
@@ -108,6 +124,8 @@ void     BK4819_DisableDTMF(void);
 void     BK4819_EnableDTMF(void);
 void     BK4819_PrepareToPlayTone(bool bTuningGainSwitch);
 void     BK4819_PlayTone(uint16_t Frequency, bool bTuningGainSwitch);
+// Tone 1 on until BK4819_EnterTxMute(), after BK4819_PrepareToPlayTone()
+void     BK4819_StartToneRaw(const unsigned int tone_Hz);
 void     BK4819_PlayToneRaw(const unsigned int tone_Hz, const unsigned int delay);
 void     BK4819_PlaySingleTone(const unsigned int tone_Hz, const unsigned int delay, const unsigned int level, const bool play_speaker);
 void     BK4819_EnterTxMute(void);
@@ -116,6 +134,9 @@ void     BK4819_Sleep(void);
 void     BK4819_TurnsOffTones_TurnsOnRX(void);
 #ifdef ENABLE_AIRCOPY
     void     BK4819_SetupAircopy(void);
+    void     BK4819_SetFSKFrameLength(uint16_t Bytes);
+    void     BK4819_StartFSKFrame(const uint16_t *pData, unsigned int Words);
+    void     BK4819_RestartFSKReceive(void);
 #endif
 void     BK4819_ResetFSK(void);
 void     BK4819_Idle(void);
@@ -106,6 +106,9 @@ void BK4819_Init(void)
     BK4819_WriteRegister(BK4819_REG_00, 0x8000);
     BK4819_WriteRegister(BK4819_REG_00, 0x0000);
 
+    // The reset put every register back to its default
+    BK4819_InvalidateRegisters();
+
     BK4819_WriteRegister(BK4819_REG_37, 0x9D1F);
     BK4819_WriteRegister(BK4819_REG_36, 0x0022);
 
@@ -223,12 +226,81 @@ static uint16_t BK4819_ReadU16(void)
     return Value;
 }
 
-static uint16_t reg_30_cache = 0xFFFF;
-static uint16_t reg_47_cache = 0xFFFF;
+// Shadow of the registers, so that writing the value a register already
+// holds costs nothing. A few registers are never elided: the ones whose
+// writes act (reset, interrupt clear, FSK FIFO and control, frequency scan)
+// and the ones whose upper bits select which internal word the write goes
+// to (REG_07, REG_08, REG_09).
+static const uint32_t ShadowVolatile[4] = {
+    (1u << BK4819_REG_00) | (1u << BK4819_REG_02) | (1u << BK4819_REG_07) | (1u << BK4819_REG_08) | (1u << BK4819_REG_09),
+    (1u << (BK4819_REG_32 - 32)),
+    (1u << (BK4819_REG_59 - 64)) | (1u << (BK4819_REG_5F - 64)),
+    0,
+};
+
+// Written in place inside an update too, after the registers pending before
+// them: they switch blocks on and off (REG_30, REG_37), drive the GPIOs
+// (REG_33) or unmask interrupts (REG_3F)
+static const uint32_t ShadowOrdered[4] = {
+    0,
+    (1u << (BK4819_REG_30 - 32)) | (1u << (BK4819_REG_33 - 32)) | (1u << (BK4819_REG_37 - 32)) | (1u << (BK4819_REG_3F - 32)),
+    0,
+    0,
+};
+
+static uint16_t ShadowValue[128];
+static uint32_t ShadowValid[4];
+static uint32_t ShadowDirty[4];
+static uint8_t  UpdateDepth;
+
+// Writes that changed a register, or may have, apart from interrupt clears
+static uint32_t ChangeCount;
+
+static void BK4819_BusWrite(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    CS_Release();
+    SCL_Reset();
+    SHORT_DELAY();
+
+    CS_Assert();
+    BK4819_WriteU8(Register);
+    SHORT_DELAY();
+
+    BK4819_WriteU16(Data);
+    SHORT_DELAY();
+
+    CS_Release();
+    SHORT_DELAY();
+
+    SCL_Set();
+    SDA_Set();
+}
+
+// Pending registers go out in register order
+static void BK4819_FlushUpdate(void)
+{
+    for (unsigned int Word = 0; Word < ARRAY_SIZE(ShadowDirty); Word++)
+    {
+        while (ShadowDirty[Word])
+        {
+            const unsigned int Bit = __builtin_ctz(ShadowDirty[Word]);
+            const unsigned int Register = Word * 32 + Bit;
+
+            ShadowDirty[Word] &= ~(1u << Bit);
+            BK4819_BusWrite(Register, ShadowValue[Register]);
+        }
+    }
+}
 
 uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
 {
-    uint16_t Value;
+    const unsigned int Word = (Register >> 5) & 3;
+    const uint32_t     Bit  = 1u << (Register & 31);
+    uint16_t           Value;
+
+    // Not written yet: the chip still has the old value
+    if (ShadowDirty[Word] & Bit)
+        return ShadowValue[Register];
 
     CS_Release();
     SCL_Reset();
@@ -243,45 +315,77 @@ uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
     SCL_Set();
     SDA_Set();
 
-    if (Register == BK4819_REG_30)
-        reg_30_cache = Value;
-    else if (Register == BK4819_REG_47)
-        reg_47_cache = Value;
+    if (!(ShadowVolatile[Word] & Bit))
+    {
+        ShadowValue[Register] = Value;
+        ShadowValid[Word] |= Bit;
+    }
 
     return Value;
 }
 
 void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
 {
-    if (Register == BK4819_REG_30)
+    const unsigned int Word = (Register >> 5) & 3;
+    const uint32_t     Bit  = 1u << (Register & 31);
+
+    if (ShadowVolatile[Word] & Bit)
     {
-        if (Data == reg_30_cache)
-            return;
-        reg_30_cache = Data;
+        if (Register != BK4819_REG_02)
+            ChangeCount++;
+
+        BK4819_FlushUpdate();
+        BK4819_BusWrite(Register, Data);
+        return;
     }
-    else if (Register == BK4819_REG_47)
+
+    if ((ShadowValid[Word] & Bit) && ShadowValue[Register] == Data)
+        return;
+
+    ShadowValue[Register] = Data;
+    ShadowValid[Word] |= Bit;
+    ChangeCount++;
+
+    if (UpdateDepth && !(ShadowOrdered[Word] & Bit))
     {
-        if (Data == reg_47_cache)
-            return;
-        reg_47_cache = Data;
+        ShadowDirty[Word] |= Bit;
+        return;
     }
 
-    CS_Release();
-    SCL_Reset();
-    SHORT_DELAY();
+    BK4819_FlushUpdate();
+    BK4819_BusWrite(Register, Data);
+}
 
-    CS_Assert();
-    BK4819_WriteU8(Register);
-    SHORT_DELAY();
+void BK4819_BeginUpdate(void)
+{
+    UpdateDepth++;
+}
 
-    BK4819_WriteU16(Data);
-    SHORT_DELAY();
+void BK4819_EndUpdate(void)
+{
+    if (UpdateDepth && --UpdateDepth == 0)
+        BK4819_FlushUpdate();
+}
 
-    CS_Release();
-    SHORT_DELAY();
+void BK4819_InvalidateRegister(BK4819_REGISTER_t Register)
+{
+    ShadowValid[(Register >> 5) & 3] &= ~(1u << (Register & 31));
+    ChangeCount++;
+}
 
-    SCL_Set();
-    SDA_Set();
+void BK4819_InvalidateRegisters(void)
+{
+    BK4819_FlushUpdate();
+
+    for (unsigned int Word = 0; Word < ARRAY_SIZE(ShadowValid); Word++)
+        ShadowValid[Word] = 0;
+
+    ChangeCount++;
+}
+
+uint32_t BK4819_GetChangeCount(void)
+{
+    return ChangeCount;
 }
 
 void BK4819_WriteU8(uint8_t Data)
@@ -1060,10 +1164,14 @@ void BK4819_PlayTone(uint16_t Frequency, bool bTuningGainSwitch)
     BK4819_WriteRegister(BK4819_REG_71, scale_freq(Frequency));
 }
 
-void BK4819_PlayToneRaw(const unsigned int tone_Hz, const unsigned int delay) {
+void BK4819_StartToneRaw(const unsigned int tone_Hz) {
     BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone_Hz));
 
     BK4819_ExitTxMute();
+}
+
+void BK4819_PlayToneRaw(const unsigned int tone_Hz, const unsigned int delay) {
+    BK4819_StartToneRaw(tone_Hz);
     SYSTEM_DelayMs(delay);
     BK4819_EnterTxMute();
 }
@@ -1144,6 +1252,32 @@ void BK4819_TurnsOffTones_TurnsOnRX(void)
         BK4819_WriteRegister(BK4819_REG_5D, 0x4700);    // FSK Data Length 72 Bytes (0xabcd + 2 byte length + 64 byte payload + 2 byte CRC + 0xdcba)
         BK4819_WriteRegister(0x5E, 0x3204);
     }
+
+    void BK4819_SetFSKFrameLength(uint16_t Bytes)
+    {
+        BK4819_WriteRegister(BK4819_REG_5D, (uint16_t)((Bytes - 1) << 8));
+    }
+
+    // Send without waiting: TX finished is raised once the FIFO has drained,
+    // for the caller to take from REG_02. The transmitter must be keyed.
+    void BK4819_StartFSKFrame(const uint16_t *pData, unsigned int Words)
+    {
+        BK4819_WriteRegister(BK4819_REG_3F, BK4819_REG_3F_FSK_TX_FINISHED);
+        BK4819_WriteRegister(BK4819_REG_59, 0x8068);    // Clear TX FIFO
+        BK4819_WriteRegister(BK4819_REG_59, 0x0068);
+
+        for (unsigned int i = 0; i < Words; i++)
+            BK4819_WriteRegister(BK4819_REG_5F, pData[i]);
+
+        BK4819_WriteRegister(BK4819_REG_59, 0x2868);    // Enable FSK TX
+    }
+
+    // Next frame, once one has been read out: the receiver is still on
+    void BK4819_RestartFSKReceive(void)
+    {
+        BK4819_WriteRegister(BK4819_REG_59, 0x4068);    // Clear RX FIFO
+        BK4819_WriteRegister(BK4819_REG_59, 0x3068);    // Enable FSK RX
+    }
 #endif
 
 void BK4819_ResetFSK(void)
@@ -21,6 +21,9 @@
 
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size);
 void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer);
+// Size bytes from Address on, handed to the Flash in one piece per mapped
+// area (eeprom_compat.c only)
+void EEPROM_WriteRange(uint16_t Address, const void *pBuffer, uint16_t Size);
 
 #endif
 
@@ -22,8 +22,10 @@
  * ------------------------------------
  */
 
+#include "app/dtmf.h"
 #include "driver/eeprom.h"
 #include "driver/py25q16.h"
+#include "misc.h"
 #include <string.h>
 
 #define HOLE_ADDR 0x1000000
@@ -76,12 +78,17 @@ static const AddrMapping_t ADDR_MAPPINGS[] = {
     // Not mapped, for documentation only (the EEPROM API uses 16-bit
     // addresses and could not reach a 32 KB window anyway):
     //
+    // 0x012000 -> 0x014000: journal of the 0x009000 and 0x00A000 sectors
+    //                       * 2 sectors (driver/journal.c, transparent:
+    //                       reads and writes of 0x9000 / 0xA000 go through it)
+    //
     // 0x1E0000 -> 0x1E8000: RX/TX append-only log * 32 KB / 8 sectors
     //                       (ENABLE_FEAT_F4HWN_RXTX_LOG, accessed directly
     //                       by app/rxtx_log.c, not through this layer)
 };
 
 static void AddrTranslate(uint16_t EEPROM_Addr, uint16_t Size, uint32_t *PY25Q16_Addr_out, uint16_t *Size_out, bool *End_out);
+static void EEPROM_WriteBufferRaw(uint16_t Address, const void *pBuffer, uint16_t Size);
 
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 {
@@ -104,11 +111,51 @@ void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
     }
 }
 
+// Channel attributes, mirrored in RAM by misc.c
+#define ATTR_FROM 0x8000
+#define ATTR_TO   (0x8000 + (MR_CHANNELS_MAX + 7) * 2)
+
+// DTMF contacts, indexed in RAM by dtmf.c
+#define CONTACTS_FROM DTMF_CONTACTS_ADDR
+#define CONTACTS_TO   (DTMF_CONTACTS_ADDR + MAX_DTMF_CONTACTS * 16)
+
 void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
 {
     // Write 8 bytes!!
+    EEPROM_WriteRange(Address, pBuffer, 8);
+}
+
+void EEPROM_WriteRange(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+    if (Size == 0)
+    {
+        return;
+    }
+
+    EEPROM_WriteBufferRaw(Address, pBuffer, Size);
+
+    // Written behind misc.c's back (UART, AirCopy): refresh its scan list index
+    const uint32_t End = (uint32_t)Address + Size;
+    if (Address < ATTR_TO && End > ATTR_FROM)
+    {
+        const uint16_t first = ((Address < ATTR_FROM) ? 0 : Address - ATTR_FROM) / 2;
+        const uint16_t last  = (((End > ATTR_TO) ? ATTR_TO : End) - ATTR_FROM - 1) / 2;
+
+        MR_ReloadChannelAttributes(first, last - first + 1);
+    }
+
+#ifdef ENABLE_DTMF_CALLING
+    if (Address < CONTACTS_TO && End > CONTACTS_FROM)
+    {
+        DTMF_LoadContacts();
+    }
+#endif
+}
 
-    uint16_t Size = 8;
+static void EEPROM_WriteBufferRaw(uint16_t Address, const void *pBuffer, uint16_t Size)
+{
+    // One Flash write per mapped span: the cache batches it by page and
+    // sector, however long it is
     while (Size)
     {
         uint32_t PY_Addr;
@@ -137,6 +184,19 @@ static void AddrTranslate(uint16_t EEPROM_Addr, uint16_t Size, uint32_t *PY25Q16
         }
     }
 
+    // A hole runs up to the next mapping (they are in address order)
+    for (uint32_t i = 0, N = sizeof(ADDR_MAPPINGS) / sizeof(AddrMapping_t); i < N; i++)
+    {
+        if (ADDR_MAPPINGS[i].EEPROM_Addr > EEPROM_Addr)
+        {
+            if (Size > ADDR_MAPPINGS[i].EEPROM_Addr - EEPROM_Addr)
+            {
+                Size = ADDR_MAPPINGS[i].EEPROM_Addr - EEPROM_Addr;
+            }
+            break;
+        }
+    }
+
     *PY25Q16_Addr_out = HOLE_ADDR;
     *Size_out = Size;
     return;
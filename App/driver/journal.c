@@ -0,0 +1,431 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+/**
+ * -----------------------------------
+ * Layout:
+ *
+ *    Two journal sectors take turns (ping-pong). Each one is made of 256
+ *    16-byte slots: slot 0 holds a header (magic, generation), the others
+ *    hold records (key = 8-byte block of a journaled area, data, CRC). The
+ *    active sector is the one with a valid header and the highest
+ *    generation; records are appended, the last one of a key wins.
+ *
+ *    When the active sector runs low on free slots, the spare sector is
+ *    erased in the background, the latest record of every key is copied
+ *    to it and its header is written last, making it active. A power cut
+ *    at any point leaves either the old or the new sector active, and a
+ *    torn record fails its CRC and is ignored.
+ *
+ *    The home sectors are only read (and erased on factory reset): they
+ *    hold the contents as of the last firmware without the journal, and
+ *    compaction does not fold the records back into them. Firmware without
+ *    the journal reads the home sectors only (see README).
+ *
+ * ------------------------------------
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "driver/crc.h"
+#include "driver/journal.h"
+#include "driver/py25q16.h"
+
+#define SECTOR_SIZE  0x1000
+#define SLOT_SIZE    16
+#define SLOTS        (SECTOR_SIZE / SLOT_SIZE)
+#define BLOCK_SIZE   8
+
+#define MAGIC        0x4C4E524Au  // "JRNL"
+
+// Start compacting in the background below this many free slots. All live
+// records (KEYS) always fit in the spare sector with room to spare.
+#define COMPACT_FREE 64
+
+// Slots per Flash read or program when scanning or copying
+#define CHUNK_SLOTS  8
+
+typedef struct
+{
+    uint32_t Begin;
+    uint32_t End;
+    uint8_t  FirstKey;
+} Region_t;
+
+static const Region_t REGIONS[] = {
+    {0x009000, 0x0090D8,  0},   // 14 VFO * 16 Bytes (0x0090D6 rounded up to a block)
+    {0x00A000, 0x00A170, 27},   // Settings
+};
+
+#define KEYS 73
+
+typedef struct
+{
+    uint8_t  Key;
+    uint8_t  KeyInv;            // ~Key: tells a record from a blank or torn slot
+    uint8_t  Data[BLOCK_SIZE];
+    uint16_t Crc;               // Key, KeyInv and Data
+    uint8_t  Unused[4];
+} Record_t;
+
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Generation;
+    uint16_t Crc;               // Magic and Generation
+    uint8_t  Unused[6];
+} Header_t;
+
+static_assert(sizeof(Record_t) == SLOT_SIZE, "a record takes one slot");
+static_assert(sizeof(Header_t) == SLOT_SIZE, "the header takes one slot");
+static_assert(KEYS < SLOTS - COMPACT_FREE, "compaction must fit every key");
+
+static uint8_t  gSlots[KEYS];   // slot of the latest record of each key, 0 = none
+static uint32_t gActive;
+static uint32_t gGeneration;
+static uint16_t gNext;          // first free slot of the active sector
+static bool     gErasing;       // background compaction: spare sector erase started
+
+static uint32_t Spare(void)
+{
+    return (gActive == JOURNAL_SECTOR_A) ? JOURNAL_SECTOR_B : JOURNAL_SECTOR_A;
+}
+
+static const Region_t *FindRegion(uint32_t Address)
+{
+    for (uint32_t i = 0; i < sizeof(REGIONS) / sizeof(REGIONS[0]); i++)
+    {
+        if (Address >= REGIONS[i].Begin && Address < REGIONS[i].End)
+        {
+            return &REGIONS[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool IsBlank(const void *pBuffer, uint32_t Size)
+{
+    const uint8_t *p = pBuffer;
+
+    for (uint32_t i = 0; i < Size; i++)
+    {
+        if (p[i] != 0xff)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool IsValidRecord(const Record_t *pRecord)
+{
+    return pRecord->Key < KEYS                          //
+           && pRecord->KeyInv == (uint8_t)~pRecord->Key //
+           && pRecord->Crc == CRC_Calculate(pRecord, offsetof(Record_t, Crc));
+}
+
+static bool ReadHeader(uint32_t Sector, uint32_t *pGeneration)
+{
+    Header_t Header;
+
+    PY25Q16_ReadBuffer(Sector, &Header, sizeof(Header));
+
+    if (Header.Magic != MAGIC || Header.Crc != CRC_Calculate(&Header, offsetof(Header_t, Crc)))
+    {
+        return false;
+    }
+
+    *pGeneration = Header.Generation;
+    return true;
+}
+
+static void WriteHeader(uint32_t Sector, uint32_t Generation)
+{
+    Header_t Header;
+
+    memset(&Header, 0xff, sizeof(Header));
+    Header.Magic = MAGIC;
+    Header.Generation = Generation;
+    Header.Crc = CRC_Calculate(&Header, offsetof(Header_t, Crc));
+
+    PY25Q16_ProgramBuffer(Sector, &Header, sizeof(Header));
+}
+
+// Rebuild the index from the active sector
+static void Scan(void)
+{
+    Record_t Chunk[CHUNK_SLOTS];
+
+    gNext = 1;
+
+    for (uint16_t Slot = 0; Slot < SLOTS; Slot += CHUNK_SLOTS)
+    {
+        PY25Q16_ReadBuffer(gActive + Slot * SLOT_SIZE, Chunk, sizeof(Chunk));
+
+        for (uint16_t i = (Slot == 0) ? 1 : 0; i < CHUNK_SLOTS; i++)
+        {
+            if (IsBlank(&Chunk[i], SLOT_SIZE))
+            {
+                continue;
+            }
+
+            // Torn records are skipped, but their slot is used
+            if (IsValidRecord(&Chunk[i]))
+            {
+                gSlots[Chunk[i].Key] = Slot + i;
+            }
+
+            gNext = Slot + i + 1;
+        }
+    }
+}
+
+// Copy the latest records to the (erased) spare sector and make it active
+static void CopyLive(void)
+{
+    const uint32_t Target = Spare();
+    Record_t Chunk[CHUNK_SLOTS];
+    uint16_t Slot = 1;
+    uint16_t Count = 0;
+
+    for (uint8_t Key = 0; Key < KEYS; Key++)
+    {
+        if (gSlots[Key] == 0)
+        {
+            continue;
+        }
+
+        PY25Q16_ReadBuffer(gActive + gSlots[Key] * SLOT_SIZE, &Chunk[Count], SLOT_SIZE);
+        gSlots[Key] = Slot + Count;
+
+        if (++Count == CHUNK_SLOTS)
+        {
+            PY25Q16_ProgramBuffer(Target + Slot * SLOT_SIZE, Chunk, Count * SLOT_SIZE);
+            Slot += Count;
+            Count = 0;
+        }
+    }
+
+    if (Count)
+    {
+        PY25Q16_ProgramBuffer(Target + Slot * SLOT_SIZE, Chunk, Count * SLOT_SIZE);
+        Slot += Count;
+    }
+
+    // Last: until the header is there, the old sector stays active
+    WriteHeader(Target, gGeneration + 1);
+
+    gActive = Target;
+    gGeneration++;
+    gNext = Slot;
+    gErasing = false;
+}
+
+static void Compact(void)
+{
+    if (!gErasing)
+    {
+        PY25Q16_SectorErase(Spare());
+    }
+
+    // Otherwise the first read waits for the erase to finish
+    CopyLive();
+}
+
+static void Append(uint8_t Key, Record_t *pRecord)
+{
+    if (gNext >= SLOTS)
+    {
+        Compact();
+    }
+
+    pRecord->Key = Key;
+    pRecord->KeyInv = ~Key;
+    pRecord->Crc = CRC_Calculate(pRecord, offsetof(Record_t, Crc));
+    memset(pRecord->Unused, 0xff, sizeof(pRecord->Unused));
+
+    PY25Q16_ProgramBuffer(gActive + gNext * SLOT_SIZE, pRecord, SLOT_SIZE);
+    gSlots[Key] = gNext++;
+}
+
+void JOURNAL_Init(void)
+{
+    uint32_t GenA, GenB;
+    const bool ValidA = ReadHeader(JOURNAL_SECTOR_A, &GenA);
+    const bool ValidB = ReadHeader(JOURNAL_SECTOR_B, &GenB);
+
+    memset(gSlots, 0, sizeof(gSlots));
+    gErasing = false;
+
+    if (!ValidA && !ValidB)
+    {
+        // First boot with the journal
+        PY25Q16_SectorErase(JOURNAL_SECTOR_A);
+        WriteHeader(JOURNAL_SECTOR_A, 1);
+        gActive = JOURNAL_SECTOR_A;
+        gGeneration = 1;
+        gNext = 1;
+        return;
+    }
+
+    if (ValidA && (!ValidB || (int32_t)(GenA - GenB) > 0))
+    {
+        gActive = JOURNAL_SECTOR_A;
+        gGeneration = GenA;
+    }
+    else
+    {
+        gActive = JOURNAL_SECTOR_B;
+        gGeneration = GenB;
+    }
+
+    Scan();
+}
+
+uint32_t JOURNAL_Split(uint32_t Address, uint32_t Size, bool *pJournaled)
+{
+    const Region_t *pRegion = FindRegion(Address);
+
+    if (pRegion)
+    {
+        *pJournaled = true;
+        return (Size < pRegion->End - Address) ? Size : pRegion->End - Address;
+    }
+
+    *pJournaled = false;
+
+    for (uint32_t i = 0; i < sizeof(REGIONS) / sizeof(REGIONS[0]); i++)
+    {
+        if (REGIONS[i].Begin > Address && REGIONS[i].Begin - Address < Size)
+        {
+            Size = REGIONS[i].Begin - Address;
+        }
+    }
+
+    return Size;
+}
+
+void JOURNAL_Overlay(uint32_t Address, void *pBuffer, uint32_t Size)
+{
+    uint8_t *pDst = pBuffer;
+
+    while (Size)
+    {
+        bool Journaled;
+        uint32_t Run = JOURNAL_Split(Address, Size, &Journaled);
+        const Region_t *pRegion = FindRegion(Address);
+
+        Address += Run;
+        Size -= Run;
+
+        if (!Journaled)
+        {
+            pDst += Run;
+            continue;
+        }
+
+        for (uint32_t From = Address - Run; Run;)
+        {
+            const uint32_t Offset = From % BLOCK_SIZE;
+            const uint32_t n = (Run < BLOCK_SIZE - Offset) ? Run : BLOCK_SIZE - Offset;
+            const uint8_t Slot = gSlots[pRegion->FirstKey + (From - pRegion->Begin) / BLOCK_SIZE];
+
+            if (Slot)
+            {
+                PY25Q16_ReadBuffer(gActive + Slot * SLOT_SIZE + offsetof(Record_t, Data) + Offset, pDst, n);
+            }
+
+            From += n;
+            pDst += n;
+            Run -= n;
+        }
+    }
+}
+
+void JOURNAL_Write(uint32_t Address, const void *pBuffer, uint32_t Size)
+{
+    const Region_t *pRegion = FindRegion(Address);
+    const uint8_t *pSrc = pBuffer;
+
+    while (Size)
+    {
+        const uint32_t Block = Address - (Address % BLOCK_SIZE);
+        const uint32_t Offset = Address - Block;
+        const uint32_t n = (Size < BLOCK_SIZE - Offset) ? Size : BLOCK_SIZE - Offset;
+        Record_t Record;
+
+        // Current contents, journal included: only changed blocks are written
+        PY25Q16_ReadBuffer(Block, Record.Data, BLOCK_SIZE);
+
+        if (0 != memcmp(Record.Data + Offset, pSrc, n))
+        {
+            memcpy(Record.Data + Offset, pSrc, n);
+            Append(pRegion->FirstKey + (Block - pRegion->Begin) / BLOCK_SIZE, &Record);
+        }
+
+        Address += n;
+        pSrc += n;
+        Size -= n;
+    }
+}
+
+void JOURNAL_Discard(uint32_t Address)
+{
+    bool Dropped = false;
+
+    for (uint32_t i = 0; i < sizeof(REGIONS) / sizeof(REGIONS[0]); i++)
+    {
+        const Region_t *pRegion = &REGIONS[i];
+
+        if (pRegion->Begin - (pRegion->Begin % SECTOR_SIZE) != Address)
+        {
+            continue;
+        }
+
+        for (uint32_t Key = pRegion->FirstKey; Key < pRegion->FirstKey + (pRegion->End - pRegion->Begin) / BLOCK_SIZE; Key++)
+        {
+            Dropped |= gSlots[Key] != 0;
+            gSlots[Key] = 0;
+        }
+    }
+
+    // Rewrite the journal without them, or they would come back at boot
+    if (Dropped)
+    {
+        Compact();
+    }
+}
+
+void JOURNAL_Task10ms(void)
+{
+    if (!gErasing)
+    {
+        if (SLOTS - gNext < COMPACT_FREE)
+        {
+            PY25Q16_SectorEraseAsync(Spare());
+            gErasing = true;
+        }
+        return;
+    }
+
+    if (!PY25Q16_IsBusy())
+    {
+        CopyLive();
+    }
+}
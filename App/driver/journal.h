@@ -0,0 +1,51 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef DRIVER_JOURNAL_H
+#define DRIVER_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Append-only journal in front of the settings (0x00A000) and VFO
+// (0x009000) areas of the SPI flash. Writes to these areas append 8-byte
+// records to a journal sector instead of erasing and reprogramming the home
+// sector; reads see the home sector patched with the latest records.
+//
+// Used by the PY25Q16 driver only: the rest of the firmware keeps calling
+// PY25Q16_ReadBuffer() / PY25Q16_WriteBuffer() with the usual addresses.
+
+#define JOURNAL_SECTOR_A 0x012000
+#define JOURNAL_SECTOR_B 0x013000
+
+void     JOURNAL_Init(void);
+
+// Length of the run of [Address, Address + Size) that is uniformly inside
+// (*pJournaled = true) or outside the journaled areas
+uint32_t JOURNAL_Split(uint32_t Address, uint32_t Size, bool *pJournaled);
+
+// Patch a buffer just read from the home sectors with the journal
+void     JOURNAL_Overlay(uint32_t Address, void *pBuffer, uint32_t Size);
+
+// Write inside a journaled area (see JOURNAL_Split)
+void     JOURNAL_Write(uint32_t Address, const void *pBuffer, uint32_t Size);
+
+// The home sector at Address was erased: forget its records
+void     JOURNAL_Discard(uint32_t Address);
+
+// Background compaction, one step per call
+void     JOURNAL_Task10ms(void);
+
+#endif
@@ -50,9 +50,7 @@ typedef enum {
     STATE_KA_1,
     STATE_KA_2,
     STATE_KA_3,
-#ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
     STATE_KA_FEATURE,
-#endif
     STATE_KEY_1,
     STATE_KEY_2,
     STATE_KEY_3,
@@ -72,10 +70,11 @@ extern volatile KEY_Code_t gKeyFromSerial;
 #define SERIAL_VIEWER_FEATURE_RF_LOG 0x01u
 #define SERIAL_VIEWER_FEATURE_RF_LOG_HISTORY 0x02u
 #define SERIAL_VIEWER_FEATURE_RF_LOG_RESTART 0x80u
+#endif
+#define SERIAL_VIEWER_FEATURE_PACKED 0x04u
 
 // Extension flags announced by the viewer's feature keepalive.
 extern volatile uint8_t    gSerialViewerFeatures;
-#endif
 
 bool KEYBOARD_ProcessProtocolByte(ParseState_t *state, uint8_t b);
 #endif
@@ -18,6 +18,7 @@
 
 #include "driver/py25q16.h"
 #include "driver/gpio.h"
+#include "driver/journal.h"
 #include "py32f071_ll_bus.h"
 #include "py32f071_ll_system.h"
 #include "py32f071_ll_spi.h"
@@ -38,10 +39,44 @@
 #define SECTOR_SIZE 0x1000
 #define PAGE_SIZE 0x100
 
-static uint32_t SectorCacheAddr = 0x1000000;
+#define NO_ADDR 0x1000000
+
+// Write-back: PY25Q16_WriteBuffer() writes into the sector cache, which
+// goes back to the Flash when another sector is written, after
+// CACHE_FLUSH_DELAY_10ms without writes, and on PY25Q16_Flush() before power
+// save and reset. The writes of a CHIRP upload come in address order and
+// cost one erase per sector.
+#define CACHE_FLUSH_DELAY_10ms 50
+
+static uint32_t SectorCacheAddr = NO_ADDR;
 static uint8_t SectorCache[SECTOR_SIZE];
+static uint16_t SectorDirty;     // bit per page: differs from the Flash
+static bool SectorSetBits;       // a write set bits: erase on flush
+static uint8_t CacheFlushCountdown_10ms;
 static uint8_t BlackHole[4] __attribute__((aligned(4)));
-static volatile bool TC_Flag;
+static bool EraseStarted;
+
+// Read queue: the read at the head is out by DMA, the next one starts from
+// the DMA interrupt as soon as it ends. Every call but PY25Q16_ReadAsync()
+// lets the queue run dry before it touches the bus or the cache.
+#define READ_QUEUE 4
+
+typedef struct
+{
+    uint32_t Address;
+    uint8_t *pBuffer;
+    uint32_t Size;
+    void (*pCallback)(void *pContext);
+    void *pContext;
+} ReadRequest_t;
+
+static ReadRequest_t ReadQueue[READ_QUEUE];
+static volatile uint8_t ReadHead;
+static volatile uint8_t ReadCount;
+
+// Fast read (0x0B) clocks a dummy byte after the address: it only pays when
+// SCK is past the 55 MHz of the plain read, and SPI2 runs at 24 MHz
+static bool FastReadEnabled = false;
 
 static inline void CS_Assert()
 {
@@ -103,7 +138,8 @@ static void SPI_Init()
     LL_SPI_Enable(SPIx);
 }
 
-static void SPI_ReadBuf(uint8_t *Buf, uint32_t Size)
+// Returns at once: ReadService() ends the transfer
+static void SPI_StartReadBuf(uint8_t *Buf, uint32_t Size)
 {
     LL_SPI_Disable(SPIx);
     LL_DMA_DisableChannel(DMA1, CHANNEL_RD);
@@ -139,7 +175,6 @@ static void SPI_ReadBuf(uint8_t *Buf, uint32_t Size)
     LL_DMA_SetPeriphAddress(DMA1, CHANNEL_WR, LL_SPI_DMA_GetRegAddr(SPIx));
     LL_DMA_SetDataLength(DMA1, CHANNEL_WR, Size);
 
-    TC_Flag = false;
     LL_DMA_EnableIT_TC(DMA1, CHANNEL_RD);
     LL_DMA_EnableChannel(DMA1, CHANNEL_RD);
     LL_DMA_EnableChannel(DMA1, CHANNEL_WR);
@@ -147,9 +182,6 @@ static void SPI_ReadBuf(uint8_t *Buf, uint32_t Size)
     LL_SPI_EnableDMAReq_RX(SPIx);
     LL_SPI_Enable(SPIx);
     LL_SPI_EnableDMAReq_TX(SPIx);
-
-    while (!TC_Flag)
-        ;
 }
 
 static void SPI_WriteBuf(const uint8_t *Buf, uint32_t Size)
@@ -188,8 +220,6 @@ static void SPI_WriteBuf(const uint8_t *Buf, uint32_t Size)
     LL_DMA_SetPeriphAddress(DMA1, CHANNEL_WR, LL_SPI_DMA_GetRegAddr(SPIx));
     LL_DMA_SetDataLength(DMA1, CHANNEL_WR, Size);
 
-    TC_Flag = false;
-    LL_DMA_EnableIT_TC(DMA1, CHANNEL_RD);
     LL_DMA_EnableChannel(DMA1, CHANNEL_RD);
     LL_DMA_EnableChannel(DMA1, CHANNEL_WR);
 
@@ -197,8 +227,14 @@ static void SPI_WriteBuf(const uint8_t *Buf, uint32_t Size)
     LL_SPI_Enable(SPIx);
     LL_SPI_EnableDMAReq_TX(SPIx);
 
-    while (!TC_Flag)
+    // The RX channel has taken the last byte: it is out
+    while (!LL_DMA_IsActiveFlag_TC4(DMA1))
         ;
+    while (LL_SPI_IsActiveFlag_BSY(SPIx))
+        ;
+
+    LL_SPI_DisableDMAReq_TX(SPIx);
+    LL_SPI_DisableDMAReq_RX(SPIx);
 }
 
 static uint8_t SPI_WriteByte(uint8_t Value)
@@ -218,19 +254,34 @@ static void WriteEnable();
 static void SectorErase(uint32_t Addr);
 static void SectorProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
 static void PageProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
+static void WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size);
+static void CacheFlush(void);
+static void CacheDrop(uint32_t SecAddr);
+static bool CacheOverlaps(uint32_t Address, uint32_t Size);
 
-void PY25Q16_Init()
+// Let an erase started by PY25Q16_SectorEraseAsync() finish
+static inline void WaitEraseAsync()
 {
-    CS_Release();
-    SPI_Init();
+    if (EraseStarted)
+    {
+        WaitWIP();
+        EraseStarted = false;
+    }
 }
 
-void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
+// Start the read at the head of the queue, with interrupts off
+static void ReadStart(void)
 {
+    const ReadRequest_t *pRead = &ReadQueue[ReadHead];
+
     CS_Assert();
 
-    SPI_WriteByte(0x03);      // Send read command
-    WriteAddr(Address);        // Send address (3 bytes)
+    SPI_WriteByte(FastReadEnabled ? 0x0B : 0x03);
+    WriteAddr(pRead->Address);
+    if (FastReadEnabled)
+    {
+        SPI_WriteByte(0xff);    // Dummy byte
+    }
 
     // CRITICAL: Flush RX FIFO before DMA to remove residual data
     while (LL_SPI_RX_FIFO_EMPTY != LL_SPI_GetRxFIFOLevel(SPIx))
@@ -238,107 +289,383 @@ void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
         LL_SPI_ReceiveData8(SPIx);  // Read and discard
     }
 
-    if (Size >= 16) {
-        SPI_ReadBuf((uint8_t *)pBuffer, Size);
-    } else {
-        for (uint32_t i = 0; i < Size; i++)
+    SPI_StartReadBuf(pRead->pBuffer, pRead->Size);
+}
+
+// Transfer complete: start the next read, then hand this one over
+static void ReadService(void)
+{
+    if (!LL_DMA_IsActiveFlag_TC4(DMA1) || !LL_DMA_IsEnabledIT_TC(DMA1, CHANNEL_RD))
+    {
+        return;
+    }
+
+    LL_DMA_DisableIT_TC(DMA1, CHANNEL_RD);
+    LL_DMA_ClearFlag_TC4(DMA1);
+
+    while (LL_SPI_IsActiveFlag_BSY(SPIx))
+        ;
+
+    LL_SPI_DisableDMAReq_TX(SPIx);
+    LL_SPI_DisableDMAReq_RX(SPIx);
+
+    CS_Release();
+
+    const ReadRequest_t Read = ReadQueue[ReadHead];
+
+    ReadHead = (ReadHead + 1) % READ_QUEUE;
+    if (--ReadCount)
+    {
+        ReadStart();
+    }
+
+    if (Read.pCallback)
+    {
+        Read.pCallback(Read.pContext);
+    }
+}
+
+static bool ReadPush(uint32_t Address, void *pBuffer, uint32_t Size, void (*pCallback)(void *), void *pContext)
+{
+    const uint32_t Primask = __get_PRIMASK();
+    __disable_irq();
+
+    const bool Queued = ReadCount < READ_QUEUE;
+    if (Queued)
+    {
+        ReadQueue[(ReadHead + ReadCount) % READ_QUEUE] = (ReadRequest_t){
+            .Address = Address,
+            .pBuffer = pBuffer,
+            .Size = Size,
+            .pCallback = pCallback,
+            .pContext = pContext,
+        };
+
+        if (ReadCount++ == 0)
         {
-            ((uint8_t *)(pBuffer))[i] = SPI_WriteByte(0xff);
+            ReadStart();
         }
     }
 
+    __set_PRIMASK(Primask);
+
+    return Queued;
+}
+
+// Let the queued reads end, and those their callbacks queue. Works with
+// interrupts off as well: the reads are then chained from here.
+static void WaitReads()
+{
+    while (ReadCount)
+    {
+        const uint32_t Primask = __get_PRIMASK();
+        __disable_irq();
+        ReadService();
+        __set_PRIMASK(Primask);
+    }
+}
+
+// Nothing on the bus and nothing to come
+static void WaitIdle()
+{
+    WaitReads();
+    WaitEraseAsync();
+}
+
+void PY25Q16_Init()
+{
     CS_Release();
+    SPI_Init();
+
+    SectorCacheAddr = NO_ADDR;
+    EraseStarted = false;
+    ReadHead = 0;
+    ReadCount = 0;
+
+    SectorDirty = 0;
+    SectorSetBits = false;
+    CacheFlushCountdown_10ms = 0;
+
+    JOURNAL_Init();
 }
 
-void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append)
+void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
 {
-#ifdef DEBUG
-    printf("spi flash write: %06x %ld %d\n", Address, Size, Append);
-#endif
+    WaitIdle();
+
+    if (Size)
+    {
+        ReadPush(Address, pBuffer, Size, NULL, NULL);
+        WaitReads();
+    }
+
+    // Pages not written back yet
+    if (CacheOverlaps(Address, Size))
+    {
+        const uint32_t From = (SectorCacheAddr > Address) ? SectorCacheAddr : Address;
+        const uint32_t To = (SectorCacheAddr + SECTOR_SIZE < Address + Size) ? SectorCacheAddr + SECTOR_SIZE : Address + Size;
 
-    //#ifdef ENABLE_FEAT_F4HWN_DEBUG
-    //    gDebug++;
-    //#endif
+        memcpy((uint8_t *)pBuffer + (From - Address), SectorCache + (From - SectorCacheAddr), To - From);
+    }
 
-    uint32_t SecIndex = Address / SECTOR_SIZE;
-    uint32_t SecAddr = SecIndex * SECTOR_SIZE;
-    uint32_t SecOffset = Address % SECTOR_SIZE;
-    uint32_t SecSize = SECTOR_SIZE - SecOffset;
+    // Settings and VFOs: latest values are in the journal
+    JOURNAL_Overlay(Address, pBuffer, Size);
+}
 
+bool PY25Q16_ReadAsync(uint32_t Address, void *pBuffer, uint32_t Size, void (*pCallback)(void *pContext), void *pContext)
+{
+    bool Journaled;
+
+    // The journal and the sector cache overlay the Flash: not from an
+    // interrupt
+    if (Size == 0 || JOURNAL_Split(Address, Size, &Journaled) < Size || Journaled || CacheOverlaps(Address, Size))
+    {
+        PY25Q16_ReadBuffer(Address, pBuffer, Size);
+        if (pCallback)
+        {
+            pCallback(pContext);
+        }
+        return true;
+    }
+
+    // An erase under way means an empty queue: the erase waited for it
+    WaitEraseAsync();
+
+    return ReadPush(Address, pBuffer, Size, pCallback, pContext);
+}
+
+void PY25Q16_SetFastRead(bool Enable)
+{
+    PY25Q16_WaitReads();
+    FastReadEnabled = Enable;
+}
+
+bool PY25Q16_IsReading(void)
+{
+    return ReadCount != 0;
+}
+
+void PY25Q16_WaitReads(void)
+{
+    WaitReads();
+}
+
+// The range reads pages not written back yet
+static bool CacheOverlaps(uint32_t Address, uint32_t Size)
+{
+    return SectorDirty && SectorCacheAddr < Address + Size && SectorCacheAddr + SECTOR_SIZE > Address;
+}
+
+void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append)
+{
+    (void)Append;
+
+    WaitReads();
+
+    // Settings and VFOs are journaled instead of rewriting their sector
     while (Size)
     {
-        // CRITICAL FIX #1: Wait for flash ready before processing each sector
-        WaitWIP();
+        bool Journaled;
+        const uint32_t Run = JOURNAL_Split(Address, Size, &Journaled);
 
-        if (Size < SecSize)
+        if (Journaled)
         {
-            SecSize = Size;
+            JOURNAL_Write(Address, pBuffer, Run);
         }
+        else
+        {
+            // Append (nothing after this write in its area) dates from the
+            // write-through path: the cache programs whole pages anyway
+            WriteBuffer(Address, pBuffer, Run);
+        }
+
+        Address += Run;
+        pBuffer += Run;
+        Size -= Run;
+    }
+}
+
+static void WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size)
+{
+#ifdef DEBUG
+    printf("spi flash write: %06x %ld\n", Address, Size);
+#endif
+
+    const uint8_t *pData = pBuffer;
+
+    while (Size)
+    {
+        const uint32_t SecAddr = Address - (Address % SECTOR_SIZE);
+        const uint32_t Offset = Address % SECTOR_SIZE;
+        const uint32_t Run = (Size < SECTOR_SIZE - Offset) ? Size : SECTOR_SIZE - Offset;
 
         if (SecAddr != SectorCacheAddr)
         {
+            CacheFlush();
+            WaitEraseAsync();
+
+            SectorCacheAddr = NO_ADDR;
             PY25Q16_ReadBuffer(SecAddr, SectorCache, SECTOR_SIZE);
             SectorCacheAddr = SecAddr;
         }
 
-        if (0 != memcmp(pBuffer, (char *)SectorCache + SecOffset, SecSize))
+        for (uint32_t k = 0; k < Run; k++)
         {
-            bool Erase = false;
-            for (uint32_t i = 0; i < SecSize; i++)
+            uint8_t *pCached = SectorCache + Offset + k;
+
+            if (pData[k] != *pCached)
             {
-                if (0xff != SectorCache[SecOffset + i])
-                {
-                    Erase = true;
-                    break;
-                }
+                // Checked against the cache rather than the Flash under it:
+                // it may take an erase that was not needed, never miss one
+                SectorSetBits |= (pData[k] & ~*pCached) != 0;
+                SectorDirty |= 1u << ((Offset + k) / PAGE_SIZE);
+                CacheFlushCountdown_10ms = CACHE_FLUSH_DELAY_10ms;
+                *pCached = pData[k];
             }
+        }
 
-            memcpy(SectorCache + SecOffset, pBuffer, SecSize);
+        Address += Run;
+        pData += Run;
+        Size -= Run;
+    }
+}
 
-            if (Erase)
-            {
-                SectorErase(SecAddr);
-
-                // CRITICAL FIX #2: Erase takes ~300ms, must complete before program starts
-                WaitWIP();
-
-                if (Append)
-                {
-                    SectorProgram(SecAddr, SectorCache, SecOffset + SecSize);
-                    memset(SectorCache + SecOffset + SecSize, 0xff, SECTOR_SIZE - SecOffset - SecSize);
-                }
-                else
-                {
-                    SectorProgram(SecAddr, SectorCache, SECTOR_SIZE);
-                }
-            }
-            else
-            {
-                SectorProgram(Address, pBuffer, SecSize);
-            }
+// Write back the dirty pages: programmed as they are when they only clear
+// bits, else the sector is erased and its non-blank pages reprogrammed
+static void CacheFlush(void)
+{
+    if (!SectorDirty)
+    {
+        return;
+    }
+
+    WaitEraseAsync();
+
+    if (SectorSetBits)
+    {
+        SectorErase(SectorCacheAddr);
+    }
+
+    // In address order: whatever a power loss interrupts, data appended to
+    // the sector stays a prefix of it
+    for (uint32_t Page = 0; Page < SECTOR_SIZE / PAGE_SIZE; Page++)
+    {
+        const uint8_t *pPage = SectorCache + Page * PAGE_SIZE;
+        bool Blank = true;
+
+        if (!SectorSetBits && !(SectorDirty & (1u << Page)))
+        {
+            continue;
         }
 
-        Address += SecSize;
-        pBuffer += SecSize;
-        Size -= SecSize;
+        for (uint32_t k = 0; k < PAGE_SIZE && Blank; k++)
+        {
+            Blank = (0xff == pPage[k]);
+        }
 
-        SecAddr += SECTOR_SIZE;
-        SecOffset = 0;
-        SecSize = SECTOR_SIZE;
-    } // while
+        // Blank pages stay as the erase left them
+        if (!Blank)
+        {
+            PageProgram(SectorCacheAddr + Page * PAGE_SIZE, pPage, PAGE_SIZE);
+        }
+    }
 
-    // CRITICAL FIX #3: Ensure all writes complete before function returns
-    WaitWIP();
+    SectorDirty = 0;
+    SectorSetBits = false;
+}
+
+// The sector is erased behind the cache: forget what was written to it
+static void CacheDrop(uint32_t SecAddr)
+{
+    if (SectorCacheAddr == SecAddr)
+    {
+        memset(SectorCache, 0xff, SECTOR_SIZE);
+        SectorDirty = 0;
+        SectorSetBits = false;
+    }
+}
+
+void PY25Q16_Flush(void)
+{
+    WaitReads();
+    CacheFlush();
+
+    CacheFlushCountdown_10ms = 0;
+}
+
+void PY25Q16_DelayFlush(uint8_t Delay_10ms)
+{
+    if (CacheFlushCountdown_10ms)
+    {
+        CacheFlushCountdown_10ms = Delay_10ms;
+    }
+}
+
+void PY25Q16_Task10ms(void)
+{
+    if (CacheFlushCountdown_10ms && --CacheFlushCountdown_10ms == 0)
+    {
+        PY25Q16_Flush();
+    }
+
+    JOURNAL_Task10ms();
 }
 
 void PY25Q16_SectorErase(uint32_t Address)
 {
+    WaitIdle();
+
     Address -= (Address % SECTOR_SIZE);
     SectorErase(Address);
-    if (SectorCacheAddr == Address)
+    CacheDrop(Address);
+    JOURNAL_Discard(Address);
+}
+
+void PY25Q16_ProgramBuffer(uint32_t Address, const void *pBuffer, uint32_t Size)
+{
+    WaitIdle();
+
+    if (Address - (Address % SECTOR_SIZE) == SectorCacheAddr)
     {
-        memset(SectorCache, 0xff, SECTOR_SIZE);
+        CacheFlush();
+
+        for (uint32_t i = 0; i < Size && (Address % SECTOR_SIZE) + i < SECTOR_SIZE; i++)
+        {
+            SectorCache[(Address % SECTOR_SIZE) + i] &= ((const uint8_t *)pBuffer)[i];
+        }
     }
+
+    SectorProgram(Address, pBuffer, Size);
+}
+
+void PY25Q16_SectorEraseAsync(uint32_t Address)
+{
+    WaitIdle();
+
+    Address -= (Address % SECTOR_SIZE);
+    CacheDrop(Address);
+
+    WriteEnable();
+    WaitWIP();
+
+    CS_Assert();
+    SPI_WriteByte(0x20);
+    WriteAddr(Address);
+    CS_Release();
+
+    EraseStarted = true;
+}
+
+bool PY25Q16_IsBusy(void)
+{
+    WaitReads();
+
+    if (EraseStarted && !(1 & ReadStatusReg(0)))
+    {
+        EraseStarted = false;
+    }
+
+    return EraseStarted;
 }
 
 static inline void WriteAddr(uint32_t Addr)
@@ -465,30 +792,5 @@ static void PageProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size)
 
 void DMA1_Channel4_5_6_7_IRQHandler()
 {
-    if (LL_DMA_IsActiveFlag_TC4(DMA1) && LL_DMA_IsEnabledIT_TC(DMA1, CHANNEL_RD))
-    {
-        LL_DMA_DisableIT_TC(DMA1, CHANNEL_RD);
-        LL_DMA_ClearFlag_TC4(DMA1);
-
-        // Wait a tiny bit for SPI to finish
-        SYSTICK_DelayUs(10);  // ← ADD THIS
-
-        uint32_t timeout = 10000;
-        
-        while ((LL_SPI_TX_FIFO_EMPTY != LL_SPI_GetTxFIFOLevel(SPIx)) && timeout--)
-            ;
-        
-        timeout = 10000;
-        while (LL_SPI_IsActiveFlag_BSY(SPIx) && timeout--)
-            ;
-        
-        timeout = 10000;
-        while ((LL_SPI_RX_FIFO_EMPTY != LL_SPI_GetRxFIFOLevel(SPIx)) && timeout--)
-            ;
-
-        LL_SPI_DisableDMAReq_TX(SPIx);
-        LL_SPI_DisableDMAReq_RX(SPIx);
-
-        TC_Flag = true;
-    }
-}
\ No newline at end of file
+    ReadService();
+}
@@ -22,7 +22,33 @@
 
 void PY25Q16_Init();
 void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size);
+
+// Queue a read and return: the DMA fills pBuffer behind the caller, then
+// pCallback(pContext) runs from the DMA interrupt, where it may queue another
+// read. The journaled areas (settings, VFOs) are read at once. False, and
+// nothing read, when the queue is full. Every other call waits for the
+// queued reads first.
+bool PY25Q16_ReadAsync(uint32_t Address, void *pBuffer, uint32_t Size, void (*pCallback)(void *pContext), void *pContext);
+bool PY25Q16_IsReading(void);
+void PY25Q16_WaitReads(void);
+// Read with the fast read command (0x0B) instead of 0x03, off by default
+void PY25Q16_SetFastRead(bool Enable);
 void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append);
 void PY25Q16_SectorErase(uint32_t Address);
 
+// PY25Q16_WriteBuffer() is write-back: write the cached sector to the Flash
+// (before power save or reset), PY25Q16_Task10ms() does it once idle
+void PY25Q16_Flush(void);
+void PY25Q16_Task10ms(void);
+// Put the idle write-back off, for a writer that flushes at its own
+// boundaries (aircopy)
+void PY25Q16_DelayFlush(uint8_t Delay_10ms);
+
+// Program erased Flash as is: no read back, no erase, no journal
+void PY25Q16_ProgramBuffer(uint32_t Address, const void *pBuffer, uint32_t Size);
+
+// Start a sector erase and return; every other call waits for its end
+void PY25Q16_SectorEraseAsync(uint32_t Address);
+bool PY25Q16_IsBusy(void);
+
 #endif
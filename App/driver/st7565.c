@@ -16,10 +16,13 @@
 
 #include <stdint.h>
 #include <stdio.h>     // NULL
+#include <string.h>
 
 #include "py32f071_ll_bus.h"
+#include "py32f071_ll_dma.h"
 #include "py32f071_ll_spi.h"
 #include "py32f071_ll_gpio.h"
+#include "py32f071_ll_system.h"
 #include "driver/gpio.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
@@ -28,12 +31,54 @@
 
 #define SPIx SPI1
 
+#define CHANNEL_RD LL_DMA_CHANNEL_1
+#define CHANNEL_WR LL_DMA_CHANNEL_6
+
 #define PIN_CS GPIO_MAKE_PIN(GPIOB, LL_GPIO_PIN_2)
 #define PIN_A0 GPIO_MAKE_PIN(GPIOA, LL_GPIO_PIN_6)
 
 uint8_t gStatusLine[LCD_WIDTH];
 uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
 
+// What the display RAM holds once the queued spans are out, as a CRC of
+// each group of 8 columns, page 0 being the status line: blits only queue
+// the groups whose CRC differs. A group not known to hold anything in
+// particular (reset, interference, direct fills) is sent again.
+#define GROUP_SIZE 8
+#define GROUPS     (LCD_WIDTH / GROUP_SIZE)
+
+static uint16_t LcdGroupCrc[FRAME_LINES + 1][GROUPS];
+static uint16_t LcdGroupValid[FRAME_LINES + 1];     // one bit per group
+
+// Spans go out by DMA from a copy taken when they were blitted, so the UI
+// can draw the next frame into gStatusLine / gFrameBuffer (and
+// K5VIEWER_Update() read them) while the display is still being written.
+// Each span is a command segment (A0 low: page and column address) then
+// its data, chained from the transfer complete interrupt. A blit that does
+// not fit waits for room.
+#define QUEUE_SIZE 256      // bytes of span data
+#define QUEUE_SPANS 16
+
+typedef struct
+{
+    uint8_t Page;
+    uint8_t Column;
+    uint8_t Size;
+} LcdSpan_t;
+
+static uint8_t   LcdQueueData[QUEUE_SIZE];
+static LcdSpan_t LcdSpans[QUEUE_SPANS];
+static volatile uint16_t LcdDataHead;   // first byte queued or out
+static volatile uint16_t LcdDataCount;  // bytes queued or out
+static volatile uint8_t  LcdSpanHead;
+static volatile uint8_t  LcdSpanCount;  // spans whose command is not out
+static volatile bool     LcdBusy;       // a chain of segments is running
+static uint8_t LcdDataLeft;             // of the span under way
+static uint8_t LcdDmaSize;              // data bytes of the segment out
+static bool    LcdChainStart;
+static uint8_t LcdCmd[4];
+static uint8_t LcdSink;                 // what comes back on MISO
+
 static void SPI_Init()
 {
     LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_SPI1);
@@ -59,6 +104,38 @@ static void SPI_Init()
         LL_GPIO_Init(GPIOA, &InitStruct);
     } while (0);
 
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    LL_SYSCFG_SetDMARemap(DMA1, CHANNEL_RD, LL_SYSCFG_DMA_MAP_SPI1_RD);
+    LL_SYSCFG_SetDMARemap(DMA1, CHANNEL_WR, LL_SYSCFG_DMA_MAP_SPI1_WR);
+
+    LL_DMA_ConfigTransfer(DMA1, CHANNEL_RD,                 //
+                          LL_DMA_DIRECTION_PERIPH_TO_MEMORY //
+                              | LL_DMA_MODE_NORMAL          //
+                              | LL_DMA_PERIPH_NOINCREMENT   //
+                              | LL_DMA_MEMORY_NOINCREMENT   //
+                              | LL_DMA_PDATAALIGN_BYTE      //
+                              | LL_DMA_MDATAALIGN_BYTE      //
+                              | LL_DMA_PRIORITY_LOW         //
+    );
+
+    LL_DMA_ConfigTransfer(DMA1, CHANNEL_WR,                 //
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH //
+                              | LL_DMA_MODE_NORMAL          //
+                              | LL_DMA_PERIPH_NOINCREMENT   //
+                              | LL_DMA_MEMORY_INCREMENT     //
+                              | LL_DMA_PDATAALIGN_BYTE      //
+                              | LL_DMA_MDATAALIGN_BYTE      //
+                              | LL_DMA_PRIORITY_LOW         //
+    );
+
+    LL_DMA_SetMemoryAddress(DMA1, CHANNEL_RD, (uint32_t)&LcdSink);
+    LL_DMA_SetPeriphAddress(DMA1, CHANNEL_RD, LL_SPI_DMA_GetRegAddr(SPIx));
+    LL_DMA_SetPeriphAddress(DMA1, CHANNEL_WR, LL_SPI_DMA_GetRegAddr(SPIx));
+
+    NVIC_SetPriority(DMA1_Channel1_IRQn, 2);
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
     LL_SPI_InitTypeDef InitStruct;
     LL_SPI_StructInit(&InitStruct);
     InitStruct.TransferDirection = LL_SPI_FULL_DUPLEX;
@@ -117,11 +194,224 @@ static void DrawLine(uint8_t column, uint8_t line, const uint8_t * lineBuffer, u
     }
 }
 
+static void DmaStart(const uint8_t *pData, uint8_t Size)
+{
+    LL_DMA_DisableChannel(DMA1, CHANNEL_RD);
+    LL_DMA_DisableChannel(DMA1, CHANNEL_WR);
+
+    LL_DMA_ClearFlag_GI1(DMA1);
+    LL_DMA_ClearFlag_GI6(DMA1);
+
+    LL_DMA_SetDataLength(DMA1, CHANNEL_RD, Size);
+    LL_DMA_SetMemoryAddress(DMA1, CHANNEL_WR, (uint32_t)pData);
+    LL_DMA_SetDataLength(DMA1, CHANNEL_WR, Size);
+
+    LL_DMA_EnableIT_TC(DMA1, CHANNEL_RD);
+    LL_DMA_EnableChannel(DMA1, CHANNEL_RD);
+    LL_DMA_EnableChannel(DMA1, CHANNEL_WR);
+
+    LL_SPI_EnableDMAReq_RX(SPIx);
+    LL_SPI_EnableDMAReq_TX(SPIx);
+}
+
+// Start the next segment of the chain, with interrupts off
+static void LcdNext(void)
+{
+    // The data segment that ended leaves room for more
+    LcdDataHead = (LcdDataHead + LcdDmaSize) % QUEUE_SIZE;
+    LcdDataCount -= LcdDmaSize;
+    LcdDmaSize = 0;
+
+    if (LcdDataLeft)
+    {
+        const uint16_t linear = QUEUE_SIZE - LcdDataHead;
+
+        LcdDmaSize = (LcdDataLeft < linear) ? LcdDataLeft : linear;
+        A0_Set();
+        DmaStart(LcdQueueData + LcdDataHead, LcdDmaSize);
+        LcdDataLeft -= LcdDmaSize;
+        return;
+    }
+
+    if (LcdSpanCount)
+    {
+        const LcdSpan_t *span = &LcdSpans[LcdSpanHead];
+        unsigned column = span->Column + 4;
+
+        LcdDataLeft   = span->Size;
+        LcdSpanHead   = (LcdSpanHead + 1) % QUEUE_SPANS;
+        LcdSpanCount--;
+
+        uint8_t *cmd = LcdCmd;
+        if (LcdChainStart)
+            *cmd++ = 0x40;      // start line ?
+        LcdChainStart = false;
+
+        *cmd++ = span->Page + 176;
+        *cmd++ = ((column >> 4) & 0x0F) | 0x10;
+        *cmd++ = (column >> 0) & 0x0F;
+
+        A0_Reset();
+        DmaStart(LcdCmd, cmd - LcdCmd);
+        return;
+    }
+
+    LcdBusy = false;
+    CS_Release();
+}
+
+// Transfer complete: the RX channel has taken the last byte, so it is out
+static void LcdService(void)
+{
+    if (!LL_DMA_IsActiveFlag_TC1(DMA1) || !LL_DMA_IsEnabledIT_TC(DMA1, CHANNEL_RD))
+        return;
+
+    LL_DMA_DisableIT_TC(DMA1, CHANNEL_RD);
+    LL_DMA_ClearFlag_TC1(DMA1);
+
+    while (LL_SPI_IsActiveFlag_BSY(SPIx))
+        ;
+
+    LL_SPI_DisableDMAReq_TX(SPIx);
+    LL_SPI_DisableDMAReq_RX(SPIx);
+
+    LcdNext();
+}
+
+void DMA1_Channel1_IRQHandler(void)
+{
+    LcdService();
+}
+
+// Let the queued spans go out before a direct write to the display. Works
+// with interrupts off as well: the segments are then chained from here.
+static void LcdWaitIdle(void)
+{
+    while (LcdBusy)
+    {
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        LcdService();
+        __set_PRIMASK(primask);
+    }
+}
+
+// CRC-16-CCITT, a nibble at a time
+static uint16_t GroupCrc(const uint8_t *pData)
+{
+    static const uint16_t Table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0;
+
+    for (unsigned i = 0; i < GROUP_SIZE; i++)
+    {
+        crc = (crc << 4) ^ Table[(crc >> 12) ^ (pData[i] >> 4)];
+        crc = (crc << 4) ^ Table[(crc >> 12) ^ (pData[i] & 0x0F)];
+    }
+
+    return crc;
+}
+
+// Copy a span into the queue, waiting for room, and start the chain
+static void LcdPush(uint8_t line, uint8_t column, const uint8_t *pData, uint8_t size)
+{
+    uint32_t primask;
+
+    for (;;)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (LcdDataCount + size <= QUEUE_SIZE && LcdSpanCount < QUEUE_SPANS)
+            break;
+        LcdService();
+        __set_PRIMASK(primask);
+    }
+
+    // Free bytes are not read by the DMA
+    const uint16_t tail   = (LcdDataHead + LcdDataCount) % QUEUE_SIZE;
+    const uint16_t linear = QUEUE_SIZE - tail;
+
+    if (size <= linear)
+        memcpy(LcdQueueData + tail, pData, size);
+    else
+    {
+        memcpy(LcdQueueData + tail, pData, linear);
+        memcpy(LcdQueueData, pData + linear, size - linear);
+    }
+
+    LcdSpans[(LcdSpanHead + LcdSpanCount) % QUEUE_SPANS] = (LcdSpan_t){ line, column, size };
+    LcdSpanCount++;
+    LcdDataCount += size;
+
+    if (!LcdBusy)
+    {
+        LcdBusy = true;
+        LcdChainStart = true;
+        CS_Assert();
+        LcdNext();
+    }
+
+    __set_PRIMASK(primask);
+}
+
+// Queue the groups of a whole page whose CRC differs from the display's,
+// adjacent ones as one span
+static void LcdQueuePage(uint8_t line, const uint8_t *pData)
+{
+    unsigned first = GROUPS;
+
+    for (unsigned group = 0; group <= GROUPS; group++)
+    {
+        bool dirty = false;
+
+        if (group < GROUPS)
+        {
+            const uint16_t crc = GroupCrc(pData + group * GROUP_SIZE);
+
+            dirty = !(LcdGroupValid[line] & (1u << group)) || LcdGroupCrc[line][group] != crc;
+            LcdGroupCrc[line][group] = crc;
+            LcdGroupValid[line] |= 1u << group;
+        }
+
+        if (dirty && first == GROUPS)
+            first = group;
+        else if (!dirty && first != GROUPS)
+        {
+            LcdPush(line, first * GROUP_SIZE, pData + first * GROUP_SIZE, (group - first) * GROUP_SIZE);
+            first = GROUPS;
+        }
+    }
+}
+
 void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const uint8_t *pBitmap, const unsigned int Size)
 {
+    if (Line <= FRAME_LINES && pBitmap != NULL && Column + Size <= LCD_WIDTH)
+    {
+        // Sent as it is: the groups it touches no longer match their CRC
+        if (Size > 0)
+        {
+            LcdPush(Line, Column, pBitmap, Size);
+            for (unsigned group = Column / GROUP_SIZE; group <= (Column + Size - 1) / GROUP_SIZE; group++)
+                LcdGroupValid[Line] &= ~(1u << group);
+        }
+        return;
+    }
+
+    LcdWaitIdle();
+
     CS_Assert();
     DrawLine(Column, Line, pBitmap, Size);
     CS_Release();
+
+    if (Line <= FRAME_LINES)
+        LcdGroupValid[Line] = 0;
+}
+
+static void BlitPage(uint8_t line, const uint8_t *pBuffer)
+{
+    LcdQueuePage(line, pBuffer);
 }
 
 
@@ -135,25 +425,20 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
 
     static void ST7565_BlitScreen(uint8_t line)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);
-
         if(line == 0)
         {
-            DrawLine(0, 0, gStatusLine, LCD_WIDTH);
+            BlitPage(0, gStatusLine);
         }
         else if(line <= FRAME_LINES)
         {
-            DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
+            BlitPage(line, gFrameBuffer[line - 1]);
         }
         else
         {
             for (line = 1; line <= FRAME_LINES; line++) {
-                DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
+                BlitPage(line, gFrameBuffer[line - 1]);
             }
         }
-
-        CS_Release();
     }
 
     void ST7565_BlitFullScreen(void)
@@ -176,39 +461,34 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
 #else
     void ST7565_BlitFullScreen(void)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);
         for (unsigned line = 0; line < FRAME_LINES; line++) {
-            DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
+            BlitPage(line+1, gFrameBuffer[line]);
         }
-        CS_Release();
     }
 
     void ST7565_BlitLine(unsigned line)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);    // start line ?
-        DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
-        CS_Release();
+        BlitPage(line+1, gFrameBuffer[line]);
     }
 
     void ST7565_BlitStatusLine(void)
     {   // the top small text line on the display
-        CS_Assert();
-        ST7565_WriteByte(0x40);    // start line ?
-        DrawLine(0, 0, gStatusLine, LCD_WIDTH);
-        CS_Release();
+        BlitPage(0, gStatusLine);
     }
 #endif
 
 void ST7565_FillScreen(uint8_t value)
 {
+    LcdWaitIdle();
+
     CS_Assert();
     for (unsigned i = 0; i < 8; i++) {
         // TODO: This is wrong
         DrawLine(0, i, NULL, value);
     }
     CS_Release();
+
+    memset(LcdGroupValid, 0, sizeof(LcdGroupValid));
 }
 
 // Software reset
@@ -294,6 +574,8 @@ uint8_t cmds[] = {
     #if defined(ENABLE_FEAT_F4HWN_CTR) || defined(ENABLE_FEAT_F4HWN_INV)
     void ST7565_ContrastAndInv(void)
     {
+        LcdWaitIdle();
+
         CS_Assert();
         ST7565_WriteByte(ST7565_CMD_SOFTWARE_RESET);   // software reset
 
@@ -302,6 +584,8 @@ uint8_t cmds[] = {
             ST7565_Cmd(i);
         }
 
+        memset(LcdGroupValid, 0, sizeof(LcdGroupValid));
+
         // TODO: Release CS??
     }
     #endif
@@ -366,16 +650,22 @@ void ST7565_Init(void)
 #ifdef ENABLE_FEAT_F4HWN_SLEEP
     void ST7565_ShutDown(void)
     {
+        LcdWaitIdle();
+
         CS_Assert();
         ST7565_WriteByte(ST7565_CMD_POWER_CIRCUIT | 0b000);   // VB=0 VR=1 VF=1
         ST7565_WriteByte(ST7565_CMD_SET_START_LINE | 0);   // line 0
         ST7565_WriteByte(ST7565_CMD_DISPLAY_ON_OFF | 0);   // D=1
         CS_Release();
+
+        memset(LcdGroupValid, 0, sizeof(LcdGroupValid));
     }
 #endif
 
 void ST7565_FixInterfGlitch(void)
 {
+    LcdWaitIdle();
+
     CS_Assert();
     for(uint8_t i = 0; i < ARRAY_SIZE(cmds); i++)
 #ifdef ENABLE_FEAT_F4HWN
@@ -385,6 +675,9 @@ void ST7565_FixInterfGlitch(void)
 #endif
 
     CS_Release();
+
+    // RF can garble the display RAM as well: send every page again
+    memset(LcdGroupValid, 0, sizeof(LcdGroupValid));
 }
 
 void ST7565_HardwareReset(void)
@@ -25,11 +25,17 @@ void SYSTICK_Init(void)
 
     NVIC_SetPriority(SysTick_IRQn, 0);
 }
+// Period of the SysTick interrupt in 2 ms steps, from now on: called from
+// SysTick_Handler() right after a reload
+void SYSTICK_SetPeriod(uint8_t Steps)
+{
+    SysTick->LOAD = SystemCoreClock / 500 * Steps - 1;
+    SysTick->VAL  = 0;
+}
 void SYSTICK_DelayUs(uint32_t Delay)
 {
     const uint32_t ticks = Delay * gTickMultiplier;
     uint32_t elapsed_ticks = 0;
-    uint32_t Start = SysTick->LOAD;
     uint32_t Previous = SysTick->VAL;
     
     // FIX: Simplified loop - removed inner "wait for change" loop
@@ -46,8 +52,12 @@ void SYSTICK_DelayUs(uint32_t Delay)
         }
         else if (Current > Previous)
         {
-            // Wraparound case: SysTick went 0 → LOAD → Current
-            uint32_t Delta = Previous + (Start - Current);
+            // Wraparound case: SysTick went 0 → LOAD → Current. LOAD may
+            // have changed since the reload: never count less than Previous
+            uint32_t Reload = SysTick->LOAD;
+            if (Reload < Current)
+                Reload = Current;
+            uint32_t Delta = Previous + (Reload - Current);
             elapsed_ticks += Delta;
         }
         
@@ -21,6 +21,7 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_DelayUs(uint32_t Delay);
+void SYSTICK_SetPeriod(uint8_t Steps);
 
 #endif
 
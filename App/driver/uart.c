@@ -22,6 +22,7 @@
 #include "py32f071_ll_dma.h"
 #include "py32f071_ll_gpio.h"
 #include "py32f071_ll_usart.h"
+#include "driver/uart.h"
 
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
 #include "driver/keyboard.h"
@@ -30,11 +31,22 @@
 #define USARTx USART1
 #define DMA_CHANNEL LL_DMA_CHANNEL_2
 
-// CRITICAL FIX: Define UART TX timeout
-// If UART TX buffer doesn't clear within this many iterations, skip byte and continue
-// Prevents permanent freeze if UART is stuck
+// Transmit ring, drained a byte at a time from the TXE interrupt (every
+// DMA channel is taken: 1/6 display, 2 UART RX, 3 voice, 4/5 flash, 7
+// backlight). At 38400 baud a byte takes 260 us on the line; the interrupt
+// costs about 1 us of it.
+#define UART_TX_SIZE 512u
+
+// A USART that is stuck or unclocked never sets TXE or TC. The waits give
+// up after this many polls without a byte moving on (several ms, a healthy
+// line takes a byte every 260 us) and drop what is queued: it could not
+// have gone out anyway, and the main loop keeps running.
 #define UART_TX_TIMEOUT_ITERATIONS 10000
 
+static uint8_t           TxRing[UART_TX_SIZE];
+static volatile uint16_t TxHead;    // free-running, written by the main loop
+static volatile uint16_t TxTail;    // free-running, advanced by the interrupt
+
 static bool UART_IsLogEnabled;
 uint8_t UART_DMA_Buffer[256];
 
@@ -107,40 +119,133 @@ void UART_Init(void)
 
     } while (0);
 
+    TxHead = 0;
+    TxTail = 0;
+
+    NVIC_SetPriority(USART1_IRQn, 3);
+    NVIC_EnableIRQ(USART1_IRQn);
+
     LL_DMA_EnableChannel(DMA1, DMA_CHANNEL);
     LL_USART_Enable(USARTx);
     LL_USART_TransmitData8(USARTx, 0);
 }
 
+static void TxService(void)
+{
+    if (!LL_USART_IsEnabledIT_TXE(USARTx) || !LL_USART_IsActiveFlag_TXE(USARTx))
+        return;
+
+    if (TxTail != TxHead)
+    {
+        LL_USART_TransmitData8(USARTx, TxRing[TxTail % UART_TX_SIZE]);
+        TxTail++;
+    }
+    else
+        LL_USART_DisableIT_TXE(USARTx);
+}
+
+void USART1_IRQHandler(void)
+{
+    TxService();
+}
+
+// Wait for the interrupt to make progress. Works with interrupts off as
+// well (UART commands from the lock screen): the ring is then drained from
+// here.
+static void TxWait(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    TxService();
+    __set_PRIMASK(primask);
+}
+
+// Empty the ring with the interrupt off, as if it had all been sent
+static void TxDrop(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    LL_USART_DisableIT_TXE(USARTx);
+    TxTail = TxHead;
+    __set_PRIMASK(primask);
+}
+
+uint32_t UART_TxFree(void)
+{
+    return UART_TX_SIZE - (uint16_t)(TxHead - TxTail);
+}
+
+uint32_t UART_TrySend(const void *pBuffer, uint32_t Size)
+{
+    const uint8_t *pData = (const uint8_t *)pBuffer;
+    const uint32_t free = UART_TxFree();
+    uint16_t head = TxHead;
+
+    if (Size > free)
+        Size = free;
+
+    for (uint32_t i = 0; i < Size; i++)
+        TxRing[head++ % UART_TX_SIZE] = pData[i];
+
+    TxHead = head;
+
+    if (Size)
+        LL_USART_EnableIT_TXE(USARTx);
+
+    return Size;
+}
+
 void UART_Send(const void *pBuffer, uint32_t Size)
 {
     const uint8_t *pData = (const uint8_t *)pBuffer;
-    uint32_t i;
+    uint32_t timeout = UART_TX_TIMEOUT_ITERATIONS;
 
-    for (i = 0; i < Size; i++)
+    for (;;)
     {
-        // CRITICAL FIX: Add timeout to UART TX busy-wait
-        // Original: while (!LL_USART_IsActiveFlag_TXE(USARTx)) ;
-        // Problem: If UART TX stuck or disconnected, this is infinite loop
-        // Result: Radio freeze for 100ms+ while trying to send one character
-        //
-        // Solution: Add iteration counter timeout
-        // If TXE flag doesn't set within timeout iterations, skip byte and continue
-        // This caps maximum freeze at ~10ms per UART_Send() call
-        
-        uint32_t timeout = UART_TX_TIMEOUT_ITERATIONS;
-        while (!LL_USART_IsActiveFlag_TXE(USARTx) && timeout > 0)
+        const uint32_t sent = UART_TrySend(pData, Size);
+
+        pData += sent;
+        Size  -= sent;
+        if (Size == 0)
+            break;
+
+        if (sent)
+            timeout = UART_TX_TIMEOUT_ITERATIONS;
+        else if (--timeout == 0)
+        {   // stuck: make room, the rest of the data goes into the ring
+            TxDrop();
+            timeout = UART_TX_TIMEOUT_ITERATIONS;
+            continue;
+        }
+
+        TxWait();
+    }
+}
+
+void UART_Flush(void)
+{
+    uint32_t timeout = UART_TX_TIMEOUT_ITERATIONS;
+    uint16_t tail    = TxTail;
+
+    while (TxTail != TxHead)
+    {
+        TxWait();
+
+        if (TxTail != tail)
         {
-            timeout--;
+            tail    = TxTail;
+            timeout = UART_TX_TIMEOUT_ITERATIONS;
         }
-        
-        // Send byte only if TXE flag is set
-        // If timeout occurred, skip this byte and continue
-        if (timeout > 0)
+        else if (--timeout == 0)
         {
-            LL_USART_TransmitData8(USARTx, pData[i]);
+            TxDrop();
+            return;
         }
     }
+
+    timeout = UART_TX_TIMEOUT_ITERATIONS;
+    while (!LL_USART_IsActiveFlag_TC(USARTx) && timeout > 0)
+        timeout--;
 }
 
 void UART_LogSend(const void *pBuffer, uint32_t Size)
@@ -24,7 +24,15 @@
 extern uint8_t UART_DMA_Buffer[256];
 
 void UART_Init(void);
+
+// Queue for sending, waiting for room in the transmit ring if it is full
 void UART_Send(const void *pBuffer, uint32_t Size);
+// Queue as much as fits without waiting; returns the number of bytes queued
+uint32_t UART_TrySend(const void *pBuffer, uint32_t Size);
+// Room left in the transmit ring
+uint32_t UART_TxFree(void);
+// Wait until everything queued is out on the line
+void UART_Flush(void);
 void UART_LogSend(const void *pBuffer, uint32_t Size);
 
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
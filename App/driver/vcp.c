@@ -47,10 +47,11 @@ bool VCP_K5ViewerPing(void)
 {
     // State machine for parsing incoming packets:
     //   Keepalive:       0x55 0xAA 0x00 0x00    → viewer alive, no extensions
-    //   Feature keepalive (ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER builds only):
+    //   Feature keepalive:
     //                    0x55 0xAA 0x05 <flags> → viewer alive, extensions enabled
-    //                    flags bit 0 = RF log stream
-    //                    flags bit 1 = paged RF log history
+    //                    flags bit 0 = RF log stream (RXTX_LOG_K5VIEWER builds)
+    //                    flags bit 1 = paged RF log history (idem)
+    //                    flags bit 2 = packed screen frames (type 0x07)
     //                    flags bit 7 = restart RF log synchronization
     //   Short key press: 0xAA 0x55 0x03 <key>   → inject short press
     //   Long key press:  0xAA 0x55 0x04 <key>   → inject long press
@@ -28,6 +28,7 @@
 #endif
 #include "driver/bk4819.h"
 #include "driver/gpio.h"
+#include "driver/py25q16.h"
 #include "driver/system.h"
 #include "driver/st7565.h"
 #include "frequencies.h"
@@ -121,9 +122,9 @@ void FUNCTION_Foreground(const FUNCTION_Type_t PreviousFunction)
 
 void FUNCTION_PowerSave() {
     #ifdef ENABLE_FEAT_F4HWN_SLEEP
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * (gWakeUp ? 200 : 10); // deep sleep now indexed on BatSav
+        TIMER_Start(&gPowerSaveTimer, gEeprom.BATTERY_SAVE * (gWakeUp ? 200 : 10)); // deep sleep now indexed on BatSav
     #else
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
+        TIMER_Start(&gPowerSaveTimer, gEeprom.BATTERY_SAVE * 10);
     #endif
     gPowerSaveCountdownExpired = false;
 
@@ -136,6 +137,9 @@ void FUNCTION_PowerSave() {
 
     BK4819_ToggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, false);
 
+    // Pending writes, before the radio may be switched off
+    PY25Q16_Flush();
+
     gUpdateStatus = true;
 
     if (gScreenToDisplay != DISPLAY_MENU)     // 1of11 .. don't close the menu
@@ -242,6 +246,11 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
     const FUNCTION_Type_t PreviousFunction = gCurrentFunction;
     const bool bWasPowerSave = PreviousFunction == FUNCTION_POWER_SAVE;
 
+    // The end of a beep turns the receiver back on, before the new function
+    // sets the BK4819 up rather than after
+    if (Function != FUNCTION_FOREGROUND)
+        AUDIO_StopBeep();
+
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG
     const bool previousWasActive =
         PreviousFunction == FUNCTION_TRANSMIT ||
@@ -315,7 +324,7 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
         gMonitor = true;
     }
 
-    gBatterySaveCountdown_10ms = battery_save_count_10ms;
+    TIMER_Start(&gBatterySaveTimer, battery_save_count_10ms);
     gSchedulePowerSave         = false;
 
 #if defined(ENABLE_FMRADIO)
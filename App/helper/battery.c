@@ -48,7 +48,12 @@ typedef enum {
 uint16_t          lowBatteryCountdown;
 const uint16_t    lowBatteryPeriod = 30;
 
-volatile uint16_t gPowerSave_10ms;
+static void PowerSaveExpired(void)
+{
+    gPowerSaveCountdownExpired = true;
+}
+
+TIMER_t           gPowerSaveTimer = TIMER_INIT(PowerSaveExpired, TIMER_GATE_POWER_SAVE);
 
 const uint16_t Voltage2PercentageTable[][7][2] = {
     [BATTERY_TYPE_1600_MAH] = {
@@ -258,6 +263,9 @@ void BATTERY_TimeSlice500ms(void)
     AUDIO_PlaySingleVoice(true);
 #endif
 
+    // The warning played out before the radio shuts down
+    AUDIO_Wait();
+
     gReducedService = true;
 
     FUNCTION_Select(FUNCTION_POWER_SAVE);
@@ -14,6 +14,8 @@
  *     limitations under the License.
  */
 
+#include <string.h>
+
 #include "debugging.h"
 #include "driver/st7565.h"
 #include "k5viewer.h"
@@ -34,11 +36,15 @@
 //   within at most 128 frames.
 // Stack optimization: chunks are computed on demand straight from
 // gStatusLine/gFrameBuffer instead of building the whole 1024-byte
-// frame on the stack. Changed chunks are tracked in a 16-byte bitmap.
-// Peak stack drops from ~1.3 KB to ~40 bytes, at the cost of
+// frame on the stack. Changed chunks are tracked in 16-byte bitmaps.
+// Peak stack drops from ~1.3 KB to ~150 bytes, at the cost of
 // transforming each transmitted chunk twice (negligible next to the
-// blocking UART transfer).
+// UART transfer).
 static uint16_t previousHash[128];
+// Chunks to send whatever their fingerprint: a forced frame that did not
+// fit in the UART transmit ring goes out over the next updates
+static uint8_t staleBitmap[16];
+static bool framePending = false;
 static uint8_t previousStateFlags = 0xFF;
 static uint8_t forcedBlock = 0;
 static uint8_t keepAlive = 3;
@@ -89,6 +95,16 @@ static void K5VIEWER_Send(const uint8_t *buf, uint16_t len)
     }
 }
 
+// Bytes that can be sent without waiting
+static uint16_t K5VIEWER_Room(void)
+{
+    if (gUSB_K5ViewerEnabled)
+        return 0xFFFF;
+
+    const uint32_t room = UART_TxFree();
+    return room > 0xFFFF ? 0xFFFF : room;
+}
+
 enum {
     K5VIEWER_CHUNK_SIZE = 8,
     K5VIEWER_CHUNKS_PER_LINE = 16,
@@ -97,11 +113,44 @@ enum {
     K5VIEWER_TYPE_DIFF = 0x02,
     K5VIEWER_TYPE_RXTX_LOG = 0x05,
     K5VIEWER_TYPE_RXTX_LOG_HISTORY = 0x06,
+    K5VIEWER_TYPE_PACKED = 0x07,
     K5VIEWER_FLAG_DEEP_SLEEP = 1 << 0,
     K5VIEWER_FLAG_LED_RED = 1 << 1,
     K5VIEWER_FLAG_LED_GREEN = 1 << 2,
+    K5VIEWER_RESUME_ROOM = 7 + 16 * 9,
+    K5VIEWER_OP_SKIP = 0x00,
+    K5VIEWER_OP_LITERAL = 0x40,
+    K5VIEWER_OP_SHIFT = 0x80,
+    K5VIEWER_OP_RECALL = 0xC0,
+    K5VIEWER_RUN_MAX = 64,
+    K5VIEWER_HISTORY = 8,
+    K5VIEWER_SHIFT_ROWS = 16,
+    K5VIEWER_SHIFT_MIN = 4,
 };
 
+// Packed frames (type 0x07, sent once the viewer announces
+// SERIAL_VIEWER_FEATURE_PACKED in its feature keepalive), same framing as
+// the diff frames: F0|flags, AA 55 07 <length>, payload, 0A.
+//
+// The payload starts with a signed chunk offset S, then ops walk the 128
+// chunks in index order, or from the last one down when S < 0:
+//   0x00 + n   skip n + 1 chunks, they stay as they are
+//   0x40 + n   n + 1 packed chunks follow
+//   0x80 + n   n + 1 chunks take the chunk S further on the viewer's
+//              screen, not reached by the walk yet: a scroll of S / 2
+//              pixel rows, chunk = 2 * row + half
+//   0xC0 + h   first op only: start from the screen the viewer was left
+//              with by the packed frame h + 1 frames ago
+// Trailing skips are left out. A packed chunk is a mask byte, bit k set
+// when byte k repeats byte k - 1 (byte -1 being 0x00), followed by the
+// bytes that do not repeat.
+//
+// The shifts and recalls are matched on the fingerprints like the skips:
+// the screens the viewer was left with are kept as signatures only,
+// newest first, 0 when the frame did not carry all the changes.
+static uint32_t historySignature[K5VIEWER_HISTORY];
+static bool packedFrames = false;
+
 static uint8_t K5VIEWER_StateFlags(void)
 {
     uint8_t flags = 0;
@@ -189,6 +238,10 @@ bool K5VIEWER_HasPendingStateChange(void)
         return true;
 #endif
 
+    // The rest of a frame goes out once there is room for a good part of it
+    if (framePending && K5VIEWER_Room() >= K5VIEWER_RESUME_ROOM)
+        return true;
+
     return !wasConnected || K5VIEWER_StateFlags() != previousStateFlags;
 }
 
@@ -213,19 +266,267 @@ static void K5VIEWER_Chunk(uint8_t chunkIdx, uint8_t *dest)
     }
 }
 
+// Packed chunk: mask byte and the bytes that do not repeat, returns the size
+static uint8_t K5VIEWER_Pack(const uint8_t *data, uint8_t *dest)
+{
+    uint8_t mask = 0;
+    uint8_t len = 1;
+    uint8_t prev = 0;
+
+    for (uint8_t k = 0; k < K5VIEWER_CHUNK_SIZE; k++) {
+        if (data[k] == prev)
+            mask |= 1 << k;
+        else
+            dest[len++] = data[k];
+        prev = data[k];
+    }
+    dest[0] = mask;
+    return len;
+}
+
+static uint8_t K5VIEWER_Walk(int8_t shift, uint8_t i)
+{
+    return shift < 0 ? 127 - i : i;
+}
+
+// What goes out in the next frame
+typedef struct {
+    uint8_t sent[16];       // 1 bit per chunk
+    uint8_t shifted[16];    // sent chunks taken from chunk + shift
+    uint16_t length;        // payload bytes
+    uint8_t count;          // chunks sent
+    bool pending;           // changed chunks left for the next updates
+} K5VIEWER_Plan_t;
+
+// Side results of the first pass over the screen
+typedef struct {
+    uint8_t shiftMatches[2 * K5VIEWER_SHIFT_ROWS];
+    uint32_t signature;
+    uint8_t forcedSize;
+} K5VIEWER_Scan_t;
+
+static uint8_t K5VIEWER_Op(const K5VIEWER_Plan_t *plan, uint8_t chunkIdx)
+{
+    const uint8_t mask = 1 << (chunkIdx & 7);
+
+    if (!(plan->sent[chunkIdx >> 3] & mask))
+        return K5VIEWER_OP_SKIP;
+    return (plan->shifted[chunkIdx >> 3] & mask) ? K5VIEWER_OP_SHIFT : K5VIEWER_OP_LITERAL;
+}
+
+// Pick the chunks of the next frame within budget payload bytes. The
+// sizes are exact: the frame is sent as planned, the display buffers do
+// not change in between (both run from the main loop).
+static void K5VIEWER_PlanFrame(K5VIEWER_Plan_t *plan, K5VIEWER_Scan_t *scan,
+                               bool force, int8_t shift, uint16_t budget)
+{
+    uint8_t chunk[K5VIEWER_CHUNK_SIZE];
+    uint8_t packed[K5VIEWER_CHUNK_SIZE + 1];
+    uint8_t runOp = 0xFF;
+    uint8_t runLength = 0;
+    uint8_t skipped = 0;
+
+    memset(plan, 0, sizeof(*plan));
+    plan->length = packedFrames ? 1 : 0;
+
+    if (scan) {
+        memset(scan, 0, sizeof(*scan));
+        scan->signature = 2166136261u;
+    }
+
+    for (uint8_t i = 0; i < 128; i++) {
+        const uint8_t chunkIdx = K5VIEWER_Walk(shift, i);
+        const uint8_t mask = 1 << (chunkIdx & 7);
+
+        if (force)
+            staleBitmap[chunkIdx >> 3] |= mask;
+
+        K5VIEWER_Chunk(chunkIdx, chunk);
+
+        const uint16_t hash = K5VIEWER_Hash(chunk);
+        const bool changed = hash != previousHash[chunkIdx];
+        const bool isForced = (chunkIdx == forcedBlock);
+        const bool stale = (staleBitmap[chunkIdx >> 3] & mask) != 0;
+
+        if (scan) {
+            scan->signature = (scan->signature ^ hash) * 16777619u;
+
+            // Vertical scrolls: the rows this chunk was found at
+            if (packedFrames && changed && !stale) {
+                for (uint8_t r = 1; r <= K5VIEWER_SHIFT_ROWS; r++) {
+                    if (chunkIdx + 2 * r < 128 && previousHash[chunkIdx + 2 * r] == hash)
+                        scan->shiftMatches[r - 1]++;
+                    if (chunkIdx >= 2 * r && previousHash[chunkIdx - 2 * r] == hash)
+                        scan->shiftMatches[K5VIEWER_SHIFT_ROWS + r - 1]++;
+                }
+            }
+        }
+
+        if (!changed && !isForced && !stale) {
+            skipped++;
+            continue;
+        }
+
+        uint8_t op = K5VIEWER_OP_LITERAL;
+        uint16_t cost = K5VIEWER_CHUNK_SIZE + 1;
+        bool newRun = false;
+
+        if (packedFrames) {
+            const int16_t source = chunkIdx + shift;
+
+            if (shift != 0 && !isForced && !stale && source >= 0 && source < 128 &&
+                previousHash[source] == hash &&
+                !(staleBitmap[source >> 3] & (1 << (source & 7)))) {
+                op = K5VIEWER_OP_SHIFT;
+                cost = 0;
+            } else {
+                cost = K5VIEWER_Pack(chunk, packed);
+                if (isForced && scan)
+                    scan->forcedSize = cost;
+            }
+
+            newRun = skipped != 0 || op != runOp || runLength == K5VIEWER_RUN_MAX;
+            cost += (skipped + K5VIEWER_RUN_MAX - 1) / K5VIEWER_RUN_MAX + newRun;
+        }
+
+        if (plan->length + cost > budget) {
+            plan->pending = true;
+            skipped++;
+            continue;
+        }
+
+        if (newRun) {
+            runOp = op;
+            runLength = 0;
+        }
+        runLength++;
+        skipped = 0;
+
+        plan->sent[chunkIdx >> 3] |= mask;
+        if (op == K5VIEWER_OP_SHIFT)
+            plan->shifted[chunkIdx >> 3] |= mask;
+        plan->length += cost;
+        plan->count++;
+    }
+
+    if (scan && scan->signature == 0)
+        scan->signature = 1;
+}
+
+// Packed frames: a scroll or an earlier screen that makes this one cheaper.
+// Returns the shift, *pRecall is the history entry to start from or -1.
+static int8_t K5VIEWER_PlanPacked(K5VIEWER_Plan_t *plan, const K5VIEWER_Scan_t *scan,
+                                  uint16_t budget, int8_t *pRecall)
+{
+    int8_t shift = 0;
+    uint8_t best = K5VIEWER_SHIFT_MIN - 1;
+
+    *pRecall = -1;
+
+    for (uint8_t r = 0; r < 2 * K5VIEWER_SHIFT_ROWS; r++) {
+        if (scan->shiftMatches[r] > best) {
+            best = scan->shiftMatches[r];
+            shift = (r < K5VIEWER_SHIFT_ROWS) ? 2 * (r + 1) : -2 * (r - K5VIEWER_SHIFT_ROWS + 1);
+        }
+    }
+
+    if (shift != 0) {
+        K5VIEWER_Plan_t shifted;
+
+        K5VIEWER_PlanFrame(&shifted, NULL, false, shift, budget);
+        if (shifted.count > plan->count ||
+            (shifted.count == plan->count && shifted.length < plan->length))
+            *plan = shifted;
+        else
+            shift = 0;
+    }
+
+    // Shift byte, recall, skips up to the forced chunk and the forced chunk
+    const uint16_t recallLength = 2 + (forcedBlock + K5VIEWER_RUN_MAX - 1) / K5VIEWER_RUN_MAX
+                                  + 1 + scan->forcedSize;
+
+    if (scan->forcedSize == 0 || recallLength > budget ||
+        (!plan->pending && recallLength >= plan->length))
+        return shift;
+
+    for (uint8_t h = 1; h < K5VIEWER_HISTORY; h++) {
+        if (historySignature[h] == scan->signature) {
+            memset(plan, 0, sizeof(*plan));
+            plan->sent[forcedBlock >> 3] = 1 << (forcedBlock & 7);
+            plan->length = recallLength;
+            plan->count = 1;
+            *pRecall = h;
+            return 0;
+        }
+    }
+
+    return shift;
+}
+
+static void K5VIEWER_SendPacked(const K5VIEWER_Plan_t *plan, int8_t shift, int8_t recall)
+{
+    uint8_t chunk[K5VIEWER_CHUNK_SIZE];
+    uint8_t packed[K5VIEWER_CHUNK_SIZE + 1];
+    uint8_t left = plan->count;
+
+    K5VIEWER_Send((const uint8_t *)&shift, 1);
+
+    if (recall >= 0) {
+        const uint8_t op = K5VIEWER_OP_RECALL | recall;
+
+        K5VIEWER_Send(&op, 1);
+
+        // The viewer shows that screen again: same fingerprints as now
+        for (uint8_t chunkIdx = 0; chunkIdx < 128; chunkIdx++) {
+            K5VIEWER_Chunk(chunkIdx, chunk);
+            previousHash[chunkIdx] = K5VIEWER_Hash(chunk);
+        }
+        memset(staleBitmap, 0, sizeof(staleBitmap));
+    }
+
+    for (uint8_t i = 0; i < 128 && left > 0; ) {
+        const uint8_t op = K5VIEWER_Op(plan, K5VIEWER_Walk(shift, i));
+        uint8_t run = 1;
+
+        while (i + run < 128 && run < K5VIEWER_RUN_MAX &&
+               K5VIEWER_Op(plan, K5VIEWER_Walk(shift, i + run)) == op)
+            run++;
+
+        const uint8_t code = op | (run - 1);
+        K5VIEWER_Send(&code, 1);
+
+        for (; run > 0; run--, i++) {
+            if (op == K5VIEWER_OP_SKIP)
+                continue;
+
+            const uint8_t chunkIdx = K5VIEWER_Walk(shift, i);
+
+            K5VIEWER_Chunk(chunkIdx, chunk);
+            if (op == K5VIEWER_OP_LITERAL)
+                K5VIEWER_Send(packed, K5VIEWER_Pack(chunk, packed));
+
+            staleBitmap[chunkIdx >> 3] &= ~(1 << (chunkIdx & 7));
+            previousHash[chunkIdx] = K5VIEWER_Hash(chunk);
+            left--;
+        }
+    }
+}
+
 void K5VIEWER_Update(bool force)
 {
     if (K5VIEWER_IsLocked())
         return;
 
     if (keepAlive > 0) {
-        if (--keepAlive == 0) {
+        // Carrying on with a frame that did not fit does not count
+        if (!framePending && --keepAlive == 0) {
             // Connection just lost → reset state for next reconnection
             wasConnected = false;
             hasConnectionPing = false;
             previousStateFlags = 0xFF;
-#ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
             gSerialViewerFeatures = 0;
+            packedFrames = false;
+#ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
             rfLogSent = false;
             rfLogHistoryBefore = RXTX_LOG_K5VIEWER_HISTORY_START;
 #endif
@@ -240,6 +541,16 @@ void K5VIEWER_Update(bool force)
         force = true;
     }
 
+    // The viewer switched frame types: start it from a full frame
+    const bool packed = (gSerialViewerFeatures & SERIAL_VIEWER_FEATURE_PACKED) != 0;
+    if (packed != packedFrames) {
+        packedFrames = packed;
+        force = true;
+    }
+
+    if (force)
+        memset(historySignature, 0, sizeof(historySignature));
+
     const uint8_t stateFlags = K5VIEWER_StateFlags();
     const bool stateChanged = (stateFlags != previousStateFlags);
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
@@ -251,37 +562,34 @@ void K5VIEWER_Update(bool force)
 #endif
 
     // ==== FIRST PASS: Count changed chunks ====
-    uint16_t deltaLen = 0;
-    uint8_t changedBitmap[16] = {0};  // 1 bit per chunk
-    uint8_t chunk[9];                 // [0] = index, [1..8] = payload
-
-    for (uint8_t chunkIdx = 0; chunkIdx < 128; chunkIdx++) {
-        K5VIEWER_Chunk(chunkIdx, &chunk[1]);
-
-        bool changed = K5VIEWER_Hash(&chunk[1]) != previousHash[chunkIdx];
-        bool isForced = (chunkIdx == forcedBlock);
-
-        if (changed || isForced || force) {
-            changedBitmap[chunkIdx >> 3] |= 1 << (chunkIdx & 7);
-            deltaLen += 9;
-        }
-    }
-
+    // The frame is queued without waiting: it carries as many chunks as the
+    // transmit ring has room for next to the marker, header and end byte,
+    // the others stay changed for the next update.
+    const uint16_t room = K5VIEWER_Room();
+    const uint16_t budget = room > 7 ? room - 7 : 0;
+    K5VIEWER_Plan_t plan;
+    K5VIEWER_Scan_t scan;
+    int8_t shift = 0;
+    int8_t recall = -1;
+
+    K5VIEWER_PlanFrame(&plan, &scan, force, 0, budget);
+    if (packedFrames && !force)
+        shift = K5VIEWER_PlanPacked(&plan, &scan, budget, &recall);
+
+    framePending = plan.pending;
     forcedBlock = (forcedBlock + 1) % 128;
 
-    if (deltaLen == 0 && !stateChanged && !rfLogPending && !rfLogHistoryPending)
+    if (plan.count == 0 && !stateChanged && !rfLogPending && !rfLogHistoryPending)
         return;
 
-    // Skip transmission if a key is currently pressed
-    // UART_Send is blocking - would freeze the main loop and lose keypresses
-    if (gKeyReading0 != KEY_INVALID)
+    if (room < 7)
         return;
 
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
     // A pending RF log packet may be the only thing to send: skip the
     // frame section when it carries nothing. Without the RF log stream
     // the early return above already guarantees this condition.
-    if (deltaLen != 0 || stateChanged)
+    if (plan.count != 0 || stateChanged)
 #endif
     {
         // ==== Send version marker and state flags ====
@@ -291,28 +599,37 @@ void K5VIEWER_Update(bool force)
 
         // ==== Send header ====
         uint8_t header[5] = {
-            0xAA, 0x55, K5VIEWER_TYPE_DIFF,
-            (uint8_t)(deltaLen >> 8),
-            (uint8_t)(deltaLen & 0xFF)
+            0xAA, 0x55, packedFrames ? K5VIEWER_TYPE_PACKED : K5VIEWER_TYPE_DIFF,
+            (uint8_t)(plan.length >> 8),
+            (uint8_t)(plan.length & 0xFF)
         };
 
         K5VIEWER_Send(header, 5);
 
         // ==== SECOND PASS: Send only changed chunks ====
-        for (uint8_t chunkIdx = 0; chunkIdx < 128; chunkIdx++) {
-            if (!(changedBitmap[chunkIdx >> 3] & (1 << (chunkIdx & 7))))
-                continue;
+        if (packedFrames) {
+            K5VIEWER_SendPacked(&plan, shift, recall);
+
+            memmove(&historySignature[1], &historySignature[0],
+                    sizeof(historySignature) - sizeof(historySignature[0]));
+            historySignature[0] = plan.pending ? 0 : scan.signature;
+        } else {
+            uint8_t chunk[9];   // [0] = index, [1..8] = payload
 
-            chunk[0] = chunkIdx;
-            K5VIEWER_Chunk(chunkIdx, &chunk[1]);
+            for (uint8_t chunkIdx = 0; chunkIdx < 128; chunkIdx++) {
+                if (K5VIEWER_Op(&plan, chunkIdx) == K5VIEWER_OP_SKIP)
+                    continue;
 
-            K5VIEWER_Send(chunk, 9);
+                chunk[0] = chunkIdx;
+                K5VIEWER_Chunk(chunkIdx, &chunk[1]);
 
-            // Update the fingerprint only once the chunk is actually sent,
-            // so chunks skipped by an early return stay marked as changed.
-            // Hashing the recomputed payload also keeps the fingerprint in
-            // sync if the display buffer changed between the two passes.
-            previousHash[chunkIdx] = K5VIEWER_Hash(&chunk[1]);
+                K5VIEWER_Send(chunk, 9);
+                staleBitmap[chunkIdx >> 3] &= ~(1 << (chunkIdx & 7));
+
+                // Update the fingerprint only once the chunk is actually sent,
+                // so chunks skipped by an early return stay marked as changed.
+                previousHash[chunkIdx] = K5VIEWER_Hash(&chunk[1]);
+            }
         }
 
         uint8_t end = 0x0A;
@@ -320,10 +637,15 @@ void K5VIEWER_Update(bool force)
     }
 
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG_K5VIEWER
-    if (rfLogPending)
-        K5VIEWER_SendRfLog();
-    if (rfLogHistoryPending)
-        K5VIEWER_SendRfLogHistory();
+    // The RF log packets are larger than the transmit ring and wait for
+    // room while they stream: not while a key is pressed, it would freeze
+    // the main loop and lose keypresses
+    if (gKeyReading0 == KEY_INVALID) {
+        if (rfLogPending)
+            K5VIEWER_SendRfLog();
+        if (rfLogHistoryPending)
+            K5VIEWER_SendRfLogHistory();
+    }
 #endif
 
     previousStateFlags = stateFlags;
@@ -83,6 +83,8 @@ void Main(void)
 
     boot_counter_10ms = 250;   // 2.5 sec
 
+    TIMER_Start(&gBatterySaveTimer, battery_save_count_10ms);
+
 #ifdef ENABLE_UART
     UART_Init();
     UART_Send(UART_Version, strlen(UART_Version));
@@ -102,6 +104,10 @@ void Main(void)
 
     SETTINGS_InitEEPROM();
 
+#ifdef ENABLE_DTMF_CALLING
+    DTMF_LoadContacts();
+#endif
+
 #ifdef ENABLE_FEAT_F4HWN_RXTX_LOG
     RXTX_LOG_Init();
 #endif
@@ -320,6 +326,10 @@ void Main(void)
     while (true) {
         APP_Update();
 
+        if (gNextTimeslice2ms) {
+            APP_TimeSlice2ms();
+        }
+
         if (gNextTimeslice) {
 
             APP_TimeSlice10ms();
@@ -178,22 +178,27 @@ uint16_t          gEEPROM_RSSI_CALIB[7][4];
 uint16_t          gEEPROM_1F8A;
 uint16_t          gEEPROM_1F8C;
 
-// 
-// Cache-Based Architecture: channel attributes moved to Flash
-// Cache holds only active channels in RAM (instead of all!)
-//
-
-MR_ChannelCache_t gMR_ChannelAttributes_Cache[MR_CHANNELS_CACHE_SIZE] = {0};
 ChannelAttributes_t gMR_ChannelAttributes_Current = {0};
 
-volatile uint16_t gBatterySaveCountdown_10ms = battery_save_count_10ms;
+static void BatterySaveExpired(void)
+{
+    gSchedulePowerSave = true;
+}
+
+// Started at boot, see main()
+TIMER_t           gBatterySaveTimer = TIMER_INIT(BatterySaveExpired, TIMER_GATE_FOREGROUND);
 
 volatile bool     gPowerSaveCountdownExpired;
 volatile bool     gSchedulePowerSave;
 
 volatile bool     gScheduleDualWatch = true;
 
-volatile uint16_t gDualWatchCountdown_10ms;
+static void DualWatchExpired(void)
+{
+    gScheduleDualWatch = true;
+}
+
+TIMER_t           gDualWatchTimer = TIMER_INIT(DualWatchExpired, TIMER_GATE_DUAL_WATCH);
 bool              gDualWatchActive           = false;
 
 volatile uint8_t  gSerialConfigCountDown_500ms;
@@ -242,7 +247,12 @@ uint8_t           gBatteryVoltageIndex;
 bool              gCssBackgroundScan;
 
 volatile bool     gScheduleScanListen = true;
-volatile uint16_t gScanPauseDelayIn_10ms;
+static void ScanPauseExpired(void)
+{
+    gScheduleScanListen = true;
+}
+
+TIMER_t           gScanPauseTimer = TIMER_INIT(ScanPauseExpired, TIMER_GATE_SCAN);
 
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
     AlarmState_t  gAlarmState;
@@ -312,10 +322,13 @@ bool              gF_LOCK = false;
 uint8_t           gShowChPrefix;
 
 volatile bool     gNextTimeslice;
+volatile bool     gNextTimeslice2ms;
+volatile bool     gFastTick;
+volatile bool     gFastTickRunning;
 volatile uint8_t  gFoundCDCSSCountdown_10ms;
 volatile uint8_t  gFoundCTCSSCountdown_10ms;
 #ifdef ENABLE_VOX
-    volatile uint16_t gVoxStopCountdown_10ms;
+    TIMER_t           gVoxStopTimer = TIMER_INIT(NULL, TIMER_GATE_NONE);
 #endif
 volatile bool     gNextTimeslice40ms;
 #ifdef ENABLE_NOAA
@@ -377,81 +390,115 @@ unsigned long StrToUL(const char * str)
 }
 
 // 
-// Cache-Based Channel Attributes Implementation
+// Channel Attributes Implementation
 // 
 //
-// This replaces the huge array (~ 2,000 bytes in RAM) with a smart cache system
-// that keeps only active channels in RAM and loads others from Flash on demand.
-//
-// SRAM Savings: ~ 2,000 bytes (84% reduction!)
+// The attributes live in Flash only (2 bytes per channel at 0x8000), every
+// lookup reads them back into a small ring of decoded copies. What stays in
+// RAM is the scan list index, one bit per scan list and block of channels,
+// rebuilt from Flash for the blocks a write covers.
 // 
 
 // Flash address where channel attributes start
-// NOTE: Verify this matches your Flash layout!
-
 #define FLASH_CHANNEL_ATTR_BASE 0x8000
 
 // Each channel takes 2 bytes (ChannelAttributes_t is uint16_t)
 #define FLASH_CHANNEL_ATTR_SIZE 2
 
-// Cache hit/miss statistics (optional, for debugging)
+#define MR_ATTR_COUNT           (MR_CHANNELS_MAX + 7)
+#define MR_ATTR_EMPTY_BAND      0x7
 
-#ifdef ENABLE_FEAT_F4HWN_DEBUG
-    static uint32_t cache_hits = 0;
-    static uint32_t cache_misses = 0;
-#endif
+// Channels per Flash read when normalizing at boot
+#define MR_ATTR_LOAD_CHUNK      32
+
+// Scan list index, see MR_GetScanListBlocks()
+static uint32_t gMR_ScanListBlocks[MR_CHANNELS_LIST + 2];
+
+// Decoded copies handed out by MR_GetChannelAttributes()
+static ChannelAttributes_t gMR_AttrSlots[MR_CHANNELS_ATTR_SLOTS];
+static uint8_t gMR_AttrSlotNext;
 
 // 
 // Internal Helper Functions
 // 
 
-// Find cache entry for given channel
-// Returns index if found, -1 if not found
-
-static int MR_FindInCache(uint16_t channel_id)
+// Bring raw Flash attributes to a consistent value
+static ChannelAttributes_t MR_ValidateChannelAttributes(ChannelAttributes_t att)
 {
-    for (int i = 0; i < MR_CHANNELS_CACHE_SIZE; i++) {
-        if (gMR_ChannelAttributes_Cache[i].channel_id == channel_id) {
-            return i;
-        }
+    if (att.__val == 0xFFFF) {
+        // Never written: empty channel
+        att.__val = 0;
+        att.band = MR_ATTR_EMPTY_BAND;
+    }
+
+    if (att.scanlist > MR_CHANNELS_LIST + 1) {
+        att.scanlist = 0;
     }
-    return -1;
+
+    att.unused_1 = 0;
+    att.unused_2 = 0;
+
+    return att;
 }
 
-// Find oldest entry in cache (for eviction - LRU)
-static int MR_FindOldestCacheEntry(void)
+// Rebuild the scan list index bits of one block of memory channels
+static void MR_IndexChannelBlock(uint16_t block)
 {
-    int oldest_index = 0;
-    uint32_t oldest_time = gMR_ChannelAttributes_Cache[0].access_time;
-    
-    for (int i = 1; i < MR_CHANNELS_CACHE_SIZE; i++) {
-        if (gMR_ChannelAttributes_Cache[i].access_time < oldest_time) {
-            oldest_time = gMR_ChannelAttributes_Cache[i].access_time;
-            oldest_index = i;
+    const uint32_t bit = 1u << block;
+    ChannelAttributes_t buf[MR_CHANNELS_BLOCK];
+
+    PY25Q16_ReadBuffer(FLASH_CHANNEL_ATTR_BASE + (block * MR_CHANNELS_BLOCK * FLASH_CHANNEL_ATTR_SIZE),
+                       buf, sizeof(buf));
+
+    for (uint8_t i = 0; i < MR_CHANNELS_LIST + 2; i++) {
+        gMR_ScanListBlocks[i] &= ~bit;
+    }
+
+    for (uint8_t i = 0; i < MR_CHANNELS_BLOCK; i++) {
+        const ChannelAttributes_t att = MR_ValidateChannelAttributes(buf[i]);
+
+        if (att.band != MR_ATTR_EMPTY_BAND) {
+            gMR_ScanListBlocks[att.scanlist] |= bit;
         }
     }
-    
-    return oldest_index;
 }
 
-// Find empty cache slot
-// Returns index if found, -1 if cache is full
-static int MR_FindEmptyCacheSlot(void)
+static void MR_IndexChannels(uint16_t first, uint16_t count)
 {
-    for (int i = 0; i < MR_CHANNELS_CACHE_SIZE; i++) {
-        if (gMR_ChannelAttributes_Cache[i].channel_id == 0xFFFF) {
-            return i;
-        }
+    const uint16_t last = MIN((uint16_t)(first + count), (uint16_t)MR_CHANNELS_MAX);
+
+    for (uint16_t block = first / MR_CHANNELS_BLOCK; block * MR_CHANNELS_BLOCK < last; block++) {
+        MR_IndexChannelBlock(block);
     }
-    return -1;  // Cache is full, need to evict
 }
 
-// Get current time (for LRU eviction)
-static uint32_t GetCurrentTime(void)
+// Normalize the attributes in Flash: exclusions only last until power off.
+// Only the chunks that change are written back.
+static void MR_NormalizeChannelAttributes(void)
 {
-    // Using gBlinkCounter which increments continuously
-    extern uint32_t gBlinkCounter;
-    return gBlinkCounter;
+    ChannelAttributes_t buf[MR_ATTR_LOAD_CHUNK];
+
+    for (uint16_t first = 0; first < MR_ATTR_COUNT; first += MR_ATTR_LOAD_CHUNK) {
+        const uint16_t n = MIN((uint16_t)(MR_ATTR_COUNT - first), (uint16_t)MR_ATTR_LOAD_CHUNK);
+        const uint32_t flash_addr = FLASH_CHANNEL_ATTR_BASE + (first * FLASH_CHANNEL_ATTR_SIZE);
+        bool dirty = false;
+
+        PY25Q16_ReadBuffer(flash_addr, buf, n * FLASH_CHANNEL_ATTR_SIZE);
+
+        for (uint16_t i = 0; i < n; i++) {
+            ChannelAttributes_t att = MR_ValidateChannelAttributes(buf[i]);
+
+            att.exclude = 0;
+            if (att.__val != buf[i].__val) {
+                buf[i] = att;
+                dirty = true;
+            }
+        }
+
+        if (dirty) {
+            PY25Q16_WriteBuffer(flash_addr, buf, n * FLASH_CHANNEL_ATTR_SIZE, false);
+        }
+    }
 }
 
 // 
@@ -462,7 +509,7 @@ static uint32_t GetCurrentTime(void)
 void MR_LoadChannelAttributesFromFlash(uint16_t channel_id, ChannelAttributes_t* attributes)
 {
     // CRITICAL: Validate channel_id
-    if (channel_id >= (MR_CHANNELS_MAX + 7)) {
+    if (channel_id >= MR_ATTR_COUNT) {
         attributes->__val = 0;
         return;
     }
@@ -474,11 +521,11 @@ void MR_LoadChannelAttributesFromFlash(uint16_t channel_id, ChannelAttributes_t*
     PY25Q16_ReadBuffer(flash_addr, attributes, sizeof(ChannelAttributes_t));
 }
 
-// Save channel attributes to Flash
+// Save channel attributes to Flash and update the scan list index
 void MR_SaveChannelAttributesToFlash(uint16_t channel_id, const ChannelAttributes_t* attributes)
 {
     // CRITICAL: Validate channel_id
-    if (channel_id >= (MR_CHANNELS_MAX + 7)) {
+    if (channel_id >= MR_ATTR_COUNT) {
         return;
     }
     
@@ -487,165 +534,79 @@ void MR_SaveChannelAttributesToFlash(uint16_t channel_id, const ChannelAttribute
     
     // Write 2 bytes to Flash
     PY25Q16_WriteBuffer(flash_addr, attributes, sizeof(ChannelAttributes_t), false);
+
+    MR_IndexChannels(channel_id, 1);
 }
 
-// Get channel attributes (from cache or Flash)
+// Get channel attributes, read from Flash into the next slot
 // This is the main function used by the rest of the code
 ChannelAttributes_t* MR_GetChannelAttributes(uint16_t channel_id)
 {
     // Input validation
-    if (channel_id >= (MR_CHANNELS_MAX + 7)) {
+    if (channel_id >= MR_ATTR_COUNT) {
         return NULL;
     }
-    
-    // Check cache first (FAST PATH)
-    int cache_index = MR_FindInCache(channel_id);
-    
-    if (cache_index >= 0) {
-        // CACHE HIT
-        #ifdef ENABLE_FEAT_F4HWN_DEBUG
-            cache_hits++;
-        #endif
-        
-        // Update access time for LRU
-        gMR_ChannelAttributes_Cache[cache_index].access_time = GetCurrentTime();
-        
-        return &gMR_ChannelAttributes_Cache[cache_index].attributes;
-    }
-    
-    // CACHE MISS - Load from Flash
-    #ifdef ENABLE_FEAT_F4HWN_DEBUG
-        cache_misses++;
-    #endif
-    
-    // Find slot for new entry
-    int slot = MR_FindEmptyCacheSlot();
-    
-    if (slot < 0) {
-        // Cache is full, evict oldest entry
-        slot = MR_FindOldestCacheEntry();
-    }
-    
-    // Load from Flash into cache slot
-    MR_LoadChannelAttributesFromFlash(channel_id, &gMR_ChannelAttributes_Cache[slot].attributes);
-    
-    // Store channel_id in cache
-    gMR_ChannelAttributes_Cache[slot].channel_id = channel_id;
-    
-    // Set access time
-    gMR_ChannelAttributes_Cache[slot].access_time = GetCurrentTime();
-    
-    return &gMR_ChannelAttributes_Cache[slot].attributes;
+
+    ChannelAttributes_t *att = &gMR_AttrSlots[gMR_AttrSlotNext];
+    gMR_AttrSlotNext = (gMR_AttrSlotNext + 1) % MR_CHANNELS_ATTR_SLOTS;
+
+    MR_LoadChannelAttributesFromFlash(channel_id, att);
+    *att = MR_ValidateChannelAttributes(*att);
+    return att;
 }
 
-// Set channel attributes (updates both cache and Flash)
+// Set channel attributes (writes the validated value to Flash)
 void MR_SetChannelAttributes(uint16_t channel_id, const ChannelAttributes_t* attributes)
 {
     // Input validation
-    if (channel_id >= (MR_CHANNELS_MAX + 7) || !attributes) {
+    if (channel_id >= MR_ATTR_COUNT || !attributes) {
         return;
     }
-    
-    // CRITICAL FIX: WRITE-PROTECT - Prevent Flash wear
-    // Before writing, check if data already exists and is identical
-    ChannelAttributes_t flash_version;
-    MR_LoadChannelAttributesFromFlash(channel_id, &flash_version);
-    
-    // Compare current Flash data with new data
-    if (memcmp(&flash_version, attributes, sizeof(ChannelAttributes_t)) == 0) {
-        // But still update cache for consistency
-        int cache_index = MR_FindInCache(channel_id);
-        if (cache_index >= 0) {
-            gMR_ChannelAttributes_Cache[cache_index].attributes = *attributes;
-            gMR_ChannelAttributes_Cache[cache_index].access_time = GetCurrentTime();
-        }
-        return;  // Early exit - no Flash write needed
+
+    const ChannelAttributes_t att = MR_ValidateChannelAttributes(*attributes);
+    ChannelAttributes_t stored;
+
+    // WRITE-PROTECT - Prevent Flash wear
+    MR_LoadChannelAttributesFromFlash(channel_id, &stored);
+    if (stored.__val == att.__val) {
+        return;
     }
     
-    // Data has changed - write to Flash
-    MR_SaveChannelAttributesToFlash(channel_id, attributes);
-    
-    // Update cache if entry exists
-    int cache_index = MR_FindInCache(channel_id);
-    
-    if (cache_index >= 0) {
-        // Entry in cache, update it
-        gMR_ChannelAttributes_Cache[cache_index].attributes = *attributes;
-        gMR_ChannelAttributes_Cache[cache_index].access_time = GetCurrentTime();
-    } else {
-        // Not in cache, add it
-        int slot = MR_FindEmptyCacheSlot();
-        
-        if (slot < 0) {
-            // Cache full, evict oldest
-            slot = MR_FindOldestCacheEntry();
-        }
-        
-        gMR_ChannelAttributes_Cache[slot].channel_id = channel_id;
-        gMR_ChannelAttributes_Cache[slot].attributes = *attributes;
-        gMR_ChannelAttributes_Cache[slot].access_time = GetCurrentTime();
-    }
+    MR_SaveChannelAttributesToFlash(channel_id, &att);
 }
 
-// Invalidate entire cache (call after loading Flash backup)
-void MR_InvalidateChannelAttributesCache(void)
+// Rebuild the index after Flash was written behind our back
+void MR_ReloadChannelAttributes(uint16_t first, uint16_t count)
 {
-    for (int i = 0; i < MR_CHANNELS_CACHE_SIZE; i++) {
-        gMR_ChannelAttributes_Cache[i].channel_id = 0xFFFF;  // Mark as empty
-        gMR_ChannelAttributes_Cache[i].access_time = 0;
+    if (first >= MR_ATTR_COUNT) {
+        return;
     }
-}
 
-// Initialize cache (call from settings.c boot sequence)
-void MR_InitChannelAttributesCache(void)
-{
-    // Clear cache
-    MR_InvalidateChannelAttributesCache();
-    
-    // Pre-load commonly used channels (VFO A, VFO B, channel 0)
-    // This speeds up first access
-    uint16_t channels_to_preload[] = {0, 1, 2};
-    
-    for (int i = 0; i < ARRAY_SIZE(channels_to_preload); i++) {
-        if (channels_to_preload[i] < (MR_CHANNELS_MAX + 7)) {
-            MR_GetChannelAttributes(channels_to_preload[i]);
-        }
-    }
+    MR_IndexChannels(first, MIN(count, (uint16_t)(MR_ATTR_COUNT - first)));
 }
 
-// 
-// Debugging / Statistics (optional, for development)
-// 
-
-#ifdef ENABLE_FEAT_F4HWN_DEBUG
-
-uint32_t MR_GetCacheHits(void)
+// Rebuild the entire index (call after loading Flash backup)
+void MR_InvalidateChannelAttributesCache(void)
 {
-    return cache_hits;
+    MR_ReloadChannelAttributes(0, MR_ATTR_COUNT);
 }
 
-uint32_t MR_GetCacheMisses(void)
+// Normalize and index (call from settings.c boot sequence)
+void MR_InitChannelAttributesCache(void)
 {
-    return cache_misses;
+    MR_NormalizeChannelAttributes();
+    MR_InvalidateChannelAttributesCache();
 }
 
-float MR_GetCacheHitRate(void)
+uint32_t MR_GetScanListBlocks(uint8_t scanlist)
 {
-    uint32_t total = cache_hits + cache_misses;
-    if (total == 0) return 0.0f;
-    return (float)cache_hits / (float)total * 100.0f;
-}
+    if (scanlist > MR_CHANNELS_LIST + 1) {
+        return 0;
+    }
 
-void MR_PrintCacheStats(void)
-{
-    // This would print cache statistics (requires UART_Printf)
-    // Uncomment if you want debug output:
-    // UART_Printf("Cache Stats: Hits=%u Misses=%u Rate=%.1f%%\n", 
-    //    cache_hits, cache_misses, MR_GetCacheHitRate());
+    return gMR_ScanListBlocks[scanlist];
 }
 
-#endif
-
 #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
     bool K5VIEWER_IsLocked(void) 
     {
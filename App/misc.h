@@ -20,6 +20,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "timer.h"
+
 #ifndef ARRAY_SIZE
     #define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
 #endif
@@ -39,9 +41,11 @@
 #define FM_CHANNELS_MAX 48
 #define MR_CHANNELS_MAX 1024
 #define MR_CHANNELS_LIST 24
-// CACHE-BASED OPTIMIZATION: Only keep active channels in RAM
-// Full array stays in EEPROM, cache holds ~10 most-used channels
-#define MR_CHANNELS_CACHE_SIZE 10
+// Decoded attribute copies returned by MR_GetChannelAttributes(): a pointer
+// stays valid until this many further calls
+#define MR_CHANNELS_ATTR_SLOTS 4
+// Memory channels per bit of the scan list index (32 blocks of 32)
+#define MR_CHANNELS_BLOCK 32
 
 
 #define IS_MR_CHANNEL(x)       ((x) >= MR_CHANNEL_FIRST && (x) <= MR_CHANNEL_LAST)
@@ -276,63 +280,50 @@ typedef union {
 } ChannelAttributes_t;
 
 // 
-// Cache-Based Architecture
+// Channel Attributes
 // 
 //
-// Instead of keeping all 1038 channel attributes in RAM (~ 2,000 bytes),
-// we now keep only the active ones in a small cache (40 bytes).
-//
-// The full array remains in Flash and is loaded on-demand.
-//
-// SRAM Savings: ~ 2,000 bytes (84% reduction!)
-// 
-
-// Cache entry structure
-typedef struct {
-    uint16_t channel_id;                    // Which channel this is
-    ChannelAttributes_t attributes;         // The actual attributes
-    uint32_t access_time;                   // For LRU eviction (optional)
-} MR_ChannelCache_t;
-
-// The cache (small, stays in RAM)
-extern MR_ChannelCache_t gMR_ChannelAttributes_Cache[MR_CHANNELS_CACHE_SIZE];
-
-// REMOVED: extern ChannelAttributes_t gMR_ChannelAttributes[MR_CHANNELS_MAX + 7];
-// This now stays in Flash, not in RAM
-
-// 
-// Cache Access Functions (See misc.c for implementation)
+// The attributes of all 1031 channels stay in Flash, each lookup reads its
+// 2 bytes. Only the scan list index below is kept in RAM.
 // 
 
-// Get channel attributes (from cache or Flash)
-// Returns pointer to attributes, loads from Flash if not in cache
-
+// Normalize the attributes in Flash and build the scan list index (boot)
 void MR_InitChannelAttributesCache(void);
 
+// Get channel attributes from Flash
+// Returns a pointer to a decoded copy, see MR_CHANNELS_ATTR_SLOTS
 ChannelAttributes_t* MR_GetChannelAttributes(uint16_t channel_id);
 
-// Set channel attributes (updates both cache and Flasf)
+// Set channel attributes (validated, written to Flash only when they change)
 void MR_SetChannelAttributes(uint16_t channel_id, const ChannelAttributes_t* attributes);
 
-// Invalidate cache (on Flash clear)
+// Reindex channels [first, first + count) from Flash (after UART/AirCopy writes)
+void MR_ReloadChannelAttributes(uint16_t first, uint16_t count);
+
+// Reindex all channels (on Flash clear)
 void MR_InvalidateChannelAttributesCache(void);
 
 // Load channel attributes from Flash directly (internal use)
 void MR_LoadChannelAttributesFromFlash(uint16_t channel_id, ChannelAttributes_t* attributes);
 
-// Save channel attributes to Flash directly (internal use)
+// Save channel attributes to Flash, scan list index included
 void MR_SaveChannelAttributesToFlash(uint16_t channel_id, const ChannelAttributes_t* attributes);
 
+// Scan list index: blocks of MR_CHANNELS_BLOCK memory channels holding at
+// least one non-empty channel with this scanlist value (0 = none, 25 = all),
+// bit n for channels n * MR_CHANNELS_BLOCK and up. Exclusions are ignored.
+uint32_t MR_GetScanListBlocks(uint8_t scanlist);
+
 extern ChannelAttributes_t   gMR_ChannelAttributes_Current;  // Current VFO attributes (for speed)
 
-extern volatile uint16_t     gBatterySaveCountdown_10ms;
+extern TIMER_t              gBatterySaveTimer;          // sets gSchedulePowerSave
 
 extern volatile bool         gPowerSaveCountdownExpired;
 extern volatile bool         gSchedulePowerSave;
 
 extern volatile bool         gScheduleDualWatch;
 
-extern volatile uint16_t     gDualWatchCountdown_10ms;
+extern TIMER_t              gDualWatchTimer;            // sets gScheduleDualWatch
 extern bool                  gDualWatchActive;
 
 extern volatile uint8_t      gSerialConfigCountDown_500ms;
@@ -391,7 +382,7 @@ enum
 };
 
 extern volatile bool     gScheduleScanListen;
-extern volatile uint16_t gScanPauseDelayIn_10ms;
+extern TIMER_t           gScanPauseTimer;            // sets gScheduleScanListen
 
 extern AlarmState_t          gAlarmState;
 extern uint16_t              gMenuCountdown;
@@ -452,6 +443,9 @@ extern uint8_t               gFSKWriteIndex;
     extern uint8_t           gNoaaChannel;
 #endif
 extern volatile bool         gNextTimeslice;
+extern volatile bool         gNextTimeslice2ms;
+extern volatile bool         gFastTick;                  // SysTick every 2 ms instead of 10 ms
+extern volatile bool         gFastTickRunning;           // and it does, from this period on
 extern bool                  gUpdateDisplay;
 extern bool                  gF_LOCK;
 #ifdef ENABLE_FMRADIO
@@ -461,7 +455,7 @@ extern uint8_t               gShowChPrefix;
 extern volatile uint8_t      gFoundCDCSSCountdown_10ms;
 extern volatile uint8_t      gFoundCTCSSCountdown_10ms;
 #ifdef ENABLE_VOX
-    extern volatile uint16_t gVoxStopCountdown_10ms;
+    extern TIMER_t           gVoxStopTimer;
 #endif
 extern volatile bool         gNextTimeslice40ms;
 #ifdef ENABLE_NOAA
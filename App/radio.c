@@ -126,7 +126,15 @@ bool RADIO_CheckValidList(uint8_t scanList)
     if(scanList == MR_CHANNELS_LIST + 1)
         return true;
 
+    // Empty channels are in no list: walk them all for list 0
+    const uint32_t blocks = (scanList == 0) ? 0xFFFFFFFF : MR_GetScanListBlocks(scanList);
+
     for (uint16_t i = 0; IS_MR_CHANNEL(i); i++) {
+        if (!(blocks & (1u << (i / MR_CHANNELS_BLOCK)))) {
+            i += MR_CHANNELS_BLOCK - 1 - (i % MR_CHANNELS_BLOCK);
+            continue;
+        }
+
         const ChannelAttributes_t* att = MR_GetChannelAttributes(i);
         if(att->scanlist == scanList && att->exclude == false)
         {
@@ -193,8 +201,34 @@ bool RADIO_CheckValidChannel(uint16_t channel, bool checkScanList, uint8_t scanL
     return true;
 }
 
+uint32_t RADIO_GetChannelBlocks(bool checkScanList, uint8_t scanList)
+{
+    uint32_t blocks = 0;
+
+    // Same membership rules as RADIO_CheckValidChannel()
+    if (!checkScanList || scanList > MR_CHANNELS_LIST) {
+        for (uint8_t i = checkScanList ? 1 : 0; i <= MR_CHANNELS_LIST + 1; i++)
+            blocks |= MR_GetScanListBlocks(i);
+    }
+    else if (scanList > 0) {
+        blocks = MR_GetScanListBlocks(scanList) | MR_GetScanListBlocks(MR_CHANNELS_LIST + 1);
+    }
+
+    return blocks;
+}
+
+// Not a constant-time lookup: the scan list index only tells which blocks of
+// MR_CHANNELS_BLOCK channels may hold a member, so the empty blocks are
+// skipped whole and the others probed channel by channel. Next/previous links
+// per list would need 10 bits per channel and list: the attribute bytes have
+// 2 spare bits, and a RAM table takes 2 KB for a single list.
 uint16_t RADIO_FindNextChannel(uint16_t Channel, int8_t Direction, bool bCheckScanList, uint8_t VFO)
 {
+    const uint32_t blocks = RADIO_GetChannelBlocks(bCheckScanList, VFO);
+
+    if (blocks == 0)
+        return 0xFFFF;
+
     for (uint16_t i = 0; IS_MR_CHANNEL(i); i++, Channel += Direction) {
         if (Channel == 0xFFFF) {
             Channel = MR_CHANNEL_LAST;
@@ -202,6 +236,17 @@ uint16_t RADIO_FindNextChannel(uint16_t Channel, int8_t Direction, bool bCheckSc
             Channel = MR_CHANNEL_FIRST;
         }
 
+        if (!(blocks & (1u << (Channel / MR_CHANNELS_BLOCK)))) {
+            // Nothing to find up to the end of this block: skip it
+            const uint16_t skip = (Direction > 0)
+                ? MR_CHANNELS_BLOCK - 1 - (Channel % MR_CHANNELS_BLOCK)
+                : (Channel % MR_CHANNELS_BLOCK);
+
+            i += skip;
+            Channel += skip * Direction;
+            continue;
+        }
+
         if (RADIO_CheckValidChannel(Channel, bCheckScanList, VFO)) {
             return Channel;
         }
@@ -738,6 +783,70 @@ BK4819_FilterBandwidth_t RADIO_GetAMFilterBandwidth(const VFO_Info_t *pVfo)
     return (pVfo->CHANNEL_BANDWIDTH == BANDWIDTH_WIDE) ? BK4819_FILTER_BW_WIDE : BK4819_FILTER_BW_AM;
 }
 
+// Everything RADIO_SetupRegisters() reads apart from the frequency. While it
+// is unchanged and nothing else has written the BK4819, retuning only has to
+// send the frequency. The menu settings it also depends on (audio profiles,
+// AM fix, scrambler) are followed by a full setup when they change.
+typedef struct
+{
+    const VFO_Info_t *vfo;
+    const VFO_Info_t *currentVfo;
+    uint8_t           modulation;
+    uint8_t           bandwidth;
+    uint8_t           squelch[6];
+    uint8_t           codeType;
+    uint8_t           code;
+    uint8_t           scrambling;
+    uint8_t           compander;
+    uint8_t           currentModulation;
+    uint8_t           micSensitivity;
+    uint8_t           volumeGain;
+    uint8_t           dacGain;
+#ifdef ENABLE_VOX
+    uint8_t           vox;
+    uint16_t          voxThresholds[2];
+#endif
+#ifdef ENABLE_FEAT_F4HWN_NARROWER
+    uint8_t           nfm;
+#endif
+} RADIO_SetupKey_t;
+
+static RADIO_SetupKey_t gSetupKey;
+static bool             gSetupKeyValid;
+static uint32_t         gSetupChangeCount;
+
+static void RADIO_GetSetupKey(RADIO_SetupKey_t *pKey)
+{
+    memset(pKey, 0, sizeof(*pKey));
+
+    pKey->vfo               = gRxVfo;
+    pKey->currentVfo        = gCurrentVfo;
+    pKey->modulation        = gRxVfo->Modulation;
+    pKey->bandwidth         = gRxVfo->CHANNEL_BANDWIDTH;
+    pKey->squelch[0]        = gRxVfo->SquelchOpenRSSIThresh;
+    pKey->squelch[1]        = gRxVfo->SquelchCloseRSSIThresh;
+    pKey->squelch[2]        = gRxVfo->SquelchOpenNoiseThresh;
+    pKey->squelch[3]        = gRxVfo->SquelchCloseNoiseThresh;
+    pKey->squelch[4]        = gRxVfo->SquelchCloseGlitchThresh;
+    pKey->squelch[5]        = gRxVfo->SquelchOpenGlitchThresh;
+    pKey->codeType          = gRxVfo->pRX->CodeType;
+    pKey->code              = gRxVfo->pRX->Code;
+    pKey->scrambling        = gRxVfo->SCRAMBLING_TYPE;
+    pKey->compander         = gRxVfo->Compander;
+    pKey->currentModulation = gCurrentVfo->Modulation;
+    pKey->micSensitivity    = gEeprom.MIC_SENSITIVITY_TUNING;
+    pKey->volumeGain        = gEeprom.VOLUME_GAIN;
+    pKey->dacGain           = gEeprom.DAC_GAIN;
+#ifdef ENABLE_VOX
+    pKey->vox               = gEeprom.VOX_SWITCH;
+    pKey->voxThresholds[0]  = gEeprom.VOX0_THRESHOLD;
+    pKey->voxThresholds[1]  = gEeprom.VOX1_THRESHOLD;
+#endif
+#ifdef ENABLE_FEAT_F4HWN_NARROWER
+    pKey->nfm               = gSetting_set_nfm;
+#endif
+}
+
 void RADIO_SetupRegisters(bool switchToForeground)
 {
     BK4819_FilterBandwidth_t Bandwidth = gRxVfo->CHANNEL_BANDWIDTH;
@@ -753,6 +862,10 @@ void RADIO_SetupRegisters(bool switchToForeground)
 
     gEnableSpeaker = false;
 
+    // Most of what follows is already set when only the VFO or the channel
+    // changed: only the registers that end up different are sent
+    BK4819_BeginUpdate();
+
     BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, false);
 
     if (gRxVfo->Modulation == MODULATION_AM)
@@ -918,10 +1031,68 @@ void RADIO_SetupRegisters(bool switchToForeground)
     // enable/disable BK4819 selected interrupts
     BK4819_WriteRegister(BK4819_REG_3F, InterruptMask);
 
+    BK4819_EndUpdate();
+
+    FUNCTION_Init();
+
+    if (switchToForeground)
+        FUNCTION_Select(FUNCTION_FOREGROUND);
+
+    RADIO_GetSetupKey(&gSetupKey);
+    gSetupKeyValid    = true;
+    gSetupChangeCount = BK4819_GetChangeCount();
+}
+
+bool RADIO_Retune(bool switchToForeground)
+{
+    RADIO_SetupKey_t Key;
+
+    RADIO_GetSetupKey(&Key);
+
+    if (!gSetupKeyValid ||
+        gSetupChangeCount != BK4819_GetChangeCount() ||
+        memcmp(&Key, &gSetupKey, sizeof(Key)) != 0
+    #ifdef ENABLE_NOAA
+        || IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE)
+    #endif
+    #ifdef ENABLE_FMRADIO
+        || gFmRadioMode
+    #endif
+    )
+    {
+        RADIO_SetupRegisters(switchToForeground);
+        return false;
+    }
+
+    const uint32_t Frequency = gRxVfo->pRX->Frequency;
+
+    AUDIO_AudioPathOff();
+
+    gEnableSpeaker = false;
+
+    // The part of RADIO_SetupRegisters() that still sends something when
+    // only the frequency changed
+    while (1)
+    {
+        const uint16_t Status = BK4819_ReadRegister(BK4819_REG_0C);
+        if ((Status & 1u) == 0) // INTERRUPT REQUEST
+            break;
+
+        BK4819_WriteRegister(BK4819_REG_02, 0);
+        SYSTEM_DelayMs(1);
+    }
+
+    BK4819_SetFrequency(Frequency);
+    BK4819_RX_TurnOn();
+    BK4819_PickRXFilterPathBasedOnFrequency(Frequency);
+
     FUNCTION_Init();
 
     if (switchToForeground)
         FUNCTION_Select(FUNCTION_FOREGROUND);
+
+    gSetupChangeCount = BK4819_GetChangeCount();
+    return true;
 }
 
 #ifdef ENABLE_NOAA
@@ -1188,7 +1359,7 @@ void RADIO_PrepareTX(void)
     if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF)
     {   // dual-RX is enabled
 
-        gDualWatchCountdown_10ms = dual_watch_count_after_tx_10ms;
+        TIMER_Start(&gDualWatchTimer, dual_watch_count_after_tx_10ms);
         gScheduleDualWatch       = false;
 
         if (!gRxVfoIsActive)
@@ -152,6 +152,7 @@ extern VfoState_t     VfoState[2];
 bool     RADIO_CheckValidList(uint8_t scanList);
 void     RADIO_NextValidList(int8_t direction);
 bool     RADIO_CheckValidChannel(uint16_t channel, bool checkScanList, uint8_t scanList);
+uint32_t RADIO_GetChannelBlocks(bool checkScanList, uint8_t scanList);
 uint16_t RADIO_FindNextChannel(uint16_t ChNum, int8_t Direction, bool bCheckScanList, uint8_t RadioNum);
 void     RADIO_InitInfo(VFO_Info_t *pInfo, const uint16_t ChannelSave, const uint32_t Frequency);
 void     RADIO_ConfigureChannel(const unsigned int VFO, const unsigned int configure);
@@ -160,6 +161,10 @@ void     RADIO_ValidateAndSetCode(FREQ_Config_t *pFreq_Config, uint8_t tmp);
 void     RADIO_ApplyOffset(VFO_Info_t *pInfo);
 void     RADIO_SelectVfos(void);
 void     RADIO_SetupRegisters(bool switchToForeground);
+// RADIO_SetupRegisters() after a change of frequency only: sends just the
+// frequency and the RX re-arm when nothing else differs from the last full
+// setup, else falls back to it. Returns false on the fallback.
+bool     RADIO_Retune(bool switchToForeground);
 #ifdef ENABLE_NOAA
     void RADIO_ConfigureNOAA(void);
 #endif
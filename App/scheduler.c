@@ -25,9 +25,11 @@
 #include "helper/battery.h"
 #include "misc.h"
 #include "settings.h"
+#include "timer.h"
 
 #include "driver/backlight.h"
 #include "driver/gpio.h"
+#include "driver/systick.h"
 
 #define DECREMENT(cnt) \
     do {               \
@@ -42,11 +44,61 @@
                 flag = true;             \
     } while (0)
 
+// The gates evaluated here, the others are set from the main loop
+#define RADIO_GATES ((1u << TIMER_GATE_FOREGROUND) | (1u << TIMER_GATE_POWER_SAVE) \
+                   | (1u << TIMER_GATE_DUAL_WATCH) | (1u << TIMER_GATE_SCAN))
+
 static volatile uint32_t gGlobalSysTickCounter;
 
-// we come here every 10ms
+#ifdef ENABLE_FEAT_F4HWN_SCAN_FASTER
+    #define SCAN_FAST_STALL_WATCHDOG_10ms  25   // 250 ms
+
+    static void ScanStalled(void)
+    {
+        gScheduleScanListen = true;
+    }
+
+    static TIMER_t scanStallTimer = TIMER_INIT(ScanStalled, TIMER_GATE_NONE);
+    static bool    scanStalled;
+#endif
+
+// we come here every 10ms, or every 2ms while gFastTick asks for it, and
+// do the 10ms work on each 10ms boundary
 void SysTick_Handler(void)
 {
+    static uint8_t subTick;             // 2ms steps into the 10ms slice
+    static uint8_t periodSteps = 5;     // 2ms steps of the SysTick period
+
+    const uint8_t ended = periodSteps;
+
+    subTick += ended;
+    if (subTick >= 5)
+        subTick = 0;
+
+    // Slower again, the periods run to the next 10ms boundary
+    const uint8_t steps = gFastTick ? 1 : 5 - subTick;
+
+    if (steps != periodSteps) {
+        periodSteps = steps;
+        SYSTICK_SetPeriod(steps);
+    }
+
+    if (gFastTickRunning != gFastTick) {
+        gFastTickRunning = gFastTick;
+        gFlagAudioStep   = true;        // a queued beep may start
+    }
+
+    gNextTimeslice2ms = true;
+
+    if (gAudioCountdown_2ms > 0) {
+        gAudioCountdown_2ms = (gAudioCountdown_2ms > ended) ? gAudioCountdown_2ms - ended : 0;
+        if (gAudioCountdown_2ms == 0)
+            gFlagAudioStep = true;
+    }
+
+    if (subTick != 0)
+        return;
+
     gGlobalSysTickCounter++;
     
     gNextTimeslice = true;
@@ -77,74 +129,69 @@ void SysTick_Handler(void)
 
     DECREMENT(gFoundCTCSSCountdown_10ms);
 
-    if (gCurrentFunction == FUNCTION_FOREGROUND)
-        DECREMENT_AND_TRIGGER(gBatterySaveCountdown_10ms, gSchedulePowerSave);
+    {
+        const bool rxTxMonitor = gCurrentFunction == FUNCTION_MONITOR
+                              || gCurrentFunction == FUNCTION_TRANSMIT
+                              || gCurrentFunction == FUNCTION_RECEIVE;
+        uint8_t gates = 0;
 
-    if (gCurrentFunction == FUNCTION_POWER_SAVE)
-        DECREMENT_AND_TRIGGER(gPowerSave_10ms, gPowerSaveCountdownExpired);
+        if (gCurrentFunction == FUNCTION_FOREGROUND)
+            gates |= 1u << TIMER_GATE_FOREGROUND;
 
-    if (gScanStateDir == SCAN_OFF && !gCssBackgroundScan && gEeprom.DUAL_WATCH != DUAL_WATCH_OFF)
-        if (gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT && gCurrentFunction != FUNCTION_RECEIVE)
-            DECREMENT_AND_TRIGGER(gDualWatchCountdown_10ms, gScheduleDualWatch);
+        if (gCurrentFunction == FUNCTION_POWER_SAVE)
+            gates |= 1u << TIMER_GATE_POWER_SAVE;
 
-#ifdef ENABLE_NOAA
-    if (gScanStateDir == SCAN_OFF && !gCssBackgroundScan && gEeprom.DUAL_WATCH == DUAL_WATCH_OFF)
-        if (gIsNoaaMode && gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT)
-            if (gCurrentFunction != FUNCTION_RECEIVE)
-                DECREMENT_AND_TRIGGER(gNOAA_Countdown_10ms, gScheduleNOAA);
-#endif
+        if (gScanStateDir == SCAN_OFF && !gCssBackgroundScan && gEeprom.DUAL_WATCH != DUAL_WATCH_OFF && !rxTxMonitor)
+            gates |= 1u << TIMER_GATE_DUAL_WATCH;
+
+        if (gScanStateDir != SCAN_OFF && gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT)
+            gates |= 1u << TIMER_GATE_SCAN;
 
-    if (gScanStateDir != SCAN_OFF)
-        if (gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT)
-            DECREMENT_AND_TRIGGER(gScanPauseDelayIn_10ms, gScheduleScanListen);
+        TIMER_SetGates(RADIO_GATES, gates);
 
 #ifdef ENABLE_FEAT_F4HWN_SCAN_FASTER
-    // Scan stall watchdog: if the scan-resume countdown has expired
-    // (gScanPauseDelayIn_10ms == 0) but no resume was actually scheduled
-    // (gScheduleScanListen == false) and no real reception is happening
-    // (squelch closed -> green LED off, not in RX/TX/MONITOR), the scan
-    // loop is stuck. Force a resume after this many 10ms ticks. The
-    // gScanPauseDelayIn_10ms == 0 guard ensures we never override the
-    // user-configured ScnRev (SCAN_RESUME_MODE) pause: while that pause
-    // is decrementing, the watchdog stays asleep.
-    #define SCAN_FAST_STALL_WATCHDOG_10ms  25   // 250 ms
-    static uint16_t scanFastStallCounter;
-
-    if (gSetting_set_scn
-        && gScanStateDir != SCAN_OFF
-        && gScanPauseDelayIn_10ms == 0
-        && !gScheduleScanListen
-        && !g_SquelchLost
-        && gCurrentFunction != FUNCTION_RECEIVE
-        && gCurrentFunction != FUNCTION_TRANSMIT
-        && gCurrentFunction != FUNCTION_MONITOR)
-    {
-        if (++scanFastStallCounter >= SCAN_FAST_STALL_WATCHDOG_10ms) {
-            scanFastStallCounter = 0;
-            gScheduleScanListen  = true;
+        // Scan stall watchdog: if the scan-resume countdown has expired
+        // but no resume was actually scheduled (gScheduleScanListen ==
+        // false) and no real reception is happening (squelch closed ->
+        // green LED off, not in RX/TX/MONITOR), the scan loop is stuck.
+        // Force a resume once this lasts SCAN_FAST_STALL_WATCHDOG_10ms
+        // ticks. The expired countdown guard ensures we never override
+        // the user-configured ScnRev (SCAN_RESUME_MODE) pause: while that
+        // pause is counting down, the watchdog stays asleep.
+        const bool stalled = gSetting_set_scn
+                          && gScanStateDir != SCAN_OFF
+                          && !TIMER_IsArmed(&gScanPauseTimer)
+                          && !gScheduleScanListen
+                          && !g_SquelchLost
+                          && !rxTxMonitor;
+
+        if (stalled != scanStalled) {
+            scanStalled = stalled;
+            if (stalled)
+                TIMER_StartPeriodic(&scanStallTimer, SCAN_FAST_STALL_WATCHDOG_10ms);
+            else
+                TIMER_Stop(&scanStallTimer);
         }
-    }
-    else
-    {
-        scanFastStallCounter = 0;
-    }
 #endif
+    }
 
-    DECREMENT_AND_TRIGGER(gTailNoteEliminationCountdown_10ms, gFlagTailNoteEliminationComplete);
+    // Dual watch, scan pause, VOX, power save, backlight, stall watchdog
+    TIMER_Tick();
 
-#ifdef ENABLE_VOICE
-    DECREMENT_AND_TRIGGER(gCountdownToPlayNextVoice_10ms, gFlagPlayQueuedVoice);
+#ifdef ENABLE_NOAA
+    if (gScanStateDir == SCAN_OFF && !gCssBackgroundScan && gEeprom.DUAL_WATCH == DUAL_WATCH_OFF)
+        if (gIsNoaaMode && gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT)
+            if (gCurrentFunction != FUNCTION_RECEIVE)
+                DECREMENT_AND_TRIGGER(gNOAA_Countdown_10ms, gScheduleNOAA);
 #endif
 
+    DECREMENT_AND_TRIGGER(gTailNoteEliminationCountdown_10ms, gFlagTailNoteEliminationComplete);
+
 #ifdef ENABLE_FMRADIO
     if (gFM_ScanState != FM_SCAN_OFF && gCurrentFunction != FUNCTION_MONITOR)
         if (gCurrentFunction != FUNCTION_TRANSMIT && gCurrentFunction != FUNCTION_RECEIVE)
             DECREMENT_AND_TRIGGER(gFmPlayCountdown_10ms, gScheduleFM);
 #endif
 
-#ifdef ENABLE_VOX
-    DECREMENT(gVoxStopCountdown_10ms);
-#endif
-
     DECREMENT(boot_counter_10ms);
 }
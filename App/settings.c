@@ -416,26 +416,10 @@ gEeprom.FreqChannel[1]   = IS_FREQ_CHANNEL(Data16[5]) ? Data16[5] : (FREQ_CHANNE
     // Init list name
     PY25Q16_ReadBuffer(0x00880E, gListName, sizeof(gListName));
 
-    // Init attr cache
+    // Load and check channel attributes (empty channels get band 7,
+    // exclusions are cleared), saved back to Flash when changed
     MR_InitChannelAttributesCache();
 
-    // Load and check channel
-    for (uint16_t i = 0; i < MR_CHANNELS_MAX + 7; i++) {
-        ChannelAttributes_t *att = MR_GetChannelAttributes(i);
-        
-        if (att != NULL) {
-            if (att->__val == 0xFFFF) {
-                att->__val = 0;
-                att->band = 0x7;
-                MR_SetChannelAttributes(i, att);  // ⭐ IMPORTANT: Sauvegarder!
-            }
-            else {
-                att->exclude = 0;
-                MR_SetChannelAttributes(i, att);  // ⭐ IMPORTANT: Sauvegarder!
-            }
-        }
-    }
-
     // 0F30..0F3F
     PY25Q16_ReadBuffer(0x00A138, gCustomAesKey, sizeof(gCustomAesKey));
     bHasCustomAesKey = false;
@@ -751,6 +735,9 @@ void SETTINGS_FactoryReset(bool bIsAll)
     for (uint32_t addr = 0x000000; addr <= 0x009000; addr += 0x1000) {
         PY25Q16_SectorErase(addr);
     }
+#ifdef ENABLE_DTMF_CALLING
+    DTMF_LoadContacts();
+#endif
     
     // 0d60 - 0e30
     if (bIsAll)
@@ -1209,6 +1196,11 @@ void SETTINGS_SaveChannel(uint16_t Channel, uint8_t VFO, const VFO_Info_t *pVFO,
 #endif
 
         PY25Q16_WriteBuffer(OffsetVFO, Buf, 0x10, false);
+#ifdef ENABLE_DTMF_CALLING
+        // channels 448-463 share their records with the contacts
+        if (Channel >= DTMF_CONTACTS_ADDR / 16 && Channel < DTMF_CONTACTS_ADDR / 16 + MAX_DTMF_CONTACTS)
+            DTMF_LoadContacts();
+#endif
 
         SETTINGS_UpdateChannel(Channel, pVFO, true, true, true);
 
@@ -1257,8 +1249,8 @@ void SETTINGS_UpdateChannel(uint16_t channel, const VFO_Info_t *pVFO, bool keep,
             .scanlist = 0,
             };        // default attributes
 
-        // 0x0D60
-        PY25Q16_ReadBuffer(0x008000 + (channel * 2), &state, 2);
+        // 0x0D60, mirrored in RAM
+        state = *MR_GetChannelAttributes(channel);
 
         if (keep) {
             att.band = pVFO->Band;
@@ -1430,6 +1422,9 @@ void SETTINGS_ResetTxLock(void)
 
         PY25Q16_WriteBuffer(Offset, Buf, BatchSize, false);
     }
+#ifdef ENABLE_DTMF_CALLING
+    DTMF_LoadContacts();
+#endif
 
     RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
     RADIO_ConfigureChannel(1, VFO_CONFIGURE_RELOAD);
@@ -0,0 +1,226 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+/**
+ * -----------------------------------
+ * Queue:
+ *
+ *    Delta list: each queued timer holds its ticks after the timer before
+ *    it, the first one its ticks from now. A tick decrements the first
+ *    timer only and pops it, and any following timer at 0, on expiry.
+ *    Timers expiring on the same tick fire in the order they were queued.
+ *
+ *    Timers behind a closed gate sit in an unsorted held list with the
+ *    ticks they have left, and go back into the queue when it opens.
+ *
+ * ------------------------------------
+ */
+
+#include "timer.h"
+#include "py32f0xx.h"
+
+// Gate 0 is always open
+TIMER_State_t gTimers = { NULL, NULL, 1u << TIMER_GATE_NONE };
+
+static bool GateOpen(const TIMER_t *pTimer)
+{
+    return gTimers.OpenGates & (1u << pTimer->Gate);
+}
+
+static void Insert(TIMER_t *pTimer, uint16_t Ticks)
+{
+    TIMER_t **pp = &gTimers.pQueue;
+
+    while (*pp != NULL && (*pp)->Ticks <= Ticks) {
+        Ticks -= (*pp)->Ticks;
+        pp     = &(*pp)->pNext;
+    }
+
+    if (*pp != NULL)
+        (*pp)->Ticks -= Ticks;
+
+    pTimer->Ticks = Ticks;
+    pTimer->pNext = *pp;
+    pTimer->State = TIMER_QUEUED;
+    *pp           = pTimer;
+}
+
+static void Hold(TIMER_t *pTimer, uint16_t Ticks)
+{
+    pTimer->Ticks = Ticks;
+    pTimer->pNext = gTimers.pHeld;
+    pTimer->State = TIMER_HELD;
+    gTimers.pHeld = pTimer;
+}
+
+static void Arm(TIMER_t *pTimer, uint16_t Ticks)
+{
+    if (Ticks == 0)
+        pTimer->State = TIMER_IDLE;
+    else if (GateOpen(pTimer))
+        Insert(pTimer, Ticks);
+    else
+        Hold(pTimer, Ticks);
+}
+
+// Unlink from the queue or the held list
+static void Detach(TIMER_t *pTimer)
+{
+    TIMER_t **pp;
+
+    switch (pTimer->State) {
+        case TIMER_QUEUED:
+            for (pp = &gTimers.pQueue; *pp != pTimer; pp = &(*pp)->pNext)
+                ;
+            if (pTimer->pNext != NULL)
+                pTimer->pNext->Ticks += pTimer->Ticks;
+            break;
+
+        case TIMER_HELD:
+            for (pp = &gTimers.pHeld; *pp != pTimer; pp = &(*pp)->pNext)
+                ;
+            break;
+
+        default:
+            return;
+    }
+
+    *pp           = pTimer->pNext;
+    pTimer->State = TIMER_IDLE;
+}
+
+void TIMER_Start(TIMER_t *pTimer, uint16_t Ticks)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    Detach(pTimer);
+    pTimer->Period = 0;
+    Arm(pTimer, Ticks);
+
+    __set_PRIMASK(primask);
+}
+
+void TIMER_StartPeriodic(TIMER_t *pTimer, uint16_t Period)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    Detach(pTimer);
+    pTimer->Period = Period;
+    Arm(pTimer, Period);
+
+    __set_PRIMASK(primask);
+}
+
+void TIMER_Stop(TIMER_t *pTimer)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    Detach(pTimer);
+
+    __set_PRIMASK(primask);
+}
+
+uint16_t TIMER_Remaining(const TIMER_t *pTimer)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint16_t ticks = 0;
+
+    if (pTimer->State == TIMER_QUEUED) {
+        for (const TIMER_t *t = gTimers.pQueue; t != pTimer; t = t->pNext)
+            ticks += t->Ticks;
+        ticks += pTimer->Ticks;
+    } else if (pTimer->State == TIMER_HELD) {
+        ticks = pTimer->Ticks;
+    }
+
+    __set_PRIMASK(primask);
+
+    return ticks;
+}
+
+void TIMER_SetGates(uint8_t Mask, uint8_t Open)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    const uint8_t gates   = (gTimers.OpenGates & ~Mask) | (Open & Mask) | (1u << TIMER_GATE_NONE);
+    const uint8_t closing = gTimers.OpenGates & ~gates;
+    const uint8_t opening = gates & ~gTimers.OpenGates;
+
+    gTimers.OpenGates = gates;
+
+    if (closing) {
+        TIMER_t **pp    = &gTimers.pQueue;
+        uint16_t  ticks = 0;
+
+        while (*pp != NULL) {
+            TIMER_t *t = *pp;
+
+            if (closing & (1u << t->Gate)) {
+                if (t->pNext != NULL)
+                    t->pNext->Ticks += t->Ticks;
+                *pp = t->pNext;
+                Hold(t, ticks + t->Ticks);
+            } else {
+                ticks += t->Ticks;
+                pp     = &t->pNext;
+            }
+        }
+    }
+
+    if (opening) {
+        TIMER_t **pp = &gTimers.pHeld;
+
+        while (*pp != NULL) {
+            TIMER_t *t = *pp;
+
+            if (opening & (1u << t->Gate)) {
+                *pp = t->pNext;
+                Insert(t, t->Ticks);
+            } else {
+                pp = &t->pNext;
+            }
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void TIMER_Tick(void)
+{
+    TIMER_t *t = gTimers.pQueue;
+
+    if (t == NULL || --t->Ticks > 0)
+        return;
+
+    do {
+        gTimers.pQueue = t->pNext;
+
+        if (t->Period > 0)
+            Insert(t, t->Period);
+        else
+            t->State = TIMER_IDLE;
+
+        if (t->pCallback != NULL)
+            t->pCallback();
+
+        t = gTimers.pQueue;
+    } while (t != NULL && t->Ticks == 0);
+}
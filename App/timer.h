@@ -0,0 +1,89 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef _TIMER_H
+#define _TIMER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// One-shot and periodic timers counted in the 10 ms ticks of
+// SysTick_Handler(), kept in a queue sorted by expiry: each tick only the
+// first timer is counted down, and the callbacks of the timers that expire
+// are called from the SysTick interrupt.
+//
+// A timer may have a gate: it only counts down while its gate is open, as
+// the countdowns guarded by the radio state used to. While the gate is
+// closed the timer is held aside with the ticks it has left.
+
+enum {
+    TIMER_GATE_NONE = 0,        // always open
+    TIMER_GATE_FOREGROUND,      // FUNCTION_FOREGROUND
+    TIMER_GATE_POWER_SAVE,      // FUNCTION_POWER_SAVE
+    TIMER_GATE_DUAL_WATCH,      // not scanning, dual watch on, not RX/TX/monitor
+    TIMER_GATE_SCAN,            // scanning, not TX/monitor
+    TIMER_GATE_BACKLIGHT,       // no backlight menu, no save prompt, no CSS scan
+    TIMER_GATE_COUNT
+};
+
+enum {
+    TIMER_IDLE = 0,
+    TIMER_QUEUED,
+    TIMER_HELD
+};
+
+typedef struct TIMER_s {
+    struct TIMER_s *pNext;
+    void          (*pCallback)(void);   // from the SysTick interrupt, may be NULL
+    uint16_t        Ticks;              // queued: after the timer before, held: left
+    uint16_t        Period;             // restarted with it after expiry, 0: one-shot
+    uint8_t         Gate;
+    uint8_t         State;
+} TIMER_t;
+
+#define TIMER_INIT(callback, gate) { NULL, (callback), 0, 0, (gate), TIMER_IDLE }
+
+// Expire after Ticks ticks of open gate, restarting any count in progress.
+// 0 stops the timer.
+void     TIMER_Start(TIMER_t *pTimer, uint16_t Ticks);
+// Expire every Period ticks of open gate
+void     TIMER_StartPeriodic(TIMER_t *pTimer, uint16_t Period);
+void     TIMER_Stop(TIMER_t *pTimer);
+
+// Ticks left, 0 once expired or stopped
+uint16_t TIMER_Remaining(const TIMER_t *pTimer);
+
+static inline bool TIMER_IsArmed(const TIMER_t *pTimer)
+{
+    return pTimer->State != TIMER_IDLE;
+}
+
+// Open or close the gates in Mask (bit 1 << TIMER_GATE_x), holding or
+// requeueing the timers behind the gates that changed
+void     TIMER_SetGates(uint8_t Mask, uint8_t Open);
+
+// From SysTick_Handler()
+void     TIMER_Tick(void);
+
+typedef struct {
+    TIMER_t *pQueue;
+    TIMER_t *pHeld;
+    uint8_t  OpenGates;
+} TIMER_State_t;
+
+extern TIMER_State_t gTimers;
+
+#endif
@@ -42,12 +42,14 @@ void UI_DisplayAircopy(void)
 
     UI_DisplayClear();
 
+    const bool v2 = gAircopyProtocol == AIRCOPY_PROTOCOL_V2;
+
     if (gAircopyState == AIRCOPY_READY) {
-        pPrintStr = "AIR COPY(RDY)";
+        pPrintStr = v2 ? "AIR COPY2(RDY)" : "AIR COPY(RDY)";
     } else if (gAircopyState == AIRCOPY_TRANSFER) {
-        pPrintStr = "AIR COPY";
+        pPrintStr = v2 ? "AIR COPY2" : "AIR COPY";
     } else {
-        pPrintStr = "AIR COPY(CMP)";
+        pPrintStr = v2 ? "AIR COPY2(CMP)" : "AIR COPY(CMP)";
         gAircopyState = AIRCOPY_READY;
     }
 
@@ -70,7 +72,8 @@ void UI_DisplayAircopy(void)
     // Get the current map and calculate percentage based on its total blocks
     const AIRCOPY_TransferMap_t *currentMap = AIRCOPY_GetCurrentMap();
 
-    uint16_t doneBlocks = gAirCopyBlockNumber + gErrorsDuringAirCopy;
+    // v2 repairs the errors: the blocks held are what counts
+    uint16_t doneBlocks = v2 ? gAirCopyBlockNumber : gAirCopyBlockNumber + gErrorsDuringAirCopy;
 
     if (doneBlocks > currentMap->total_blocks)
         doneBlocks = currentMap->total_blocks;
@@ -118,7 +121,7 @@ void UI_DisplayAircopy(void)
     if (doneBlocks > 0)
     {
         // Track CRC errors per real block index
-        if (gErrorsDuringAirCopy != lErrorsDuringAirCopy)
+        if (!v2 && gErrorsDuringAirCopy != lErrorsDuringAirCopy)
         {
             // Mark the last processed block as faulty
             set_bit(crc, doneBlocks - 1);
@@ -130,8 +133,8 @@ void UI_DisplayAircopy(void)
 
         for (uint8_t col = 0; col < AIRCOPY_BAR_WIDTH; col++)
         {
-            bool processed = (b < doneBlocks);
-            bool error     = processed && get_bit(crc, b);
+            bool processed = v2 ? AIRCOPY_BlockDone(b) : (b < doneBlocks);
+            bool error     = !v2 && processed && get_bit(crc, b);
 
             if (!processed)
                 gFrameBuffer[4][col + 4] = 0x81;   // not yet processed
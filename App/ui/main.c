@@ -278,7 +278,14 @@ static void ScanProgress_RebuildMemoryMap(uint8_t scan_list)
     memset(gScanProgressMemoryExcludeOrdinalMap, 0, sizeof(gScanProgressMemoryExcludeOrdinalMap));
     gScanProgressMemoryTotal = 0;
 
+    const uint32_t blocks = RADIO_GetChannelBlocks(true, scan_list);
+
     for (uint16_t ch = MR_CHANNEL_FIRST; IS_MR_CHANNEL(ch); ch++) {
+        if (!(blocks & (1u << (ch / MR_CHANNELS_BLOCK)))) {
+            ch += MR_CHANNELS_BLOCK - 1 - (ch % MR_CHANNELS_BLOCK);
+            continue;
+        }
+
         const ChannelAttributes_t *att = MR_GetChannelAttributes(ch);
 
         if (att == NULL || !ScanProgress_ChannelBelongsToList(ch, att, scan_list))
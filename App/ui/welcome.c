@@ -49,14 +49,18 @@ static void UI_LoadLogo(void)
 {
     // Skip 8-byte header, then read 128x64 bitmap (1024 B):
     // page 0 -> gStatusLine, pages 1..7 -> gFrameBuffer.
+    // gFrameBuffer is queued: it streams in while the status line is blitted,
+    // PY25Q16_WaitReads() before using it, read at once when the queue is full.
     PY25Q16_ReadBuffer(LOGO_BITMAP_ADDR, gStatusLine, sizeof(gStatusLine));
-    PY25Q16_ReadBuffer(LOGO_BITMAP_ADDR + sizeof(gStatusLine), gFrameBuffer, sizeof(gFrameBuffer));
+    if (!PY25Q16_ReadAsync(LOGO_BITMAP_ADDR + sizeof(gStatusLine), gFrameBuffer, sizeof(gFrameBuffer), NULL, NULL))
+        PY25Q16_ReadBuffer(LOGO_BITMAP_ADDR + sizeof(gStatusLine), gFrameBuffer, sizeof(gFrameBuffer));
 }
 
 void UI_DisplayLogo(void)
 {
     UI_LoadLogo();
     ST7565_BlitStatusLine();
+    PY25Q16_WaitReads();
     ST7565_BlitFullScreen();
 }
 #endif
@@ -353,6 +357,9 @@ void UI_DisplayWelcome(void)
     }
 
     ST7565_BlitStatusLine();
+#ifdef ENABLE_FEAT_F4HWN_LOGO
+    PY25Q16_WaitReads();    // Logo frame buffer, see UI_LoadLogo()
+#endif
     ST7565_BlitFullScreen();
 
     #ifdef ENABLE_FEAT_F4HWN_K5VIEWER
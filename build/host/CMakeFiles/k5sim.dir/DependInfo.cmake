@@ -0,0 +1,87 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/host/check.c" "CMakeFiles/k5sim.dir/check.c.o" "gcc" "CMakeFiles/k5sim.dir/check.c.o.d"
+  "/root/repo/host/main.c" "CMakeFiles/k5sim.dir/main.c.o" "gcc" "CMakeFiles/k5sim.dir/main.c.o.d"
+  "/root/repo/App/app/action.c" "CMakeFiles/k5sim.dir/root/repo/App/app/action.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/action.c.o.d"
+  "/root/repo/App/app/aircopy.c" "CMakeFiles/k5sim.dir/root/repo/App/app/aircopy.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/aircopy.c.o.d"
+  "/root/repo/App/app/app.c" "CMakeFiles/k5sim.dir/root/repo/App/app/app.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/app.c.o.d"
+  "/root/repo/App/app/beam.c" "CMakeFiles/k5sim.dir/root/repo/App/app/beam.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/beam.c.o.d"
+  "/root/repo/App/app/breakout.c" "CMakeFiles/k5sim.dir/root/repo/App/app/breakout.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/breakout.c.o.d"
+  "/root/repo/App/app/chFrScanner.c" "CMakeFiles/k5sim.dir/root/repo/App/app/chFrScanner.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/chFrScanner.c.o.d"
+  "/root/repo/App/app/common.c" "CMakeFiles/k5sim.dir/root/repo/App/app/common.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/common.c.o.d"
+  "/root/repo/App/app/dtmf.c" "CMakeFiles/k5sim.dir/root/repo/App/app/dtmf.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/dtmf.c.o.d"
+  "/root/repo/App/app/flashlight.c" "CMakeFiles/k5sim.dir/root/repo/App/app/flashlight.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/flashlight.c.o.d"
+  "/root/repo/App/app/fm.c" "CMakeFiles/k5sim.dir/root/repo/App/app/fm.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/fm.c.o.d"
+  "/root/repo/App/app/generic.c" "CMakeFiles/k5sim.dir/root/repo/App/app/generic.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/generic.c.o.d"
+  "/root/repo/App/app/main.c" "CMakeFiles/k5sim.dir/root/repo/App/app/main.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/main.c.o.d"
+  "/root/repo/App/app/menu.c" "CMakeFiles/k5sim.dir/root/repo/App/app/menu.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/menu.c.o.d"
+  "/root/repo/App/app/rxtx_log.c" "CMakeFiles/k5sim.dir/root/repo/App/app/rxtx_log.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/rxtx_log.c.o.d"
+  "/root/repo/App/app/scanner.c" "CMakeFiles/k5sim.dir/root/repo/App/app/scanner.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/scanner.c.o.d"
+  "/root/repo/App/app/spectrum.c" "CMakeFiles/k5sim.dir/root/repo/App/app/spectrum.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/spectrum.c.o.d"
+  "/root/repo/App/app/uart.c" "CMakeFiles/k5sim.dir/root/repo/App/app/uart.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/app/uart.c.o.d"
+  "/root/repo/App/audio.c" "CMakeFiles/k5sim.dir/root/repo/App/audio.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/audio.c.o.d"
+  "/root/repo/App/bitmaps.c" "CMakeFiles/k5sim.dir/root/repo/App/bitmaps.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/bitmaps.c.o.d"
+  "/root/repo/App/board.c" "CMakeFiles/k5sim.dir/root/repo/App/board.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/board.c.o.d"
+  "/root/repo/App/dcs.c" "CMakeFiles/k5sim.dir/root/repo/App/dcs.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/dcs.c.o.d"
+  "/root/repo/App/driver/backlight.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/backlight.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/backlight.c.o.d"
+  "/root/repo/App/driver/bk1080.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/bk1080.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/bk1080.c.o.d"
+  "/root/repo/App/driver/bk4829.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/bk4829.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/bk4829.c.o.d"
+  "/root/repo/App/driver/crc.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/crc.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/crc.c.o.d"
+  "/root/repo/App/driver/eeprom_compat.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/eeprom_compat.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/eeprom_compat.c.o.d"
+  "/root/repo/App/driver/gpio.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/gpio.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/gpio.c.o.d"
+  "/root/repo/App/driver/i2c.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/i2c.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/i2c.c.o.d"
+  "/root/repo/App/driver/journal.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/journal.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/journal.c.o.d"
+  "/root/repo/App/driver/keyboard.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/keyboard.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/keyboard.c.o.d"
+  "/root/repo/App/driver/py25q16.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/py25q16.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/py25q16.c.o.d"
+  "/root/repo/App/driver/st7565.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/st7565.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/st7565.c.o.d"
+  "/root/repo/App/driver/system.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/system.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/system.c.o.d"
+  "/root/repo/App/driver/systick.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/systick.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/systick.c.o.d"
+  "/root/repo/App/driver/uart.c" "CMakeFiles/k5sim.dir/root/repo/App/driver/uart.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/driver/uart.c.o.d"
+  "/root/repo/App/external/printf/printf.c" "CMakeFiles/k5sim.dir/root/repo/App/external/printf/printf.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/external/printf/printf.c.o.d"
+  "/root/repo/App/font.c" "CMakeFiles/k5sim.dir/root/repo/App/font.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/font.c.o.d"
+  "/root/repo/App/frequencies.c" "CMakeFiles/k5sim.dir/root/repo/App/frequencies.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/frequencies.c.o.d"
+  "/root/repo/App/functions.c" "CMakeFiles/k5sim.dir/root/repo/App/functions.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/functions.c.o.d"
+  "/root/repo/App/helper/battery.c" "CMakeFiles/k5sim.dir/root/repo/App/helper/battery.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/helper/battery.c.o.d"
+  "/root/repo/App/helper/boot.c" "CMakeFiles/k5sim.dir/root/repo/App/helper/boot.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/helper/boot.c.o.d"
+  "/root/repo/App/k5viewer.c" "CMakeFiles/k5sim.dir/root/repo/App/k5viewer.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/k5viewer.c.o.d"
+  "/root/repo/App/main.c" "CMakeFiles/k5sim.dir/root/repo/App/main.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/main.c.o.d"
+  "/root/repo/App/misc.c" "CMakeFiles/k5sim.dir/root/repo/App/misc.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/misc.c.o.d"
+  "/root/repo/App/radio.c" "CMakeFiles/k5sim.dir/root/repo/App/radio.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/radio.c.o.d"
+  "/root/repo/App/scheduler.c" "CMakeFiles/k5sim.dir/root/repo/App/scheduler.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/scheduler.c.o.d"
+  "/root/repo/App/settings.c" "CMakeFiles/k5sim.dir/root/repo/App/settings.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/settings.c.o.d"
+  "/root/repo/App/timer.c" "CMakeFiles/k5sim.dir/root/repo/App/timer.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/timer.c.o.d"
+  "/root/repo/App/ui/aircopy.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/aircopy.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/aircopy.c.o.d"
+  "/root/repo/App/ui/battery.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/battery.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/battery.c.o.d"
+  "/root/repo/App/ui/fmradio.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/fmradio.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/fmradio.c.o.d"
+  "/root/repo/App/ui/helper.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/helper.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/helper.c.o.d"
+  "/root/repo/App/ui/inputbox.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/inputbox.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/inputbox.c.o.d"
+  "/root/repo/App/ui/main.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/main.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/main.c.o.d"
+  "/root/repo/App/ui/menu.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/menu.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/menu.c.o.d"
+  "/root/repo/App/ui/scanner.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/scanner.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/scanner.c.o.d"
+  "/root/repo/App/ui/status.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/status.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/status.c.o.d"
+  "/root/repo/App/ui/ui.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/ui.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/ui.c.o.d"
+  "/root/repo/App/ui/welcome.c" "CMakeFiles/k5sim.dir/root/repo/App/ui/welcome.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/ui/welcome.c.o.d"
+  "/root/repo/App/version.c" "CMakeFiles/k5sim.dir/root/repo/App/version.c.o" "gcc" "CMakeFiles/k5sim.dir/root/repo/App/version.c.o.d"
+  "/root/repo/host/sim/bk4819.c" "CMakeFiles/k5sim.dir/sim/bk4819.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/bk4819.c.o.d"
+  "/root/repo/host/sim/core.c" "CMakeFiles/k5sim.dir/sim/core.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/core.c.o.d"
+  "/root/repo/host/sim/periph.c" "CMakeFiles/k5sim.dir/sim/periph.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/periph.c.o.d"
+  "/root/repo/host/sim/py25q16.c" "CMakeFiles/k5sim.dir/sim/py25q16.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/py25q16.c.o.d"
+  "/root/repo/host/sim/st7565.c" "CMakeFiles/k5sim.dir/sim/st7565.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/st7565.c.o.d"
+  "/root/repo/host/sim/usb.c" "CMakeFiles/k5sim.dir/sim/usb.c.o" "gcc" "CMakeFiles/k5sim.dir/sim/usb.c.o.d"
+  "/root/repo/host/viewer.c" "CMakeFiles/k5sim.dir/viewer.c.o" "gcc" "CMakeFiles/k5sim.dir/viewer.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,147 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/k5sim.dir/check.c.o"
+  "CMakeFiles/k5sim.dir/check.c.o.d"
+  "CMakeFiles/k5sim.dir/main.c.o"
+  "CMakeFiles/k5sim.dir/main.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/action.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/action.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/aircopy.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/aircopy.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/app.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/app.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/beam.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/beam.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/breakout.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/breakout.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/chFrScanner.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/chFrScanner.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/common.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/common.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/dtmf.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/dtmf.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/flashlight.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/flashlight.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/fm.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/fm.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/generic.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/generic.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/main.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/main.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/menu.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/menu.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/rxtx_log.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/rxtx_log.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/scanner.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/scanner.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/spectrum.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/spectrum.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/uart.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/app/uart.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/audio.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/audio.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/bitmaps.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/bitmaps.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/board.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/board.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/dcs.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/dcs.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/backlight.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/backlight.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/bk1080.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/bk1080.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/bk4829.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/bk4829.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/crc.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/crc.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/eeprom_compat.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/eeprom_compat.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/gpio.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/gpio.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/i2c.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/i2c.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/journal.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/journal.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/keyboard.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/keyboard.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/py25q16.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/py25q16.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/st7565.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/st7565.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/system.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/system.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/systick.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/systick.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/uart.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/driver/uart.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/external/printf/printf.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/external/printf/printf.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/font.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/font.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/frequencies.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/frequencies.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/functions.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/functions.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/helper/battery.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/helper/battery.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/helper/boot.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/helper/boot.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/k5viewer.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/k5viewer.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/main.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/main.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/misc.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/misc.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/radio.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/radio.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/scheduler.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/scheduler.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/settings.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/settings.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/timer.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/timer.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/aircopy.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/aircopy.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/battery.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/battery.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/fmradio.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/fmradio.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/helper.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/helper.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/inputbox.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/inputbox.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/main.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/main.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/menu.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/menu.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/scanner.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/scanner.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/status.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/status.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/ui.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/ui.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/welcome.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/ui/welcome.c.o.d"
+  "CMakeFiles/k5sim.dir/root/repo/App/version.c.o"
+  "CMakeFiles/k5sim.dir/root/repo/App/version.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/bk4819.c.o"
+  "CMakeFiles/k5sim.dir/sim/bk4819.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/core.c.o"
+  "CMakeFiles/k5sim.dir/sim/core.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/periph.c.o"
+  "CMakeFiles/k5sim.dir/sim/periph.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/py25q16.c.o"
+  "CMakeFiles/k5sim.dir/sim/py25q16.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/st7565.c.o"
+  "CMakeFiles/k5sim.dir/sim/st7565.c.o.d"
+  "CMakeFiles/k5sim.dir/sim/usb.c.o"
+  "CMakeFiles/k5sim.dir/sim/usb.c.o.d"
+  "CMakeFiles/k5sim.dir/viewer.c.o"
+  "CMakeFiles/k5sim.dir/viewer.c.o.d"
+  "k5sim"
+  "k5sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/k5sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,2487 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// Consistency checks of firmware internals against straightforward reference
+// implementations. They run between two main loop iterations, when no
+// driver transaction is in progress.
+
+#include <inttypes.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "app/dtmf.h"
+#include "app/rxtx_log.h"
+#include "audio.h"
+#include "check.h"
+#include "dcs.h"
+#include "driver/bk4819.h"
+#include "driver/eeprom.h"
+#include "driver/journal.h"
+#include "driver/py25q16.h"
+#include "driver/st7565.h"
+#include "driver/system.h"
+#include "driver/uart.h"
+#include "functions.h"
+#include "k5viewer.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+#include "sim/sim.h"
+#include "timer.h"
+#include "viewer.h"
+
+// ---------------------------------------------------------------------------
+// Scan list index
+
+// RADIO_FindNextChannel() as it was before the index: one channel at a time
+static uint16_t LinearFindNextChannel(uint16_t Channel, int8_t Direction, bool bCheckScanList, uint8_t VFO)
+{
+    for (uint16_t i = 0; IS_MR_CHANNEL(i); i++, Channel += Direction) {
+        if (Channel == 0xFFFF) {
+            Channel = MR_CHANNEL_LAST;
+        } else if (!IS_MR_CHANNEL(Channel)) {
+            Channel = MR_CHANNEL_FIRST;
+        }
+
+        if (RADIO_CheckValidChannel(Channel, bCheckScanList, VFO)) {
+            return Channel;
+        }
+    }
+
+    return 0xFFFF;
+}
+
+static bool LinearCheckValidList(uint8_t scanList)
+{
+    if (scanList == MR_CHANNELS_LIST + 1)
+        return true;
+
+    for (uint16_t i = 0; IS_MR_CHANNEL(i); i++) {
+        const ChannelAttributes_t *att = MR_GetChannelAttributes(i);
+        if (att->scanlist == scanList && att->exclude == false)
+            return true;
+    }
+
+    return false;
+}
+
+static ChannelAttributes_t RandomAttributes(unsigned Density)
+{
+    ChannelAttributes_t att;
+
+    if ((unsigned)(rand() % 100) >= Density) {
+        att.__val = 0xFFFF;
+        return att;
+    }
+
+    att.__val     = 0;
+    att.band      = rand() % 7;
+    att.compander = rand() % 4;
+    att.exclude   = (rand() % 10) == 0;
+
+    // Few lists per map, so that most of them are sparse
+    switch (rand() % 4) {
+        case 0:  att.scanlist = 0;                        break;
+        case 1:  att.scanlist = 1 + (rand() % 3);         break;
+        case 2:  att.scanlist = 1 + (rand() % MR_CHANNELS_LIST); break;
+        default: att.scanlist = (rand() % 8) ? 5 : MR_CHANNELS_LIST + 1; break;
+    }
+
+    return att;
+}
+
+static unsigned CompareScanLists(unsigned *pLookups)
+{
+    unsigned mismatches = 0;
+
+    for (uint8_t list = 0; list <= MR_CHANNELS_LIST + 2; list++) {
+        if (list <= MR_CHANNELS_LIST + 1 && RADIO_CheckValidList(list) != LinearCheckValidList(list)) {
+            fprintf(stderr, "[check] RADIO_CheckValidList(%u) differs\n", list);
+            mismatches++;
+        }
+
+        for (unsigned n = 0; n < 32; n++) {
+            const uint16_t start = (n < 2) ? (uint16_t)(n * MR_CHANNEL_LAST) : (uint16_t)(rand() % MR_CHANNELS_MAX);
+
+            for (int dir = -1; dir <= 1; dir += 2) {
+                for (int check = 0; check < 2; check++) {
+                    const uint16_t want = LinearFindNextChannel(start, dir, check, list);
+                    const uint16_t got  = RADIO_FindNextChannel(start, dir, check, list);
+
+                    (*pLookups)++;
+                    if (got != want) {
+                        fprintf(stderr, "[check] RADIO_FindNextChannel(%u, %d, %d, %u) = %u, expected %u\n",
+                            start, dir, check, list, got, want);
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+bool CHECK_ScanLists(unsigned Rounds, unsigned Seed)
+{
+    uint8_t *const image      = SIM_PY25Q16_Image();
+    unsigned       lookups    = 0;
+    unsigned       mismatches = 0;
+
+    srand(Seed);
+
+    for (unsigned round = 0; round < Rounds; round++) {
+        const unsigned density = 1 + rand() % 100;
+
+        // Whole map written behind the firmware's back, then reloaded
+        for (uint16_t ch = 0; ch < MR_CHANNELS_MAX; ch++) {
+            const ChannelAttributes_t att = RandomAttributes(density);
+            memcpy(image + 0x8000 + ch * 2, &att, sizeof(att));
+        }
+        MR_InvalidateChannelAttributesCache();
+
+        gEeprom.SCAN_LIST_ENABLED       = rand() % 2;
+        gEeprom.SCANLIST_PRIORITY_CH[0] = rand() % MR_CHANNELS_MAX;
+        gEeprom.SCANLIST_PRIORITY_CH[1] = rand() % MR_CHANNELS_MAX;
+
+        mismatches += CompareScanLists(&lookups);
+
+        // Incremental updates: saved, deleted, excluded, moved channels
+        for (unsigned n = 0; n < 8; n++) {
+            const uint16_t      ch  = rand() % MR_CHANNELS_MAX;
+            ChannelAttributes_t att = RandomAttributes(density);
+
+            if (att.__val == 0xFFFF) {
+                att.__val = 0;
+                att.band  = 7;
+            }
+            MR_SetChannelAttributes(ch, &att);
+        }
+
+        mismatches += CompareScanLists(&lookups);
+    }
+
+    printf("check-scanlists: %u rounds, %u lookups, %u mismatches\n", Rounds, lookups, mismatches);
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Settings journal
+
+#define JOURNAL_BLOCK 8
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+} Area_t;
+
+static const Area_t gAreas[] = {
+    { 0x009000, 0x00D8 },
+    { 0x00A000, 0x0170 },
+};
+
+// Sector nobody uses, written the way every save was before the journal
+#define LEGACY_SECTOR 0x014000
+
+typedef struct
+{
+    unsigned writes;
+    uint64_t erases;
+    uint64_t cycles;
+    uint64_t maxCycles;
+} WriteStats_t;
+
+static jmp_buf gPowerCut;
+
+static void PowerCut(void)
+{
+    longjmp(gPowerCut, 1);
+}
+
+static void TimedWrite(WriteStats_t *pStats, uint32_t Address, const void *pBuffer, uint32_t Size, bool Flush)
+{
+    const uint64_t erases = gSimStats.flashSectorErases;
+    const uint64_t start  = gSimCycles;
+
+    PY25Q16_WriteBuffer(Address, pBuffer, Size, false);
+    if (Flush)
+        PY25Q16_Flush();
+
+    const uint64_t cycles = gSimCycles - start;
+
+    pStats->writes++;
+    pStats->erases += gSimStats.flashSectorErases - erases;
+    pStats->cycles += cycles;
+    if (pStats->maxCycles < cycles)
+        pStats->maxCycles = cycles;
+}
+
+static void PrintWriteStats(const char *pTitle, const WriteStats_t *pStats)
+{
+    printf("  %-8s %6u writes %6llu erases, %8.3f ms avg %8.3f ms max\n", pTitle, pStats->writes,
+        (unsigned long long)pStats->erases,
+        pStats->writes ? pStats->cycles / (SIM_CPU_HZ / 1000.0) / pStats->writes : 0.0,
+        pStats->maxCycles / (SIM_CPU_HZ / 1000.0));
+}
+
+// Blocks of an area that hold neither Before nor After
+static unsigned CompareArea(const Area_t *pArea, const uint8_t *pBefore, const uint8_t *pAfter)
+{
+    uint8_t  data[0x200];
+    unsigned mismatches = 0;
+
+    PY25Q16_ReadBuffer(pArea->address, data, pArea->size);
+
+    for (uint32_t i = 0; i < pArea->size; i += JOURNAL_BLOCK) {
+        const uint32_t n = (pArea->size - i < JOURNAL_BLOCK) ? pArea->size - i : JOURNAL_BLOCK;
+
+        if (memcmp(data + i, pBefore + i, n) != 0 && memcmp(data + i, pAfter + i, n) != 0) {
+            fprintf(stderr, "[check] journal: %06x differs\n", pArea->address + i);
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+bool CHECK_Journal(unsigned Writes, unsigned Seed)
+{
+    // Static: they change between setjmp() and longjmp()
+    static uint8_t      before[2][0x200];
+    static uint8_t      after[2][0x200];
+    static WriteStats_t journal;
+    static WriteStats_t legacy;
+    static unsigned     cuts;
+    static unsigned     mismatches;
+    static uint64_t     nextCut;
+    uint64_t            erases;
+
+    memset(&journal, 0, sizeof(journal));
+    memset(&legacy, 0, sizeof(legacy));
+    cuts       = 0;
+    mismatches = 0;
+    srand(Seed);
+
+    for (unsigned a = 0; a < 2; a++) {
+        PY25Q16_ReadBuffer(gAreas[a].address, before[a], gAreas[a].size);
+        memcpy(after[a], before[a], gAreas[a].size);
+    }
+
+    // Flash operations (programmed bytes, erases) until the next power cut
+    nextCut = 1 + rand() % 4000;
+    erases  = gSimStats.flashSectorErases;
+
+    for (unsigned n = 0; n < Writes; n++) {
+        const unsigned  a    = rand() % 2;
+        const Area_t   *area = &gAreas[a];
+        const uint32_t  size = 1 + rand() % ((rand() % 4) ? 8 : 64);
+        const uint32_t  off  = rand() % (area->size - (size < area->size ? size : area->size) + 1);
+        uint8_t         data[64];
+
+        // Settings mostly change a field or two, sometimes nothing at all
+        memcpy(data, after[a] + off, size);
+        for (unsigned k = rand() % 3; k > 0; k--)
+            data[rand() % size] = rand();
+        memcpy(after[a] + off, data, size);
+
+        if (setjmp(gPowerCut) == 0) {
+            SIM_PY25Q16_PowerCut(nextCut, PowerCut);
+            TimedWrite(&journal, area->address + off, data, size, false);
+            memcpy(before[a] + off, data, size);
+
+            // Time for the background compaction now and then
+            for (unsigned k = rand() % 4; k > 0; k--)
+                JOURNAL_Task10ms();
+
+            nextCut = SIM_PY25Q16_PowerCut(0, NULL);
+        } else {
+            // Power lost, the write (or the compaction after it) was torn:
+            // reboot the driver and see what is left
+            cuts++;
+            nextCut = 1 + rand() % 4000;
+            PY25Q16_Init();
+        }
+
+        for (unsigned k = 0; k < 2; k++) {
+            mismatches += CompareArea(&gAreas[k], before[k], after[k]);
+
+            // Whatever survived the cut is the new reference
+            PY25Q16_ReadBuffer(gAreas[k].address, before[k], gAreas[k].size);
+            memcpy(after[k], before[k], gAreas[k].size);
+        }
+    }
+
+    SIM_PY25Q16_PowerCut(0, NULL);
+    erases = gSimStats.flashSectorErases - erases;
+
+    // Same write pattern through the sector read-modify-write path, written
+    // back at once as a save has to be
+    srand(Seed);
+    for (unsigned n = 0; n < Writes; n++) {
+        const uint32_t size = 1 + rand() % ((rand() % 4) ? 8 : 64);
+        uint8_t        data[64];
+
+        for (uint32_t k = 0; k < size; k++)
+            data[k] = rand();
+        TimedWrite(&legacy, LEGACY_SECTOR + rand() % (0x200 - size), data, size, true);
+    }
+
+    printf("check-journal: %u writes, %u power cuts, %u mismatches\n", Writes, cuts, mismatches);
+    PrintWriteStats("journal", &journal);
+    printf("  journal  %6llu erases including compaction\n", (unsigned long long)erases);
+    PrintWriteStats("legacy", &legacy);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// RX/TX log sector index
+
+#define RXTX_LOG_BASE   0x1E0000
+#define RXTX_LOG_SIZE   0x8000
+#define RXTX_LOG_SLOTS  (RXTX_LOG_SIZE / 32)
+
+typedef struct
+{
+    unsigned boots;
+    uint64_t bytes;
+    uint64_t cycles;
+    uint64_t maxCycles;
+} BootStats_t;
+
+// Entry as written by firmware without sector headers: display fields, a
+// pad byte, the sequence, reserved bytes, CRC-8 (init 0x5A, poly 0x31) of
+// the first 30 bytes and the 0xA5 commit byte
+static void WriteLegacyEntry(uint8_t *pSlot, uint32_t Sequence, uint32_t TrafficSeq, bool Marker)
+{
+    uint8_t crc = 0x5A;
+
+    memset(pSlot, 0xFF, 32);
+    memset(pSlot, 0, 16);
+    if (!Marker) {
+        const uint32_t frequency = 14500000 + rand() % 100000;
+
+        memcpy(pSlot, &frequency, 4);
+        pSlot[12] = rand() % 2;
+    } else {
+        pSlot[12] = 1u << 3;
+    }
+    memcpy(pSlot + 4, &TrafficSeq, 4);
+    pSlot[15] = 0xFF;
+    memcpy(pSlot + 16, &Sequence, 4);
+
+    for (unsigned i = 0; i < 30; i++) {
+        crc ^= pSlot[i];
+        for (unsigned bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    pSlot[30] = crc;
+    pSlot[31] = 0xA5;
+}
+
+// Legacy log of random length, wrapped like the firmware wraps it
+static void WriteLegacyLog(uint8_t *pImage)
+{
+    const unsigned count   = rand() % (2 * RXTX_LOG_SLOTS);
+    uint32_t       traffic = 0;
+
+    for (unsigned n = 0; n < count; n++) {
+        uint8_t *const slot   = pImage + RXTX_LOG_BASE + (n % RXTX_LOG_SLOTS) * 32;
+        const bool     marker = (rand() % 8) == 0;
+
+        if (n >= RXTX_LOG_SLOTS && (n % 128) == 0)
+            memset(slot, 0xFF, 0x1000);
+        WriteLegacyEntry(slot, n, marker ? traffic : traffic++, marker);
+    }
+}
+
+static void TimedFindHead(BootStats_t *pStats, RXTX_LogHead_t *pHead, bool Linear)
+{
+    const uint64_t bytes  = gSimStats.flashReadBytes;
+    const uint64_t start  = gSimCycles;
+
+    RXTX_LOG_FindHead(pHead, Linear);
+
+    const uint64_t cycles = gSimCycles - start;
+
+    pStats->boots++;
+    pStats->bytes  += gSimStats.flashReadBytes - bytes;
+    pStats->cycles += cycles;
+    if (pStats->maxCycles < cycles)
+        pStats->maxCycles = cycles;
+}
+
+static void PrintBootStats(const char *pTitle, const BootStats_t *pStats)
+{
+    printf("  %-8s %6u boots %8.0f bytes read avg, %8.3f ms avg %8.3f ms max\n", pTitle, pStats->boots,
+        pStats->boots ? (double)pStats->bytes / pStats->boots : 0.0,
+        pStats->boots ? pStats->cycles / (SIM_CPU_HZ / 1000.0) / pStats->boots : 0.0,
+        pStats->maxCycles / (SIM_CPU_HZ / 1000.0));
+}
+
+static unsigned CompareHeads(BootStats_t *pIndexed, BootStats_t *pLinear)
+{
+    RXTX_LogHead_t want;
+    RXTX_LogHead_t got;
+
+    PY25Q16_Flush();
+    TimedFindHead(pLinear, &want, true);
+    TimedFindHead(pIndexed, &got, false);
+
+    if (got.found != want.found || got.hasTraffic != want.hasTraffic ||
+        got.nextAddress != want.nextAddress || got.nextSequence != want.nextSequence ||
+        got.nextTrafficSequence != want.nextTrafficSequence || got.lastFlags != want.lastFlags) {
+        fprintf(stderr, "[check] rxtx log head %06x seq %u traffic %u flags %02x, expected %06x seq %u traffic %u flags %02x\n",
+            got.nextAddress, got.nextSequence, got.nextTrafficSequence, got.lastFlags,
+            want.nextAddress, want.nextSequence, want.nextTrafficSequence, want.lastFlags);
+        return 1;
+    }
+
+    return 0;
+}
+
+bool CHECK_RxTxLog(unsigned Rounds, unsigned Seed)
+{
+    // Static: they change between setjmp() and longjmp()
+    static BootStats_t indexed;
+    static BootStats_t upgrade;
+    static BootStats_t linear;
+    static unsigned    entries;
+    static unsigned    cuts;
+    static unsigned    mismatches;
+    static uint64_t    nextCut;
+    uint8_t *const     image = SIM_PY25Q16_Image();
+
+    memset(&indexed, 0, sizeof(indexed));
+    memset(&upgrade, 0, sizeof(upgrade));
+    memset(&linear, 0, sizeof(linear));
+    entries    = 0;
+    cuts       = 0;
+    mismatches = 0;
+    srand(Seed);
+
+    for (unsigned round = 0; round < Rounds; round++) {
+        const unsigned steps = RXTX_LOG_SLOTS / 2 + rand() % (3 * RXTX_LOG_SLOTS);
+        BootStats_t   *boots = (round & 1) ? &upgrade : &indexed;
+
+        // Odd rounds start from a log left by the previous firmware, read
+        // linearly until the log has wrapped over all of it
+        PY25Q16_Flush();
+        memset(image + RXTX_LOG_BASE, 0xFF, RXTX_LOG_SIZE);
+        if (round & 1)
+            WriteLegacyLog(image);
+        PY25Q16_Init();
+        RXTX_LOG_Init();
+        mismatches += CompareHeads(boots, &linear);
+
+        nextCut = 1 + rand() % 20000;
+
+        for (unsigned step = 0; step < steps; step++) {
+            bool reboot = false;
+
+            if (setjmp(gPowerCut) == 0) {
+                SIM_PY25Q16_PowerCut(nextCut, PowerCut);
+
+                if (rand() % 64 == 0) {
+                    RXTX_LOG_Init();
+                    reboot = true;
+                } else {
+                    if (rand() % 3)
+                        RXTX_LOG_BeginRx(&gEeprom.VfoInfo[0], FUNCTION_RECEIVE);
+                    else
+                        RXTX_LOG_BeginTx(&gEeprom.VfoInfo[0]);
+                    RXTX_LOG_EndActive();
+                    entries++;
+                }
+
+                if (rand() % 4 == 0)
+                    PY25Q16_Flush();
+
+                nextCut = SIM_PY25Q16_PowerCut(0, NULL);
+            } else {
+                // Power lost while the log was being written back
+                cuts++;
+                nextCut = 1 + rand() % 20000;
+                PY25Q16_Init();
+                RXTX_LOG_Init();
+                reboot = true;
+            }
+
+            if (reboot || step % 16 == 0)
+                mismatches += CompareHeads(boots, &linear);
+        }
+    }
+
+    SIM_PY25Q16_PowerCut(0, NULL);
+
+    printf("check-rxtxlog: %u rounds, %u entries, %u power cuts, %u mismatches\n", Rounds, entries, cuts, mismatches);
+    PrintBootStats("indexed", &indexed);
+    PrintBootStats("upgrade", &upgrade);
+    PrintBootStats("linear", &linear);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// BK4819 register shadow
+
+typedef struct
+{
+    unsigned calls;
+    uint64_t writes;
+    uint64_t reads;
+    uint64_t busCycles;
+} BusStats_t;
+
+// What a VFO switch, a channel step or a menu change leaves for the next
+// RADIO_SetupRegisters()
+static void RandomRxVfo(void)
+{
+    VFO_Info_t *vfo = &gEeprom.VfoInfo[rand() % 2];
+
+    gRxVfo = vfo;
+    if (rand() % 4)
+        return;
+
+    switch (rand() % 5)
+    {
+        case 0:
+            vfo->pRX->Frequency = 14400000 + (rand() % 400) * 1250;
+            break;
+        case 1:
+            vfo->CHANNEL_BANDWIDTH = rand() % 2;
+            break;
+        case 2:
+            vfo->Modulation = (rand() % 4) ? MODULATION_FM : MODULATION_AM;
+            break;
+        case 3:
+            vfo->pRX->CodeType = rand() % 4;
+            vfo->pRX->Code     = rand() % ((vfo->pRX->CodeType == CODE_TYPE_CONTINUOUS_TONE) ? ARRAY_SIZE(CTCSS_Options) : ARRAY_SIZE(DCS_Options));
+            break;
+        default:
+            vfo->SquelchOpenRSSIThresh  = rand() % 256;
+            vfo->SquelchCloseRSSIThresh = rand() % 256;
+            break;
+    }
+}
+
+static void SetupRegisters(BusStats_t *pStats)
+{
+    const SIM_Stats_t before = gSimStats;
+
+    RADIO_SetupRegisters(false);
+
+    pStats->calls++;
+    pStats->writes    += gSimStats.bkWrites - before.bkWrites;
+    pStats->reads     += gSimStats.bkReads - before.bkReads;
+    pStats->busCycles += gSimStats.bkBusCycles - before.bkBusCycles;
+}
+
+static void PrintBusStats(const char *pTitle, const BusStats_t *pStats)
+{
+    const double calls = pStats->calls ? pStats->calls : 1;
+
+    printf("  %-8s %6.1f writes %5.1f reads per call, %7.1f us bus per call\n", pTitle,
+        pStats->writes / calls, pStats->reads / calls,
+        pStats->busCycles / calls / (SIM_CPU_HZ / 1000000.0));
+}
+
+bool CHECK_Bk4819Shadow(unsigned Calls, unsigned Seed)
+{
+    VFO_Info_t *const rxVfo      = gRxVfo;
+    uint16_t         *regs       = malloc(Calls * 128 * sizeof(uint16_t));
+    uint32_t         *written    = calloc(Calls * 4, sizeof(uint32_t));
+    VFO_Info_t        vfos[2];
+    SIM_BK4819_Write_t trace[512];
+    BusStats_t        full       = { 0 };
+    BusStats_t        shadow     = { 0 };
+    unsigned          mismatches = 0;
+
+    // The same changes twice: the first time as before the shadow, every
+    // register written
+    memcpy(vfos, gEeprom.VfoInfo, sizeof(vfos));
+    srand(Seed);
+    for (unsigned n = 0; n < Calls; n++) {
+        RandomRxVfo();
+        BK4819_InvalidateRegisters();
+        SIM_BK4819_TraceStart(trace, ARRAY_SIZE(trace));
+        SetupRegisters(&full);
+
+        for (size_t k = SIM_BK4819_TraceStop(); k-- > 0; )
+            written[n * 4 + trace[k].reg / 32] |= 1u << (trace[k].reg % 32);
+        for (unsigned r = 0; r < 128; r++)
+            regs[n * 128 + r] = SIM_BK4819_GetRegister(r);
+    }
+
+    memcpy(gEeprom.VfoInfo, vfos, sizeof(vfos));
+    srand(Seed);
+    for (unsigned n = 0; n < Calls; n++) {
+        RandomRxVfo();
+        SetupRegisters(&shadow);
+
+        // Registers the call sets; the others keep whatever was there
+        for (unsigned r = 0; r < 128; r++) {
+            if ((written[n * 4 + r / 32] & (1u << (r % 32))) && SIM_BK4819_GetRegister(r) != regs[n * 128 + r]) {
+                fprintf(stderr, "[check] call %u: REG_%02X %04x, expected %04x\n", n, r,
+                    SIM_BK4819_GetRegister(r), regs[n * 128 + r]);
+                mismatches++;
+            }
+        }
+    }
+
+    free(regs);
+    free(written);
+    memcpy(gEeprom.VfoInfo, vfos, sizeof(vfos));
+    gRxVfo = rxVfo;
+    RADIO_SetupRegisters(true);
+
+    printf("check-bk4819: %u RADIO_SetupRegisters() calls, %u mismatches\n", Calls, mismatches);
+    PrintBusStats("full", &full);
+    PrintBusStats("shadow", &shadow);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Frequency-only retune
+
+typedef struct
+{
+    unsigned steps;
+    unsigned retunes;
+    uint64_t writes;
+    uint64_t cycles;
+} StepStats_t;
+
+typedef struct
+{
+    uint16_t        regs[128];
+    uint32_t        written[4];
+    // Frequency and REG_30 writes in order: the retune has to re-arm the
+    // receiver after the new frequency like the full setup does
+    SIM_BK4819_Write_t tune[8];
+    uint8_t         tuneLength;
+    FUNCTION_Type_t function;
+    DCS_CodeType_t  codeType;
+    bool            speaker;
+} StepState_t;
+
+// One scanner step: mostly the next frequency, now and then something that
+// needs the full setup, or a register written behind the radio's back as when
+// a reception starts
+static void RandomScanStep(VFO_Info_t *vfo)
+{
+    switch (rand() % 40)
+    {
+        case 0:
+            vfo->Modulation = (vfo->Modulation == MODULATION_FM) ? MODULATION_AM : MODULATION_FM;
+            break;
+        case 1:
+            vfo->CHANNEL_BANDWIDTH = !vfo->CHANNEL_BANDWIDTH;
+            break;
+        case 2:
+            vfo->pRX->CodeType = rand() % 4;
+            vfo->pRX->Code     = rand() % ((vfo->pRX->CodeType == CODE_TYPE_CONTINUOUS_TONE) ? ARRAY_SIZE(CTCSS_Options) : ARRAY_SIZE(DCS_Options));
+            break;
+        case 3:
+            gEeprom.SQUELCH_LEVEL = rand() % 10;
+            break;
+        case 4:
+            BK4819_SetAF(BK4819_AF_FM);
+            break;
+        case 5:
+            // Across the 28 MHz filter path switch
+            vfo->freq_config_RX.Frequency = (vfo->freq_config_RX.Frequency < 28000000) ? 14400000 : 2700000;
+            break;
+        default:
+            vfo->freq_config_RX.Frequency += 1250;
+            if (vfo->freq_config_RX.Frequency >= 18000000)
+                vfo->freq_config_RX.Frequency = 13600000;
+            else if (vfo->freq_config_RX.Frequency >= 2800000 && vfo->freq_config_RX.Frequency < 13600000)
+                vfo->freq_config_RX.Frequency = 2700000;
+            break;
+    }
+
+    RADIO_ApplyOffset(vfo);
+    RADIO_ConfigureSquelchAndOutputPower(vfo);
+}
+
+static void ScanStep(StepStats_t *pStats, StepState_t *pState, bool Retune)
+{
+    const SIM_Stats_t  before = gSimStats;
+    const uint64_t     cycles = gSimCycles;
+    SIM_BK4819_Write_t trace[512];
+
+    RandomScanStep(gRxVfo);
+
+    SIM_BK4819_TraceStart(trace, ARRAY_SIZE(trace));
+    if (!Retune)
+        RADIO_SetupRegisters(true);
+    else if (RADIO_Retune(true))
+        pStats->retunes++;
+
+    const size_t length = SIM_BK4819_TraceStop();
+
+    memset(pState->written, 0, sizeof(pState->written));
+    pState->tuneLength = 0;
+    for (size_t k = 0; k < length; k++) {
+        pState->written[trace[k].reg / 32] |= 1u << (trace[k].reg % 32);
+        if ((trace[k].reg == BK4819_REG_30 || trace[k].reg == BK4819_REG_38 || trace[k].reg == BK4819_REG_39) &&
+            pState->tuneLength < ARRAY_SIZE(pState->tune))
+        {
+            pState->tune[pState->tuneLength++] = trace[k];
+        }
+    }
+    for (unsigned r = 0; r < 128; r++)
+        pState->regs[r] = SIM_BK4819_GetRegister(r);
+
+    pState->function = gCurrentFunction;
+    pState->codeType = gCurrentCodeType;
+    pState->speaker  = gEnableSpeaker;
+
+    pStats->steps++;
+    pStats->writes += gSimStats.bkWrites - before.bkWrites;
+    pStats->cycles += gSimCycles - cycles;
+}
+
+static void PrintStepStats(const char *pTitle, const StepStats_t *pStats)
+{
+    const double steps  = pStats->steps ? pStats->steps : 1;
+    const double stepUs = pStats->cycles / steps / (SIM_CPU_HZ / 1000000.0);
+
+    printf("  %-8s %5.1f writes %7.1f us per step, %4.1f%% retuned\n", pTitle,
+        pStats->writes / steps, stepUs, 100.0 * pStats->retunes / steps);
+}
+
+bool CHECK_Retune(unsigned Steps, unsigned Seed)
+{
+    VFO_Info_t *const rxVfo      = gRxVfo;
+    const uint8_t     squelch    = gEeprom.SQUELCH_LEVEL;
+    StepState_t      *states     = malloc(Steps * sizeof(StepState_t));
+    VFO_Info_t        vfos[2];
+    StepState_t       state;
+    StepStats_t       full       = { 0 };
+    StepStats_t       retune     = { 0 };
+    unsigned          mismatches = 0;
+
+    memcpy(vfos, gEeprom.VfoInfo, sizeof(vfos));
+
+    // The same steps twice: through RADIO_SetupRegisters() and through
+    // RADIO_Retune()
+    for (unsigned pass = 0; pass < 2; pass++) {
+        memcpy(gEeprom.VfoInfo, vfos, sizeof(vfos));
+        gEeprom.SQUELCH_LEVEL = squelch;
+        gRxVfo = &gEeprom.VfoInfo[0];
+        gRxVfo->freq_config_RX.Frequency = 14400000;
+        RADIO_ApplyOffset(gRxVfo);
+        RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
+        RADIO_SetupRegisters(true);
+
+        srand(Seed);
+        for (unsigned n = 0; n < Steps; n++) {
+            if (pass == 0) {
+                ScanStep(&full, &states[n], false);
+                continue;
+            }
+
+            ScanStep(&retune, &state, true);
+
+            // Registers either path sets; the others keep whatever was there
+            for (unsigned r = 0; r < 128; r++) {
+                if (((states[n].written[r / 32] | state.written[r / 32]) & (1u << (r % 32))) && state.regs[r] != states[n].regs[r]) {
+                    fprintf(stderr, "[check] step %u: REG_%02X %04x, expected %04x\n", n, r, state.regs[r], states[n].regs[r]);
+                    mismatches++;
+                }
+            }
+
+            bool sameTune = state.tuneLength == states[n].tuneLength;
+            for (unsigned k = 0; sameTune && k < state.tuneLength; k++)
+                sameTune = state.tune[k].reg == states[n].tune[k].reg && state.tune[k].value == states[n].tune[k].value;
+
+            if (!sameTune) {
+                fprintf(stderr, "[check] step %u: %u frequency / REG_30 writes, expected %u\n", n,
+                    state.tuneLength, states[n].tuneLength);
+                mismatches++;
+            }
+
+            if (state.function != states[n].function || state.codeType != states[n].codeType || state.speaker != states[n].speaker) {
+                fprintf(stderr, "[check] step %u: function %u code type %u speaker %u, expected %u %u %u\n", n,
+                    state.function, state.codeType, state.speaker,
+                    states[n].function, states[n].codeType, states[n].speaker);
+                mismatches++;
+            }
+        }
+    }
+
+    free(states);
+    memcpy(gEeprom.VfoInfo, vfos, sizeof(vfos));
+    gEeprom.SQUELCH_LEVEL = squelch;
+    gRxVfo = rxVfo;
+    RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
+    RADIO_SetupRegisters(true);
+
+    printf("check-retune: %u scan steps, %u mismatches\n", Steps, mismatches);
+    PrintStepStats("full", &full);
+    PrintStepStats("retune", &retune);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// ST7565 partial blits
+
+static uint8_t *LcdPage(unsigned Page)
+{
+    return (Page == 0) ? gStatusLine : gFrameBuffer[Page - 1];
+}
+
+// What a screen update does to the buffers: a few glyphs or bars redrawn,
+// sometimes the whole screen cleared and redrawn
+static void RandomDrawing(void)
+{
+    const unsigned count = rand() % 6;
+
+    if (rand() % 8 == 0) {
+        memset(gStatusLine, 0, sizeof(gStatusLine));
+        memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+    }
+
+    for (unsigned k = 0; k < count; k++) {
+        uint8_t *page   = LcdPage(rand() % (FRAME_LINES + 1));
+        unsigned column = rand() % LCD_WIDTH;
+        unsigned length = 1 + rand() % ((rand() % 4) ? 8 : LCD_WIDTH);
+
+        if (column + length > LCD_WIDTH)
+            length = LCD_WIDTH - column;
+        for (unsigned i = 0; i < length; i++)
+            page[column + i] = (rand() % 3) ? rand() : page[column + i] ^ 0xFF;
+    }
+}
+
+// Let the queued page updates go out
+static void LcdDrain(void)
+{
+    for (unsigned i = 0; i < 1000 && SIM_ST7565_SelectedPage() >= 0; i++)
+        SIM_AdvanceUs(100);
+}
+
+#define LCD_SNAPSHOTS 8
+
+bool CHECK_Lcd(unsigned Frames, unsigned Seed)
+{
+    uint8_t  statusLine[LCD_WIDTH];
+    uint8_t  frameBuffer[FRAME_LINES][LCD_WIDTH];
+    uint8_t  image[8][128];
+    uint8_t  shown[8][128];                             // display at the last drain
+    uint8_t  snaps[8][LCD_SNAPSHOTS][LCD_WIDTH];        // pages blitted since
+    unsigned nsnaps[8] = {0};
+    uint8_t  blitted    = 0;    // pages blitted since the last direct write
+    uint8_t  direct     = 0;    // pages written directly since the last drain
+    uint64_t pages      = 0;
+    uint64_t stalled    = 0;    // cycles spent in the blits
+    unsigned samples    = 0;
+    unsigned mismatches = 0;
+    const uint64_t before = gSimStats.lcdDataBytes;
+
+    memcpy(statusLine, gStatusLine, sizeof(statusLine));
+    memcpy(frameBuffer, gFrameBuffer, sizeof(frameBuffer));
+
+    LcdDrain();
+    SIM_ST7565_GetImage(shown);
+
+    srand(Seed);
+    for (unsigned n = 0; n < Frames; n++) {
+        uint8_t blits = 0;
+
+        RandomDrawing();
+
+        switch (rand() % 16) {
+            case 0: {
+                // The battery icon goes straight to the display
+                uint8_t bitmap[16];
+                for (unsigned i = 0; i < sizeof(bitmap); i++)
+                    bitmap[i] = rand();
+                ST7565_DrawLine(LCD_WIDTH - sizeof(bitmap), 0, bitmap, sizeof(bitmap));
+                direct  |= 1u << 0;
+                blitted &= ~(1u << 0);
+                break;
+            }
+            case 1:
+                ST7565_FillScreen(0xFF);
+                direct  = 0xFF;
+                blitted = 0;
+                break;
+            case 2:
+                ST7565_FixInterfGlitch();
+                break;
+            default:
+                break;
+        }
+
+        const uint64_t start = gSimCycles;
+
+        switch (rand() % 4) {
+            case 0:
+                ST7565_BlitStatusLine();
+                blits = 1u << 0;
+                break;
+            case 1: {
+                const unsigned line = rand() % FRAME_LINES;
+                ST7565_BlitLine(line);
+                blits = 1u << (line + 1);
+                break;
+            }
+            default:
+                ST7565_BlitStatusLine();
+                ST7565_BlitFullScreen();
+                blits = 0xFF;
+                break;
+        }
+
+        stalled += gSimCycles - start;
+        pages   += __builtin_popcount(blits);
+        blitted |= blits;
+
+        for (unsigned page = 0; page < 8; page++) {
+            if ((blits & (1u << page)) && nsnaps[page] < LCD_SNAPSHOTS)
+                memcpy(snaps[page][nsnaps[page]++], LcdPage(page), LCD_WIDTH);
+        }
+
+        // The UI carries on while the pages go out. Every page but the one
+        // being addressed must show what it showed at the last drain or one
+        // of the frames blitted since: never half of one and half of another.
+        const unsigned steps = rand() % 4;
+        for (unsigned k = 0; k < steps; k++) {
+            SIM_AdvanceUs(rand() % 1500);
+            SIM_ST7565_GetImage(image);
+            samples++;
+
+            const int selected = SIM_ST7565_SelectedPage();
+            for (unsigned page = 0; page < 8; page++) {
+                if ((int)page == selected || (direct & (1u << page)))
+                    continue;
+
+                bool ok = memcmp(image[page], shown[page], LCD_WIDTH) == 0;
+                for (unsigned i = 0; !ok && i < nsnaps[page]; i++)
+                    ok = memcmp(image[page], snaps[page][i], LCD_WIDTH) == 0;
+
+                if (!ok) {
+                    fprintf(stderr, "[check] frame %u: page %u torn\n", n, page);
+                    mismatches++;
+                }
+            }
+        }
+
+        bool full = false;
+        for (unsigned page = 0; page < 8; page++)
+            full |= nsnaps[page] == LCD_SNAPSHOTS;
+
+        // Then the last frame blitted must be on the display
+        if (full || rand() % 4 == 0 || n + 1 == Frames) {
+            LcdDrain();
+            SIM_ST7565_GetImage(image);
+
+            for (unsigned page = 0; page < 8; page++) {
+                if ((blitted & (1u << page)) && memcmp(image[page], snaps[page][nsnaps[page] - 1], LCD_WIDTH) != 0) {
+                    fprintf(stderr, "[check] frame %u: page %u differs from the buffer\n", n, page);
+                    mismatches++;
+                }
+            }
+
+            memcpy(shown, image, sizeof(shown));
+            memset(nsnaps, 0, sizeof(nsnaps));
+            blitted = 0;
+            direct  = 0;
+        }
+    }
+
+    const uint64_t data = gSimStats.lcdDataBytes - before;
+
+    memcpy(gStatusLine, statusLine, sizeof(statusLine));
+    memcpy(gFrameBuffer, frameBuffer, sizeof(frameBuffer));
+    ST7565_BlitStatusLine();
+    ST7565_BlitFullScreen();
+    LcdDrain();
+
+    printf("check-lcd: %u frames, %u display samples, %u mismatches\n", Frames, samples, mismatches);
+    printf("  %.1f data bytes per page blitted, %u when sending whole pages\n",
+        pages ? (double)data / pages : 0.0, LCD_WIDTH);
+    printf("  %.0f us per frame in the blits\n",
+        Frames ? (double)stalled / SIM_CYCLES_PER_US / Frames : 0.0);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// K5Viewer mirror over the UART transmit ring
+
+// K5VIEWER_Chunk(): bit layer of 8 columns, one byte per column group
+static void ViewerChunk(unsigned Index, uint8_t *pDest)
+{
+    const unsigned inLine = Index % 16;
+    const unsigned bit    = inLine / 2;
+    const uint8_t *src    = LcdPage(Index / 16) + (inLine % 2) * (LCD_WIDTH / 2);
+
+    for (unsigned j = 0; j < 8; j++) {
+        uint8_t acc = 0;
+        for (unsigned k = 0; k < 8; k++)
+            if (src[j * 8 + k] & (1u << bit))
+                acc |= 1u << k;
+        pDest[j] = gSetting_set_inv ? ~acc : acc;
+    }
+}
+
+// What the viewer on the other end of the cable shows: the screen frames
+// (F0|flags, AA 55 type length, payload, 0A) applied to its copy of the
+// screen by the reference codec
+typedef struct {
+    VIEWER_Screen_t screen;
+    uint8_t  header[6];
+    unsigned state;             // bytes of the frame seen so far
+    unsigned length;
+    uint8_t  payload[VIEWER_PAYLOAD_MAX];
+    uint64_t bytes[2];          // diff, packed frames
+    unsigned frames;
+    unsigned errors;
+    unsigned collisions;
+} Viewer_t;
+
+static void ViewerByte(Viewer_t *v, uint8_t b)
+{
+    if (v->state < 6) {
+        static const uint8_t expected[3] = {0xF0, 0xAA, 0x55};
+        bool ok = true;
+
+        if (v->state == 0)
+            ok = (b & 0xF0) == 0xF0;
+        else if (v->state < 3)
+            ok = b == expected[v->state];
+        else if (v->state == 3)
+            ok = b == VIEWER_TYPE_DIFF || b == VIEWER_TYPE_PACKED;
+
+        if (!ok) {
+            v->errors++;
+            v->state = 0;
+            return;
+        }
+        v->header[v->state++] = b;
+        if (v->state == 6) {
+            v->length = (v->header[4] << 8) | v->header[5];
+            if (v->length > VIEWER_PAYLOAD_MAX) {
+                v->errors++;
+                v->state = 0;
+            }
+        }
+        return;
+    }
+
+    const unsigned offset = v->state - 6;
+
+    if (offset < v->length) {
+        v->payload[offset] = b;
+        v->state++;
+        return;
+    }
+
+    if (b != 0x0A || !VIEWER_Apply(&v->screen, v->header[3], v->payload, v->length))
+        v->errors++;
+    v->bytes[v->header[3] == VIEWER_TYPE_PACKED] += 7 + v->length;
+    v->frames++;
+    v->state = 0;
+}
+
+static void ViewerReceive(Viewer_t *v)
+{
+    uint8_t  buffer[256];
+    size_t   n;
+
+    while ((n = SIM_UartTake(buffer, sizeof(buffer))) > 0)
+        for (size_t i = 0; i < n; i++)
+            ViewerByte(v, buffer[i]);
+}
+
+// Keepalive, announcing packed frames or not
+static void ViewerPing(bool Packed)
+{
+    const uint8_t ping[4] = {0x55, 0xAA, Packed ? 0x05 : 0x00, Packed ? 0x04 : 0x00};
+
+    SIM_UartInject(ping, sizeof(ping));
+    K5VIEWER_ParseInput();
+}
+
+// K5VIEWER_Hash()
+static uint16_t ViewerHash(const uint8_t *pChunk)
+{
+    uint32_t h = 2166136261u;
+
+    for (unsigned i = 0; i < 8; i++)
+        h = (h ^ pChunk[i]) * 16777619u;
+    return (uint16_t)(h ^ (h >> 16));
+}
+
+// Chunks differing on the viewer. A chunk changed to one with the same
+// fingerprint is not sent, the forced chunk rotation repairs it: counted in
+// v->collisions.
+static unsigned ViewerCompare(Viewer_t *v, unsigned Screen)
+{
+    unsigned mismatches = 0;
+
+    for (unsigned i = 0; i < 128; i++) {
+        uint8_t expected[8];
+        ViewerChunk(i, expected);
+        if (memcmp(v->screen.chunks[i], expected, 8) == 0)
+            continue;
+        if (ViewerHash(v->screen.chunks[i]) == ViewerHash(expected)) {
+            v->collisions++;
+            continue;
+        }
+        fprintf(stderr, "[check] screen %u: chunk %u differs on the viewer\n", Screen, i);
+        mismatches++;
+    }
+    return mismatches;
+}
+
+// Let the updates catch up with the screen
+static void ViewerCatchUp(Viewer_t *v, bool Packed, unsigned *pUpdates)
+{
+    UART_Flush();
+    for (unsigned i = 0; i < 32 && K5VIEWER_HasPendingStateChange(); i++) {
+        ViewerPing(Packed);
+        K5VIEWER_Update(false);
+        (*pUpdates)++;
+        UART_Flush();
+    }
+    ViewerReceive(v);
+}
+
+static bool ScreenPixel(unsigned x, unsigned y)
+{
+    return (LcdPage(y / 8)[x] >> (y % 8)) & 1;
+}
+
+static void ScreenSetPixel(unsigned x, unsigned y, bool On)
+{
+    uint8_t *column = &LcdPage(y / 8)[x];
+
+    *column = On ? (*column | (1u << (y % 8))) : (*column & ~(1u << (y % 8)));
+}
+
+// A list or a trace scrolling: rows Top..Bottom-1 of the left, right or both
+// halves move up (Rows > 0) or down, the rows showing up are cleared
+static void ScreenScroll(unsigned Top, unsigned Bottom, int Rows)
+{
+    static const unsigned halves[3][2] = {{0, LCD_WIDTH}, {0, LCD_WIDTH / 2}, {LCD_WIDTH / 2, LCD_WIDTH}};
+    const unsigned *half = halves[rand() % 3];
+
+    for (unsigned n = 0; n < Bottom - Top; n++) {
+        const unsigned y = (Rows > 0) ? Top + n : Bottom - 1 - n;
+        const int from = (int)y + Rows;
+
+        for (unsigned x = half[0]; x < half[1]; x++)
+            ScreenSetPixel(x, y, from >= (int)Top && from < (int)Bottom && ScreenPixel(x, (unsigned)from));
+    }
+}
+
+#define VIEWER_SAVED 4
+
+bool CHECK_Viewer(unsigned Frames, unsigned Seed)
+{
+    static Viewer_t viewer;
+    static uint8_t saved[VIEWER_SAVED][FRAME_LINES + 1][LCD_WIDTH];
+    uint8_t  statusLine[LCD_WIDTH];
+    uint8_t  frameBuffer[FRAME_LINES][LCD_WIDTH];
+    uint64_t stalled    = 0;
+    uint64_t maxStall   = 0;
+    unsigned screens[2] = {0};
+    unsigned updates    = 0;
+    unsigned mismatches = 0;
+
+    memcpy(statusLine, gStatusLine, sizeof(statusLine));
+    memcpy(frameBuffer, gFrameBuffer, sizeof(frameBuffer));
+
+    UART_Flush();
+    ViewerReceive(&viewer);
+    memset(&viewer, 0, sizeof(viewer));
+    memset(saved, 0, sizeof(saved));
+
+    srand(Seed);
+    for (unsigned n = 0; n < Frames; n++) {
+        // Diff and packed frames in turn, the switch forces a full frame
+        const bool packed = (n / 64) % 2 == 1;
+
+        if (n % 8 == 0)
+            ViewerPing(packed);
+
+        switch (rand() % 8) {
+            case 0: {
+                const unsigned top    = rand() % 48;
+                const unsigned bottom = top + 8 + rand() % (LCD_HEIGHT - top - 7);
+                const int      rows   = 1 + rand() % 12;
+
+                ScreenScroll(top, bottom > LCD_HEIGHT ? LCD_HEIGHT : bottom, (rand() % 2) ? rows : -rows);
+                break;
+            }
+            case 1: {
+                // Back to an earlier screen
+                const unsigned i = rand() % VIEWER_SAVED;
+                memcpy(gStatusLine, saved[i][0], LCD_WIDTH);
+                memcpy(gFrameBuffer, saved[i][1], sizeof(gFrameBuffer));
+                break;
+            }
+            case 2: {
+                const unsigned i = rand() % VIEWER_SAVED;
+                memcpy(saved[i][0], gStatusLine, LCD_WIDTH);
+                memcpy(saved[i][1], gFrameBuffer, sizeof(gFrameBuffer));
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (rand() % 2)
+            RandomDrawing();
+
+        // The first update after the ping is the full frame of a new
+        // connection
+        const uint64_t start = gSimCycles;
+        K5VIEWER_Update(n == 0 || rand() % 16 == 0);
+        const uint64_t stall = gSimCycles - start;
+
+        stalled += stall;
+        if (stall > maxStall)
+            maxStall = stall;
+        updates++;
+        screens[packed]++;
+
+        SIM_AdvanceUs(rand() % 50000);
+        ViewerReceive(&viewer);
+
+        // Once the updates catch up, the viewer must show the screen
+        if (rand() % 8 == 0 || n + 1 == Frames || n % 64 == 63) {
+            ViewerCatchUp(&viewer, packed, &updates);
+            mismatches += ViewerCompare(&viewer, n);
+        }
+    }
+
+    if (viewer.errors) {
+        fprintf(stderr, "[check] %u framing errors\n", viewer.errors);
+        mismatches += viewer.errors;
+    }
+
+    memcpy(gStatusLine, statusLine, sizeof(statusLine));
+    memcpy(gFrameBuffer, frameBuffer, sizeof(frameBuffer));
+
+    printf("check-viewer: %u screens, %u updates, %u frames received, %u mismatches, %u fingerprint collisions\n",
+        Frames, updates, viewer.frames, mismatches, viewer.collisions);
+    printf("  %.0f bytes per screen in diff frames, %.0f in packed frames\n",
+        screens[0] ? (double)viewer.bytes[0] / screens[0] : 0.0,
+        screens[1] ? (double)viewer.bytes[1] / screens[1] : 0.0);
+    printf("  %.0f us per update waiting in K5VIEWER_Update(), %.0f us at most\n",
+        Frames ? (double)stalled / SIM_CYCLES_PER_US / Frames : 0.0,
+        (double)maxStall / SIM_CYCLES_PER_US);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// K5Viewer frames on recorded screens
+
+#define CORPUS_SCREENS  4096
+#define CORPUS_SEGMENTS 16
+
+typedef struct {
+    char     name[32];
+    unsigned first;
+    unsigned count;
+} CorpusSegment_t;
+
+static uint8_t         gCorpus[CORPUS_SCREENS][FRAME_LINES + 1][LCD_WIDTH];
+static CorpusSegment_t gSegments[CORPUS_SEGMENTS];
+static unsigned        gSegmentCount;
+static unsigned        gCorpusCount;
+static bool            gRecording;
+
+void CHECK_ViewerRecord(const char *pSegment)
+{
+    gRecording = pSegment != NULL && gSegmentCount < CORPUS_SEGMENTS;
+    if (!gRecording)
+        return;
+
+    CorpusSegment_t *segment = &gSegments[gSegmentCount++];
+
+    snprintf(segment->name, sizeof(segment->name), "%s", pSegment);
+    segment->first = gCorpusCount;
+    segment->count = 0;
+}
+
+void CHECK_ViewerRecordScreen(void)
+{
+    if (!gRecording || gCorpusCount == CORPUS_SCREENS)
+        return;
+
+    CorpusSegment_t *segment = &gSegments[gSegmentCount - 1];
+    uint8_t (*screen)[LCD_WIDTH] = gCorpus[gCorpusCount];
+
+    memcpy(screen[0], gStatusLine, LCD_WIDTH);
+    memcpy(screen[1], gFrameBuffer, sizeof(gFrameBuffer));
+
+    // Updates with nothing new on the screen send nothing
+    if (segment->count > 0 && memcmp(screen, gCorpus[gCorpusCount - 1], sizeof(gCorpus[0])) == 0)
+        return;
+
+    segment->count++;
+    gCorpusCount++;
+}
+
+static void CorpusShow(unsigned Screen)
+{
+    memcpy(gStatusLine, gCorpus[Screen][0], LCD_WIDTH);
+    memcpy(gFrameBuffer, gCorpus[Screen][1], sizeof(gFrameBuffer));
+}
+
+static uint64_t HostNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+// One segment mirrored from its first screen on: bytes and host time of the
+// updates after the full frame of the connection
+static unsigned CorpusMirror(const CorpusSegment_t *pSegment, bool Packed, uint64_t *pBytes, uint64_t *pNs)
+{
+    static Viewer_t viewer;
+    unsigned updates    = 0;
+    unsigned mismatches = 0;
+
+    UART_Flush();
+    ViewerReceive(&viewer);
+    memset(&viewer, 0, sizeof(viewer));
+
+    CorpusShow(pSegment->first);
+    ViewerPing(Packed);
+    K5VIEWER_Update(true);
+    ViewerCatchUp(&viewer, Packed, &updates);
+
+    const uint64_t before = gSimStats.uartTxBytes;
+
+    *pNs = 0;
+    for (unsigned i = 1; i < pSegment->count; i++) {
+        CorpusShow(pSegment->first + i);
+        ViewerPing(Packed);
+
+        const uint64_t start = HostNs();
+        K5VIEWER_Update(false);
+        *pNs += HostNs() - start;
+
+        ViewerCatchUp(&viewer, Packed, &updates);
+        mismatches += ViewerCompare(&viewer, pSegment->first + i);
+    }
+
+    *pBytes = gSimStats.uartTxBytes - before;
+    return mismatches + viewer.errors;
+}
+
+bool CHECK_ViewerCorpus(void)
+{
+    static VIEWER_Screen_t reference;
+    uint8_t  statusLine[LCD_WIDTH];
+    uint8_t  frameBuffer[FRAME_LINES][LCD_WIDTH];
+    uint8_t  payload[VIEWER_PAYLOAD_MAX];
+    unsigned mismatches = 0;
+
+    gRecording = false;
+    memcpy(statusLine, gStatusLine, sizeof(statusLine));
+    memcpy(frameBuffer, gFrameBuffer, sizeof(frameBuffer));
+
+    printf("bench-viewer: %u screens recorded\n", gCorpusCount);
+    printf("  %-10s %7s %12s %6s %14s %6s %17s\n",
+        "", "screens", "diff bytes", "us", "packed bytes", "us", "reference bytes");
+
+    for (unsigned s = 0; s < gSegmentCount; s++) {
+        const CorpusSegment_t *segment = &gSegments[s];
+        uint64_t diffBytes, diffNs, packedBytes, packedNs;
+        uint64_t referenceBytes = 0;
+
+        if (segment->count < 2)
+            continue;
+
+        mismatches += CorpusMirror(segment, false, &diffBytes, &diffNs);
+        mismatches += CorpusMirror(segment, true, &packedBytes, &packedNs);
+
+        memset(&reference, 0, sizeof(reference));
+        CorpusShow(segment->first);
+        for (unsigned i = 0; i < 128; i++)
+            ViewerChunk(i, reference.chunks[i]);
+        memcpy(reference.history[0], reference.chunks, sizeof(reference.chunks));
+
+        for (unsigned i = 1; i < segment->count; i++) {
+            uint8_t chunks[VIEWER_CHUNKS][8];
+
+            CorpusShow(segment->first + i);
+            for (unsigned c = 0; c < 128; c++)
+                ViewerChunk(c, chunks[c]);
+
+            const unsigned length = VIEWER_Pack(&reference, chunks, payload);
+            VIEWER_Apply(&reference, VIEWER_TYPE_PACKED, payload, length);
+            if (memcmp(reference.chunks, chunks, sizeof(chunks)) != 0)
+                mismatches++;
+            referenceBytes += 7 + length;
+        }
+
+        const double updates = segment->count - 1;
+
+        printf("  %-10s %7u %12.1f %6.1f %14.1f %6.1f %17.1f\n", segment->name, segment->count,
+            diffBytes / updates, diffNs / updates / 1000.0,
+            packedBytes / updates, packedNs / updates / 1000.0,
+            referenceBytes / updates);
+    }
+
+    memcpy(gStatusLine, statusLine, sizeof(statusLine));
+    memcpy(gFrameBuffer, frameBuffer, sizeof(frameBuffer));
+
+    printf("  bytes per screen after the first, host us per update; %u mismatches\n", mismatches);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Timer queue
+
+#define TIMER_CHECK_COUNT 8
+
+// Countdowns as SysTick_Handler() kept them before the queue: each one
+// decremented every tick its gate is open, DECREMENT_AND_TRIGGER()
+typedef struct {
+    uint16_t count;
+    uint16_t period;
+    uint8_t  gate;
+} Countdown_t;
+
+static TIMER_t     gCheckTimers[TIMER_CHECK_COUNT];
+static Countdown_t gCountdowns[TIMER_CHECK_COUNT];
+static uint32_t    gTimerFired;
+
+#define TIMER_FIRED(n) static void TimerFired##n(void) { gTimerFired |= 1u << n; }
+TIMER_FIRED(0) TIMER_FIRED(1) TIMER_FIRED(2) TIMER_FIRED(3)
+TIMER_FIRED(4) TIMER_FIRED(5) TIMER_FIRED(6) TIMER_FIRED(7)
+
+static void (*const gTimerCallbacks[TIMER_CHECK_COUNT])(void) = {
+    TimerFired0, TimerFired1, TimerFired2, TimerFired3,
+    TimerFired4, TimerFired5, TimerFired6, TimerFired7,
+};
+
+static uint32_t CountdownTick(uint8_t Open)
+{
+    uint32_t fired = 0;
+
+    for (unsigned i = 0; i < TIMER_CHECK_COUNT; i++) {
+        Countdown_t *c = &gCountdowns[i];
+
+        if ((Open & (1u << c->gate)) && c->count > 0 && --c->count == 0) {
+            fired  |= 1u << i;
+            c->count = c->period;
+        }
+    }
+
+    return fired;
+}
+
+static unsigned QueueLength(const TIMER_t *t)
+{
+    unsigned n = 0;
+
+    for (; t != NULL; t = t->pNext)
+        n++;
+    return n;
+}
+
+// Timers visited by TIMER_SetGates() and TIMER_Tick(): the gates that
+// change walk the queue or the held list, a tick the timers it pops
+static unsigned TimerVisits(uint8_t Open, uint32_t Fired)
+{
+    const uint8_t before  = gTimers.OpenGates & ~(1u << TIMER_GATE_NONE);
+    const uint8_t after   = Open & ~(1u << TIMER_GATE_NONE);
+    unsigned      visits  = 1 + __builtin_popcount(Fired);
+
+    if (before & ~after)
+        visits += QueueLength(gTimers.pQueue);
+    if (after & ~before)
+        visits += QueueLength(gTimers.pHeld);
+    return visits;
+}
+
+static void TimerStep(unsigned Timer, bool Periodic, uint16_t Ticks)
+{
+    Countdown_t *c = &gCountdowns[Timer];
+
+    c->count  = Ticks;
+    c->period = Periodic ? Ticks : 0;
+
+    if (Periodic)
+        TIMER_StartPeriodic(&gCheckTimers[Timer], Ticks);
+    else
+        TIMER_Start(&gCheckTimers[Timer], Ticks);
+}
+
+bool CHECK_Timers(unsigned Ticks, unsigned Seed)
+{
+    const TIMER_State_t saved = gTimers;
+    unsigned mismatches = 0;
+    unsigned misplaced  = 0;
+    unsigned expiries   = 0;
+    uint64_t visits     = 0;
+    uint64_t armed      = 0;
+    uint8_t  open       = 1u << TIMER_GATE_NONE;
+
+    srand(Seed);
+
+    // The firmware timers stay out of it: no SysTick while the check runs
+    gTimers = (TIMER_State_t){ NULL, NULL, open };
+
+    for (unsigned i = 0; i < TIMER_CHECK_COUNT; i++) {
+        const uint8_t gate = (i < 2) ? TIMER_GATE_NONE : 1 + (rand() % (TIMER_GATE_COUNT - 1));
+
+        gCheckTimers[i] = (TIMER_t)TIMER_INIT(gTimerCallbacks[i], gate);
+        gCountdowns[i]  = (Countdown_t){ 0, 0, gate };
+    }
+
+    for (unsigned tick = 0; tick < Ticks; tick++) {
+        // Main loop: restarts, stops and state changes between two ticks
+        if (rand() % 4 == 0) {
+            const unsigned i = rand() % TIMER_CHECK_COUNT;
+
+            switch (rand() % 8) {
+                case 0:  TimerStep(i, false, 0);                        break;
+                case 1:  TimerStep(i, true, 1 + rand() % 50);           break;
+                case 2:  TimerStep(i, false, 1 + rand() % 3);           break;
+                default: TimerStep(i, false, 1 + rand() % 300);         break;
+            }
+        }
+
+        if (rand() % 16 == 0)
+            open ^= 1u << (1 + rand() % (TIMER_GATE_COUNT - 1));
+
+        // SysTick
+        const uint32_t expected = CountdownTick(open);
+
+        gTimerFired = 0;
+        visits     += TimerVisits(open, expected);
+        TIMER_SetGates(0xFF, open);
+        TIMER_Tick();
+
+        if (gTimerFired != expected)
+            mismatches++;
+        expiries += __builtin_popcount(expected);
+
+        for (unsigned i = 0; i < TIMER_CHECK_COUNT; i++) {
+            if (TIMER_Remaining(&gCheckTimers[i]) != gCountdowns[i].count
+                || TIMER_IsArmed(&gCheckTimers[i]) != (gCountdowns[i].count > 0))
+            {
+                mismatches++;
+            }
+            armed += gCountdowns[i].count > 0;
+        }
+
+        // Queued timers behind open gates and not yet due, held ones behind
+        // closed gates
+        for (const TIMER_t *t = gTimers.pQueue; t != NULL; t = t->pNext)
+            if (!(open & (1u << t->Gate)) || t->State != TIMER_QUEUED || (t == gTimers.pQueue && t->Ticks == 0))
+                misplaced++;
+        for (const TIMER_t *t = gTimers.pHeld; t != NULL; t = t->pNext)
+            if ((open & (1u << t->Gate)) || t->State != TIMER_HELD)
+                misplaced++;
+    }
+
+    mismatches += misplaced;
+
+    // ISR cost with the radio's six timers armed and its gates steady
+    uint64_t countdownNs = 0;
+    uint64_t queueNs     = 0;
+
+    gTimers = (TIMER_State_t){ NULL, NULL, 0xFF };
+    for (unsigned i = 0; i < TIMER_CHECK_COUNT; i++) {
+        const uint16_t ticks = (i < 6) ? 100 + 50 * i : 0;
+        const uint8_t  gate  = 1 + i % (TIMER_GATE_COUNT - 1);
+
+        gCheckTimers[i] = (TIMER_t)TIMER_INIT(gTimerCallbacks[i], gate);
+        gCountdowns[i]  = (Countdown_t){ ticks, ticks, gate };
+        TIMER_StartPeriodic(&gCheckTimers[i], ticks);
+    }
+
+    for (unsigned round = 0; round < 100; round++) {
+        uint64_t start = HostNs();
+        for (unsigned tick = 0; tick < 1000; tick++)
+            CountdownTick(0xFF);
+        countdownNs += HostNs() - start;
+
+        start = HostNs();
+        for (unsigned tick = 0; tick < 1000; tick++) {
+            TIMER_SetGates(0xFF, 0xFF);
+            TIMER_Tick();
+        }
+        queueNs += HostNs() - start;
+    }
+
+    gTimers = saved;
+
+    printf("check-timers: %u ticks, %u expiries, %u mismatches\n", Ticks, expiries, mismatches);
+    printf("  timers armed per tick %.2f, visited per tick: countdowns %u, queue %.2f\n",
+        (double)armed / Ticks, TIMER_CHECK_COUNT, (double)visits / Ticks);
+    printf("  host ns per tick, 6 timers armed: countdowns %.1f, queue %.1f\n",
+        countdownNs / 100000.0, queueNs / 100000.0);
+
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Flash reads
+
+// Sectors nobody uses, past the legacy one
+#define READ_AREA       0x015000
+#define READ_AREA_SIZE  0x2000
+#define READ_QUEUED     6       // more than the driver queue holds
+
+static const uint16_t gReadSizes[] = { 1, 2, 4, 8, 15, 16, 32, 64, 128, 256, 1024 };
+
+#define READ_SIZE_COUNT (sizeof(gReadSizes) / sizeof(gReadSizes[0]))
+
+typedef struct
+{
+    unsigned reads;
+    uint64_t cycles;
+    unsigned queued;
+    uint64_t queueCycles;       // in PY25Q16_ReadAsync()
+    uint64_t doneCycles;        // until its callback
+    unsigned fast;
+    uint64_t fastCycles;
+} ReadStats_t;
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    uint64_t doneAt;
+    bool     done;
+    bool     chain;             // queue another read from the callback
+} ReadJob_t;
+
+static uint8_t     gReadExpected[READ_AREA_SIZE];
+static uint8_t     gReadBuffer[READ_QUEUED + 1][1024];
+static ReadJob_t   gReadJobs[READ_QUEUED + 1];
+static ReadStats_t gReadStats[READ_SIZE_COUNT];
+static unsigned    gReadMismatches;
+
+static uint32_t RandomReadAddress(uint32_t Size)
+{
+    return READ_AREA + rand() % (READ_AREA_SIZE - Size + 1);
+}
+
+static bool ReadMatches(const char *pWhat, uint32_t Address, const uint8_t *pData, uint32_t Size)
+{
+    if (memcmp(pData, gReadExpected + (Address - READ_AREA), Size) == 0)
+        return true;
+
+    fprintf(stderr, "[check] %s read %06x %u bytes differs\n", pWhat, Address, Size);
+    return false;
+}
+
+static void ReadDone(void *pContext)
+{
+    ReadJob_t *job = pContext;
+
+    job->doneAt = gSimCycles;
+    gReadMismatches += !ReadMatches(job->chain ? "chaining" : "queued", job->address, gReadBuffer[job - gReadJobs], job->size);
+    job->done = true;
+
+    if (job->chain) {
+        ReadJob_t *next = &gReadJobs[READ_QUEUED];
+
+        *next = (ReadJob_t){ .address = RandomReadAddress(64), .size = 64 };
+        if (!PY25Q16_ReadAsync(next->address, gReadBuffer[READ_QUEUED], next->size, ReadDone, next))
+            next->done = true;
+    }
+}
+
+static void SyncReads(bool Fast)
+{
+    PY25Q16_SetFastRead(Fast);
+
+    for (unsigned s = 0; s < READ_SIZE_COUNT; s++) {
+        ReadStats_t   *stats   = &gReadStats[s];
+        const uint32_t size    = gReadSizes[s];
+        const uint32_t address = RandomReadAddress(size);
+        const uint64_t start   = gSimCycles;
+
+        PY25Q16_ReadBuffer(address, gReadBuffer[0], size);
+        if (Fast) {
+            stats->fastCycles += gSimCycles - start;
+            stats->fast++;
+        } else {
+            stats->cycles += gSimCycles - start;
+            stats->reads++;
+        }
+        gReadMismatches += !ReadMatches(Fast ? "fast" : "sync", address, gReadBuffer[0], size);
+    }
+
+    PY25Q16_SetFastRead(false);
+}
+
+// One read of each size queued alone, time going by until its callback
+static void AsyncReads(void)
+{
+    for (unsigned s = 0; s < READ_SIZE_COUNT; s++) {
+        ReadStats_t   *stats = &gReadStats[s];
+        ReadJob_t     *job   = &gReadJobs[0];
+
+        *job = (ReadJob_t){ .size = gReadSizes[s] };
+        job->address = RandomReadAddress(job->size);
+
+        const uint64_t start = gSimCycles;
+
+        PY25Q16_ReadAsync(job->address, gReadBuffer[0], job->size, ReadDone, job);
+        stats->queueCycles += gSimCycles - start;
+        stats->queued++;
+
+        for (unsigned n = 0; n < 1000000 && !job->done; n++)
+            SIM_AdvanceCycles(1);
+
+        stats->doneCycles += job->doneAt - start;
+        if (!job->done) {
+            fprintf(stderr, "[check] %u-byte read never done\n", job->size);
+            gReadMismatches++;
+        }
+    }
+}
+
+// Reads queued past the queue size, the first one chaining another from its
+// callback, while time goes by; then a write over the area, which must not
+// show in the reads queued before it
+static void QueuedReads(void)
+{
+    unsigned queued = 0;
+
+    gReadJobs[READ_QUEUED].done = true;
+
+    for (unsigned i = 0; i < READ_QUEUED; i++) {
+        ReadJob_t *job = &gReadJobs[i];
+
+        *job = (ReadJob_t){
+            .size  = gReadSizes[rand() % READ_SIZE_COUNT],
+            .chain = i == 0 && rand() % 2,
+        };
+        job->address = RandomReadAddress(job->size);
+        gReadJobs[READ_QUEUED].done &= !job->chain;
+
+        // Reads over pages not written back run at once
+        if (!PY25Q16_ReadAsync(job->address, gReadBuffer[i], job->size, ReadDone, job))
+            job->done = true;
+        else if (!job->done)
+            queued++;
+    }
+
+    if (queued > 4) {
+        fprintf(stderr, "[check] %u reads queued\n", queued);
+        gReadMismatches++;
+    }
+
+    // Other work meanwhile: the callbacks come from the DMA interrupt
+    if (rand() % 2) {
+        for (unsigned n = 0; n < 100000 && PY25Q16_IsReading(); n++)
+            SIM_AdvanceCycles(100);
+    }
+
+    if (rand() % 2) {
+        uint8_t        data[300];
+        const uint32_t size    = 1 + rand() % sizeof(data);
+        const uint32_t address = RandomReadAddress(size);
+
+        for (uint32_t i = 0; i < size; i++)
+            data[i] = rand();
+        PY25Q16_WriteBuffer(address, data, size, false);
+        memcpy(gReadExpected + (address - READ_AREA), data, size);
+    }
+
+    PY25Q16_WaitReads();
+
+    for (unsigned i = 0; i <= READ_QUEUED; i++) {
+        if (!gReadJobs[i].done) {
+            fprintf(stderr, "[check] queued read %u never done\n", i);
+            gReadMismatches++;
+        }
+    }
+}
+
+bool CHECK_FlashRead(unsigned Rounds, unsigned Seed)
+{
+    srand(Seed);
+    memset(gReadStats, 0, sizeof(gReadStats));
+    gReadMismatches = 0;
+
+    PY25Q16_SectorErase(READ_AREA);
+    PY25Q16_SectorErase(READ_AREA + 0x1000);
+    for (uint32_t i = 0; i < READ_AREA_SIZE; i++)
+        gReadExpected[i] = rand();
+    PY25Q16_WriteBuffer(READ_AREA, gReadExpected, READ_AREA_SIZE, false);
+
+    for (unsigned round = 0; round < Rounds; round++) {
+        // Some pages only in the write-back cache
+        if (rand() % 4 == 0) {
+            const uint32_t size    = 1 + rand() % 300;
+            const uint32_t address = RandomReadAddress(size);
+
+            for (uint32_t i = 0; i < size; i++)
+                gReadExpected[address - READ_AREA + i] = rand();
+            PY25Q16_WriteBuffer(address, gReadExpected + (address - READ_AREA), size, false);
+        } else {
+            PY25Q16_Flush();
+        }
+
+        SyncReads(false);
+        SyncReads(true);
+        AsyncReads();
+        QueuedReads();
+    }
+
+    PY25Q16_Flush();
+
+    printf("check-flashread: %u rounds, %u mismatches\n", Rounds, gReadMismatches);
+    printf("  size      read   fast read     queue      done\n");
+    for (unsigned s = 0; s < READ_SIZE_COUNT; s++) {
+        const ReadStats_t *stats = &gReadStats[s];
+        const double       us    = SIM_CYCLES_PER_US;
+
+        printf("  %4u B %7.2f us %7.2f us %7.2f us %7.2f us\n", gReadSizes[s],
+            stats->cycles / us / stats->reads, stats->fastCycles / us / stats->fast,
+            stats->queueCycles / us / stats->queued, stats->doneCycles / us / stats->queued);
+    }
+
+    return gReadMismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Beep sequencer
+
+#define BEEP_CHECK_TRACE    256
+#define BEEP_CHECK_LATE_MS  4       // a 2 ms slice, the rounding, the loop
+
+static const uint16_t gLegacyBeeps[][3] = {
+    [BEEP_NONE]                            = {0,    0,   0},
+    [BEEP_1KHZ_60MS_OPTIONAL]              = {1000, 60,  1},
+    [BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL] = {500,  60,  2},
+#ifdef ENABLE_DTMF_CALLING
+    [BEEP_880HZ_200MS]                     = {880,  200, 1},
+    [BEEP_880HZ_500MS]                     = {880,  500, 1},
+#endif
+#ifdef ENABLE_FEAT_F4HWN
+    [BEEP_400HZ_30MS]                      = {400,  30,  1},
+    [BEEP_500HZ_30MS]                      = {500,  30,  1},
+    [BEEP_600HZ_30MS]                      = {600,  30,  1},
+#endif
+    [BEEP_880HZ_60MS_TRIPLE_BEEP]          = {880,  60,  3},
+};
+
+typedef struct {
+    unsigned beeps;
+    uint64_t cycles;        // first call to the end of the last step
+    uint64_t busyCycles;    // in the calls, the main loop held
+    uint64_t maxCall;
+} BeepStats_t;
+
+typedef struct {
+    SIM_BK4819_Write_t trace[BEEP_CHECK_TRACE];
+    size_t             length;
+    uint16_t           regs[128];
+    bool               audioPath;
+} BeepRun_t;
+
+static BeepRun_t gBeepRuns[2];
+
+static bool LegacyBeepAllowed(BEEP_Type_t Beep)
+{
+    if (Beep == BEEP_NONE)
+        return false;
+
+    if ((Beep == BEEP_1KHZ_60MS_OPTIONAL || Beep == BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL) && !gEeprom.BEEP_CONTROL)
+        return false;
+
+    return gCurrentFunction != FUNCTION_RECEIVE && gCurrentFunction != FUNCTION_MONITOR;
+}
+
+// AUDIO_PlayBeep() as it was before the sequencer: every step in line
+static void LegacyPlayBeep(BEEP_Type_t Beep)
+{
+    if (!LegacyBeepAllowed(Beep))
+        return;
+
+    AUDIO_AudioPathOff();
+
+    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+        BK4819_RX_TurnOn();
+
+    SYSTEM_DelayMs(20);
+
+    const uint16_t toneConfig = BK4819_ReadRegister(BK4819_REG_71);
+
+#ifdef ENABLE_FEAT_F4HWN
+    if (Beep == BEEP_400HZ_30MS || Beep == BEEP_500HZ_30MS || Beep == BEEP_600HZ_30MS)
+        BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | (1 << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
+#endif
+
+    BK4819_PrepareToPlayTone(true);
+    SYSTEM_DelayMs(2);
+    AUDIO_AudioPathOn();
+    SYSTEM_DelayMs(60);
+
+    for (unsigned i = 0; i < gLegacyBeeps[Beep][BEEP_REPEATS]; i++) {
+        BK4819_PlayToneRaw(gLegacyBeeps[Beep][BEEP_TONE], gLegacyBeeps[Beep][BEEP_DURATION]);
+        SYSTEM_DelayMs(20);
+    }
+
+    AUDIO_AudioPathOff();
+    SYSTEM_DelayMs(5);
+    BK4819_TurnsOffTones_TurnsOnRX();
+    SYSTEM_DelayMs(5);
+    BK4819_WriteRegister(BK4819_REG_71, toneConfig);
+
+    if (gEnableSpeaker)
+        AUDIO_AudioPathOn();
+
+    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+        BK4819_Sleep();
+
+#ifdef ENABLE_VOX
+    gVoxResumeCountdown = 80;
+#endif
+}
+
+static void BeepRunEnd(BeepRun_t *pRun)
+{
+    pRun->length = SIM_BK4819_TraceStop();
+    for (unsigned r = 0; r < 128; r++)
+        pRun->regs[r] = SIM_BK4819_GetRegister(r);
+    pRun->audioPath = SIM_GpioOutput(SIM_PORT_A, 8);
+}
+
+static void BeepCall(BeepStats_t *pStats, void (*pCall)(BEEP_Type_t), BEEP_Type_t Beep)
+{
+    const uint64_t start = gSimCycles;
+
+    pCall(Beep);
+
+    const uint64_t cycles = gSimCycles - start;
+
+    pStats->busyCycles += cycles;
+    if (pStats->maxCall < cycles)
+        pStats->maxCall = cycles;
+}
+
+static void ServiceCall(BEEP_Type_t Beep)
+{
+    (void)Beep;
+    AUDIO_Service();
+}
+
+static void StopCall(BEEP_Type_t Beep)
+{
+    (void)Beep;
+    AUDIO_StopBeep();
+}
+
+static void PrintBeepStats(const char *pTitle, const BeepStats_t *pStats)
+{
+    const double beeps = pStats->beeps ? pStats->beeps : 1;
+    const double ms    = SIM_CPU_HZ / 1000.0;
+
+    printf("  %-10s %6.1f ms per beep, main loop held %7.3f ms per beep (%5.1f%% free), longest %7.3f ms\n",
+        pTitle, pStats->cycles / beeps / ms, pStats->busyCycles / beeps / ms,
+        pStats->cycles ? 100.0 * (1.0 - (double)pStats->busyCycles / pStats->cycles) : 0.0, pStats->maxCall / ms);
+}
+
+bool CHECK_Beep(unsigned Rounds, unsigned Seed)
+{
+    const bool  beepControl = gEeprom.BEEP_CONTROL;
+    const bool  speaker     = gEnableSpeaker;
+    BeepStats_t legacy      = { 0 };
+    BeepStats_t sequencer   = { 0 };
+    unsigned    mismatches  = 0;
+    unsigned    cuts        = 0;
+    unsigned    compared    = 0;
+    double      lateSum     = 0;
+    uint64_t    lateMax     = 0;
+    unsigned    started     = 0;
+    double      delaySum    = 0;
+    uint64_t    delayMax    = 0;
+
+    srand(Seed);
+
+    for (unsigned round = 0; round < Rounds; round++) {
+        BeepRun_t *const  old   = &gBeepRuns[0];
+        BeepRun_t *const  new   = &gBeepRuns[1];
+        // The first round leaves the BK4819 as every beep does, for the
+        // others to start from
+        const BEEP_Type_t beep1 = round ? rand() % ARRAY_SIZE(gLegacyBeeps) : BEEP_880HZ_60MS_TRIPLE_BEEP;
+        const BEEP_Type_t beep2 = (rand() % 4 == 0) ? rand() % ARRAY_SIZE(gLegacyBeeps) : BEEP_NONE;
+        const bool        cut   = round > 0 && rand() % 4 == 0;
+        const uint64_t    cutAt = (uint64_t)(rand() % 200) * SIM_CPU_HZ / 1000;
+        uint64_t          start;
+
+        gEeprom.BEEP_CONTROL = rand() % 8 != 0;
+        gEnableSpeaker       = rand() % 2;
+        if (gEnableSpeaker)
+            AUDIO_AudioPathOn();
+        else
+            AUDIO_AudioPathOff();
+
+        // Blocking: the main loop held for the whole beep
+        SIM_BK4819_TraceStart(old->trace, BEEP_CHECK_TRACE);
+        start = gSimCycles;
+        BeepCall(&legacy, LegacyPlayBeep, beep1);
+        if (beep2 != BEEP_NONE)
+            BeepCall(&legacy, LegacyPlayBeep, beep2);
+        legacy.cycles += gSimCycles - start;
+        BeepRunEnd(old);
+
+        const uint64_t oldStart = start;
+
+        // Sequencer: from an idle radio, SysTick back at 10 ms, the steps
+        // from the main loop as each wait ends
+        gFastTick = false;
+        while (gFastTickRunning)
+            SIM_AdvanceToNextTick();
+
+        SIM_BK4819_TraceStart(new->trace, BEEP_CHECK_TRACE);
+        start = gSimCycles;
+        BeepCall(&sequencer, AUDIO_PlayBeep, beep1);
+        if (beep2 != BEEP_NONE)
+            BeepCall(&sequencer, AUDIO_PlayBeep, beep2);
+
+        while (AUDIO_IsPlaying()) {
+            if (cut && gSimCycles - start >= cutAt) {
+                BeepCall(&sequencer, StopCall, BEEP_NONE);
+                cuts++;
+                break;
+            }
+
+            if (gFlagAudioStep)
+                BeepCall(&sequencer, ServiceCall, BEEP_NONE);
+            else
+                SIM_AdvanceToNextTick();
+        }
+        sequencer.cycles += gSimCycles - start;
+        BeepRunEnd(new);
+
+        legacy.beeps    += LegacyBeepAllowed(beep1) + LegacyBeepAllowed(beep2);
+        sequencer.beeps += LegacyBeepAllowed(beep1) + LegacyBeepAllowed(beep2);
+
+        // The beep starts once SysTick runs at 2 ms
+        if (new->length > 0 && old->length > 0) {
+            const uint64_t delay = (new->trace[0].cycles - start) - (old->trace[0].cycles - oldStart);
+
+            delaySum += delay;
+            if (delayMax < delay)
+                delayMax = delay;
+            started++;
+        }
+
+        // Same writes in the same order, each about as long after the first
+        if (!cut) {
+            bool same = old->length == new->length;
+
+            for (size_t k = 0; same && k < old->length; k++) {
+                const int64_t late = (int64_t)(new->trace[k].cycles - new->trace[0].cycles) -
+                                     (int64_t)(old->trace[k].cycles - old->trace[0].cycles);
+                const uint64_t lateAbs = late < 0 ? -late : late;
+
+                same = old->trace[k].reg == new->trace[k].reg && old->trace[k].value == new->trace[k].value;
+                if (same && lateAbs > (uint64_t)BEEP_CHECK_LATE_MS * SIM_CPU_HZ / 1000) {
+                    fprintf(stderr, "[check] round %u: write %zu REG_%02X %.2f ms off\n", round, k,
+                        old->trace[k].reg, late / (SIM_CPU_HZ / 1000.0));
+                    mismatches++;
+                }
+                lateSum += late;
+                if (lateMax < lateAbs)
+                    lateMax = lateAbs;
+                compared++;
+            }
+
+            if (!same) {
+                fprintf(stderr, "[check] round %u: beeps %u %u, %zu writes, expected %zu\n", round, beep1, beep2,
+                    new->length, old->length);
+                mismatches++;
+            }
+        }
+
+        // Cut short or not, the radio is left as after the beeps
+        for (unsigned r = 0; r < 128; r++) {
+            if (new->regs[r] != old->regs[r]) {
+                fprintf(stderr, "[check] round %u%s: REG_%02X %04x, expected %04x\n", round, cut ? " (cut)" : "", r,
+                    new->regs[r], old->regs[r]);
+                mismatches++;
+            }
+        }
+        if (new->audioPath != old->audioPath) {
+            fprintf(stderr, "[check] round %u%s: audio path %s\n", round, cut ? " (cut)" : "", new->audioPath ? "on" : "off");
+            mismatches++;
+        }
+    }
+
+    gEeprom.BEEP_CONTROL = beepControl;
+    gEnableSpeaker       = speaker;
+
+    printf("check-beep: %u rounds, %u beeps, %u cut short, %u mismatches\n", Rounds, legacy.beeps, cuts, mismatches);
+    PrintBeepStats("blocking", &legacy);
+    PrintBeepStats("sequencer", &sequencer);
+    printf("  started %.2f ms later on average, %.2f ms at most, waiting for the 2 ms SysTick\n",
+        started ? delaySum / started / (SIM_CPU_HZ / 1000.0) : 0.0, delayMax / (SIM_CPU_HZ / 1000.0));
+    printf("  writes against the blocking beep: %.2f ms late on average, %.2f ms at most\n",
+        compared ? lateSum / compared / (SIM_CPU_HZ / 1000.0) : 0.0, lateMax / (SIM_CPU_HZ / 1000.0));
+
+    return mismatches == 0;
+}
+
+#ifdef ENABLE_DTMF_CALLING
+// ---------------------------------------------------------------------------
+// DTMF contacts
+
+#define CONTACTS_ADDR   DTMF_CONTACTS_ADDR
+#define CONTACTS_CH     (CONTACTS_ADDR / 16)    // the channel records they share
+
+typedef struct
+{
+    unsigned lookups;
+    unsigned found;
+    unsigned flashLookups;      // that read the flash
+    uint64_t reads;
+    uint64_t ns;
+} LookupStats_t;
+
+// The search DTMF_FindContact() did before the index
+static bool LinearFindContact(const char *pContact, char *pResult)
+{
+    pResult[0] = 0;
+
+    for (unsigned int i = 0; i < MAX_DTMF_CONTACTS; i++) {
+        char Contact[16];
+        if (!DTMF_GetContact(i, Contact))
+            return false;
+
+        if (memcmp(pContact, Contact + 8, 3) == 0) {
+            memcpy(pResult, Contact, 8);
+            pResult[8] = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// A few IDs only, so that several contacts share one
+static void RandomId(char *pId)
+{
+    static const char digits[] = "0123";
+
+    for (unsigned i = 0; i < 3; i++)
+        pId[i] = digits[rand() % (sizeof(digits) - 1)];
+}
+
+static void RandomContact(uint8_t *pRecord)
+{
+    for (unsigned i = 0; i < 8; i++)
+        pRecord[i] = ' ' + rand() % 95;
+    RandomId((char *)pRecord + 8);
+    for (unsigned i = 11; i < 16; i++)
+        pRecord[i] = (rand() % 2) ? 0xFF : rand();
+
+    // An empty slot ends the list, whatever follows it
+    if (rand() % 12 == 0)
+        pRecord[0] = (rand() % 2) ? 0xFF : rand() % ' ';
+}
+
+static bool TimedFind(LookupStats_t *pStats, bool Linear, const char *pId, char *pName)
+{
+    const uint64_t reads = gSimStats.flashReadCmds;
+    const uint64_t start = HostNs();
+
+    const bool found = Linear ? LinearFindContact(pId, pName) : DTMF_FindContact(pId, pName);
+
+    pStats->ns    += HostNs() - start;
+    pStats->reads += gSimStats.flashReadCmds - reads;
+    pStats->flashLookups += gSimStats.flashReadCmds != reads;
+    pStats->lookups++;
+    pStats->found += found;
+
+    return found;
+}
+
+static void PrintLookupStats(const char *pTitle, const LookupStats_t *pStats)
+{
+    const double lookups = pStats->lookups ? pStats->lookups : 1;
+
+    printf("  %-7s %5.2f flash reads, %7.1f ns per lookup, %u found\n", pTitle,
+        pStats->reads / lookups, pStats->ns / lookups, pStats->found);
+}
+
+bool CHECK_DtmfContacts(unsigned Rounds, unsigned Seed)
+{
+    uint8_t        saved[MAX_DTMF_CONTACTS * 16];
+    LookupStats_t  indexed    = { 0 };
+    LookupStats_t  linear     = { 0 };
+    unsigned       writes     = 0;
+    unsigned       mismatches = 0;
+
+    for (unsigned i = 0; i < MAX_DTMF_CONTACTS; i++)
+        EEPROM_ReadBuffer(CONTACTS_ADDR + i * 16, saved + i * 16, 16);
+    srand(Seed);
+
+    for (unsigned round = 0; round < Rounds; round++) {
+        const unsigned way = rand() % 4;
+
+        // Contacts rewritten the ways the radio does it: a whole upload,
+        // single records from the UART, or channels 448-463 saved over them,
+        // and now and then a channel elsewhere
+        if (way == 0) {
+            uint8_t records[MAX_DTMF_CONTACTS * 16];
+
+            for (unsigned i = 0; i < MAX_DTMF_CONTACTS; i++)
+                RandomContact(records + i * 16);
+            EEPROM_WriteRange(CONTACTS_ADDR, records, sizeof(records));
+        } else if (way < 3) {
+            uint8_t record[16];
+
+            RandomContact(record);
+            const unsigned slot   = rand() % MAX_DTMF_CONTACTS;
+            const unsigned offset = (way == 1) ? 0 : 8 * (rand() % 2);
+            EEPROM_WriteRange(CONTACTS_ADDR + slot * 16 + offset, record + offset, (way == 1) ? 16 : 8);
+        } else {
+            VFO_Info_t vfo = gEeprom.VfoInfo[0];
+
+            vfo.freq_config_RX.Frequency = 14400000 + (rand() % 4000) * 1250;
+            SETTINGS_SaveChannel((rand() % 4) ? CONTACTS_CH + rand() % MAX_DTMF_CONTACTS : rand() % MR_CHANNELS_MAX,
+                0, &vfo, 2);
+        }
+        writes++;
+
+        if (rand() % 8 == 0)
+            PY25Q16_Flush();
+
+        for (unsigned n = 0; n < 16; n++) {
+            char id[3];
+            char want[9];
+            char got[9];
+
+            // Mostly IDs of the table, some of slots past its end
+            if (rand() % 4) {
+                uint8_t record[16];
+                EEPROM_ReadBuffer(CONTACTS_ADDR + (rand() % MAX_DTMF_CONTACTS) * 16, record, 16);
+                memcpy(id, record + 8, 3);
+            } else {
+                RandomId(id);
+            }
+
+            const bool found = TimedFind(&indexed, false, id, got);
+            const bool expected = TimedFind(&linear, true, id, want);
+
+            if (found != expected || strcmp(got, want) != 0) {
+                fprintf(stderr, "[check] round %u: contact %.3s \"%s\"%s, expected \"%s\"%s\n", round, id,
+                    got, found ? "" : " (none)", want, expected ? "" : " (none)");
+                mismatches++;
+            }
+        }
+    }
+
+    EEPROM_WriteRange(CONTACTS_ADDR, saved, sizeof(saved));
+
+    // The index is kept up to date by the writes, never read by a lookup
+    if (indexed.flashLookups) {
+        fprintf(stderr, "[check] %u lookups through the index read the flash\n", indexed.flashLookups);
+        mismatches += indexed.flashLookups;
+    }
+
+    printf("check-dtmf: %u rounds, %u writes, %u lookups, %u mismatches\n", Rounds, writes, indexed.lookups, mismatches);
+    PrintLookupStats("indexed", &indexed);
+    PrintLookupStats("linear", &linear);
+
+    return mismatches == 0;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// CTCSS / DCS decoding
+
+typedef struct
+{
+    unsigned calls;
+    uint64_t ns;
+} DecodeStats_t;
+
+// What dcs.c did before its tables: the check bits by a bit loop, every
+// rotation against every option, every tone in turn
+static uint32_t LinearGolay(uint32_t CodeWord)
+{
+    uint32_t Word = CodeWord;
+
+    for (unsigned i = 0; i < 12; i++) {
+        Word <<= 1;
+        if (Word & 0x1000)
+            Word ^= 0x08EA;
+    }
+    return CodeWord | ((Word & 0x0FFE) << 11);
+}
+
+static uint8_t LinearCdcssCode(uint32_t Code)
+{
+    for (unsigned i = 0; i < 23; i++) {
+        if (((Code >> 9) & 0x7U) == 4) {
+            for (unsigned j = 0; j < ARRAY_SIZE(DCS_Options); j++)
+                if (DCS_Options[j] == (Code & 0x1FF) && LinearGolay(DCS_Options[j] + 0x800U) == Code)
+                    return j;
+        }
+
+        Code = (Code >> 1) | ((Code & 1U) << 22);
+    }
+
+    return 0xFF;
+}
+
+static uint8_t LinearCtcssCode(int Code)
+{
+    uint8_t Result   = 0xFF;
+    int     Smallest = ARRAY_SIZE(CTCSS_Options);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(CTCSS_Options); i++) {
+        const int Delta = abs(Code - CTCSS_Options[i]);
+        if (Smallest > Delta) {
+            Smallest = Delta;
+            Result   = i;
+        }
+    }
+
+    return Result;
+}
+
+static void AddBlock(DecodeStats_t *pStats, unsigned Calls, uint64_t Ns)
+{
+    pStats->calls += Calls;
+    pStats->ns    += Ns;
+}
+
+static void PrintDecodeStats(const char *pTitle, const DecodeStats_t *pStats)
+{
+    printf("  %-12s %9u calls, %8.1f ns per call\n", pTitle, pStats->calls,
+        pStats->calls ? (double)pStats->ns / pStats->calls : 0.0);
+}
+
+#define DCS_BLOCK 0x10000
+
+bool CHECK_Dcs(void)
+{
+    static uint8_t  got[DCS_BLOCK];
+    static uint8_t  want[DCS_BLOCK];
+    static uint32_t codes[DCS_BLOCK];
+    DecodeStats_t   dcs[2]       = { 0 };    // table, linear
+    DecodeStats_t   words[2]     = { 0 };
+    DecodeStats_t   tones[2]     = { 0 };
+    unsigned        found        = 0;
+    unsigned        mismatches   = 0;
+
+    // Every word REG_69 / REG_6A can give, 23 bits and the 24th
+    for (uint32_t base = 0; base < 0x1000000; base += DCS_BLOCK) {
+        uint64_t start = HostNs();
+        for (uint32_t n = 0; n < DCS_BLOCK; n++)
+            got[n] = DCS_GetCdcssCode(base + n);
+        AddBlock(&dcs[0], DCS_BLOCK, HostNs() - start);
+
+        start = HostNs();
+        for (uint32_t n = 0; n < DCS_BLOCK; n++)
+            want[n] = LinearCdcssCode(base + n);
+        AddBlock(&dcs[1], DCS_BLOCK, HostNs() - start);
+
+        for (uint32_t n = 0; n < DCS_BLOCK; n++) {
+            found += want[n] != 0xFF;
+            if (got[n] != want[n] && mismatches++ < 10)
+                fprintf(stderr, "[check] DCS word %06x: option %u, expected %u\n", base + n, got[n], want[n]);
+        }
+    }
+
+    // The words of the options, both polarities, at every rotation: what a
+    // transmitter actually sends
+    unsigned count = 0;
+    for (unsigned j = 0; j < ARRAY_SIZE(DCS_Options); j++) {
+        for (unsigned type = CODE_TYPE_DIGITAL; type <= CODE_TYPE_REVERSE_DIGITAL; type++) {
+            uint32_t word = DCS_GetGolayCodeWord(type, j);
+            uint32_t linear = LinearGolay(DCS_Options[j] + 0x800U);
+
+            if (type == CODE_TYPE_REVERSE_DIGITAL)
+                linear ^= 0x7FFFFF;
+            if (word != linear) {
+                fprintf(stderr, "[check] DCS option %u type %u: word %06x, expected %06x\n", j, type, word, linear);
+                mismatches++;
+            }
+
+            for (unsigned r = 0; r < 23; r++) {
+                codes[count++] = word;
+                word = (word >> 1) | ((word & 1U) << 22);
+            }
+        }
+    }
+
+    for (unsigned pass = 0; pass < 16; pass++) {
+        uint64_t start = HostNs();
+        for (unsigned n = 0; n < count; n++)
+            got[n] = DCS_GetCdcssCode(codes[n]);
+        AddBlock(&words[0], count, HostNs() - start);
+
+        start = HostNs();
+        for (unsigned n = 0; n < count; n++)
+            want[n] = LinearCdcssCode(codes[n]);
+        AddBlock(&words[1], count, HostNs() - start);
+
+        for (unsigned n = 0; n < count; n++) {
+            if (got[n] != want[n] && mismatches++ < 10)
+                fprintf(stderr, "[check] DCS word %06x: option %u, expected %u\n", codes[n], got[n], want[n]);
+        }
+    }
+
+    // Every tone REG_68 can give and well past either end
+    for (unsigned pass = 0; pass < 16; pass++) {
+        const int from = -1000;
+        const int to   = 0x10000;
+
+        for (int base = from; base < to; base += DCS_BLOCK) {
+            const unsigned size = (to - base < DCS_BLOCK) ? to - base : DCS_BLOCK;
+
+            uint64_t start = HostNs();
+            for (unsigned n = 0; n < size; n++)
+                got[n] = DCS_GetCtcssCode(base + n);
+            AddBlock(&tones[0], size, HostNs() - start);
+
+            start = HostNs();
+            for (unsigned n = 0; n < size; n++)
+                want[n] = LinearCtcssCode(base + n);
+            AddBlock(&tones[1], size, HostNs() - start);
+
+            for (unsigned n = 0; n < size && pass == 0; n++) {
+                if (got[n] != want[n] && mismatches++ < 10)
+                    fprintf(stderr, "[check] CTCSS %d: tone %u, expected %u\n", base + (int)n, got[n], want[n]);
+            }
+        }
+    }
+
+    printf("check-dcs: %u DCS words (%u of an option), %u option words, %u tones, %u mismatches\n",
+        dcs[0].calls, found, count, tones[0].calls / 16, mismatches);
+    PrintDecodeStats("DCS table", &dcs[0]);
+    PrintDecodeStats("DCS linear", &dcs[1]);
+    PrintDecodeStats("words table", &words[0]);
+    PrintDecodeStats("words linear", &words[1]);
+    PrintDecodeStats("CTCSS search", &tones[0]);
+    PrintDecodeStats("CTCSS linear", &tones[1]);
+
+    return mismatches == 0;
+}
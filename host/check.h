@@ -0,0 +1,95 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdbool.h>
+
+// Randomised channel maps: RADIO_FindNextChannel() and RADIO_CheckValidList()
+// against a linear walk of the channels
+bool CHECK_ScanLists(unsigned Rounds, unsigned Seed);
+
+// Random settings and VFO writes with power cuts at random points: after
+// each reboot every journaled block must hold its value from before or after
+// the interrupted write, and every earlier write must have survived
+bool CHECK_Journal(unsigned Writes, unsigned Seed);
+
+// RX/TX log written over several wraps, from blank or from a log left by
+// firmware without sector headers, with reboots and power cuts: the head
+// found from the sector headers must match a scan of every slot
+bool CHECK_RxTxLog(unsigned Rounds, unsigned Seed);
+
+// RADIO_SetupRegisters() on random VFO and channel changes, through the
+// BK4819 register shadow and with the shadow invalidated before each call:
+// the chip must end up with the same registers. Prints the bus traffic of
+// both.
+bool CHECK_Bk4819Shadow(unsigned Calls, unsigned Seed);
+
+// Scanner steps through RADIO_Retune() and through RADIO_SetupRegisters(),
+// with changes that need the full setup now and then: the chip must end up
+// with the same registers. Prints the time per step and the steps per second
+// with the scan dwell.
+bool CHECK_Retune(unsigned Steps, unsigned Seed);
+
+// Random drawing into the frame buffers, direct writes to the display and
+// blits of single pages or the whole screen, going out by DMA while time
+// goes by: no page may show parts of two frames but the one being sent, and
+// once sent every page blitted must be on the display as it was blitted.
+// Prints the data bytes sent per page and the time spent in the blits.
+bool CHECK_Lcd(unsigned Frames, unsigned Seed);
+
+// Random drawing, scrolls and earlier screens coming back, mirrored to
+// K5Viewer through the UART transmit ring in diff and in packed frames, with
+// forced full frames and time going by: once the updates catch up, the
+// screen decoded from the UART stream must match the frame buffers. Prints
+// the bytes per screen and the time spent in K5VIEWER_Update().
+bool CHECK_Viewer(unsigned Screens, unsigned Seed);
+
+// Record the screens K5VIEWER_Update() is called with into a new segment
+// (NULL stops)
+void CHECK_ViewerRecord(const char *pSegment);
+void CHECK_ViewerRecordScreen(void);
+
+// Each recorded segment mirrored in diff frames, in packed frames and packed
+// by the reference encoder: the screen decoded from the UART stream must
+// match. Prints the bytes per screen and the host time per update.
+bool CHECK_ViewerCorpus(void);
+
+// Timers started, stopped and gated at random through the timer queue and
+// through the countdowns SysTick_Handler() used to decrement: they must
+// expire on the same ticks with the same ticks left. Prints the timers
+// visited and the host time per tick of both.
+bool CHECK_Timers(unsigned Ticks, unsigned Seed);
+
+// Reads of every size from 1 byte to 1 KB at random addresses of two scratch
+// sectors, some of their pages only in the write-back cache: each read must
+// return what was written. Prints the time per read by size.
+bool CHECK_FlashRead(unsigned Rounds, unsigned Seed);
+
+// Random beeps, two in a row now and then, through the sequencer stepped
+// as the main loop does and through the blocking AUDIO_PlayBeep() it
+// replaces: the same BK4819 writes in the same order, each within a few ms
+// of the blocking one, and the same registers and audio path after the
+// beeps, also when cut short. Prints the time the main loop is held per
+// beep by both.
+bool CHECK_Beep(unsigned Rounds, unsigned Seed);
+
+// Every 24-bit word the BK4819 gives for a DCS code, the words of every
+// option at every rotation, and every CTCSS reading from -1000 to 65535,
+// decoded through the tables of dcs.c and by the searches they replace: the
+// results must be the same. Prints the host time per call of both.
+bool CHECK_Dcs(void);
+
+#ifdef ENABLE_DTMF_CALLING
+// Random DTMF contacts, some with the same ID or with an empty slot in the
+// middle, rewritten whole, a record at a time and through the channels that
+// share their records: each lookup through the contacts index must return
+// the contact the linear search of the records does, without reading the
+// flash. Prints the flash reads and the host time per lookup of both.
+bool CHECK_DtmfContacts(unsigned Rounds, unsigned Seed);
+#endif
+
+#endif
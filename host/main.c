@@ -0,0 +1,2129 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// Host runner: boots the firmware against the simulated board and drives it
+// with a small script.
+//
+//   k5sim [--flash FILE] [--script FILE] [--run "CMD; CMD; ..."] [--battery N]
+//         [--channels N] [--uart-echo] [--pty] [--verbose]
+//
+// --channels N fills a new image with N memory channels, 145 MHz upwards in
+// 12.5 kHz steps, all in scan list 1.
+//
+// --pty puts USART1 on a pseudo-terminal, for PC tools to talk to the radio
+// (tools/serialtool), and runs the firmware in real time:
+//
+//   k5sim --flash radio.bin --pty --run "wait 600000" &
+//   python3 tools/serialtool/cli.py dump -p /dev/pts/N dump.bin
+//
+// Script commands, executed at 10 ms granularity of simulated time:
+//
+//   wait MS              let the firmware run for MS milliseconds
+//   key NAME [MS]        press NAME for MS (default 150), then release it
+//   hold NAME            press NAME and keep it pressed
+//   release              release every key and PTT
+//   ptt on|off           PTT
+//   rssi N               raw BK4819 RSSI (REG_67)
+//   battery N            raw battery ADC reading
+//   uart HEX...          inject bytes on USART1 RX
+//   shot FILE            dump gStatusLine + gFrameBuffer as PBM
+//   lcd FILE             dump the ST7565 display RAM as PBM
+//   stats [TITLE]        print the counters
+//   reset-stats          clear the counters
+//   watch-flash BEGIN END  count the reads of flash addresses BEGIN..END-1
+//   upload-channels N [bulk]
+//                        CHIRP-style upload over USART1 of N memory channels
+//                        (frequencies, names, attributes) in 64-byte 0x051D
+//                        writes, each sent once the previous one is
+//                        acknowledged, or in 96-byte 0x0543 bulk writes two
+//                        in flight; the script waits for the last one and
+//                        prints the throughput
+//   dump BEGIN END [bulk]
+//                        read EEPROM addresses BEGIN..END-1 over USART1 in
+//                        128-byte 0x051B reads one at a time, or in 0x0541
+//                        bulk reads three in flight; prints the throughput,
+//                        exit 2 if the data differs from the flash
+//   radio-events [COUNT] [SEED] [aircopy]
+//                        raise COUNT BK4819 interrupts (squelch, CSS, VOX,
+//                        DTMF, FSK sync) 3-40 ms apart, wait until the
+//                        firmware has serviced them; prints the latency
+//                        against the first 10 ms slice after each event,
+//                        exit 1 if one was handled out of order or the mean
+//                        is worse (more than 1 ms worse outside aircopy
+//                        receive), 2 if some are never serviced
+//   spectrum-bench [MS] [SEED] [uniform] [bursty]
+//                        random carriers keyed on and off around the VFO
+//                        frequency, glitch settling after each tune, for MS
+//                        (default 10000) while the spectrum analyzer runs,
+//                        every bin the same dwell with uniform; bursty keys
+//                        40-100 ms bursts on the bins of the span, a few
+//                        channels busy and the others rare; prints the
+//                        sweep points per second, how many carriers were
+//                        found and how soon, how many floor bins read as
+//                        floor, and the gaps between main loop iterations,
+//                        exit 1 if none was swept or the main loop stalled
+//                        a 10 ms slice
+//   scan-bench [MS]      with the memory scan running, count the channel
+//                        hops for MS (default 10000) on the fast scan
+//                        precheck; prints the hops per second and the flash
+//                        reads per hop, exit 1 if the scanner did not move
+//   aircopy-bench [LOSS] [SEED] [v1|v2] [send|receive]
+//                        aircopy of memory bank 0 with the host as the other
+//                        radio, LOSS percent (default 10) of the frames lost
+//                        either way; the radio sends (default) or receives,
+//                        in v1 started over until every block got through
+//                        once, or in v2 (default); prints the time until
+//                        every block got through and until the radio was
+//                        done, and the time on air from either side, for
+//                        a receiving radio also the time each frame took,
+//                        the main loop stalls, the frames heard but not
+//                        stored and the flash erases; exit 1 if a block is
+//                        missing or differs
+//   verify-upload        exit 2 if the flash image does not hold the upload
+//   check-scanlists [ROUNDS] [SEED]
+//                        compare the scan list index with a linear walk on
+//                        randomised channel maps (overwrites them), exit 1
+//                        on mismatch
+//   check-flashread [ROUNDS] [SEED]
+//                        reads of 1 byte to 1 KB at random addresses of two
+//                        scratch sectors (overwrites them), exit 1 if one
+//                        returns other data than written; prints the time
+//                        per read by size
+//   check-journal [WRITES] [SEED]
+//                        random settings / VFO writes with power cuts at
+//                        random points, check what survives each reboot
+//                        and compare erases and latency with the sector
+//                        rewrite path (scratch sector 0x014000), exit 1 on
+//                        mismatch
+//   check-rxtxlog [ROUNDS] [SEED]
+//                        write the RX/TX log over several wraps with reboots
+//                        and power cuts (overwrites it), compare the head
+//                        found from the sector headers with a scan of every
+//                        slot, exit 1 on mismatch
+//   check-bk4819 [CALLS] [SEED]
+//                        RADIO_SetupRegisters() after random VFO / channel
+//                        changes, with and without the BK4819 register
+//                        shadow, exit 1 if the chip registers differ;
+//                        prints bus writes and time per call
+//   check-retune [STEPS] [SEED]
+//                        frequency scan steps through the retune fast path
+//                        and through the full RADIO_SetupRegisters(), exit 1
+//                        if the chip registers differ; prints bus writes
+//                        and time per step
+//   check-lcd [FRAMES] [SEED]
+//                        random drawing and blits with the UI carrying on
+//                        while the DMA sends them, exit 1 if a page shows
+//                        half of one frame and half of another, or differs
+//                        from its last blit once sent; prints the data bytes
+//                        sent per page and the time spent in the blits
+//   check-viewer [SCREENS] [SEED]
+//                        random drawing mirrored to K5Viewer over the UART,
+//                        exit 1 if the screen decoded from the UART stream
+//                        differs from the frame buffers once the updates
+//                        catch up, in diff and in packed frames; prints
+//                        the bytes per screen and the time spent per update
+//   check-timers [TICKS] [SEED]
+//                        timers started, stopped and gated at random through
+//                        the timer queue and through the old SysTick
+//                        countdowns, exit 1 if they expire on different
+//                        ticks; prints the timers visited and the host time
+//                        per tick
+//   check-beep [ROUNDS] [SEED]
+//                        random beeps through the sequencer stepped as the
+//                        main loop does and through the blocking beep it
+//                        replaces, exit 1 if the BK4819 writes, their timing
+//                        or the state left differ; prints how long the main
+//                        loop is held per beep and the start delay
+//   check-dcs            decode every 24-bit DCS word, the option words at
+//                        every rotation and every CTCSS reading through the
+//                        tables and by the old searches, exit 1 if a result
+//                        differs; prints the time per call
+//   check-dtmf [ROUNDS] [SEED]
+//                        random DTMF contacts rewritten whole, by record and
+//                        through the channels sharing their records, exit 1
+//                        if a lookup through the contacts index differs
+//                        from the linear search or reads the flash; prints
+//                        flash reads and time per lookup
+//   record-screens NAME|off
+//                        record the screens K5VIEWER_Update() is called
+//                        with into segment NAME, or stop recording
+//   bench-viewer         mirror each recorded segment in diff frames, in
+//                        packed frames and through the reference encoder,
+//                        exit 1 if the viewer screen differs; prints bytes
+//                        per screen and host time per update
+//   exit                 save the flash image and stop
+//
+// Keys: 0-9 MENU UP DOWN EXIT STAR F PTT SIDE1 SIDE2.
+
+#define _GNU_SOURCE     // posix_openpt(), MAP_32BIT
+
+#include <errno.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app/aircopy.h"
+#include "check.h"
+#include "driver/crc.h"
+#include "driver/eeprom.h"
+#include "driver/py25q16.h"
+#include "helper/boot.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+#include "sim/sim.h"
+
+// From the firmware
+void Main(void);
+void __real_APP_Update(void);
+void __real_K5VIEWER_Update(bool force);
+void __real_AIRCOPY_StorePacket(void);
+extern uint8_t gStatusLine[128];
+extern uint8_t gFrameBuffer[7][128];
+extern bool    isListening;     // spectrum analyzer
+extern bool    newScanStart;
+extern bool    adaptiveSweepEnabled;
+extern uint16_t rssiHistory[128];
+extern uint32_t fMeasure;       // tuned, the signal listened to when listening
+uint32_t GetFStart(void);
+uint16_t GetScanStep(void);
+uint16_t GetStepsCount(void);
+
+// DMA registers and the firmware's (uint32_t) pointer casts are 32 bits
+// wide: run it on a stack below 4 GB, statics are there already (non-PIE).
+#define FIRMWARE_STACK_SIZE (1u << 20)
+
+#define MAX_STEPS           1024
+
+typedef struct
+{
+    char    *steps[MAX_STEPS];
+    unsigned count;
+    unsigned next;
+    uint64_t resumeUs;
+    int      releaseKey;    // key to release when the current wait ends
+} Script_t;
+
+static Script_t gScript;
+static uint64_t gLastLoopCycles;
+
+// Programming protocol client, driven the way a PC tool does: the blocks of
+// an upload or a dump, one at a time in 0x051D / 0x051B or several in flight
+// in bulk 0x0543 / 0x0541, the frames arriving at the line rate
+#define UPLOAD_BLOCK        64
+#define DUMP_BLOCK          128
+#define BULK_WRITE_BLOCK    96
+#define BULK_WRITE_WINDOW   2       // frames that fit the 256-byte RX buffer
+#define BULK_READ_WINDOW    3       // replies that fit the 512-byte TX ring
+#define TRANSFER_TIMESTAMP  0x4B355349u
+#define TRANSFER_BLOCKS     1024
+
+typedef struct
+{
+    uint16_t address;
+    uint16_t size;
+} Block_t;
+
+typedef struct
+{
+    uint8_t  data[0x10000];     // by EEPROM address
+    Block_t  areas[3];          // of the last upload
+    Block_t  blocks[TRANSFER_BLOCKS];
+    unsigned count;
+    unsigned sent;
+    unsigned acked;
+    unsigned round;
+    bool     active;
+    bool     hello;
+    bool     write;
+    bool     bulk;
+    uint64_t startUs;
+    uint64_t replyUs;
+    uint8_t  reply[8 + 256];    // frame being received
+    unsigned replyLength;
+} Transfer_t;
+
+static Transfer_t gTransfer;
+
+// BK4819 interrupt events raised at random times while the firmware runs,
+// the script waiting until it has serviced them all
+#define EVENT_SLICE_US      10000   // the 10 ms time slice that used to poll
+#define EVENT_LOOP_US       1000    // the slice work ahead of the poll
+
+typedef struct
+{
+    bool     active;
+    bool     aircopy;               // in aircopy receive, polled every 2 ms
+    size_t   count;
+} RadioEvents_t;
+
+static RadioEvents_t gRadioEvents;
+
+// Spectrum analyzer on a synthetic band: sweep rate and main loop gaps
+#define SPECTRUM_CARRIERS   4
+#define SPECTRUM_BURSTY     8       // 3 busy channels, 5 rare ones
+#define SPECTRUM_FLOOR      80      // about -120 dBm
+#define SPECTRUM_SETTLE_US  300     // glitch high after the receiver restarts
+#define SPECTRUM_STALL_US   10000
+#define SPECTRUM_SHOWN      (SPECTRUM_FLOOR + 15)   // a bin holding a carrier
+
+typedef struct
+{
+    bool     active;
+    uint64_t startCycles;
+    uint64_t endCycles;
+    uint64_t tunes;             // gSimStats.bkTunes at the start
+    uint64_t ticks;
+    uint64_t sweepTicks;        // SysTicks seen sweeping, not listening
+    unsigned listens;
+    bool     listening;
+    uint64_t loops;
+    uint64_t loopCycles;        // start of the last iteration
+    uint64_t gapSum;
+    uint64_t gapMax;
+    uint64_t slow;              // gaps over a 2 ms slice
+    bool     hw;
+    bool     uniform;
+    bool     bursty;
+    uint64_t keyedSince[128];   // SysTick a carrier came up on the bin, 0 if none
+    bool     found[128];
+    uint16_t keyedShown[128];   // rssiHistory then: found once measured higher
+    unsigned keyed;             // carriers coming up on a bin
+    unsigned foundCount;        // then shown or listened to
+    uint64_t foundTicks;
+    uint64_t floorBins;         // sampled each SysTick while sweeping
+    uint64_t floorShown;
+} SpectrumBench_t;
+
+static SpectrumBench_t gSpectrumBench;
+
+// Memory scan: channel hops and the flash traffic behind them
+typedef struct
+{
+    bool        active;
+    bool        fastScan;       // gSetting_set_scn before the run
+    uint64_t    startCycles;
+    uint64_t    endCycles;
+    SIM_Stats_t stats;          // at the start
+    uint16_t    channel;
+    unsigned    hops;
+} ScanBench_t;
+
+static ScanBench_t gScanBench;
+
+// Aircopy of memory bank 0 over a lossy channel, the host playing the other
+// radio: the firmware sends and the host receives, or the other way round,
+// in v1 (passes repeated until every block got through once) or in v2
+#define AIRCOPY_BLOCKS          68
+#define AIRCOPY_FRAMING         11          // preamble and sync bytes
+#define AIRCOPY_V1_GAP_US       427000      // host v1 sender: as the firmware paces
+#define AIRCOPY_V2_GAP_US       15000       // host v2 sender: between two frames
+#define AIRCOPY_TURNAROUND_US   50000       // host v2 receiver: poll to bitmap
+#define AIRCOPY_REPLY_US        1500000     // host v2 sender: bitmap awaited
+#define AIRCOPY_SETTLE_US       2000000     // host v1 sender: last frame written back
+#define AIRCOPY_PASSES          20
+#define AIRCOPY_TIMEOUT_S       1800
+
+typedef struct
+{
+    uint16_t words[AIRCOPY_V2_FRAME_WORDS];
+    size_t   count;
+    uint64_t syncCycles;        // host frame: its sync word goes by
+    uint64_t dataCycles;        // host frame: the same, kept
+    uint64_t endCycles;
+    bool     pending;
+    bool     lost;
+} AircopyFrame_t;
+
+typedef struct
+{
+    bool           active;
+    bool           send;        // the firmware sends
+    bool           v2;
+    unsigned       loss;        // percent of the frames, either way
+    uint64_t       startCycles;
+    uint64_t       completeCycles;  // every block through
+    uint8_t        data[AIRCOPY_BLOCKS][64];    // sent by the host, or received
+    bool           held[AIRCOPY_BLOCKS];        // by the receiving side
+    unsigned       heldCount;
+    unsigned       passes;
+    unsigned       frames[2];   // from the radio, from the host
+    unsigned       lost[2];
+    uint64_t       airCycles[2];
+    AircopyFrame_t heard;       // radio frame on air
+    AircopyFrame_t tx;          // host frame on air
+    uint64_t       nextCycles;  // host sender: next frame, or bitmap timeout
+    unsigned       next;        // host sender: block of the pass
+    bool           todo[AIRCOPY_BLOCKS];
+    bool           polling;     // host v2: bitmap awaited, or due to the radio
+    unsigned       polls;
+    bool           transfer;    // the radio was seen transferring
+    unsigned       received;    // host frames the radio heard
+    unsigned       handled;     // frames the radio took in, and stored
+    unsigned       stored;
+    uint64_t       handleCycles;
+    uint64_t       handleMaxCycles;
+    uint64_t       loopMaxCycles;   // longest main loop iteration
+    unsigned       stalls;      // ones over a FIFO event period, in a frame
+    uint64_t       erases;      // flash erases before the transfer
+} AircopyBench_t;
+
+static AircopyBench_t gAircopyBench;
+
+// Checks calling into the firmware wait for the main loop, the script is
+// paused while they run
+static void   (*gPendingCheck)(void);
+static bool     gCheckRunning;
+static unsigned gCheckRounds;
+static unsigned gCheckSeed;
+
+static const char *const gKeyNames[] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9",
+    "MENU", "UP", "DOWN", "EXIT", "STAR", "F", "PTT", "SIDE2", "SIDE1",
+};
+
+static int KeyFromName(const char *pName)
+{
+    for (unsigned i = 0; i < sizeof(gKeyNames) / sizeof(gKeyNames[0]); i++)
+        if (strcasecmp(pName, gKeyNames[i]) == 0)
+            return (int)i;
+
+    if (strcmp(pName, "*") == 0)
+        return 14;
+    if (strcmp(pName, "#") == 0)
+        return 15;
+
+    return -1;
+}
+
+static void Fail(const char *pStep, const char *pWhy)
+{
+    fprintf(stderr, "[sim] %s: %s\n", pStep, pWhy);
+    SIM_Exit(2);
+}
+
+static void Split(char *pText)
+{
+    for (char *tok = strtok(pText, ";\n"); tok; tok = strtok(NULL, ";\n"))
+    {
+        while (*tok == ' ' || *tok == '\t')
+            tok++;
+        if (*tok == '\0' || *tok == '#')
+            continue;
+        if (gScript.count == MAX_STEPS)
+            Fail(tok, "script too long");
+        gScript.steps[gScript.count++] = tok;
+    }
+}
+
+static char *ReadFile(const char *pPath)
+{
+    FILE *f = fopen(pPath, "rb");
+    if (f == NULL)
+        return NULL;
+
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *text = calloc(1, (size_t)size + 1);
+    if (text && fread(text, 1, (size_t)size, f) != (size_t)size)
+    {
+        free(text);
+        text = NULL;
+    }
+
+    fclose(f);
+    return text;
+}
+
+static void Wait(uint64_t Ms)
+{
+    gScript.resumeUs = SIM_TimeUs() + Ms * 1000u;
+}
+
+static void Shot(const char *pStep, const char *pPath, bool Lcd)
+{
+    uint8_t pages[8][128];
+
+    if (Lcd)
+        SIM_ST7565_GetImage(pages);
+    else
+    {
+        memcpy(pages[0], gStatusLine, 128);
+        memcpy(pages[1], gFrameBuffer, sizeof(gFrameBuffer));
+    }
+
+    if (pPath == NULL || !SIM_WritePbm(pPath, (const uint8_t (*)[128])pages))
+        Fail(pStep, "cannot write image");
+}
+
+static void UartHex(const char *pStep, char *pArgs)
+{
+    uint8_t  buf[256];
+    size_t   n = 0;
+
+    for (char *tok = strtok(pArgs, " "); tok; tok = strtok(NULL, " "))
+    {
+        for (char *p = tok; p[0] && p[1]; p += 2)
+        {
+            char byte[3] = { p[0], p[1], 0 };
+            char *end;
+
+            if (n == sizeof(buf))
+            {
+                SIM_UartInject(buf, n);
+                n = 0;
+            }
+            buf[n++] = (uint8_t)strtoul(byte, &end, 16);
+            if (*end)
+                Fail(pStep, "bad hex");
+        }
+    }
+
+    SIM_UartInject(buf, n);
+}
+
+static const uint8_t gObfuscation[16] = {
+    0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80
+};
+
+// Framing of the UV-K5 programming protocol: AB CD, length, obfuscated
+// payload and CRC, DC BA
+static void UartSendCommand(const void *pCommand, uint16_t Size)
+{
+    uint8_t        frame[8 + 256];
+    const uint16_t crc = CRC_Calculate(pCommand, Size);
+
+    frame[0] = 0xAB;
+    frame[1] = 0xCD;
+    frame[2] = Size & 0xFF;
+    frame[3] = Size >> 8;
+    memcpy(frame + 4, pCommand, Size);
+    frame[4 + Size] = crc & 0xFF;
+    frame[5 + Size] = crc >> 8;
+    for (unsigned i = 0; i < Size + 2u; i++)
+        frame[4 + i] ^= gObfuscation[i % 16];
+    frame[6 + Size] = 0xDC;
+    frame[7 + Size] = 0xBA;
+
+    SIM_UartFeed(frame, Size + 8u);
+}
+
+// Next reply frame from the firmware, its payload deobfuscated in
+// gTransfer.reply + 4
+static bool UartTakeReply(void)
+{
+    uint8_t  *frame = gTransfer.reply;
+    unsigned *n     = &gTransfer.replyLength;
+    uint8_t   byte;
+
+    while (SIM_UartTake(&byte, 1) == 1)
+    {
+        if ((*n == 0 && byte != 0xAB) || (*n == 1 && byte != 0xCD))
+        {
+            *n = 0;
+            if (byte == 0xAB)
+                frame[(*n)++] = byte;
+            continue;
+        }
+
+        frame[(*n)++] = byte;
+        if (*n < 4)
+            continue;
+
+        const unsigned size = frame[2] | (frame[3] << 8);
+
+        if (size + 8u > sizeof(gTransfer.reply))
+            *n = 0;
+        if (*n < size + 8u)
+            continue;
+
+        *n = 0;
+        if (frame[size + 6] != 0xDC || frame[size + 7] != 0xBA)
+            continue;
+
+        for (unsigned i = 0; i < size; i++)
+            frame[4 + i] ^= gObfuscation[i % 16];
+        return true;
+    }
+
+    return false;
+}
+
+static void TransferStart(bool Write, bool Bulk)
+{
+    const struct __attribute__((packed)) { uint16_t id, size; uint32_t timestamp; } hello = {
+        0x0514, 4, TRANSFER_TIMESTAMP
+    };
+
+    gTransfer.write       = Write;
+    gTransfer.bulk        = Bulk;
+    gTransfer.sent        = 0;
+    gTransfer.acked       = 0;
+    gTransfer.hello       = true;
+    gTransfer.active      = true;
+    gTransfer.replyUs     = SIM_TimeUs();
+    gTransfer.replyLength = 0;
+
+    UartSendCommand(&hello, sizeof(hello));
+}
+
+static void AddBlocks(uint16_t Address, uint32_t Size, uint16_t Block)
+{
+    for (uint32_t offset = 0; offset < Size; offset += Block)
+    {
+        if (gTransfer.count == TRANSFER_BLOCKS)
+            Fail("transfer", "too many blocks");
+
+        gTransfer.blocks[gTransfer.count].address = (uint16_t)(Address + offset);
+        gTransfer.blocks[gTransfer.count].size    = (uint16_t)((Size - offset < Block) ? Size - offset : Block);
+        gTransfer.count++;
+    }
+}
+
+// Channels 433 MHz upwards in 25 kHz steps, so that an image seeded with
+// --channels has every record changed; each upload moves them 12.5 kHz up
+static void UploadPrepare(unsigned Count, bool Bulk)
+{
+    memset(gTransfer.data, 0, sizeof(gTransfer.data));
+
+    for (unsigned ch = 0; ch < Count; ch++)
+    {
+        const uint32_t freq = 43300000u + ch * 2500u + gTransfer.round * 1250u;
+        uint8_t       *record = gTransfer.data + 0x0000 + ch * 16;
+
+        memcpy(record, &freq, sizeof(freq));
+        record[8 + 4] = 0xFF;
+        record[8 + 5] = 0xFF;
+
+        snprintf((char *)gTransfer.data + 0x4000 + ch * 16, 11, "UP-%04u", ch + 1);
+
+        gTransfer.data[0x8000 + ch * 2 + 0] = 0x04;     // band 4 (400 MHz)
+        gTransfer.data[0x8000 + ch * 2 + 1] = 0x02;     // scan list 2
+    }
+
+    gTransfer.areas[0] = (Block_t){ 0x0000, (uint16_t)(Count * 16) };
+    gTransfer.areas[1] = (Block_t){ 0x4000, (uint16_t)(Count * 16) };
+    gTransfer.areas[2] = (Block_t){ 0x8000, (uint16_t)(Count * 2) };
+    gTransfer.round++;
+    gTransfer.count = 0;
+
+    for (unsigned a = 0; a < 3; a++)
+        AddBlocks(gTransfer.areas[a].address, gTransfer.areas[a].size, Bulk ? BULK_WRITE_BLOCK : UPLOAD_BLOCK);
+
+    TransferStart(true, Bulk);
+}
+
+static void DumpPrepare(uint32_t Begin, uint32_t End, bool Bulk)
+{
+    gTransfer.count = 0;
+    AddBlocks((uint16_t)Begin, End - Begin, DUMP_BLOCK);
+    TransferStart(false, Bulk);
+}
+
+static void TransferSend(const Block_t *pBlock)
+{
+    if (gTransfer.write && gTransfer.bulk)
+    {
+        struct __attribute__((packed))
+        {
+            uint16_t id;
+            uint16_t size;
+            uint16_t offset;
+            uint16_t length;
+            uint8_t  allowPassword;
+            uint8_t  padding[3];
+            uint32_t timestamp;
+            uint8_t  data[BULK_WRITE_BLOCK];
+        } write = { 0x0543, (uint16_t)(12 + pBlock->size), pBlock->address, pBlock->size, 0, {0},
+                    TRANSFER_TIMESTAMP, {0} };
+
+        memcpy(write.data, gTransfer.data + pBlock->address, pBlock->size);
+        UartSendCommand(&write, (uint16_t)(16 + pBlock->size));
+    }
+    else if (gTransfer.write)
+    {
+        struct __attribute__((packed))
+        {
+            uint16_t id;
+            uint16_t size;
+            uint16_t offset;
+            uint8_t  length;
+            uint8_t  allowPassword;
+            uint32_t timestamp;
+            uint8_t  data[UPLOAD_BLOCK];
+        } write = { 0x051D, (uint16_t)(8 + pBlock->size), pBlock->address, (uint8_t)pBlock->size, 0,
+                    TRANSFER_TIMESTAMP, {0} };
+
+        memcpy(write.data, gTransfer.data + pBlock->address, pBlock->size);
+        UartSendCommand(&write, (uint16_t)(12 + pBlock->size));
+    }
+    else
+    {
+        // 0x051B has an 8-bit size and a padding byte where 0x0541 has a
+        // 16-bit size: the same layout for blocks up to 255 bytes
+        const struct __attribute__((packed)) { uint16_t id, size, offset, length; uint32_t timestamp; } read = {
+            gTransfer.bulk ? 0x0541 : 0x051B, 8, pBlock->address, pBlock->size, TRANSFER_TIMESTAMP
+        };
+
+        UartSendCommand(&read, sizeof(read));
+    }
+}
+
+// Reply to the oldest block in flight: the firmware handles the commands in
+// the order they came
+static void TransferReply(const char *pStep)
+{
+    const uint8_t  *reply  = gTransfer.reply + 4;
+    const Block_t  *block  = &gTransfer.blocks[gTransfer.acked];
+    const uint16_t  id     = reply[0] | (reply[1] << 8);
+    const uint16_t  offset = reply[4] | (reply[5] << 8);
+    const uint16_t  expect = gTransfer.write ? (gTransfer.bulk ? 0x0544 : 0x051E)
+                                             : (gTransfer.bulk ? 0x0542 : 0x051C);
+
+    if (id != expect || offset != block->address)
+        Fail(pStep, "reply out of order");
+
+    if (gTransfer.write && gTransfer.bulk && reply[8] != 0)
+        Fail(pStep, "write refused");
+
+    if (!gTransfer.write)
+    {
+        const uint16_t size = gTransfer.bulk ? (reply[6] | (reply[7] << 8)) : reply[6];
+        const uint8_t *data = reply + (gTransfer.bulk ? 12 : 8);
+
+        if (size != block->size || (gTransfer.bulk && reply[10] != 0))
+            Fail(pStep, "read refused");
+        if (gTransfer.bulk && CRC_Calculate(data, size) != (reply[8] | (reply[9] << 8)))
+            Fail(pStep, "block CRC");
+
+        memcpy(gTransfer.data + block->address, data, size);
+    }
+
+    gTransfer.acked++;
+}
+
+static void VerifyDump(void)
+{
+    for (unsigned i = 0; i < gTransfer.count; i++)
+    {
+        const Block_t *block = &gTransfer.blocks[i];
+        uint8_t        flash[DUMP_BLOCK];
+
+        EEPROM_ReadBuffer(block->address, flash, (uint8_t)block->size);
+        for (unsigned k = 0; k < block->size; k++)
+        {
+            if (flash[k] != gTransfer.data[block->address + k])
+            {
+                fprintf(stderr, "[sim] %04x: %02x, dumped %02x\n", block->address + k,
+                    flash[k], gTransfer.data[block->address + k]);
+                Fail("dump", "dump differs from the flash");
+            }
+        }
+    }
+}
+
+// Blocks sent up to the window, one for 0x051B / 0x051D
+static void TransferFill(const char *pStep)
+{
+    const unsigned window = !gTransfer.bulk ? 1 : gTransfer.write ? BULK_WRITE_WINDOW : BULK_READ_WINDOW;
+
+    while (gTransfer.sent < gTransfer.count && gTransfer.sent - gTransfer.acked < window)
+        TransferSend(&gTransfer.blocks[gTransfer.sent++]);
+
+    if (gTransfer.acked < gTransfer.count)
+        return;
+
+    const double   seconds = (SIM_TimeUs() - gTransfer.startUs) / 1e6;
+    uint32_t       bytes   = 0;
+
+    for (unsigned i = 0; i < gTransfer.count; i++)
+        bytes += gTransfer.blocks[i].size;
+
+    printf("%s %s: %u bytes in %u blocks, %.3f s, %.0f bytes/s\n", pStep,
+        gTransfer.bulk ? "bulk" : "legacy", bytes, gTransfer.count, seconds, bytes / seconds);
+
+    gTransfer.active = false;
+    if (!gTransfer.write)
+        gPendingCheck = VerifyDump;
+}
+
+static void TransferTick(void)
+{
+    const char *step     = gTransfer.write ? "upload-channels" : "dump";
+    bool        progress = false;
+
+    while (UartTakeReply())
+    {
+        if (gTransfer.hello)
+        {
+            gTransfer.hello   = false;
+            gTransfer.startUs = SIM_TimeUs();
+        }
+        else if (gTransfer.acked < gTransfer.sent)
+            TransferReply(step);
+        progress = true;
+    }
+
+    if (progress)
+    {
+        gTransfer.replyUs = SIM_TimeUs();
+        if (!gTransfer.hello)
+            TransferFill(step);
+    }
+    else if (SIM_TimeUs() - gTransfer.replyUs > 2000000u)
+        Fail(step, "no reply");
+}
+
+// Squelch opening and closing now and then, single other flags in between
+static void RadioEventsPrepare(unsigned Count, unsigned Seed, const char *pMode)
+{
+    static const uint16_t flags[] = {
+        1u << 1,    // FSK RX sync
+        1u << 4,    // VOX lost
+        1u << 5,    // VOX found
+        1u << 6,    // CTCSS lost
+        1u << 7,    // CTCSS found
+        1u << 9,    // CDCSS found
+        1u << 10,   // CSS tail
+        1u << 11,   // DTMF / 5-tone
+    };
+    uint64_t due  = gSimCycles + 10000u * SIM_CYCLES_PER_US;
+    bool     open = false;
+
+    srand(Seed);
+    SIM_BK4819_ClearEvents();
+
+    gRadioEvents.aircopy = strstr(pMode, "aircopy") != NULL;
+    if (gRadioEvents.aircopy)
+    {
+        BOOT_ProcessMode(BOOT_MODE_AIRCOPY);
+        AIRCOPY_ProcessKeys(KEY_EXIT, true, false);
+    }
+
+    for (unsigned i = 0; i < Count || open; i++)
+    {
+        uint16_t event;
+
+        if (i % 10 == 9 || i >= Count)
+        {
+            event = open ? 1u << 3 : 1u << 2;   // squelch found / lost
+            open  = !open;
+        }
+        else
+            event = flags[rand() % (sizeof(flags) / sizeof(flags[0]))];
+
+        due += (uint64_t)(3000 + rand() % 37000) * SIM_CYCLES_PER_US;
+        SIM_BK4819_RaiseInterrupt(due, event);
+    }
+
+    gRadioEvents.active = true;
+}
+
+static void RadioEventsTick(void)
+{
+    size_t count, serviced;
+    const SIM_BK4819_Event_t *events = SIM_BK4819_Events(&count, &serviced);
+
+    if (serviced < count)
+    {
+        if (gSimCycles > events[count - 1].dueCycles + 2000000ull * SIM_CYCLES_PER_US)
+            Fail("radio-events", "events not serviced");
+        return;
+    }
+
+    // The polled path read REG_0C on the first 10 ms slice after the event
+    // at the earliest
+    const uint64_t slice    = (uint64_t)EVENT_SLICE_US * SIM_CYCLES_PER_US;
+    const uint64_t origin   = SIM_SysTickOrigin();
+    double         sum      = 0;
+    double         polled   = 0;
+    uint64_t       max      = 0;
+    uint64_t       maxPoll  = 0;
+    unsigned       misread  = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SIM_BK4819_Event_t *e = &events[i];
+        const uint64_t latency = e->servicedCycles - e->dueCycles;
+        const uint64_t poll    = slice - (e->dueCycles - origin) % slice;
+
+        sum    += latency;
+        polled += poll;
+        if (max < latency)
+            max = latency;
+        if (maxPoll < poll)
+            maxPoll = poll;
+        if (e->read != e->flags)
+            misread++;
+    }
+
+    printf("radio-events: %s, %zu events, latency mean %.0f us, max %.0f us; "
+        "10 ms slice poll at least mean %.0f us, max %.0f us; %u handled out of order\n",
+        gRadioEvents.aircopy ? "aircopy receive" : "main screen",
+        count, sum / count / SIM_CYCLES_PER_US, (double)max / SIM_CYCLES_PER_US,
+        polled / count / SIM_CYCLES_PER_US, (double)maxPoll / SIM_CYCLES_PER_US, misread);
+
+    gRadioEvents.active = false;
+    if (!gRadioEvents.aircopy)
+        polled += (double)count * EVENT_LOOP_US * SIM_CYCLES_PER_US;
+    if (misread > 0 || sum > polled)
+        SIM_Exit(1);
+}
+
+// Carriers within the 16 x 25 kHz span the analyzer opens with on a blank
+// image, strong and weak, keyed for 0.3 to 1.5 s every 3 to 9 s. Bursty:
+// 40 to 100 ms bursts on bins of the current span, every 0.3 to 0.9 s on
+// the busy channels, every 3 to 8 s on the rare ones.
+static void SpectrumBenchPrepare(unsigned Ms, unsigned Seed, const char *pMode)
+{
+    SIM_BK4819_Carrier_t carriers[SPECTRUM_BURSTY];
+    const uint32_t       center = gTxVfo->pRX->Frequency;
+    const bool           bursty = strstr(pMode, "bursty") != NULL;
+    const unsigned       count  = bursty ? SPECTRUM_BURSTY : SPECTRUM_CARRIERS;
+
+    srand(Seed);
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (bursty)
+        {
+            const uint16_t period = (uint16_t)(i < 3 ? 300 + rand() % 600 : 3000 + rand() % 5000);
+
+            carriers[i] = (SIM_BK4819_Carrier_t){
+                .freq     = GetFStart() + (uint32_t)(rand() % GetStepsCount()) * GetScanStep(),
+                .width    = 500u,
+                .rssi     = (uint16_t)(SPECTRUM_FLOOR + 40 + rand() % 100),
+                .onMs     = (uint16_t)(40 + rand() % 60),
+                .periodMs = period,
+                .phaseMs  = (uint16_t)(rand() % period),
+            };
+            continue;
+        }
+
+        const uint16_t period = (uint16_t)(3000 + rand() % 6000);
+
+        carriers[i] = (SIM_BK4819_Carrier_t){
+            .freq     = center - 20000u + (uint32_t)(rand() % 17) * 2500u,
+            .width    = 600u + (uint32_t)(rand() % 1200),
+            .rssi     = (uint16_t)(SPECTRUM_FLOOR + 30 + rand() % 120),
+            .onMs     = (uint16_t)(300 + rand() % 1200),
+            .periodMs = period,
+            .phaseMs  = (uint16_t)(rand() % period),
+        };
+    }
+
+    SIM_BK4819_SetBand(carriers, count, SPECTRUM_FLOOR, SPECTRUM_SETTLE_US);
+
+    gSpectrumBench = (SpectrumBench_t){
+        .active      = true,
+        .startCycles = gSimCycles,
+        .endCycles   = gSimCycles + (uint64_t)Ms * 1000u * SIM_CYCLES_PER_US,
+        .tunes       = gSimStats.bkTunes,
+        .listening   = isListening,
+        .uniform     = strstr(pMode, "uniform") != NULL,
+        .bursty      = bursty,
+    };
+
+    adaptiveSweepEnabled = !gSpectrumBench.uniform;
+    newScanStart         = true;
+}
+
+// The analyzer's bins against what the band holds at their frequencies: how
+// long a carrier coming up waits to be shown or listened to, how many floor
+// bins read as floor
+static void SpectrumBenchSample(SpectrumBench_t *b)
+{
+    const uint32_t start = GetFStart();
+    const uint16_t step  = GetScanStep();
+    uint16_t       count = GetStepsCount();
+
+    if (count > 128)
+        return;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const bool carrier = SIM_BK4819_BandRssiAt(start + (uint32_t)i * step) >= SPECTRUM_SHOWN;
+        const bool shown   = rssiHistory[i] != 0xFFFF && rssiHistory[i] >= SPECTRUM_SHOWN;
+
+        if (!carrier)
+        {
+            b->keyedSince[i] = 0;
+            b->found[i]      = false;
+            if (!isListening)
+            {
+                b->floorBins++;
+                b->floorShown += !shown;
+            }
+            continue;
+        }
+
+        // Only the bursts keyed while sweeping count: while listening, the
+        // others are missed whatever the order of the sweep
+        if (b->keyedSince[i] == 0)
+        {
+            b->keyedSince[i] = b->ticks;
+            b->keyedShown[i] = rssiHistory[i];
+            b->found[i]      = isListening;
+            b->keyed        += !isListening;
+        }
+        const uint32_t f      = start + (uint32_t)i * step;
+        const bool     listen = isListening && fMeasure + step / 2 >= f && fMeasure < f + step / 2;
+
+        if (!b->found[i] && ((shown && rssiHistory[i] > b->keyedShown[i]) || listen))
+        {
+            b->found[i] = true;
+            b->foundCount++;
+            b->foundTicks += b->ticks - b->keyedSince[i];
+        }
+    }
+}
+
+// From the start of one main loop iteration to the start of the next, the
+// analyzer step included
+static void SpectrumBenchLoop(uint64_t Start)
+{
+    const uint64_t gap = Start - gSpectrumBench.loopCycles;
+
+    gSpectrumBench.loopCycles = Start;
+    if (gSpectrumBench.loops++ == 0)
+        return;
+
+    gSpectrumBench.gapSum += gap;
+    if (gSpectrumBench.gapMax < gap)
+        gSpectrumBench.gapMax = gap;
+    if (gap > 2000u * SIM_CYCLES_PER_US)
+        gSpectrumBench.slow++;
+}
+
+static void SpectrumBenchTick(void)
+{
+    SpectrumBench_t *b = &gSpectrumBench;
+
+    b->ticks++;
+    SpectrumBenchSample(b);
+    if (!isListening)
+        b->sweepTicks++;
+    else if (!b->listening)
+        b->listens++;
+    b->listening = isListening;
+
+    if (gSimCycles < b->endCycles)
+        return;
+
+    const double   seconds = (double)(gSimCycles - b->startCycles) / SIM_CPU_HZ;
+    const double   sweep   = seconds * b->sweepTicks / b->ticks;
+    const uint64_t points  = gSimStats.bkTunes - b->tunes;
+
+    // A main loop that never came back stalled for the whole run
+    const uint64_t last = b->loops > 0 ? b->loopCycles : b->startCycles;
+
+    if (gSimCycles - last > b->gapMax)
+        b->gapMax = gSimCycles - last;
+
+    printf("spectrum-bench: %s%s sweep, %" PRIu64 " sweep points in %.1f s sweeping of %.1f s, "
+        "%.0f points/s, %u of %u carriers found %.0f ms after keying, %.1f%% of floor bins right, "
+        "%u signals listened to; main loop %" PRIu64 " iterations, gap mean %.0f us, max %.0f us, "
+        "%" PRIu64 " over 2 ms\n",
+        b->bursty ? "bursty, " : "", b->uniform ? "uniform" : "adaptive", points, sweep, seconds, sweep > 0 ? points / sweep : 0.0,
+        b->foundCount, b->keyed, b->foundCount > 0 ? seconds * 1000 * b->foundTicks / b->foundCount / b->ticks : 0.0,
+        b->floorBins > 0 ? 100.0 * b->floorShown / b->floorBins : 0.0, b->listens, b->loops,
+        b->loops > 1 ? (double)b->gapSum / (b->loops - 1) / SIM_CYCLES_PER_US : 0.0,
+        (double)b->gapMax / SIM_CYCLES_PER_US, b->slow);
+
+    SIM_BK4819_SetBand(NULL, 0, 0, 0);
+    adaptiveSweepEnabled = true;
+    newScanStart         = true;
+    b->active            = false;
+
+    if (points == 0 || b->gapMax > (uint64_t)SPECTRUM_STALL_US * SIM_CYCLES_PER_US)
+        SIM_Exit(1);
+}
+
+static void ScanBenchPrepare(unsigned Ms)
+{
+    gScanBench = (ScanBench_t){
+        .active      = true,
+        .fastScan    = gSetting_set_scn,
+        .startCycles = gSimCycles,
+        .endCycles   = gSimCycles + (uint64_t)Ms * 1000u * SIM_CYCLES_PER_US,
+        .stats       = gSimStats,
+        .channel     = gNextMrChannel,
+    };
+
+    gSetting_set_scn = true;
+}
+
+static void ScanBenchTick(void)
+{
+    ScanBench_t *b = &gScanBench;
+
+    if (gNextMrChannel != b->channel)
+    {
+        b->channel = gNextMrChannel;
+        b->hops++;
+    }
+
+    if (gSimCycles < b->endCycles)
+        return;
+
+    const double   seconds = (double)(gSimCycles - b->startCycles) / SIM_CPU_HZ;
+    const double   hops    = b->hops ? b->hops : 1;
+    const uint64_t reads   = gSimStats.flashReadCmds - b->stats.flashReadCmds;
+    const uint64_t bytes   = gSimStats.flashReadBytes - b->stats.flashReadBytes;
+
+    printf("scan-bench: %u hops in %.1f s, %.1f hops/s, %.2f flash reads and %.1f bytes per hop\n",
+        b->hops, seconds, b->hops / seconds, reads / hops, bytes / hops);
+
+    gSetting_set_scn = b->fastScan;
+    b->active        = false;
+
+    if (b->hops == 0)
+        SIM_Exit(1);
+}
+
+// Bank 0 as the aircopy map numbers it: 32 blocks at 0x0000, 32 at 0x4000,
+// 4 at 0x8000
+static uint16_t AircopyOffset(unsigned Block)
+{
+    if (Block < 32)
+        return (uint16_t)(Block * 64);
+    if (Block < 64)
+        return (uint16_t)(0x4000 + (Block - 32) * 64);
+    return (uint16_t)(0x8000 + (Block - 64) * 64);
+}
+
+static int AircopyBlock(uint16_t Offset)
+{
+    for (unsigned i = 0; i < AIRCOPY_BLOCKS; i++)
+        if (AircopyOffset(i) == Offset)
+            return (int)i;
+    return -1;
+}
+
+// Words 1 to Count, with the key of the programming protocol
+static void AircopyObfuscate(uint16_t *pFrame, size_t Count)
+{
+    for (size_t i = 0; i < Count; i++)
+        pFrame[i + 1] ^= (uint16_t)(gObfuscation[2 * (i % 8)] | gObfuscation[2 * (i % 8) + 1] << 8);
+}
+
+static bool AircopyLost(void)
+{
+    return (unsigned)(rand() % 100) < gAircopyBench.loss;
+}
+
+static void AircopyHeld(unsigned Block)
+{
+    AircopyBench_t *b = &gAircopyBench;
+
+    if (b->held[Block])
+        return;
+
+    b->held[Block] = true;
+    if (++b->heldCount == AIRCOPY_BLOCKS)
+        b->completeCycles = gSimCycles;
+}
+
+// Host frame of tx.words, starting now
+static void AircopyHostSend(size_t Count)
+{
+    AircopyBench_t *b   = &gAircopyBench;
+    const uint64_t  air = (AIRCOPY_FRAMING + 2 * Count) * (uint64_t)SIM_BK4819_FSK_BYTE_CYCLES;
+
+    b->tx.count      = Count;
+    b->tx.syncCycles = gSimCycles + AIRCOPY_FRAMING * (uint64_t)SIM_BK4819_FSK_BYTE_CYCLES;
+    b->tx.dataCycles = b->tx.syncCycles;
+    b->tx.endCycles  = gSimCycles + air;
+    b->tx.pending    = true;
+    b->tx.lost       = AircopyLost();
+    b->frames[1]++;
+    b->airCycles[1] += air;
+}
+
+static void AircopyV1Frame(unsigned Block)
+{
+    uint16_t *w = gAircopyBench.tx.words;
+
+    w[0] = 0xABCD;
+    w[1] = AircopyOffset(Block);
+    memcpy(&w[2], gAircopyBench.data[Block], 64);
+    w[34] = CRC_Calculate(&w[1], 2 + 64);
+    AircopyObfuscate(w, 34);
+    w[35] = 0xDCBA;
+    AircopyHostSend(AIRCOPY_V1_FRAME_WORDS);
+}
+
+// Data frame of First and Second (-1: none), poll, or the host's bitmap
+static void AircopyV2Frame(AIRCOPY_FrameType_t Type, int First, int Second)
+{
+    AircopyBench_t *b = &gAircopyBench;
+    uint16_t       *w = b->tx.words;
+
+    memset(w, 0, sizeof(b->tx.words));
+    w[0] = 0xABCE;
+    w[1] = (uint16_t)(Type << 12 | AIRCOPY_BLOCKS);     // map 0
+    w[2] = (uint16_t)((First < 0 ? 0xFF : First) | (Second < 0 ? 0xFF : Second) << 8);
+
+    if (First >= 0)
+        memcpy(&w[3], b->data[First], 64);
+    if (Second >= 0)
+        memcpy(&w[3 + 32], b->data[Second], 64);
+    if (Type == AIRCOPY_FRAME_BITMAP)
+        for (unsigned i = 0; i < AIRCOPY_BLOCKS; i++)
+            if (b->held[i])
+                ((uint8_t *)&w[3])[i / 8] |= (uint8_t)(1u << (i % 8));
+
+    w[67] = CRC_Calculate(&w[1], 2 * 66);
+    AircopyObfuscate(w, 67);
+    AircopyHostSend(AIRCOPY_V2_FRAME_WORDS);
+}
+
+// Radio frame over: stored by the host receiver, or the bitmap the host
+// sender waits for
+static void AircopyHear(void)
+{
+    AircopyBench_t *b = &gAircopyBench;
+    uint16_t       *w = b->heard.words;
+
+    b->heard.pending = false;
+    if (b->heard.lost)
+    {
+        b->lost[0]++;
+        return;
+    }
+
+    if (!b->v2)
+    {
+        if (b->heard.count != AIRCOPY_V1_FRAME_WORDS || w[0] != 0xABCD)
+            return;
+
+        AircopyObfuscate(w, 34);
+        const int block = AircopyBlock(w[1]);
+
+        if (block >= 0 && w[34] == CRC_Calculate(&w[1], 2 + 64))
+        {
+            memcpy(b->data[block], &w[2], 64);
+            AircopyHeld((unsigned)block);
+        }
+        return;
+    }
+
+    if (b->heard.count != AIRCOPY_V2_FRAME_WORDS || w[0] != 0xABCE)
+        return;
+
+    AircopyObfuscate(w, 67);
+    if (w[67] != CRC_Calculate(&w[1], 2 * 66) || (w[1] & 0x0FFF) != AIRCOPY_BLOCKS)
+        return;
+
+    const uint8_t *bitmap = (const uint8_t *)&w[3];
+
+    switch (w[1] >> 12)
+    {
+        case AIRCOPY_FRAME_DATA:
+            for (unsigned i = 0; i < 2; i++)
+            {
+                const unsigned block = (w[2] >> (8 * i)) & 0xFF;
+
+                if (block < AIRCOPY_BLOCKS && !b->held[block])
+                {
+                    memcpy(b->data[block], &w[3 + 32 * i], 64);
+                    AircopyHeld(block);
+                }
+            }
+            break;
+
+        case AIRCOPY_FRAME_POLL:        // bitmap after the turnaround
+            b->polling    = true;
+            b->nextCycles = gSimCycles + AIRCOPY_TURNAROUND_US * (uint64_t)SIM_CYCLES_PER_US;
+            b->passes++;
+            break;
+
+        case AIRCOPY_FRAME_BITMAP:
+            if (!b->polling)
+                break;
+            for (unsigned i = 0; i < AIRCOPY_BLOCKS; i++)
+            {
+                b->todo[i] = !((bitmap[i / 8] >> (i % 8)) & 1u);
+                if (!b->todo[i])
+                    AircopyHeld(i);
+            }
+            b->polling    = false;
+            b->polls      = 0;
+            b->next       = 0;
+            b->nextCycles = gSimCycles;
+            break;
+    }
+}
+
+static void AircopyBenchHook(const uint16_t *pWords, size_t Count, uint64_t EndCycles)
+{
+    AircopyBench_t *b = &gAircopyBench;
+
+    if (b->heard.pending)
+        AircopyHear();
+
+    if (Count > AIRCOPY_V2_FRAME_WORDS)
+        Count = AIRCOPY_V2_FRAME_WORDS;
+
+    memcpy(b->heard.words, pWords, Count * sizeof(pWords[0]));
+    b->heard.count     = Count;
+    b->heard.endCycles = EndCycles;
+    b->heard.pending   = true;
+    b->heard.lost      = AircopyLost() || b->tx.pending;   // half duplex
+    b->frames[0]++;
+    b->airCycles[0] += EndCycles - gSimCycles;
+}
+
+// Random blocks: on the radio when it sends, to send to it otherwise
+static void AircopyBenchStart(void)
+{
+    AircopyBench_t *b = &gAircopyBench;
+
+    BOOT_ProcessMode(BOOT_MODE_AIRCOPY);
+    gAircopyCurrentMapIndex = 0;
+    gAircopyProtocol        = b->v2 ? AIRCOPY_PROTOCOL_V2 : AIRCOPY_PROTOCOL_V1;
+
+    for (unsigned i = 0; i < AIRCOPY_BLOCKS; i++)
+    {
+        for (unsigned k = 0; k < 64; k++)
+            b->data[i][k] = (uint8_t)rand();
+        if (b->send)
+        {
+            for (unsigned k = 0; k < 64; k += 8)
+                EEPROM_WriteBuffer((uint16_t)(AircopyOffset(i) + k), &b->data[i][k]);
+            memset(b->data[i], 0, 64);
+        }
+        b->todo[i] = true;
+    }
+
+    PY25Q16_Flush();
+    b->erases = gSimStats.flashSectorErases;
+
+    gSimFskTxHook  = AircopyBenchHook;
+    b->startCycles = gSimCycles;
+    b->nextCycles  = gSimCycles;
+    AIRCOPY_ProcessKeys(b->send ? KEY_MENU : KEY_EXIT, true, false);
+}
+
+// The radio done with a pass, and blocks still missing: the user starts
+// it over
+static void AircopyBenchRestart(void)
+{
+    AIRCOPY_ProcessKeys(gAircopyBench.send ? KEY_MENU : KEY_EXIT, true, false);
+}
+
+// Once the radio has written back what it received: when it received,
+// the frames it took in, how long each held the main loop, how many it
+// heard but did not store, and the flash erases
+static void AircopyBenchVerify(void)
+{
+    const AircopyBench_t *b = &gAircopyBench;
+
+    PY25Q16_Flush();
+
+    if (!b->send)
+    {
+        printf("aircopy-bench: %u frames handled by the radio, %.2f ms each on average, %.2f ms at most, "
+            "main loop held %.2f ms at most, %u times over 53 ms in a frame; %u of %u host frames dropped; "
+            "%" PRIu64 " flash erases\n",
+            b->handled, b->handled ? (double)b->handleCycles / b->handled / (SIM_CPU_HZ / 1000) : 0.0,
+            (double)b->handleMaxCycles / (SIM_CPU_HZ / 1000), (double)b->loopMaxCycles / (SIM_CPU_HZ / 1000),
+            b->stalls, b->received - b->stored, b->received, gSimStats.flashSectorErases - b->erases);
+    }
+
+    if (b->heldCount < AIRCOPY_BLOCKS)
+        SIM_Exit(1);
+
+    for (unsigned i = 0; i < AIRCOPY_BLOCKS; i++)
+    {
+        uint8_t eeprom[64];
+
+        EEPROM_ReadBuffer(AircopyOffset(i), eeprom, sizeof(eeprom));
+        if (memcmp(eeprom, b->data[i], sizeof(eeprom)) != 0)
+        {
+            fprintf(stderr, "[sim] aircopy block %u at %04x differs\n", i, AircopyOffset(i));
+            SIM_Exit(1);
+        }
+    }
+}
+
+static void AircopyBenchPrepare(unsigned Loss, unsigned Seed, const char *pMode)
+{
+    srand(Seed);
+
+    // Active from now, ticking once AircopyBenchStart() has run
+    gAircopyBench = (AircopyBench_t){
+        .active = true,
+        .send = strstr(pMode, "receive") == NULL,
+        .v2   = strstr(pMode, "v1") == NULL,
+        .loss = Loss,
+    };
+
+    gPendingCheck = AircopyBenchStart;
+}
+
+static void AircopyBenchDone(void)
+{
+    AircopyBench_t *b       = &gAircopyBench;
+    const double    seconds = (double)(gSimCycles - b->startCycles) / SIM_CPU_HZ;
+    const double    through = (double)((b->completeCycles ? b->completeCycles : gSimCycles) - b->startCycles) / SIM_CPU_HZ;
+
+    printf("aircopy-bench: %s, radio %s, %u%% loss: %u of %u blocks through in %.1f s (%.0f bytes/s), "
+        "done in %.1f s, %u passes; on air %.1f s from the radio (%u frames), %.1f s from the host "
+        "(%u frames), %u + %u frames lost or missed\n",
+        b->v2 ? "v2" : "v1", b->send ? "sends" : "receives", b->loss, b->heldCount, AIRCOPY_BLOCKS,
+        through, b->heldCount * 64 / through, seconds, b->passes,
+        (double)b->airCycles[0] / SIM_CPU_HZ, b->frames[0], (double)b->airCycles[1] / SIM_CPU_HZ, b->frames[1],
+        b->lost[0], b->lost[1]);
+
+    gSimFskTxHook = NULL;
+    b->active     = false;
+    gPendingCheck = AircopyBenchVerify;
+}
+
+// Main loop iteration from gLastLoopCycles to Start: long enough for two
+// FIFO almost-full events to come due while the radio receives a frame,
+// and be read as one, it may cost the frame
+static void AircopyBenchLoop(uint64_t Start)
+{
+    AircopyBench_t *b = &gAircopyBench;
+
+    if (Start - gLastLoopCycles > b->loopMaxCycles)
+        b->loopMaxCycles = Start - gLastLoopCycles;
+
+    if (Start - gLastLoopCycles > 8 * (uint64_t)SIM_BK4819_FSK_BYTE_CYCLES &&
+        gLastLoopCycles < b->tx.endCycles && Start > b->tx.dataCycles)
+        b->stalls++;
+}
+
+// Frames the radio receives, timed from the last FIFO words read to the
+// return of AIRCOPY_StorePacket(); the v1 host sender learns from here
+// which blocks got through
+void __wrap_AIRCOPY_StorePacket(void)
+{
+    AircopyBench_t *b      = &gAircopyBench;
+    const size_t    words  = gAircopyProtocol == AIRCOPY_PROTOCOL_V2 ? AIRCOPY_V2_FRAME_WORDS : AIRCOPY_V1_FRAME_WORDS;
+    const bool      frame  = b->active && gFSKWriteIndex >= words;
+    const uint16_t  errors = gErrorsDuringAirCopy;
+    const uint64_t  start  = gSimCycles;
+    const AIRCOPY_Protocol_t protocol = gAircopyProtocol;
+
+    __real_AIRCOPY_StorePacket();
+
+    if (!frame)
+        return;
+
+    b->handled++;
+    b->handleCycles += gSimCycles - start;
+    if (gSimCycles - start > b->handleMaxCycles)
+        b->handleMaxCycles = gSimCycles - start;
+
+    // Bad, or of the other protocol: the receiver switches to it
+    if (gErrorsDuringAirCopy != errors || gAircopyProtocol != protocol)
+        return;
+
+    b->stored++;
+    if (!b->send && !b->v2 && AircopyBlock(g_FSK_Buffer[1]) >= 0)
+        AircopyHeld((unsigned)AircopyBlock(g_FSK_Buffer[1]));
+}
+
+// Host sender: v1 passes over every block until all got through, v2 the
+// blocks of the last bitmap then a poll
+static void AircopyBenchSend(AircopyBench_t *b)
+{
+    if (b->tx.pending || gSimCycles < b->nextCycles)
+        return;
+
+    if (!b->v2)
+    {
+        if (b->next == AIRCOPY_BLOCKS)
+        {
+            if (b->heldCount == AIRCOPY_BLOCKS)
+            {
+                if (gSimCycles >= b->tx.endCycles + AIRCOPY_SETTLE_US * (uint64_t)SIM_CYCLES_PER_US)
+                    AircopyBenchDone();
+                return;
+            }
+            b->next = 0;
+        }
+
+        if (b->next == 0)
+            b->passes++;
+
+        AircopyV1Frame(b->next++);
+        b->nextCycles = b->tx.endCycles + AIRCOPY_V1_GAP_US * (uint64_t)SIM_CYCLES_PER_US;
+        return;
+    }
+
+    if (b->heldCount == AIRCOPY_BLOCKS)
+        return;
+
+    if (b->polling && ++b->polls > AIRCOPY_PASSES)
+    {
+        AircopyBenchDone();
+        return;
+    }
+
+    int blocks[2] = { -1, -1 };
+
+    for (unsigned i = 0; i < 2 && !b->polling; i++)
+    {
+        while (b->next < AIRCOPY_BLOCKS && !b->todo[b->next])
+            b->next++;
+        if (b->next < AIRCOPY_BLOCKS)
+        {
+            b->todo[b->next] = false;
+            blocks[i] = (int)b->next;
+        }
+    }
+
+    if (blocks[0] >= 0)
+    {
+        AircopyV2Frame(AIRCOPY_FRAME_DATA, blocks[0], blocks[1]);
+        b->nextCycles = b->tx.endCycles + AIRCOPY_V2_GAP_US * (uint64_t)SIM_CYCLES_PER_US;
+        return;
+    }
+
+    if (!b->polling)
+        b->passes++;
+    b->polling = true;
+    AircopyV2Frame(AIRCOPY_FRAME_POLL, -1, -1);
+    b->nextCycles = b->tx.endCycles + AIRCOPY_REPLY_US * (uint64_t)SIM_CYCLES_PER_US;
+}
+
+static void AircopyBenchTick(void)
+{
+    AircopyBench_t *b = &gAircopyBench;
+
+    // A host frame is heard if it gets through and the radio listens when
+    // its sync word goes by
+    if (b->tx.pending && b->tx.syncCycles && gSimCycles >= b->tx.syncCycles)
+    {
+        const bool listening = AIRCOPY_IsListening();
+        const bool heard     = !b->tx.lost && SIM_BK4819_FskReceive(b->tx.words, b->tx.count);
+
+        b->tx.syncCycles = 0;
+        b->lost[1]      += !heard;
+        b->received     += heard && listening;
+    }
+    if (b->tx.pending && gSimCycles >= b->tx.endCycles)
+        b->tx.pending = false;
+    if (b->heard.pending && gSimCycles >= b->heard.endCycles)
+        AircopyHear();
+
+    if (gSimCycles - b->startCycles > AIRCOPY_TIMEOUT_S * (uint64_t)SIM_CPU_HZ)
+    {
+        AircopyBenchDone();
+        return;
+    }
+
+    const bool transfer = gAircopyState == AIRCOPY_TRANSFER;
+    const bool ended    = b->transfer && !transfer;
+
+    b->transfer = transfer;
+
+    if (!b->send)
+    {
+        // v2 is over once the radio has sent the bitmap with every block;
+        // the v1 receiver counts frames, not blocks, and is started over
+        if (b->v2 && ended)
+            AircopyBenchDone();
+        else if (!b->v2 && ended && b->heldCount < AIRCOPY_BLOCKS)
+            gPendingCheck = AircopyBenchRestart;
+        else
+            AircopyBenchSend(b);
+        return;
+    }
+
+    // Host receiver: the bitmap after the turnaround
+    if (b->v2 && b->polling && !b->tx.pending && gSimCycles >= b->nextCycles)
+    {
+        b->polling = false;
+        AircopyV2Frame(AIRCOPY_FRAME_BITMAP, -1, -1);
+    }
+
+    if (!ended)
+        return;
+
+    if (!b->v2)
+        b->passes++;
+
+    if (b->v2 || b->heldCount == AIRCOPY_BLOCKS || b->passes == AIRCOPY_PASSES)
+        AircopyBenchDone();
+    else
+        gPendingCheck = AircopyBenchRestart;
+}
+
+static void VerifyUpload(const char *pStep)
+{
+    const uint8_t *image = SIM_PY25Q16_Image();
+
+    for (unsigned a = 0; a < 3; a++)
+    {
+        const Block_t *area = &gTransfer.areas[a];
+
+        for (unsigned i = area->address; i < area->address + area->size; i++)
+        {
+            if (image[i] != gTransfer.data[i])
+            {
+                fprintf(stderr, "[sim] %06x: %02x, uploaded %02x\n", i, image[i], gTransfer.data[i]);
+                Fail(pStep, "flash differs from the upload");
+            }
+        }
+    }
+}
+
+static void CheckScanLists(void)
+{
+    if (!CHECK_ScanLists(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckFlashRead(void)
+{
+    if (!CHECK_FlashRead(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckJournal(void)
+{
+    if (!CHECK_Journal(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckRxTxLog(void)
+{
+    if (!CHECK_RxTxLog(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckBk4819(void)
+{
+    if (!CHECK_Bk4819Shadow(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckRetune(void)
+{
+    if (!CHECK_Retune(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckLcd(void)
+{
+    if (!CHECK_Lcd(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckViewer(void)
+{
+    if (!CHECK_Viewer(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckTimers(void)
+{
+    if (!CHECK_Timers(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckBeep(void)
+{
+    if (!CHECK_Beep(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+}
+
+static void CheckDcs(void)
+{
+    if (!CHECK_Dcs())
+        SIM_Exit(1);
+}
+
+static void CheckDtmf(void)
+{
+#ifdef ENABLE_DTMF_CALLING
+    if (!CHECK_DtmfContacts(gCheckRounds, gCheckSeed))
+        SIM_Exit(1);
+#else
+    printf("check-dtmf: built without ENABLE_DTMF_CALLING, nothing to check\n");
+#endif
+}
+
+static void BenchViewer(void)
+{
+    if (!CHECK_ViewerCorpus())
+        SIM_Exit(1);
+}
+
+static void RunStep(char *pStep)
+{
+    char  line[256];
+    char *arg;
+
+    snprintf(line, sizeof(line), "%s", pStep);
+    char *cmd = strtok_r(line, " \t", &arg);
+    char *a1  = strtok_r(NULL, " \t", &arg);
+
+    if (gSimVerbose)
+        fprintf(stderr, "[sim] %8.3f ms: %s\n", SIM_TimeUs() / 1000.0, pStep);
+
+    if (strcmp(cmd, "wait") == 0)
+        Wait(a1 ? strtoull(a1, NULL, 0) : 0);
+    else if (strcmp(cmd, "key") == 0 || strcmp(cmd, "hold") == 0)
+    {
+        const int key = a1 ? KeyFromName(a1) : -1;
+        if (key < 0)
+            Fail(pStep, "unknown key");
+
+        SIM_KeypadPress(key);
+        if (cmd[0] == 'k')
+        {
+            gScript.releaseKey = key;
+            Wait((*arg) ? strtoull(arg, NULL, 0) : 150);
+        }
+    }
+    else if (strcmp(cmd, "release") == 0)
+        SIM_KeypadPress(-1);
+    else if (strcmp(cmd, "ptt") == 0)
+        SIM_SetPtt(a1 && strcmp(a1, "on") == 0);
+    else if (strcmp(cmd, "rssi") == 0 && a1)
+        SIM_BK4819_SetRssi((uint16_t)strtoul(a1, NULL, 0));
+    else if (strcmp(cmd, "battery") == 0 && a1)
+        SIM_SetBatteryAdc((uint16_t)strtoul(a1, NULL, 0));
+    else if (strcmp(cmd, "uart") == 0)
+    {
+        char hex[256];
+        snprintf(hex, sizeof(hex), "%s %s", a1 ? a1 : "", arg);
+        UartHex(pStep, hex);
+    }
+    else if (strcmp(cmd, "shot") == 0)
+        Shot(pStep, a1, false);
+    else if (strcmp(cmd, "lcd") == 0)
+        Shot(pStep, a1, true);
+    else if (strcmp(cmd, "stats") == 0)
+    {
+        char title[128];
+        snprintf(title, sizeof(title), "%s%s%s", a1 ? a1 : "stats", *arg ? " " : "", arg);
+        SIM_PrintStats(stdout, title);
+    }
+    else if (strcmp(cmd, "reset-stats") == 0)
+        SIM_ResetStats();
+    else if (strcmp(cmd, "watch-flash") == 0 && a1 && *arg)
+        SIM_PY25Q16_Watch((uint32_t)strtoul(a1, NULL, 0), (uint32_t)strtoul(arg, NULL, 0));
+    else if (strcmp(cmd, "upload-channels") == 0 && a1)
+    {
+        const unsigned count = (unsigned)strtoul(a1, NULL, 0);
+
+        if (count == 0 || count > 1024)
+            Fail(pStep, "1 to 1024 channels");
+        UploadPrepare(count, strcmp(arg, "bulk") == 0);
+    }
+    else if (strcmp(cmd, "dump") == 0 && a1 && *arg)
+    {
+        char          *end;
+        const uint32_t begin = (uint32_t)strtoul(a1, NULL, 0);
+        const uint32_t until = (uint32_t)strtoul(arg, &end, 0);
+
+        if (begin >= until || until > 0x10000)
+            Fail(pStep, "bad range");
+        DumpPrepare(begin, until, strstr(end, "bulk") != NULL);
+    }
+    else if (strcmp(cmd, "radio-events") == 0)
+        RadioEventsPrepare(a1 ? (unsigned)strtoul(a1, NULL, 0) : 200,
+            *arg ? (unsigned)strtoul(arg, NULL, 0) : 1, arg);
+    else if (strcmp(cmd, "spectrum-bench") == 0)
+        SpectrumBenchPrepare(a1 ? (unsigned)strtoul(a1, NULL, 0) : 10000,
+            *arg ? (unsigned)strtoul(arg, NULL, 0) : 1, arg);
+    else if (strcmp(cmd, "aircopy-bench") == 0)
+        AircopyBenchPrepare(a1 ? (unsigned)strtoul(a1, NULL, 0) : 10,
+            *arg ? (unsigned)strtoul(arg, NULL, 0) : 1, arg);
+    else if (strcmp(cmd, "scan-bench") == 0)
+        ScanBenchPrepare(a1 ? (unsigned)strtoul(a1, NULL, 0) : 10000);
+    else if (strcmp(cmd, "verify-upload") == 0)
+        VerifyUpload(pStep);
+    else if (strcmp(cmd, "check-scanlists") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 10;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckScanLists;
+    }
+    else if (strcmp(cmd, "check-flashread") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 100;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckFlashRead;
+    }
+    else if (strcmp(cmd, "check-journal") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 1000;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckJournal;
+    }
+    else if (strcmp(cmd, "check-rxtxlog") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 8;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckRxTxLog;
+    }
+    else if (strcmp(cmd, "check-bk4819") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 200;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckBk4819;
+    }
+    else if (strcmp(cmd, "check-retune") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 1000;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckRetune;
+    }
+    else if (strcmp(cmd, "check-lcd") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 1000;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckLcd;
+    }
+    else if (strcmp(cmd, "check-viewer") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 1000;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckViewer;
+    }
+    else if (strcmp(cmd, "check-timers") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 100000;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckTimers;
+    }
+    else if (strcmp(cmd, "check-beep") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 200;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckBeep;
+    }
+    else if (strcmp(cmd, "check-dcs") == 0)
+        gPendingCheck = CheckDcs;
+    else if (strcmp(cmd, "check-dtmf") == 0)
+    {
+        gCheckRounds  = a1 ? (unsigned)strtoul(a1, NULL, 0) : 500;
+        gCheckSeed    = *arg ? (unsigned)strtoul(arg, NULL, 0) : 1;
+        gPendingCheck = CheckDtmf;
+    }
+    else if (strcmp(cmd, "record-screens") == 0 && a1)
+        CHECK_ViewerRecord(strcmp(a1, "off") == 0 ? NULL : a1);
+    else if (strcmp(cmd, "bench-viewer") == 0)
+        gPendingCheck = BenchViewer;
+    else if (strcmp(cmd, "exit") == 0)
+        SIM_Exit(0);
+    else
+        Fail(pStep, "unknown command");
+}
+
+// USART1 on a pseudo-terminal: what the PC sends arrives at the line rate,
+// and the simulated time is held back to the wall clock
+static int      gPty = -1;
+static uint64_t gPtyStartUs;
+
+static uint64_t WallUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static void PtyOpen(void)
+{
+    struct termios tio;
+
+    gPty = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (gPty < 0 || grantpt(gPty) != 0 || unlockpt(gPty) != 0)
+    {
+        perror("[sim] pty");
+        exit(2);
+    }
+
+    if (tcgetattr(gPty, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(gPty, TCSANOW, &tio);
+    }
+
+    fprintf(stderr, "[sim] USART1 on %s\n", ptsname(gPty));
+}
+
+static void PtyTick(void)
+{
+    uint8_t buf[256];
+    ssize_t n;
+    size_t  taken;
+
+    while ((n = read(gPty, buf, sizeof(buf))) > 0)
+        SIM_UartFeed(buf, (size_t)n);
+
+    // Dropped if nothing has the terminal open, as on an unplugged cable
+    while ((taken = SIM_UartTake(buf, sizeof(buf))) > 0)
+        if (write(gPty, buf, taken) < 0)
+            break;
+
+    if (gPtyStartUs == 0)
+        gPtyStartUs = WallUs() - SIM_TimeUs();
+
+    const uint64_t wall = WallUs() - gPtyStartUs;
+
+    if (SIM_TimeUs() > wall)
+        usleep((useconds_t)(SIM_TimeUs() - wall));
+}
+
+static void ScriptTick(void)
+{
+    if (gPty >= 0)
+        PtyTick();
+
+    if (gCheckRunning || gPendingCheck)
+        return;
+
+    if (gTransfer.active)
+    {
+        TransferTick();
+        if (gTransfer.active || gPendingCheck)
+            return;
+    }
+
+    if (gRadioEvents.active)
+    {
+        RadioEventsTick();
+        if (gRadioEvents.active)
+            return;
+    }
+
+    if (gSpectrumBench.active)
+    {
+        SpectrumBenchTick();
+        if (gSpectrumBench.active)
+            return;
+    }
+
+    if (gScanBench.active)
+    {
+        ScanBenchTick();
+        if (gScanBench.active)
+            return;
+    }
+
+    if (gAircopyBench.active)
+    {
+        AircopyBenchTick();
+        if (gAircopyBench.active || gPendingCheck)
+            return;
+    }
+
+    while (SIM_TimeUs() >= gScript.resumeUs)
+    {
+        if (gScript.releaseKey >= 0)
+        {
+            // Long enough for the debounce to see the release
+            SIM_KeypadPress(-1);
+            gScript.releaseKey = -1;
+            Wait(100);
+            continue;
+        }
+
+        if (gScript.next == gScript.count)
+            SIM_Exit(0);
+
+        RunStep(gScript.steps[gScript.next++]);
+        if (gTransfer.active || gRadioEvents.active || gSpectrumBench.active || gScanBench.active ||
+            gAircopyBench.active)
+            return;
+    }
+}
+
+// Main loop hook: when an iteration found nothing to do, skip to the next
+// SysTick instead of spinning through millions of empty iterations.
+void __wrap_APP_Update(void)
+{
+    const uint64_t start = gSimCycles;
+
+    if (gSimStats.loopIterations++ > 0 && start - gLastLoopCycles > gSimStats.loopMaxGapCycles)
+        gSimStats.loopMaxGapCycles = start - gLastLoopCycles;
+
+    if (gAircopyBench.active)
+        AircopyBenchLoop(start);
+
+    if (gSpectrumBench.active)
+        SpectrumBenchLoop(start);
+
+    if (gPendingCheck)
+    {
+        void (*check)(void) = gPendingCheck;
+
+        gPendingCheck = NULL;
+        gCheckRunning = true;
+        check();
+        gCheckRunning = false;
+    }
+
+    __real_APP_Update();
+
+    if (gSimCycles == start)
+        SIM_AdvanceToNextTick();
+
+    gLastLoopCycles = gSimCycles;
+}
+
+// Screens mirrored to K5Viewer, recorded for bench-viewer
+void __wrap_K5VIEWER_Update(bool force)
+{
+    if (!gCheckRunning)
+        CHECK_ViewerRecordScreen();
+
+    __real_K5VIEWER_Update(force);
+}
+
+// A blank image stands for a radio fresh from the factory: it has the
+// calibration block, the settings are left for the firmware to default.
+static void SeedCalibration(void)
+{
+    // 0x1F40: battery ADC thresholds of a stock UV-K5
+    static const uint16_t battery[6] = { 1246, 1786, 1861, 1886, 1989, 2300 };
+
+    memcpy(SIM_PY25Q16_Image() + 0x010140, battery, sizeof(battery));
+}
+
+// Memory channels as SETTINGS_SaveChannel() lays them out: 16-byte records
+// at 0x0000, names at 0x4000, 2-byte attributes at 0x8000 (band 2 = 137 MHz,
+// scan list 1).
+static void SeedChannels(unsigned Count)
+{
+    uint8_t *image = SIM_PY25Q16_Image();
+
+    for (unsigned ch = 0; ch < Count && ch < 1024; ch++)
+    {
+        const uint32_t freq = 14500000u + ch * 1250u;
+        uint8_t        record[16] = {0};
+        char           name[16];
+
+        memcpy(&record[0], &freq, sizeof(freq));
+        record[8 + 4] = 0xFF;   // default flags
+        record[8 + 5] = 0xFF;   // default DTMF / PTT ID
+        memcpy(image + ch * 16, record, sizeof(record));
+
+        memset(name, 0, sizeof(name));
+        snprintf(name, 11, "CH-%04u", ch + 1);
+        memcpy(image + 0x4000 + ch * 16, name, sizeof(name));
+
+        image[0x8000 + ch * 2 + 0] = 0x02;
+        image[0x8000 + ch * 2 + 1] = 0x01;
+    }
+}
+
+static void *FirmwareThread(void *pArg)
+{
+    (void)pArg;
+    Main();
+    return NULL;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+        "usage: k5sim [--flash FILE] [--script FILE] [--run \"CMD; ...\"]\n"
+        "             [--battery N] [--channels N] [--uart-echo] [--pty] [--verbose]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *flash    = NULL;
+    unsigned    channels = 0;
+
+    gScript.releaseKey = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *opt  = argv[i];
+        const char *next = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(opt, "--flash") == 0 && next)
+            flash = argv[++i];
+        else if (strcmp(opt, "--script") == 0 && next)
+        {
+            char *text = ReadFile(argv[++i]);
+            if (text == NULL)
+            {
+                fprintf(stderr, "[sim] %s: %s\n", next, strerror(errno));
+                return 2;
+            }
+            Split(text);
+        }
+        else if (strcmp(opt, "--run") == 0 && next)
+            Split(strdup(argv[++i]));
+        else if (strcmp(opt, "--battery") == 0 && next)
+            SIM_SetBatteryAdc((uint16_t)strtoul(argv[++i], NULL, 0));
+        else if (strcmp(opt, "--channels") == 0 && next)
+            channels = (unsigned)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(opt, "--uart-echo") == 0)
+            SIM_UartSetEcho(stderr);
+        else if (strcmp(opt, "--pty") == 0)
+            PtyOpen();
+        else if (strcmp(opt, "--verbose") == 0)
+            gSimVerbose = true;
+        else
+            Usage();
+    }
+
+    FILE *image = flash ? fopen(flash, "rb") : NULL;
+
+    if (image)
+        fclose(image);
+
+    if (!SIM_PY25Q16_Load(flash))
+    {
+        fprintf(stderr, "[sim] cannot load %s\n", flash);
+        return 2;
+    }
+
+    if (image == NULL)
+    {
+        SeedCalibration();
+        SeedChannels(channels);
+    }
+
+    SIM_BK4819_Reset();
+    gSimTickHook = ScriptTick;
+
+    void *stack = mmap(NULL, FIRMWARE_STACK_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (stack == MAP_FAILED)
+    {
+        perror("[sim] mmap");
+        return 1;
+    }
+
+    pthread_attr_t attr;
+    pthread_t      thread;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, FIRMWARE_STACK_SIZE);
+
+    if (pthread_create(&thread, &attr, FirmwareThread, NULL) != 0)
+    {
+        perror("[sim] pthread_create");
+        return 1;
+    }
+
+    pthread_join(thread, NULL);
+    return 0;
+}
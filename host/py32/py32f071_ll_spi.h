@@ -0,0 +1 @@
+#include "py32f0xx.h"
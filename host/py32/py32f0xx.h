@@ -0,0 +1,566 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// Host replacement for the PY32F071 device header and the LL drivers.
+//
+// Only the subset the App tree actually uses is provided. Peripheral
+// instances are fake addresses that are never dereferenced: every LL call
+// is routed to the peripheral models in host/sim, which in turn drive the
+// BK4819, ST7565 and PY25Q16 chip models.
+
+#ifndef HOST_PY32F0XX_H
+#define HOST_PY32F0XX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------
+// Core
+
+extern uint32_t SystemCoreClock;
+
+typedef enum
+{
+    SysTick_IRQn                = -1,
+    DMA1_Channel1_IRQn          = 9,
+    DMA1_Channel2_3_IRQn        = 10,
+    DMA1_Channel4_5_6_7_IRQn    = 11,
+    USART1_IRQn                 = 27,
+} IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    volatile uint32_t AIRCR;
+} SCB_Type;
+
+SysTick_Type *SIM_SysTick(void);
+uint32_t SysTick_Config(uint32_t ticks);
+void NVIC_SystemReset(void) __attribute__((noreturn));
+
+#define SysTick                 (SIM_SysTick())
+
+#define SCB_AIRCR_VECTKEY_Pos   16U
+#define SCB_AIRCR_SYSRESETREQ_Msk (1UL << 2U)
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+void SIM_DisableIrq(void);
+void SIM_EnableIrq(void);
+uint32_t SIM_GetPrimask(void);
+void SIM_SetPrimask(uint32_t Value);
+
+#define __disable_irq()         SIM_DisableIrq()
+#define __enable_irq()          SIM_EnableIrq()
+#define __get_PRIMASK()         SIM_GetPrimask()
+#define __set_PRIMASK(x)        SIM_SetPrimask(x)
+#define __DSB()                 __sync_synchronize()
+#define __DMB()                 __sync_synchronize()
+#define __NOP()                 do {} while (0)
+#define __WFI()                 do {} while (0)
+
+// ---------------------------------------------------------------------------
+// Peripheral instances
+//
+// The addresses match the real memory map so that GPIO_MAKE_PIN() and
+// GPIO_PORT() in driver/gpio.h keep working unchanged.
+
+typedef struct
+{
+    volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR;
+} GPIO_TypeDef;
+
+typedef struct { volatile uint32_t CR1, CR2, SR, DR; } SPI_TypeDef;
+typedef struct { volatile uint32_t ISR, IFCR; } DMA_TypeDef;
+typedef struct { volatile uint32_t SR, DR, BRR, CR1, CR2, CR3; } USART_TypeDef;
+typedef struct { volatile uint32_t SR, CR1, CR2, DR; } ADC_TypeDef;
+typedef struct { volatile uint32_t CCR; } ADC_Common_TypeDef;
+typedef struct { volatile uint32_t CR1, ARR, PSC; } TIM_TypeDef;
+typedef struct { volatile uint32_t CR; } DAC_TypeDef;
+
+#define IOPORT_BASE             (0x50000000UL)
+#define GPIOA                   ((GPIO_TypeDef *)(IOPORT_BASE + 0x00000000UL))
+#define GPIOB                   ((GPIO_TypeDef *)(IOPORT_BASE + 0x00000400UL))
+#define GPIOC                   ((GPIO_TypeDef *)(IOPORT_BASE + 0x00000800UL))
+#define GPIOF                   ((GPIO_TypeDef *)(IOPORT_BASE + 0x00001400UL))
+
+#define SPI1                    ((SPI_TypeDef *)0x40013000UL)
+#define SPI2                    ((SPI_TypeDef *)0x40003800UL)
+#define USART1                  ((USART_TypeDef *)0x40013800UL)
+#define DMA1                    ((DMA_TypeDef *)0x40020000UL)
+#define ADC1                    ((ADC_TypeDef *)0x40012400UL)
+#define ADC1_COMMON             ((ADC_Common_TypeDef *)0x40012708UL)
+#define TIM6                    ((TIM_TypeDef *)0x40001000UL)
+#define TIM7                    ((TIM_TypeDef *)0x40001400UL)
+#define DAC1                    ((DAC_TypeDef *)0x40007400UL)
+
+// ---------------------------------------------------------------------------
+// Models (host/sim)
+
+void     SIM_GPIO_Init(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Mode);
+void     SIM_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Mode);
+void     SIM_GPIO_Write(GPIO_TypeDef *GPIOx, uint32_t SetMask, uint32_t ResetMask);
+uint32_t SIM_GPIO_ReadOutput(GPIO_TypeDef *GPIOx);
+uint32_t SIM_GPIO_ReadInput(GPIO_TypeDef *GPIOx);
+
+void     SIM_SPI_Init(SPI_TypeDef *SPIx, uint32_t BaudRate);
+void     SIM_SPI_Enable(SPI_TypeDef *SPIx, bool Enable);
+bool     SIM_SPI_IsEnabled(SPI_TypeDef *SPIx);
+void     SIM_SPI_Transmit(SPI_TypeDef *SPIx, uint8_t Data);
+uint8_t  SIM_SPI_Receive(SPI_TypeDef *SPIx);
+bool     SIM_SPI_IsRxNotEmpty(SPI_TypeDef *SPIx);
+void     SIM_SPI_SetDMAReq(SPI_TypeDef *SPIx, bool Tx, bool Enable);
+
+void     SIM_DMA_Config(uint32_t Channel, uint32_t Config);
+void     SIM_DMA_Enable(uint32_t Channel, bool Enable);
+bool     SIM_DMA_IsEnabled(uint32_t Channel);
+void     SIM_DMA_SetMemoryAddress(uint32_t Channel, uint32_t Address);
+void     SIM_DMA_SetPeriphAddress(uint32_t Channel, uint32_t Address);
+void     SIM_DMA_SetDataLength(uint32_t Channel, uint32_t Length);
+uint32_t SIM_DMA_GetDataLength(uint32_t Channel);
+void     SIM_DMA_SetRemap(uint32_t Channel, uint32_t Request);
+void     SIM_DMA_EnableIT_TC(uint32_t Channel, bool Enable);
+bool     SIM_DMA_IsEnabledIT_TC(uint32_t Channel);
+bool     SIM_DMA_IsActiveFlag_TC(uint32_t Channel);
+void     SIM_DMA_ClearFlags(uint32_t Channel);
+
+void     SIM_USART_Init(USART_TypeDef *USARTx, uint32_t BaudRate);
+void     SIM_USART_Enable(USART_TypeDef *USARTx, bool Enable);
+void     SIM_USART_SetDMAReqRx(USART_TypeDef *USARTx, bool Enable);
+void     SIM_USART_Transmit(USART_TypeDef *USARTx, uint8_t Data);
+bool     SIM_USART_IsTxEmpty(USART_TypeDef *USARTx);
+bool     SIM_USART_IsTxComplete(USART_TypeDef *USARTx);
+void     SIM_USART_EnableIT_TXE(USART_TypeDef *USARTx, bool Enable);
+bool     SIM_USART_IsEnabledIT_TXE(USART_TypeDef *USARTx);
+
+uint16_t SIM_ADC_Read(void);
+
+// ---------------------------------------------------------------------------
+// RCC / bus
+
+#define LL_IOP_GRP1_PERIPH_GPIOA    (1U << 0)
+#define LL_IOP_GRP1_PERIPH_GPIOB    (1U << 1)
+#define LL_IOP_GRP1_PERIPH_GPIOC    (1U << 2)
+#define LL_IOP_GRP1_PERIPH_GPIOF    (1U << 5)
+#define LL_AHB1_GRP1_PERIPH_DMA1    (1U << 0)
+#define LL_AHB1_GRP1_PERIPH_CRC     (1U << 12)
+#define LL_APB1_GRP1_PERIPH_TIM6    (1U << 4)
+#define LL_APB1_GRP1_PERIPH_TIM7    (1U << 5)
+#define LL_APB1_GRP1_PERIPH_SPI2    (1U << 14)
+#define LL_APB1_GRP1_PERIPH_PWR     (1U << 28)
+#define LL_APB1_GRP1_PERIPH_DAC1    (1U << 29)
+#define LL_APB1_GRP2_PERIPH_SYSCFG  (1U << 0)
+#define LL_APB1_GRP2_PERIPH_ADC1    (1U << 9)
+#define LL_APB1_GRP2_PERIPH_SPI1    (1U << 12)
+#define LL_APB1_GRP2_PERIPH_USART1  (1U << 14)
+
+static inline void LL_IOP_GRP1_EnableClock(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_AHB1_GRP1_EnableClock(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP1_EnableClock(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP2_EnableClock(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP1_ForceReset(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP1_ReleaseReset(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP2_ForceReset(uint32_t Periphs) { (void)Periphs; }
+static inline void LL_APB1_GRP2_ReleaseReset(uint32_t Periphs) { (void)Periphs; }
+
+#define LL_RCC_ADC_CLKSOURCE_PCLK_DIV4 0U
+static inline void LL_RCC_SetADCClockSource(uint32_t Source) { (void)Source; }
+static inline void LL_SetSystemCoreClock(uint32_t HCLKFrequency) { SystemCoreClock = HCLKFrequency; }
+
+// ---------------------------------------------------------------------------
+// GPIO
+
+#define LL_GPIO_PIN_0               (1U << 0)
+#define LL_GPIO_PIN_1               (1U << 1)
+#define LL_GPIO_PIN_2               (1U << 2)
+#define LL_GPIO_PIN_3               (1U << 3)
+#define LL_GPIO_PIN_4               (1U << 4)
+#define LL_GPIO_PIN_5               (1U << 5)
+#define LL_GPIO_PIN_6               (1U << 6)
+#define LL_GPIO_PIN_7               (1U << 7)
+#define LL_GPIO_PIN_8               (1U << 8)
+#define LL_GPIO_PIN_9               (1U << 9)
+#define LL_GPIO_PIN_10              (1U << 10)
+#define LL_GPIO_PIN_11              (1U << 11)
+#define LL_GPIO_PIN_12              (1U << 12)
+#define LL_GPIO_PIN_13              (1U << 13)
+#define LL_GPIO_PIN_14              (1U << 14)
+#define LL_GPIO_PIN_15              (1U << 15)
+#define LL_GPIO_PIN_ALL             (0xFFFFU)
+
+#define LL_GPIO_MODE_INPUT          (0U)
+#define LL_GPIO_MODE_OUTPUT         (1U)
+#define LL_GPIO_MODE_ALTERNATE      (2U)
+#define LL_GPIO_MODE_ANALOG         (3U)
+
+#define LL_GPIO_OUTPUT_PUSHPULL     (0U)
+#define LL_GPIO_OUTPUT_OPENDRAIN    (1U)
+#define LL_GPIO_SPEED_FREQ_LOW      (0U)
+#define LL_GPIO_SPEED_FREQ_HIGH     (2U)
+#define LL_GPIO_SPEED_FREQ_VERY_HIGH (3U)
+#define LL_GPIO_PULL_NO             (0U)
+#define LL_GPIO_PULL_UP             (1U)
+#define LL_GPIO_PULL_DOWN           (2U)
+
+#define LL_GPIO_AF_0                (0U)
+#define LL_GPIO_AF0_SPI1            (0U)
+#define LL_GPIO_AF1_USART1          (1U)
+#define LL_GPIO_AF8_SPI2            (8U)
+#define LL_GPIO_AF9_SPI2            (9U)
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Speed;
+    uint32_t OutputType;
+    uint32_t Pull;
+    uint32_t Alternate;
+} LL_GPIO_InitTypeDef;
+
+static inline void LL_GPIO_StructInit(LL_GPIO_InitTypeDef *GPIO_InitStruct)
+{
+    GPIO_InitStruct->Pin        = LL_GPIO_PIN_ALL;
+    GPIO_InitStruct->Mode       = LL_GPIO_MODE_ANALOG;
+    GPIO_InitStruct->Speed      = LL_GPIO_SPEED_FREQ_LOW;
+    GPIO_InitStruct->OutputType = LL_GPIO_OUTPUT_PUSHPULL;
+    GPIO_InitStruct->Pull       = LL_GPIO_PULL_NO;
+    GPIO_InitStruct->Alternate  = LL_GPIO_AF_0;
+}
+
+static inline int LL_GPIO_Init(GPIO_TypeDef *GPIOx, LL_GPIO_InitTypeDef *GPIO_InitStruct)
+{
+    SIM_GPIO_Init(GPIOx, GPIO_InitStruct->Pin, GPIO_InitStruct->Mode);
+    return 0;
+}
+
+static inline void LL_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t Pin, uint32_t Mode) { SIM_GPIO_SetPinMode(GPIOx, Pin, Mode); }
+static inline void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) { SIM_GPIO_Write(GPIOx, PinMask, 0); }
+static inline void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) { SIM_GPIO_Write(GPIOx, 0, PinMask); }
+static inline void LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    const uint32_t odr = SIM_GPIO_ReadOutput(GPIOx);
+    SIM_GPIO_Write(GPIOx, ~odr & PinMask, odr & PinMask);
+}
+static inline uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx) { return SIM_GPIO_ReadInput(GPIOx); }
+static inline uint32_t LL_GPIO_ReadOutputPort(GPIO_TypeDef *GPIOx) { return SIM_GPIO_ReadOutput(GPIOx); }
+static inline uint32_t LL_GPIO_IsInputPinSet(GPIO_TypeDef *GPIOx, uint32_t PinMask) { return (SIM_GPIO_ReadInput(GPIOx) & PinMask) == PinMask; }
+static inline uint32_t LL_GPIO_IsOutputPinSet(GPIO_TypeDef *GPIOx, uint32_t PinMask) { return (SIM_GPIO_ReadOutput(GPIOx) & PinMask) == PinMask; }
+
+// ---------------------------------------------------------------------------
+// SPI
+
+#define LL_SPI_MODE_MASTER              (1U)
+#define LL_SPI_MODE_SLAVE               (0U)
+#define LL_SPI_FULL_DUPLEX              (0U)
+#define LL_SPI_DATAWIDTH_8BIT           (0U)
+#define LL_SPI_POLARITY_LOW             (0U)
+#define LL_SPI_POLARITY_HIGH            (1U)
+#define LL_SPI_PHASE_1EDGE              (0U)
+#define LL_SPI_PHASE_2EDGE              (1U)
+#define LL_SPI_NSS_SOFT                 (1U)
+#define LL_SPI_MSB_FIRST                (0U)
+#define LL_SPI_CRCCALCULATION_DISABLE   (0U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV2   (0U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV4   (1U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV8   (2U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV16  (3U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV32  (4U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV64  (5U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV128 (6U)
+#define LL_SPI_BAUDRATEPRESCALER_DIV256 (7U)
+#define LL_SPI_RX_FIFO_EMPTY            (0U)
+#define LL_SPI_TX_FIFO_EMPTY            (0U)
+
+typedef struct
+{
+    uint32_t TransferDirection;
+    uint32_t Mode;
+    uint32_t DataWidth;
+    uint32_t ClockPolarity;
+    uint32_t ClockPhase;
+    uint32_t NSS;
+    uint32_t BaudRate;
+    uint32_t BitOrder;
+    uint32_t CRCCalculation;
+    uint32_t CRCPoly;
+} LL_SPI_InitTypeDef;
+
+static inline void LL_SPI_StructInit(LL_SPI_InitTypeDef *SPI_InitStruct)
+{
+    SPI_InitStruct->TransferDirection = LL_SPI_FULL_DUPLEX;
+    SPI_InitStruct->Mode              = LL_SPI_MODE_SLAVE;
+    SPI_InitStruct->DataWidth         = LL_SPI_DATAWIDTH_8BIT;
+    SPI_InitStruct->ClockPolarity     = LL_SPI_POLARITY_LOW;
+    SPI_InitStruct->ClockPhase        = LL_SPI_PHASE_1EDGE;
+    SPI_InitStruct->NSS               = LL_SPI_NSS_SOFT;
+    SPI_InitStruct->BaudRate          = LL_SPI_BAUDRATEPRESCALER_DIV2;
+    SPI_InitStruct->BitOrder          = LL_SPI_MSB_FIRST;
+    SPI_InitStruct->CRCCalculation    = LL_SPI_CRCCALCULATION_DISABLE;
+    SPI_InitStruct->CRCPoly           = 7U;
+}
+
+static inline int LL_SPI_Init(SPI_TypeDef *SPIx, LL_SPI_InitTypeDef *SPI_InitStruct)
+{
+    SIM_SPI_Init(SPIx, SPI_InitStruct->BaudRate);
+    return 0;
+}
+
+static inline void     LL_SPI_Enable(SPI_TypeDef *SPIx) { SIM_SPI_Enable(SPIx, true); }
+static inline void     LL_SPI_Disable(SPI_TypeDef *SPIx) { SIM_SPI_Enable(SPIx, false); }
+static inline uint32_t LL_SPI_IsEnabled(SPI_TypeDef *SPIx) { return SIM_SPI_IsEnabled(SPIx); }
+static inline uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef *SPIx) { (void)SPIx; return 1; }
+static inline uint32_t LL_SPI_IsActiveFlag_RXNE(SPI_TypeDef *SPIx) { return SIM_SPI_IsRxNotEmpty(SPIx); }
+static inline uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef *SPIx) { (void)SPIx; return 0; }
+static inline uint32_t LL_SPI_GetRxFIFOLevel(SPI_TypeDef *SPIx) { return SIM_SPI_IsRxNotEmpty(SPIx) ? 1U : LL_SPI_RX_FIFO_EMPTY; }
+static inline uint32_t LL_SPI_GetTxFIFOLevel(SPI_TypeDef *SPIx) { (void)SPIx; return LL_SPI_TX_FIFO_EMPTY; }
+static inline void     LL_SPI_TransmitData8(SPI_TypeDef *SPIx, uint8_t TxData) { SIM_SPI_Transmit(SPIx, TxData); }
+static inline uint8_t  LL_SPI_ReceiveData8(SPI_TypeDef *SPIx) { return SIM_SPI_Receive(SPIx); }
+static inline void     LL_SPI_EnableDMAReq_RX(SPI_TypeDef *SPIx) { SIM_SPI_SetDMAReq(SPIx, false, true); }
+static inline void     LL_SPI_DisableDMAReq_RX(SPI_TypeDef *SPIx) { SIM_SPI_SetDMAReq(SPIx, false, false); }
+static inline void     LL_SPI_EnableDMAReq_TX(SPI_TypeDef *SPIx) { SIM_SPI_SetDMAReq(SPIx, true, true); }
+static inline void     LL_SPI_DisableDMAReq_TX(SPI_TypeDef *SPIx) { SIM_SPI_SetDMAReq(SPIx, true, false); }
+static inline uint32_t LL_SPI_DMA_GetRegAddr(SPI_TypeDef *SPIx) { return (uint32_t)(uintptr_t)&SPIx->DR; }
+
+// ---------------------------------------------------------------------------
+// DMA
+
+#define LL_DMA_CHANNEL_1                    1U
+#define LL_DMA_CHANNEL_2                    2U
+#define LL_DMA_CHANNEL_3                    3U
+#define LL_DMA_CHANNEL_4                    4U
+#define LL_DMA_CHANNEL_5                    5U
+#define LL_DMA_CHANNEL_6                    6U
+#define LL_DMA_CHANNEL_7                    7U
+
+#define LL_DMA_DIRECTION_PERIPH_TO_MEMORY   (0U)
+#define LL_DMA_DIRECTION_MEMORY_TO_PERIPH   (1U << 4)
+#define LL_DMA_DIRECTION_MEMORY_TO_MEMORY   (1U << 14)
+#define LL_DMA_MODE_NORMAL                  (0U)
+#define LL_DMA_MODE_CIRCULAR                (1U << 5)
+#define LL_DMA_PERIPH_INCREMENT             (1U << 6)
+#define LL_DMA_PERIPH_NOINCREMENT           (0U)
+#define LL_DMA_MEMORY_INCREMENT             (1U << 7)
+#define LL_DMA_MEMORY_NOINCREMENT           (0U)
+#define LL_DMA_PDATAALIGN_BYTE              (0U)
+#define LL_DMA_PDATAALIGN_HALFWORD          (1U << 8)
+#define LL_DMA_PDATAALIGN_WORD              (2U << 8)
+#define LL_DMA_MDATAALIGN_BYTE              (0U)
+#define LL_DMA_MDATAALIGN_HALFWORD          (1U << 10)
+#define LL_DMA_MDATAALIGN_WORD              (2U << 10)
+#define LL_DMA_PRIORITY_LOW                 (0U)
+#define LL_DMA_PRIORITY_MEDIUM              (1U << 12)
+#define LL_DMA_PRIORITY_HIGH                (2U << 12)
+#define LL_DMA_PRIORITY_VERYHIGH            (3U << 12)
+
+typedef struct
+{
+    uint32_t PeriphOrM2MSrcAddress;
+    uint32_t MemoryOrM2MDstAddress;
+    uint32_t Direction;
+    uint32_t Mode;
+    uint32_t PeriphOrM2MSrcIncMode;
+    uint32_t MemoryOrM2MDstIncMode;
+    uint32_t PeriphOrM2MSrcDataSize;
+    uint32_t MemoryOrM2MDstDataSize;
+    uint32_t NbData;
+    uint32_t Priority;
+} LL_DMA_InitTypeDef;
+
+static inline void LL_DMA_StructInit(LL_DMA_InitTypeDef *DMA_InitStruct)
+{
+    DMA_InitStruct->PeriphOrM2MSrcAddress  = 0U;
+    DMA_InitStruct->MemoryOrM2MDstAddress  = 0U;
+    DMA_InitStruct->Direction              = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    DMA_InitStruct->Mode                   = LL_DMA_MODE_NORMAL;
+    DMA_InitStruct->PeriphOrM2MSrcIncMode  = LL_DMA_PERIPH_NOINCREMENT;
+    DMA_InitStruct->MemoryOrM2MDstIncMode  = LL_DMA_MEMORY_NOINCREMENT;
+    DMA_InitStruct->PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
+    DMA_InitStruct->MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
+    DMA_InitStruct->NbData                 = 0U;
+    DMA_InitStruct->Priority               = LL_DMA_PRIORITY_LOW;
+}
+
+static inline int LL_DMA_Init(DMA_TypeDef *DMAx, uint32_t Channel, LL_DMA_InitTypeDef *DMA_InitStruct)
+{
+    (void)DMAx;
+    SIM_DMA_Config(Channel,
+        DMA_InitStruct->Direction |
+        DMA_InitStruct->Mode |
+        DMA_InitStruct->PeriphOrM2MSrcIncMode |
+        DMA_InitStruct->MemoryOrM2MDstIncMode |
+        DMA_InitStruct->PeriphOrM2MSrcDataSize |
+        DMA_InitStruct->MemoryOrM2MDstDataSize |
+        DMA_InitStruct->Priority);
+    SIM_DMA_SetPeriphAddress(Channel, DMA_InitStruct->PeriphOrM2MSrcAddress);
+    SIM_DMA_SetMemoryAddress(Channel, DMA_InitStruct->MemoryOrM2MDstAddress);
+    SIM_DMA_SetDataLength(Channel, DMA_InitStruct->NbData);
+    return 0;
+}
+
+static inline void     LL_DMA_ConfigTransfer(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Configuration) { (void)DMAx; SIM_DMA_Config(Channel, Configuration); }
+static inline void     LL_DMA_EnableChannel(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; SIM_DMA_Enable(Channel, true); }
+static inline void     LL_DMA_DisableChannel(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; SIM_DMA_Enable(Channel, false); }
+static inline uint32_t LL_DMA_IsEnabledChannel(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; return SIM_DMA_IsEnabled(Channel); }
+static inline void     LL_DMA_SetMemoryAddress(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t MemoryAddress) { (void)DMAx; SIM_DMA_SetMemoryAddress(Channel, MemoryAddress); }
+static inline void     LL_DMA_SetPeriphAddress(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t PeriphAddress) { (void)DMAx; SIM_DMA_SetPeriphAddress(Channel, PeriphAddress); }
+static inline void     LL_DMA_SetDataLength(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t NbData) { (void)DMAx; SIM_DMA_SetDataLength(Channel, NbData); }
+static inline uint32_t LL_DMA_GetDataLength(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; return SIM_DMA_GetDataLength(Channel); }
+static inline void     LL_DMA_EnableIT_TC(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; SIM_DMA_EnableIT_TC(Channel, true); }
+static inline void     LL_DMA_DisableIT_TC(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; SIM_DMA_EnableIT_TC(Channel, false); }
+static inline uint32_t LL_DMA_IsEnabledIT_TC(DMA_TypeDef *DMAx, uint32_t Channel) { (void)DMAx; return SIM_DMA_IsEnabledIT_TC(Channel); }
+
+#define LL_DMA_IsActiveFlag_TC1(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(1))
+#define LL_DMA_IsActiveFlag_TC2(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(2))
+#define LL_DMA_IsActiveFlag_TC3(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(3))
+#define LL_DMA_IsActiveFlag_TC4(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(4))
+#define LL_DMA_IsActiveFlag_TC5(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(5))
+#define LL_DMA_IsActiveFlag_TC6(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(6))
+#define LL_DMA_IsActiveFlag_TC7(DMAx)   ((void)(DMAx), SIM_DMA_IsActiveFlag_TC(7))
+#define LL_DMA_ClearFlag_GI1(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(1))
+#define LL_DMA_ClearFlag_GI2(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(2))
+#define LL_DMA_ClearFlag_GI3(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(3))
+#define LL_DMA_ClearFlag_GI4(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(4))
+#define LL_DMA_ClearFlag_GI5(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(5))
+#define LL_DMA_ClearFlag_GI6(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(6))
+#define LL_DMA_ClearFlag_GI7(DMAx)      ((void)(DMAx), SIM_DMA_ClearFlags(7))
+#define LL_DMA_ClearFlag_TC1(DMAx)      LL_DMA_ClearFlag_GI1(DMAx)
+#define LL_DMA_ClearFlag_TC2(DMAx)      LL_DMA_ClearFlag_GI2(DMAx)
+#define LL_DMA_ClearFlag_TC3(DMAx)      LL_DMA_ClearFlag_GI3(DMAx)
+#define LL_DMA_ClearFlag_TC4(DMAx)      LL_DMA_ClearFlag_GI4(DMAx)
+#define LL_DMA_ClearFlag_TC5(DMAx)      LL_DMA_ClearFlag_GI5(DMAx)
+#define LL_DMA_ClearFlag_TC6(DMAx)      LL_DMA_ClearFlag_GI6(DMAx)
+#define LL_DMA_ClearFlag_TC7(DMAx)      LL_DMA_ClearFlag_GI7(DMAx)
+
+// ---------------------------------------------------------------------------
+// SYSCFG
+
+#define LL_SYSCFG_DMA_MAP_ADC           0U
+#define LL_SYSCFG_DMA_MAP_SPI1_RD       1U
+#define LL_SYSCFG_DMA_MAP_SPI1_WR       2U
+#define LL_SYSCFG_DMA_MAP_SPI2_RD       3U
+#define LL_SYSCFG_DMA_MAP_SPI2_WR       4U
+#define LL_SYSCFG_DMA_MAP_USART1_RD     5U
+#define LL_SYSCFG_DMA_MAP_USART1_WR     6U
+#define LL_SYSCFG_DMA_MAP_TIM7_UP       7U
+#define LL_SYSCFG_DMA_MAP_DAC1          8U
+
+static inline void LL_SYSCFG_SetDMARemap(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Request) { (void)DMAx; SIM_DMA_SetRemap(Channel, Request); }
+
+// ---------------------------------------------------------------------------
+// USART
+
+#define LL_USART_DIRECTION_NONE     0U
+#define LL_USART_DIRECTION_RX       1U
+#define LL_USART_DIRECTION_TX       2U
+#define LL_USART_DIRECTION_TX_RX    3U
+
+typedef struct
+{
+    uint32_t BaudRate;
+    uint32_t DataWidth;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t TransferDirection;
+    uint32_t HardwareFlowControl;
+    uint32_t OverSampling;
+} LL_USART_InitTypeDef;
+
+static inline void LL_USART_StructInit(LL_USART_InitTypeDef *USART_InitStruct)
+{
+    USART_InitStruct->BaudRate            = 9600U;
+    USART_InitStruct->DataWidth           = 0U;
+    USART_InitStruct->StopBits            = 0U;
+    USART_InitStruct->Parity              = 0U;
+    USART_InitStruct->TransferDirection   = LL_USART_DIRECTION_TX_RX;
+    USART_InitStruct->HardwareFlowControl = 0U;
+    USART_InitStruct->OverSampling        = 0U;
+}
+
+static inline int LL_USART_Init(USART_TypeDef *USARTx, LL_USART_InitTypeDef *USART_InitStruct)
+{
+    SIM_USART_Init(USARTx, USART_InitStruct->BaudRate);
+    return 0;
+}
+
+static inline void     LL_USART_Enable(USART_TypeDef *USARTx) { SIM_USART_Enable(USARTx, true); }
+static inline void     LL_USART_Disable(USART_TypeDef *USARTx) { SIM_USART_Enable(USARTx, false); }
+static inline void     LL_USART_EnableDMAReq_RX(USART_TypeDef *USARTx) { SIM_USART_SetDMAReqRx(USARTx, true); }
+static inline void     LL_USART_DisableDMAReq_RX(USART_TypeDef *USARTx) { SIM_USART_SetDMAReqRx(USARTx, false); }
+static inline void     LL_USART_TransmitData8(USART_TypeDef *USARTx, uint8_t Value) { SIM_USART_Transmit(USARTx, Value); }
+static inline uint32_t LL_USART_IsActiveFlag_TXE(USART_TypeDef *USARTx) { return SIM_USART_IsTxEmpty(USARTx); }
+static inline uint32_t LL_USART_IsActiveFlag_TC(USART_TypeDef *USARTx) { return SIM_USART_IsTxComplete(USARTx); }
+static inline void     LL_USART_EnableIT_TXE(USART_TypeDef *USARTx) { SIM_USART_EnableIT_TXE(USARTx, true); }
+static inline void     LL_USART_DisableIT_TXE(USART_TypeDef *USARTx) { SIM_USART_EnableIT_TXE(USARTx, false); }
+static inline uint32_t LL_USART_IsEnabledIT_TXE(USART_TypeDef *USARTx) { return SIM_USART_IsEnabledIT_TXE(USARTx); }
+static inline uint32_t LL_USART_DMA_GetRegAddr(USART_TypeDef *USARTx) { return (uint32_t)(uintptr_t)&USARTx->DR; }
+
+// ---------------------------------------------------------------------------
+// ADC
+
+#define LL_ADC_PATH_INTERNAL_NONE       0U
+#define LL_ADC_RESOLUTION_12B           0U
+#define LL_ADC_DATA_ALIGN_RIGHT         0U
+#define LL_ADC_SEQ_SCAN_DISABLE         0U
+#define LL_ADC_REG_TRIG_SOFTWARE        0U
+#define LL_ADC_REG_CONV_SINGLE          0U
+#define LL_ADC_REG_DMA_TRANSFER_NONE    0U
+#define LL_ADC_REG_SEQ_SCAN_DISABLE     0U
+#define LL_ADC_REG_SEQ_DISCONT_DISABLE  0U
+#define LL_ADC_REG_RANK_1               0U
+#define LL_ADC_CHANNEL_8                8U
+#define LL_ADC_SAMPLINGTIME_41CYCLES_5  0U
+
+static inline void     LL_ADC_SetCommonPathInternalCh(ADC_Common_TypeDef *ADCxy_COMMON, uint32_t PathInternal) { (void)ADCxy_COMMON; (void)PathInternal; }
+static inline void     LL_ADC_SetResolution(ADC_TypeDef *ADCx, uint32_t Resolution) { (void)ADCx; (void)Resolution; }
+static inline void     LL_ADC_SetDataAlignment(ADC_TypeDef *ADCx, uint32_t DataAlignment) { (void)ADCx; (void)DataAlignment; }
+static inline void     LL_ADC_SetSequencersScanMode(ADC_TypeDef *ADCx, uint32_t ScanMode) { (void)ADCx; (void)ScanMode; }
+static inline void     LL_ADC_REG_SetTriggerSource(ADC_TypeDef *ADCx, uint32_t TriggerSource) { (void)ADCx; (void)TriggerSource; }
+static inline void     LL_ADC_REG_SetContinuousMode(ADC_TypeDef *ADCx, uint32_t Continuous) { (void)ADCx; (void)Continuous; }
+static inline void     LL_ADC_REG_SetDMATransfer(ADC_TypeDef *ADCx, uint32_t DMATransfer) { (void)ADCx; (void)DMATransfer; }
+static inline void     LL_ADC_REG_SetSequencerLength(ADC_TypeDef *ADCx, uint32_t SequencerNbRanks) { (void)ADCx; (void)SequencerNbRanks; }
+static inline void     LL_ADC_REG_SetSequencerDiscont(ADC_TypeDef *ADCx, uint32_t SeqDiscont) { (void)ADCx; (void)SeqDiscont; }
+static inline void     LL_ADC_REG_SetSequencerRanks(ADC_TypeDef *ADCx, uint32_t Rank, uint32_t Channel) { (void)ADCx; (void)Rank; (void)Channel; }
+static inline void     LL_ADC_SetChannelSamplingTime(ADC_TypeDef *ADCx, uint32_t Channel, uint32_t SamplingTime) { (void)ADCx; (void)Channel; (void)SamplingTime; }
+static inline void     LL_ADC_StartCalibration(ADC_TypeDef *ADCx) { (void)ADCx; }
+static inline uint32_t LL_ADC_IsCalibrationOnGoing(ADC_TypeDef *ADCx) { (void)ADCx; return 0; }
+static inline void     LL_ADC_Enable(ADC_TypeDef *ADCx) { (void)ADCx; }
+static inline void     LL_ADC_REG_StartConversionSWStart(ADC_TypeDef *ADCx) { (void)ADCx; }
+static inline uint32_t LL_ADC_IsActiveFlag_EOS(ADC_TypeDef *ADCx) { (void)ADCx; return 1; }
+static inline void     LL_ADC_ClearFlag_JEOS(ADC_TypeDef *ADCx) { (void)ADCx; }
+static inline uint16_t LL_ADC_REG_ReadConversionData12(ADC_TypeDef *ADCx) { (void)ADCx; return SIM_ADC_Read(); }
+
+// ---------------------------------------------------------------------------
+// TIM
+
+static inline void     LL_TIM_SetPrescaler(TIM_TypeDef *TIMx, uint32_t Prescaler) { (void)TIMx; (void)Prescaler; }
+static inline void     LL_TIM_SetAutoReload(TIM_TypeDef *TIMx, uint32_t AutoReload) { (void)TIMx; (void)AutoReload; }
+static inline void     LL_TIM_EnableARRPreload(TIM_TypeDef *TIMx) { (void)TIMx; }
+static inline void     LL_TIM_EnableDMAReq_UPDATE(TIM_TypeDef *TIMx) { (void)TIMx; }
+static inline void     LL_TIM_EnableUpdateEvent(TIM_TypeDef *TIMx) { (void)TIMx; }
+void                   SIM_TIM_SetCounter(TIM_TypeDef *TIMx, bool Enable);
+uint32_t               SIM_TIM_IsEnabledCounter(TIM_TypeDef *TIMx);
+static inline void     LL_TIM_EnableCounter(TIM_TypeDef *TIMx) { SIM_TIM_SetCounter(TIMx, true); }
+static inline void     LL_TIM_DisableCounter(TIM_TypeDef *TIMx) { SIM_TIM_SetCounter(TIMx, false); }
+static inline uint32_t LL_TIM_IsEnabledCounter(TIM_TypeDef *TIMx) { return SIM_TIM_IsEnabledCounter(TIMx); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,496 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// BK4819 seen from its 3-wire bus: CSN low, 8 address bits (bit 7 set for
+// a read), then 16 data bits, all sampled on the rising edge of SCL. On a
+// read, the chip drives bit 15 on SDA as soon as the address is complete and
+// shifts out the next bit after every rising edge.
+//
+// Registers hold what was last written, except the ones the chip computes,
+// which read back an input value set by the host (RSSI, noise, glitch,
+// interrupt flags, ...).
+
+#include <string.h>
+
+#include "sim/sim.h"
+
+typedef enum
+{
+    BUS_IDLE = 0,
+    BUS_ADDRESS,
+    BUS_WRITE,
+    BUS_READ,
+} BusState_t;
+
+static uint16_t   gRegs[128];
+static uint16_t   gInputs[128];
+static uint8_t    gInputMask[128 / 8];
+
+static BusState_t gState;
+static bool       gCsn = true;
+static bool       gScl = true;
+static bool       gSda = true;
+static unsigned   gBits;
+static uint8_t    gAddress;
+static uint16_t   gShift;
+static uint64_t   gSelectCycles;
+
+// Interrupt events raised by SIM_BK4819_RaiseInterrupt(), in due order
+static SIM_BK4819_Event_t  gEvents[SIM_BK4819_EVENTS];
+static size_t              gEventCount;
+static size_t              gEventServiced;
+
+// Synthetic band of SIM_BK4819_SetBand()
+static SIM_BK4819_Carrier_t gCarriers[SIM_BK4819_CARRIERS];
+static size_t               gCarrierCount;
+static uint16_t             gNoiseFloor;
+static uint64_t             gSettleCycles;
+static uint64_t             gRestartCycles;    // last REG_30 write
+static uint64_t             gCaptureCycles;    // frequency scan (re)started
+
+// Frequency scan of the synthetic band: it hears carriers this far either
+// side of the tuned frequency, this much over the floor
+#define CAPTURE_RANGE       100000u         // 1 MHz, 10 Hz units
+#define CAPTURE_LEVEL       20u
+#define CAPTURE_ERROR       50u             // +/- 500 Hz
+
+// FSK FIFOs, and the end of the frame on air
+static uint16_t            gFskTx[SIM_BK4819_FSK_WORDS];
+static size_t              gFskTxCount;
+static uint16_t            gFskRx[SIM_BK4819_FSK_WORDS];
+static size_t              gFskRxHead;
+static size_t              gFskRxCount;
+static uint64_t            gFskTxEndCycles;
+
+void (*gSimFskTxHook)(const uint16_t *pWords, size_t Count, uint64_t EndCycles);
+
+static SIM_BK4819_Write_t *gTrace;
+static size_t              gTraceCapacity;
+static size_t              gTraceLength;
+
+static bool IsInput(uint8_t Register)
+{
+    return gInputMask[Register >> 3] & (1u << (Register & 7));
+}
+
+static bool EventDue(void)
+{
+    return gEventServiced < gEventCount && gEvents[gEventServiced].dueCycles <= gSimCycles;
+}
+
+static bool CarrierOn(const SIM_BK4819_Carrier_t *pCarrier, uint64_t Cycles)
+{
+    if (pCarrier->onMs == 0 || pCarrier->periodMs == 0)
+        return true;
+
+    const uint64_t ms = Cycles / (SIM_CYCLES_PER_US * 1000u) + pCarrier->phaseMs;
+
+    return ms % pCarrier->periodMs < pCarrier->onMs;
+}
+
+static uint32_t TunedFrequency(void)
+{
+    return gRegs[0x38] | ((uint32_t)gRegs[0x39] << 16);
+}
+
+static uint16_t CarrierRssi(uint32_t Frequency, uint16_t Floor, uint64_t Cycles)
+{
+    uint16_t rssi = Floor;
+
+    for (size_t i = 0; i < gCarrierCount; i++)
+    {
+        const SIM_BK4819_Carrier_t *c = &gCarriers[i];
+        const uint32_t offset = Frequency > c->freq ? Frequency - c->freq : c->freq - Frequency;
+
+        if (offset <= c->width && c->rssi > rssi && CarrierOn(c, Cycles))
+            rssi = c->rssi;
+    }
+
+    return rssi;
+}
+
+// As of the time the read started, the same for every bit of it
+static uint16_t BandRssi(void)
+{
+    const uint64_t hash = gSelectCycles * 0x9E3779B97F4A7C15ull;
+
+    return CarrierRssi(TunedFrequency(), gNoiseFloor + (uint16_t)((hash >> 60) & 3u), gSelectCycles);
+}
+
+// REG_32 <15:14>: 0.2, 0.4, 0.8 or 1.6 s per frequency scan report
+static uint64_t CapturePeriod(void)
+{
+    return (200000ull << (gRegs[0x32] >> 14)) * SIM_CYCLES_PER_US;
+}
+
+// Report of the frequency scan that completed at Cycles: the strongest
+// carrier keyed on within range, a little off, or noise anywhere in range
+static uint32_t CaptureResult(uint64_t Cycles)
+{
+    const uint32_t tuned = TunedFrequency();
+    const uint64_t hash  = Cycles * 0x9E3779B97F4A7C15ull;
+    uint16_t       best  = gNoiseFloor + CAPTURE_LEVEL;
+    uint32_t       freq  = tuned - CAPTURE_RANGE + (uint32_t)((hash >> 32) % (2 * CAPTURE_RANGE + 1));
+
+    for (size_t i = 0; i < gCarrierCount; i++)
+    {
+        const SIM_BK4819_Carrier_t *c = &gCarriers[i];
+        const uint32_t offset = tuned > c->freq ? tuned - c->freq : c->freq - tuned;
+
+        if (offset <= CAPTURE_RANGE && c->rssi >= best && CarrierOn(c, Cycles))
+        {
+            best = c->rssi;
+            freq = c->freq - CAPTURE_ERROR + (uint32_t)((hash >> 16) % (2 * CAPTURE_ERROR + 1));
+        }
+    }
+
+    return freq;
+}
+
+// REG_5D <15:8>: data length - 1, in bytes
+static size_t FskLength(void)
+{
+    return (gRegs[0x5D] >> 8) + 1u;
+}
+
+// REG_59 <7:4>: preamble length - 1, bit 3: 4 sync bytes rather than 2
+static size_t FskOverhead(void)
+{
+    return ((gRegs[0x59] >> 4) & 0xFu) + 1u + ((gRegs[0x59] & 0x0008u) ? 4u : 2u);
+}
+
+static void FskSend(void)
+{
+    const size_t   bytes = FskLength();
+    const size_t   words = (bytes + 1) / 2 < gFskTxCount ? (bytes + 1) / 2 : gFskTxCount;
+    const uint64_t end   = gSimCycles + (FskOverhead() + bytes) * SIM_BK4819_FSK_BYTE_CYCLES;
+
+    gSimStats.fskTxFrames++;
+    gSimStats.fskTxCycles += end - gSimCycles;
+    gFskTxEndCycles        = end;
+
+    if (gRegs[0x3F] & 0x8000u)
+        SIM_BK4819_RaiseInterrupt(end, 0x8000u);
+
+    if (gSimFskTxHook)
+        gSimFskTxHook(gFskTx, words, end);
+
+    gFskTxCount = 0;
+}
+
+static uint16_t ReadValue(uint8_t Register)
+{
+    if (Register == 0x5F && gFskRxHead < gFskRxCount)
+        return gFskRx[gFskRxHead];
+
+    if (gCarrierCount > 0)
+    {
+        if (Register == 0x67)
+            return BandRssi();
+        if (Register == 0x63)
+            return gSelectCycles < gRestartCycles + gSettleCycles ? 0x00FF : 0x0000;
+
+        // Frequency scan running (REG_32 bit 0): busy (bit 15) until the
+        // period is over, then the report; reading REG_0E starts the next
+        if ((Register == 0x0D || Register == 0x0E) && (gRegs[0x32] & 1u))
+        {
+            const uint64_t due = gCaptureCycles + CapturePeriod();
+
+            if (gSelectCycles < due)
+                return Register == 0x0D ? 0x8000 : 0x0000;
+
+            const uint32_t freq = CaptureResult(due);
+
+            return Register == 0x0D ? (uint16_t)((freq >> 16) & 0x07FF) : (uint16_t)freq;
+        }
+    }
+
+    const uint16_t value = IsInput(Register) ? gInputs[Register] : gRegs[Register];
+
+    // REG_0C bit 0: interrupt request
+    if (Register == 0x0C && EventDue())
+        return value | 1u;
+
+    return value;
+}
+
+static void CommitWrite(uint8_t Register, uint16_t Value)
+{
+    const uint16_t previous = gRegs[Register];
+
+    gRegs[Register] = Value;
+    gSimStats.bkWrites++;
+
+    if (Register == 0x38)
+        gSimStats.bkTunes++;
+
+    if (Register == 0x30)
+        gRestartCycles = gSimCycles;
+
+    // The frequency scan starts over when enabled or the receiver restarts
+    if (Register == 0x30 || Register == 0x32)
+        gCaptureCycles = gSimCycles;
+
+    if (gTrace && gTraceLength < gTraceCapacity)
+        gTrace[gTraceLength++] = (SIM_BK4819_Write_t){ Register, Value, gSimCycles };
+
+    // FSK: REG_5F fills the TX FIFO, REG_59 clears the FIFOs (bits 15 and
+    // 14) and sends (bit 11 set)
+    if (Register == 0x5F && gFskTxCount < SIM_BK4819_FSK_WORDS)
+        gFskTx[gFskTxCount++] = Value;
+
+    if (Register == 0x59)
+    {
+        if (Value & 0x8000u)
+            gFskTxCount = 0;
+        if (Value & 0x4000u)
+        {
+            // The frame being received goes with the FIFO
+            gFskRxHead = gFskRxCount = 0;
+            for (size_t i = gEventServiced; i < gEventCount; i++)
+                if (!(gEvents[i].flags & ~0x3000u))
+                    gEvents[i].flags = 0;
+        }
+        if ((Value & 0x0800u) && !(previous & 0x0800u))
+            FskSend();
+    }
+
+    // REG_02 is write-to-clear for the interrupt flags: the write takes the
+    // first due event off, leaving its flags to read
+    if (Register == 0x02)
+    {
+        gRegs[0x02] = 0;
+
+        if (EventDue())
+        {
+            gRegs[0x02] = gEvents[gEventServiced].flags;
+            gEvents[gEventServiced++].servicedCycles = gSimCycles;
+
+            // FSK FIFO events the firmware is late for are one flag: they
+            // come as one, the words they stand for left in the FIFO
+            while ((gRegs[0x02] & 0x1000u) && EventDue() && !(gEvents[gEventServiced].flags & ~0x3000u))
+            {
+                gRegs[0x02] |= gEvents[gEventServiced].flags;
+                gEvents[gEventServiced++].servicedCycles = gSimCycles;
+            }
+        }
+    }
+}
+
+void SIM_BK4819_PinsChanged(bool Csn, bool Scl, bool Sda)
+{
+    const bool rising = Scl && !gScl;
+
+    if (Csn != gCsn)
+    {
+        if (!Csn)
+        {
+            gState        = BUS_ADDRESS;
+            gBits         = 0;
+            gShift        = 0;
+            gSelectCycles = gSimCycles;
+        }
+        else
+        {
+            gState = BUS_IDLE;
+            gSimStats.bkBusCycles += gSimCycles - gSelectCycles;
+        }
+    }
+
+    gCsn = Csn;
+    gScl = Scl;
+    gSda = Sda;
+
+    if (gCsn || !rising)
+        return;
+
+    switch (gState)
+    {
+        case BUS_ADDRESS:
+            gShift = (uint16_t)((gShift << 1) | Sda);
+            if (++gBits == 8)
+            {
+                gAddress = gShift & 0x7F;
+                gState   = (gShift & 0x80) ? BUS_READ : BUS_WRITE;
+                gBits    = 0;
+                gShift   = 0;
+
+                if (gState == BUS_READ)
+                {
+                    gSimStats.bkReads++;
+
+                    if (gAddress == 0x02 && gEventServiced > 0)
+                        gEvents[gEventServiced - 1].read = ReadValue(0x02);
+                }
+            }
+            break;
+
+        case BUS_WRITE:
+            gShift = (uint16_t)((gShift << 1) | Sda);
+            if (++gBits == 16)
+            {
+                CommitWrite(gAddress, gShift);
+                gState = BUS_IDLE;
+            }
+            break;
+
+        case BUS_READ:
+            if (++gBits == 16)
+            {
+                gState = BUS_IDLE;
+
+                if (gAddress == 0x5F && gFskRxHead < gFskRxCount)
+                    gFskRxHead++;
+
+                if (gAddress == 0x0E && gCarrierCount > 0 && (gRegs[0x32] & 1u) &&
+                    gSelectCycles >= gCaptureCycles + CapturePeriod())
+                    gCaptureCycles = gSelectCycles;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool SIM_BK4819_Sda(void)
+{
+    if (gState != BUS_READ)
+        return true;
+
+    return (ReadValue(gAddress) >> (15 - gBits)) & 1u;
+}
+
+uint16_t SIM_BK4819_GetRegister(uint8_t Register)
+{
+    return gRegs[Register & 0x7F];
+}
+
+void SIM_BK4819_SetInput(uint8_t Register, uint16_t Value)
+{
+    Register &= 0x7F;
+    gInputs[Register] = Value;
+    gInputMask[Register >> 3] |= 1u << (Register & 7);
+}
+
+void SIM_BK4819_ClearInput(uint8_t Register)
+{
+    Register &= 0x7F;
+    gInputMask[Register >> 3] &= ~(1u << (Register & 7));
+}
+
+void SIM_BK4819_SetRssi(uint16_t Rssi)
+{
+    SIM_BK4819_SetInput(0x67, Rssi & 0x01FF);
+}
+
+void SIM_BK4819_SetBand(const SIM_BK4819_Carrier_t *pCarriers, size_t Count, uint16_t Floor,
+                        uint32_t SettleUs)
+{
+    if (Count > SIM_BK4819_CARRIERS)
+        Count = SIM_BK4819_CARRIERS;
+
+    if (Count > 0)
+        memcpy(gCarriers, pCarriers, Count * sizeof(gCarriers[0]));
+    gCarrierCount = Count;
+    gNoiseFloor   = Floor;
+    gSettleCycles = (uint64_t)SettleUs * SIM_CYCLES_PER_US;
+}
+
+uint16_t SIM_BK4819_BandRssiAt(uint32_t Frequency)
+{
+    return CarrierRssi(Frequency, gNoiseFloor, gSimCycles);
+}
+
+bool SIM_BK4819_RaiseInterrupt(uint64_t DueCycles, uint16_t Flags)
+{
+    // All serviced: start over, for long runs of FSK frames
+    if (gEventCount == SIM_BK4819_EVENTS && gEventServiced == gEventCount)
+        SIM_BK4819_ClearEvents();
+
+    if (gEventCount == SIM_BK4819_EVENTS || (gEventCount > 0 && DueCycles < gEvents[gEventCount - 1].dueCycles))
+        return false;
+
+    gEvents[gEventCount++] = (SIM_BK4819_Event_t){ DueCycles, 0, Flags, 0 };
+    return true;
+}
+
+bool SIM_BK4819_FskReceive(const uint16_t *pWords, size_t Count)
+{
+    const size_t   words = (FskLength() + 1) / 2;
+    const uint16_t mask  = gRegs[0x3F] & 0x3000u;
+
+    if (!(gRegs[0x59] & 0x1000u) || (gRegs[0x59] & 0x0800u) || gSimCycles < gFskTxEndCycles ||
+        words > SIM_BK4819_FSK_WORDS)
+        return false;
+
+    for (size_t i = 0; i < words; i++)
+        gFskRx[i] = i < Count ? pWords[i] : (uint16_t)(((gSimCycles + i) * 0x9E3779B97F4A7C15ull) >> 48);
+    gFskRxHead  = 0;
+    gFskRxCount = words;
+
+    // FIFO almost full every 4 words, RX finished with the last ones
+    for (size_t n = 4;; n += 4)
+    {
+        const size_t   got   = n < words ? n : words;
+        const uint16_t flags = (uint16_t)((0x1000u | (got == words ? 0x2000u : 0)) & mask);
+
+        if (flags && !SIM_BK4819_RaiseInterrupt(gSimCycles + got * 2 * SIM_BK4819_FSK_BYTE_CYCLES, flags))
+            return false;
+        if (got == words)
+            return true;
+    }
+}
+
+const SIM_BK4819_Event_t *SIM_BK4819_Events(size_t *pCount, size_t *pServiced)
+{
+    *pCount    = gEventCount;
+    *pServiced = gEventServiced;
+    return gEvents;
+}
+
+void SIM_BK4819_ClearEvents(void)
+{
+    gEventCount    = 0;
+    gEventServiced = 0;
+}
+
+void SIM_BK4819_TraceStart(SIM_BK4819_Write_t *pBuffer, size_t Capacity)
+{
+    gTrace         = pBuffer;
+    gTraceCapacity = Capacity;
+    gTraceLength   = 0;
+}
+
+size_t SIM_BK4819_TraceStop(void)
+{
+    const size_t n = gTraceLength;
+
+    gTrace         = NULL;
+    gTraceCapacity = 0;
+    gTraceLength   = 0;
+    return n;
+}
+
+void SIM_BK4819_Reset(void)
+{
+    memset(gRegs, 0, sizeof(gRegs));
+    memset(gInputMask, 0, sizeof(gInputMask));
+    SIM_BK4819_ClearEvents();
+    gCarrierCount   = 0;
+    gFskTxCount     = 0;
+    gFskRxHead      = 0;
+    gFskRxCount     = 0;
+    gFskTxEndCycles = 0;
+
+    // Values the firmware polls for and expects a live chip to report
+    SIM_BK4819_SetInput(0x0C, 0x0000);  // no interrupt pending
+    SIM_BK4819_SetInput(0x63, 0x0000);  // glitch
+    SIM_BK4819_SetInput(0x65, 0x0000);  // noise
+    SIM_BK4819_SetRssi(0x0050);         // quiet band, about -120 dBm
+    SIM_BK4819_SetInput(0x0D, 0x0000);  // frequency scan idle
+    SIM_BK4819_SetInput(0x68, 0x0000);  // CTCSS scan result
+    SIM_BK4819_SetInput(0x69, 0x0000);  // CDCSS scan result
+}
@@ -0,0 +1,285 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py32f0xx.h"
+#include "sim/sim.h"
+
+// From App/scheduler.c
+void SysTick_Handler(void);
+
+uint32_t    SystemCoreClock = SIM_CPU_HZ;
+SIM_Stats_t gSimStats;
+uint64_t    gSimCycles;
+bool        gSimVerbose;
+
+static SysTick_Type gSysTick;
+static uint64_t     gSysTickNext;       // cycle count of the next interrupt
+static uint32_t     gSysTickVal;        // VAL as last set here, to see writes
+static uint64_t     gSysTickOrigin;     // cycle count of SysTick_Config()
+static bool         gSysTickPending;
+static bool         gInIsr;
+static bool         gPrimask;           // interrupts masked, as PRIMASK on the M0+
+static void       (*gIrqPending[4])(void);
+
+// Polling SysTick->VAL in SYSTICK_DelayUs() costs a load, a compare and a
+// branch on the Cortex-M0+.
+#define SYSTICK_POLL_CYCLES 12u
+
+void (*gSimTickHook)(void);
+
+static void RunTickHook(void)
+{
+    static bool busy;
+
+    if (gSimTickHook == NULL || busy)
+        return;
+
+    busy = true;
+    gSimTickHook();
+    busy = false;
+}
+
+// A write to VAL clears the counter, which reloads LOAD on the next cycle
+// without an interrupt
+static void SysTickSync(void)
+{
+    if ((gSysTick.CTRL & 1u) && gSysTick.VAL != gSysTickVal)
+    {
+        gSysTickNext = gSimCycles + gSysTick.LOAD + 1;
+        gSysTickVal  = gSysTick.VAL;
+    }
+}
+
+// Run the pending interrupts, SysTick first, unless masked or already in a
+// handler (there is no nesting)
+static void RunIrqs(void)
+{
+    while (!gInIsr && !gPrimask)
+    {
+        void (*handler)(void) = NULL;
+
+        if (gSysTickPending)
+        {
+            gSysTickPending = false;
+            gSimStats.sysTicks++;
+            handler = SysTick_Handler;
+        }
+        else
+        {
+            for (unsigned i = 0; i < 4 && handler == NULL; i++)
+            {
+                handler = gIrqPending[i];
+                gIrqPending[i] = NULL;
+            }
+        }
+
+        if (handler == NULL)
+            return;
+
+        gInIsr = true;
+        handler();
+        gInIsr = false;
+    }
+}
+
+void SIM_RaiseIrq(void (*Handler)(void))
+{
+    for (unsigned i = 0; i < 4; i++)
+        if (gIrqPending[i] == Handler)
+            return;
+
+    for (unsigned i = 0; i < 4; i++)
+    {
+        if (gIrqPending[i] == NULL)
+        {
+            gIrqPending[i] = Handler;
+            return;
+        }
+    }
+}
+
+void SIM_AdvanceCycles(uint64_t Cycles)
+{
+    const uint64_t target = gSimCycles + Cycles;
+
+    SysTickSync();
+
+    // Step from one event to the next (SysTick, SPI DMA byte, UART TXE and RX
+    // byte), so that each interrupt runs when it would on the radio
+    do
+    {
+        uint64_t next = SIM_PeriphNextEvent();
+
+        if ((gSysTick.CTRL & 1u) && gSysTickNext < next)
+            next = gSysTickNext;
+        gSimCycles = (next > gSimCycles && next < target) ? next : target;
+
+        SIM_PeriphAdvance();
+
+        bool ticked = false;
+
+        if (gSysTick.CTRL & 1u)
+        {
+            const uint64_t period = (uint64_t)gSysTick.LOAD + 1;
+
+            while (gSimCycles >= gSysTickNext)
+            {
+                gSysTickNext += period;
+                gSysTickPending = true;
+                ticked = true;
+            }
+        }
+
+        RunIrqs();
+
+        if (ticked)
+            RunTickHook();
+    } while (gSimCycles < target);
+}
+
+void SIM_AdvanceUs(uint64_t Us)
+{
+    SIM_AdvanceCycles(Us * SIM_CYCLES_PER_US);
+}
+
+void SIM_AdvanceToNextTick(void)
+{
+    SysTickSync();
+
+    if ((gSysTick.CTRL & 1u) == 0)
+    {
+        SIM_AdvanceUs(10000);
+        return;
+    }
+
+    SIM_AdvanceCycles(gSysTickNext - gSimCycles);
+}
+
+uint64_t SIM_TimeUs(void)
+{
+    return gSimCycles / SIM_CYCLES_PER_US;
+}
+
+bool SIM_InIsr(void)
+{
+    return gInIsr;
+}
+
+SysTick_Type *SIM_SysTick(void)
+{
+    SIM_AdvanceCycles(SYSTICK_POLL_CYCLES);
+
+    // LOAD may have changed since the reload: count down to the next tick
+    if (gSysTick.CTRL & 1u)
+    {
+        gSysTick.VAL = (uint32_t)(gSysTickNext - gSimCycles) - 1;
+        gSysTickVal  = gSysTick.VAL;
+    }
+
+    return &gSysTick;
+}
+
+uint64_t SIM_SysTickOrigin(void)
+{
+    return gSysTickOrigin;
+}
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+    gSysTickOrigin  = gSimCycles;
+    gSysTick.LOAD   = ticks - 1;
+    gSysTick.VAL    = 0;
+    gSysTickVal     = 0;
+    gSysTick.CTRL   = 7u;     // CLKSOURCE | TICKINT | ENABLE
+    gSysTickNext    = gSimCycles + ticks;
+    return 0;
+}
+
+void SIM_DisableIrq(void)
+{
+    gPrimask = true;
+}
+
+void SIM_EnableIrq(void)
+{
+    gPrimask = false;
+    RunIrqs();
+}
+
+uint32_t SIM_GetPrimask(void)
+{
+    return gPrimask;
+}
+
+void SIM_SetPrimask(uint32_t Value)
+{
+    if (Value & 1u)
+        SIM_DisableIrq();
+    else
+        SIM_EnableIrq();
+}
+
+void NVIC_SystemReset(void)
+{
+    fprintf(stderr, "[sim] NVIC_SystemReset() at %" PRIu64 " us\n", SIM_TimeUs());
+    SIM_Exit(0);
+}
+
+void SIM_ResetStats(void)
+{
+    memset(&gSimStats, 0, sizeof(gSimStats));
+}
+
+#define US(c) ((double)(c) / SIM_CYCLES_PER_US)
+
+void SIM_PrintStats(FILE *f, const char *pTitle)
+{
+    const SIM_Stats_t *s = &gSimStats;
+
+    fprintf(f, "== %s @ %.3f ms\n", pTitle ? pTitle : "stats", US(gSimCycles) / 1000.0);
+    fprintf(f, "bk4819   writes %-9" PRIu64 " reads %-9" PRIu64 " bus %.0f us, %" PRIu64 " tunes\n",
+        s->bkWrites, s->bkReads, US(s->bkBusCycles), s->bkTunes);
+    if (s->fskTxFrames > 0)
+        fprintf(f, "         fsk tx %" PRIu64 " frames, %.0f ms on air\n", s->fskTxFrames, US(s->fskTxCycles) / 1000.0);
+    fprintf(f, "st7565   xfers  %-9" PRIu64 " cmd %-11" PRIu64 " data %" PRIu64 " bytes\n",
+        s->lcdTransactions, s->lcdCmdBytes, s->lcdDataBytes);
+    fprintf(f, "py25q16  xfers  %-9" PRIu64 " reads %-9" PRIu64 " (%" PRIu64 " bytes)\n",
+        s->flashTransactions, s->flashReadCmds, s->flashReadBytes);
+    fprintf(f, "         erases %-9" PRIu64 " pages %-9" PRIu64 " (%" PRIu64 " bytes) busy %.0f us, %" PRIu64 " status polls\n",
+        s->flashSectorErases, s->flashPagePrograms, s->flashProgramBytes, US(s->flashBusyCycles), s->flashStatusPolls);
+    fprintf(f, "         watch  reads %-9" PRIu64 " bytes %" PRIu64 "\n", s->flashWatchReads, s->flashWatchBytes);
+    for (unsigned i = 0; i < SIM_FLASH_READ_SIZES; i++)
+    {
+        const unsigned lo = 1u << i;
+        char           sizes[16];
+
+        if (s->flashReadsBySize[i] == 0)
+            continue;
+
+        if (i == SIM_FLASH_READ_SIZES - 1)
+            snprintf(sizes, sizeof(sizes), "%u+", lo);
+        else if (i == 0)
+            snprintf(sizes, sizeof(sizes), "%u", lo);
+        else
+            snprintf(sizes, sizeof(sizes), "%u-%u", lo, 2 * lo - 1);
+
+        fprintf(f, "         read   %-7s B %-9" PRIu64 " %.2f us each\n",
+            sizes, s->flashReadsBySize[i], US(s->flashReadCyclesBySize[i]) / s->flashReadsBySize[i]);
+    }
+    fprintf(f, "usart1   tx %" PRIu64 " rx %" PRIu64 " bytes\n", s->uartTxBytes, s->uartRxBytes);
+    fprintf(f, "mainloop iterations %" PRIu64 " max gap %.0f us, %" PRIu64 " systicks\n",
+        s->loopIterations, US(s->loopMaxGapCycles), s->sysTicks);
+}
+
+void SIM_Exit(int Status)
+{
+    SIM_PY25Q16_Save();
+    fflush(stdout);
+    exit(Status);
+}
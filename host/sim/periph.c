@@ -0,0 +1,708 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// GPIO, SPI, DMA, USART, ADC and TIM models of the PY32F071, wired the way
+// the UV-K1 / UV-K5 V3 board wires them.
+
+#include <string.h>
+
+#include "py32f0xx.h"
+#include "sim/sim.h"
+
+// Interrupt handlers implemented by the firmware, when the feature using
+// them is compiled in.
+void DMA1_Channel1_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel2_3_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel4_5_6_7_IRQHandler(void) __attribute__((weak));
+void USART1_IRQHandler(void) __attribute__((weak));
+
+// ---------------------------------------------------------------------------
+// GPIO
+
+// Each toggle of a BK4819 pin is followed by SHORT_DELAY() (40 nops) in
+// driver/bk4829.c, which the host cannot see; charge it on the pin write.
+#define BK4819_PIN_CYCLES   45u
+#define GPIO_WRITE_CYCLES   2u
+
+#define PIN_KEY_ROWS        (LL_GPIO_PIN_15 | LL_GPIO_PIN_14 | LL_GPIO_PIN_13 | LL_GPIO_PIN_12)
+#define PIN_KEY_COLS        (LL_GPIO_PIN_6 | LL_GPIO_PIN_5 | LL_GPIO_PIN_4 | LL_GPIO_PIN_3)
+
+typedef struct
+{
+    uint32_t odr;
+    uint32_t output;        // pins configured as outputs
+} Port_t;
+
+static Port_t   gPorts[SIM_PORT_COUNT];
+static int      gKeyPressed = -1;
+static bool     gPttPressed;
+static uint16_t gBatteryAdc = 2100;
+
+static SIM_Port_t PortIndex(GPIO_TypeDef *GPIOx)
+{
+    switch ((uintptr_t)GPIOx - IOPORT_BASE)
+    {
+        case 0x0000: return SIM_PORT_A;
+        case 0x0400: return SIM_PORT_B;
+        case 0x0800: return SIM_PORT_C;
+        default:     return SIM_PORT_F;
+    }
+}
+
+void SIM_GPIO_Init(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Mode)
+{
+    SIM_GPIO_SetPinMode(GPIOx, PinMask, Mode);
+}
+
+void SIM_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t PinMask, uint32_t Mode)
+{
+    Port_t *p = &gPorts[PortIndex(GPIOx)];
+
+    if (Mode == LL_GPIO_MODE_OUTPUT)
+        p->output |= PinMask;
+    else
+        p->output &= ~PinMask;
+
+    if (GPIOx == GPIOB && (PinMask & LL_GPIO_PIN_9))
+        SIM_AdvanceCycles(BK4819_PIN_CYCLES);
+}
+
+void SIM_GPIO_Write(GPIO_TypeDef *GPIOx, uint32_t SetMask, uint32_t ResetMask)
+{
+    const SIM_Port_t idx = PortIndex(GPIOx);
+    Port_t          *p   = &gPorts[idx];
+    const uint32_t   old = p->odr;
+
+    p->odr = (old | SetMask) & ~ResetMask;
+
+    const uint32_t changed = (old ^ p->odr) | SetMask | ResetMask;
+
+    SIM_AdvanceCycles(GPIO_WRITE_CYCLES);
+
+    // BK4819: CSN PF9, SCL PB8, SDA PB9
+    if ((idx == SIM_PORT_F && (changed & LL_GPIO_PIN_9)) ||
+        (idx == SIM_PORT_B && (changed & (LL_GPIO_PIN_8 | LL_GPIO_PIN_9))))
+    {
+        SIM_AdvanceCycles(BK4819_PIN_CYCLES);
+        SIM_BK4819_PinsChanged(
+            gPorts[SIM_PORT_F].odr & LL_GPIO_PIN_9,
+            gPorts[SIM_PORT_B].odr & LL_GPIO_PIN_8,
+            gPorts[SIM_PORT_B].odr & LL_GPIO_PIN_9);
+    }
+
+    // ST7565 CS: PB2
+    if (idx == SIM_PORT_B && ((old ^ p->odr) & LL_GPIO_PIN_2))
+        SIM_ST7565_Select(!(p->odr & LL_GPIO_PIN_2));
+
+    // PY25Q16 CS: PA3
+    if (idx == SIM_PORT_A && ((old ^ p->odr) & LL_GPIO_PIN_3))
+        SIM_PY25Q16_Select(!(p->odr & LL_GPIO_PIN_3));
+}
+
+uint32_t SIM_GPIO_ReadOutput(GPIO_TypeDef *GPIOx)
+{
+    return gPorts[PortIndex(GPIOx)].odr;
+}
+
+// Keypad matrix, see driver/keyboard.c: columns PB6..PB3 are driven low one
+// at a time and rows PB15..PB12 are read back with pull-ups. SIDE1/SIDE2
+// pull their row low without any column.
+static uint32_t KeypadRows(uint32_t odr)
+{
+    static const int8_t matrix[5][4] = {
+        { 18, 17, -1, -1 },     // KEY_SIDE1, KEY_SIDE2
+        { 10,  1,  4,  7 },     // KEY_MENU, 1, 4, 7
+        { 11,  2,  5,  8 },     // KEY_UP, 2, 5, 8
+        { 12,  3,  6,  9 },     // KEY_DOWN, 3, 6, 9
+        { 13, 14,  0, 15 },     // KEY_EXIT, KEY_STAR, 0, KEY_F
+    };
+
+    uint32_t rows = PIN_KEY_ROWS;
+
+    if (gKeyPressed < 0)
+        return rows;
+
+    for (unsigned col = 0; col < 5; col++)
+    {
+        for (unsigned row = 0; row < 4; row++)
+        {
+            if (matrix[col][row] != gKeyPressed)
+                continue;
+
+            if (col == 0 || !(odr & (1u << (6 - (col - 1)))))
+                rows &= ~(1u << (15 - row));
+        }
+    }
+
+    return rows;
+}
+
+uint32_t SIM_GPIO_ReadInput(GPIO_TypeDef *GPIOx)
+{
+    const SIM_Port_t idx = PortIndex(GPIOx);
+    const Port_t    *p   = &gPorts[idx];
+    uint32_t         in  = (p->odr & p->output) | (~p->output & 0xFFFFu);  // pull-ups
+
+    SIM_AdvanceCycles(GPIO_WRITE_CYCLES);
+
+    if (idx == SIM_PORT_B)
+    {
+        in = (in & ~PIN_KEY_ROWS) | KeypadRows(p->odr);
+
+        if (gPttPressed)
+            in &= ~LL_GPIO_PIN_10;
+
+        if (!(p->output & LL_GPIO_PIN_9))
+            in = SIM_BK4819_Sda() ? (in | LL_GPIO_PIN_9) : (in & ~LL_GPIO_PIN_9);
+    }
+
+    return in;
+}
+
+bool SIM_GpioOutput(SIM_Port_t Port, unsigned Pin)
+{
+    return gPorts[Port].odr & (1u << Pin);
+}
+
+void SIM_KeypadPress(int Key)
+{
+    gKeyPressed = (Key >= 0 && Key < 19 && Key != 16) ? Key : -1;
+    if (Key == 16)
+        gPttPressed = true;
+    else if (Key < 0 || Key >= 19)
+        gPttPressed = false;
+}
+
+int SIM_KeypadPressed(void)
+{
+    return gPttPressed ? 16 : gKeyPressed;
+}
+
+void SIM_SetPtt(bool Pressed)
+{
+    gPttPressed = Pressed;
+}
+
+// ---------------------------------------------------------------------------
+// DMA
+
+typedef struct
+{
+    uint32_t config;
+    uint32_t memory;
+    uint32_t periph;
+    uint32_t length;
+    uint32_t reload;
+    uint32_t request;
+    bool     enabled;
+    bool     tcie;
+    bool     tc;
+} DmaChannel_t;
+
+static DmaChannel_t gDma[8];
+
+#define DMA_POLL_CYCLES 4u
+
+static DmaChannel_t *FindDmaChannel(uint32_t Request)
+{
+    for (unsigned i = 1; i < 8; i++)
+        if (gDma[i].request == Request && gDma[i].enabled)
+            return &gDma[i];
+    return NULL;
+}
+
+static void (*DmaHandler(uint32_t Channel))(void)
+{
+    if (Channel == 1)
+        return DMA1_Channel1_IRQHandler;
+    if (Channel <= 3)
+        return DMA1_Channel2_3_IRQHandler;
+    return DMA1_Channel4_5_6_7_IRQHandler;
+}
+
+// Transfer complete on a channel: the flag, and the interrupt if enabled
+static void DmaComplete(DmaChannel_t *ch, bool Async)
+{
+    void (*handler)(void) = DmaHandler(ch - gDma);
+
+    ch->tc = true;
+
+    if (!ch->tcie || handler == NULL)
+        return;
+
+    if (Async)
+        SIM_RaiseIrq(handler);
+    else
+        handler();
+}
+
+static uint8_t *DmaPtr(const DmaChannel_t *ch, uint32_t Index)
+{
+    const uint32_t offset = (ch->config & LL_DMA_MEMORY_INCREMENT) ? Index : 0;
+    return (uint8_t *)(uintptr_t)(ch->memory + offset);
+}
+
+void SIM_DMA_Config(uint32_t Channel, uint32_t Config)              { gDma[Channel].config = Config; }
+bool SIM_DMA_IsEnabled(uint32_t Channel)                            { return gDma[Channel].enabled; }
+void SIM_DMA_SetMemoryAddress(uint32_t Channel, uint32_t Address)   { gDma[Channel].memory = Address; }
+void SIM_DMA_SetPeriphAddress(uint32_t Channel, uint32_t Address)   { gDma[Channel].periph = Address; }
+uint32_t SIM_DMA_GetDataLength(uint32_t Channel)                    { return gDma[Channel].length; }
+void SIM_DMA_SetRemap(uint32_t Channel, uint32_t Request)           { gDma[Channel].request = Request; }
+void SIM_DMA_EnableIT_TC(uint32_t Channel, bool Enable)             { gDma[Channel].tcie = Enable; }
+bool SIM_DMA_IsEnabledIT_TC(uint32_t Channel)                       { return gDma[Channel].tcie; }
+void SIM_DMA_ClearFlags(uint32_t Channel)                           { gDma[Channel].tc = false; }
+
+// Polling the flag is a load, a test and a branch: time moves on, so that a
+// loop waiting for a background transfer ends
+bool SIM_DMA_IsActiveFlag_TC(uint32_t Channel)
+{
+    SIM_AdvanceCycles(DMA_POLL_CYCLES);
+    return gDma[Channel].tc;
+}
+
+void SIM_DMA_SetDataLength(uint32_t Channel, uint32_t Length)
+{
+    gDma[Channel].length = Length;
+    gDma[Channel].reload = Length;
+}
+
+static void SpiDmaService(SPI_TypeDef *SPIx);
+
+void SIM_DMA_Enable(uint32_t Channel, bool Enable)
+{
+    gDma[Channel].enabled = Enable;
+    if (Enable)
+        SpiDmaService(SPI2);
+}
+
+// ---------------------------------------------------------------------------
+// SPI
+
+typedef struct
+{
+    uint32_t prescaler;
+    bool     enabled;
+    bool     txDma;
+    bool     rxDma;
+    bool     rxne;
+    uint8_t  rx;
+} Spi_t;
+
+static Spi_t gSpi[2];
+
+static Spi_t *SpiState(SPI_TypeDef *SPIx)
+{
+    return &gSpi[SPIx == SPI2];
+}
+
+// The byte on the wire: to the display on SPI1, to and from the flash on SPI2
+static uint8_t SpiShift(SPI_TypeDef *SPIx, uint8_t Data)
+{
+    if (SPIx == SPI1)
+    {
+        SIM_ST7565_Byte(SIM_GpioOutput(SIM_PORT_A, 6), Data);
+        return 0xFF;
+    }
+
+    return SIM_PY25Q16_Exchange(Data);
+}
+
+static uint64_t SpiByteCycles(SPI_TypeDef *SPIx)
+{
+    // 8 SCK periods at PCLK / 2^(prescaler + 1)
+    return 8u << (SpiState(SPIx)->prescaler + 1);
+}
+
+static uint8_t SpiExchange(SPI_TypeDef *SPIx, uint8_t Data)
+{
+    SIM_AdvanceCycles(SpiByteCycles(SPIx));
+    return SpiShift(SPIx, Data);
+}
+
+void SIM_SPI_Init(SPI_TypeDef *SPIx, uint32_t BaudRate)
+{
+    SpiState(SPIx)->prescaler = BaudRate;
+}
+
+void SIM_SPI_Enable(SPI_TypeDef *SPIx, bool Enable)
+{
+    SpiState(SPIx)->enabled = Enable;
+    if (Enable)
+        SpiDmaService(SPIx);
+}
+
+bool SIM_SPI_IsEnabled(SPI_TypeDef *SPIx)
+{
+    return SpiState(SPIx)->enabled;
+}
+
+void SIM_SPI_Transmit(SPI_TypeDef *SPIx, uint8_t Data)
+{
+    Spi_t *spi = SpiState(SPIx);
+
+    spi->rx   = SpiExchange(SPIx, Data);
+    spi->rxne = true;
+}
+
+uint8_t SIM_SPI_Receive(SPI_TypeDef *SPIx)
+{
+    Spi_t *spi = SpiState(SPIx);
+
+    spi->rxne = false;
+    return spi->rx;
+}
+
+bool SIM_SPI_IsRxNotEmpty(SPI_TypeDef *SPIx)
+{
+    return SpiState(SPIx)->rxne;
+}
+
+void SIM_SPI_SetDMAReq(SPI_TypeDef *SPIx, bool Tx, bool Enable)
+{
+    Spi_t *spi = SpiState(SPIx);
+
+    if (Tx)
+        spi->txDma = Enable;
+    else
+        spi->rxDma = Enable;
+
+    if (Enable)
+        SpiDmaService(SPIx);
+}
+
+// Full-duplex DMA transfer: the TX channel paces the bus, the RX channel
+// stores what comes back. The transfer runs in the background, one byte per
+// byte time as the clock advances (SIM_PeriphAdvance), so the firmware keeps
+// running meanwhile; memory, and the A0 line on SPI1, are read as each byte
+// goes out, and the TC interrupts fire after the last one.
+typedef struct
+{
+    DmaChannel_t *wr;
+    DmaChannel_t *rd;
+    uint32_t      index;
+    uint64_t      next;         // cycle at which the byte at index is out
+} SpiDmaJob_t;
+
+static SpiDmaJob_t gSpiDma[2];
+static bool        gSpiDmaBusy;
+
+static void SpiDmaService(SPI_TypeDef *SPIx)
+{
+    Spi_t       *spi = SpiState(SPIx);
+    SpiDmaJob_t *job = &gSpiDma[SPIx == SPI2];
+
+    if (!spi->enabled || !spi->txDma || job->wr)
+        return;
+
+    const uint32_t rdReq = (SPIx == SPI2) ? LL_SYSCFG_DMA_MAP_SPI2_RD : LL_SYSCFG_DMA_MAP_SPI1_RD;
+    const uint32_t wrReq = (SPIx == SPI2) ? LL_SYSCFG_DMA_MAP_SPI2_WR : LL_SYSCFG_DMA_MAP_SPI1_WR;
+
+    DmaChannel_t *wr = FindDmaChannel(wrReq);
+    DmaChannel_t *rd = spi->rxDma ? FindDmaChannel(rdReq) : NULL;
+
+    if (wr == NULL || wr->length == 0)
+        return;
+
+    job->wr    = wr;
+    job->rd    = rd;
+    job->index = 0;
+    job->next  = gSimCycles + SpiByteCycles(SPIx);
+}
+
+static void SpiDmaAdvanceJob(SPI_TypeDef *SPIx)
+{
+    SpiDmaJob_t *job = &gSpiDma[SPIx == SPI2];
+    const Spi_t *spi = SpiState(SPIx);
+
+    while (job->wr && gSimCycles >= job->next)
+    {
+        DmaChannel_t *wr = job->wr;
+        DmaChannel_t *rd = job->rd;
+
+        // Stopped by the firmware halfway: the rest is never sent
+        if (!spi->enabled || !spi->txDma || !wr->enabled || wr->length == 0)
+        {
+            job->wr = NULL;
+            break;
+        }
+
+        const uint8_t rx = SpiShift(SPIx, *DmaPtr(wr, job->index));
+
+        if (rd && rd->enabled && rd->length > 0)
+        {
+            *DmaPtr(rd, job->index) = rx;
+            rd->length--;
+        }
+
+        job->index++;
+        job->next += SpiByteCycles(SPIx);
+
+        if (--wr->length == 0)
+        {
+            job->wr = NULL;
+            DmaComplete(wr, true);
+            if (rd)
+                DmaComplete(rd, true);
+        }
+    }
+}
+
+static void SpiDmaAdvance(void)
+{
+    if (gSpiDmaBusy)
+        return;
+
+    gSpiDmaBusy = true;
+    SpiDmaAdvanceJob(SPI1);
+    SpiDmaAdvanceJob(SPI2);
+    gSpiDmaBusy = false;
+}
+
+// Power lost halfway through a flash transfer: the checks longjmp() out of
+// it and reboot the driver, which finds SPI2 and its DMA channels as reset
+void SIM_PeriphPowerCut(void)
+{
+    gSpiDma[1].wr = NULL;
+    gSpiDmaBusy   = false;
+
+    gSpi[1].txDma = false;
+    gSpi[1].rxDma = false;
+    gSpi[1].rxne  = false;
+
+    for (unsigned i = 1; i < 8; i++)
+    {
+        if (gDma[i].request == LL_SYSCFG_DMA_MAP_SPI2_RD || gDma[i].request == LL_SYSCFG_DMA_MAP_SPI2_WR)
+        {
+            gDma[i].enabled = false;
+            gDma[i].tcie    = false;
+            gDma[i].tc      = false;
+            gDma[i].length  = 0;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// USART1
+
+#define UART_CAPTURE_SIZE 0x10000u
+
+static uint32_t gUartBaud = 38400;
+static bool     gUartEnabled;
+static bool     gUartRxDma;
+static bool     gUartTxeie;
+static uint64_t gUartLineFree;      // cycle at which the shift register empties
+static uint8_t  gUartCapture[UART_CAPTURE_SIZE];
+static size_t   gUartCaptureHead;
+static size_t   gUartCaptureTail;
+static FILE    *gUartEcho;
+
+// Bytes fed on RX at the line rate, and the cycle the next one lands
+#define UART_RX_QUEUE_SIZE 0x10000u
+
+static uint8_t  gUartRxQueue[UART_RX_QUEUE_SIZE];
+static size_t   gUartRxHead;
+static size_t   gUartRxTail;
+static uint64_t gUartRxNext;
+
+// Polling TXE in UART_Send() is a load, a test and a branch
+#define UART_POLL_CYCLES 6u
+
+static uint64_t UartByteCycles(void)
+{
+    return (uint64_t)SIM_CPU_HZ * 10u / gUartBaud;
+}
+
+// TXE: the data register is free once the byte before has moved on into the
+// shift register
+static bool UartTxe(void)
+{
+    return gUartLineFree <= gSimCycles + UartByteCycles();
+}
+
+static void UartRxByte(uint8_t Data);
+
+static void UartAdvance(void)
+{
+    while (gUartRxTail < gUartRxHead && gUartRxNext <= gSimCycles)
+    {
+        UartRxByte(gUartRxQueue[gUartRxTail++ % UART_RX_QUEUE_SIZE]);
+        gUartRxNext += UartByteCycles();
+    }
+
+    if (gUartTxeie && UartTxe() && USART1_IRQHandler)
+        SIM_RaiseIrq(USART1_IRQHandler);
+}
+
+void SIM_USART_EnableIT_TXE(USART_TypeDef *USARTx, bool Enable)
+{
+    (void)USARTx;
+    gUartTxeie = Enable;
+    UartAdvance();
+}
+
+bool SIM_USART_IsEnabledIT_TXE(USART_TypeDef *USARTx)
+{
+    (void)USARTx;
+    return gUartTxeie;
+}
+
+void SIM_USART_Init(USART_TypeDef *USARTx, uint32_t BaudRate)
+{
+    (void)USARTx;
+    gUartBaud = BaudRate ? BaudRate : 38400;
+}
+
+void SIM_USART_Enable(USART_TypeDef *USARTx, bool Enable)
+{
+    (void)USARTx;
+    gUartEnabled = Enable;
+}
+
+void SIM_USART_SetDMAReqRx(USART_TypeDef *USARTx, bool Enable)
+{
+    (void)USARTx;
+    gUartRxDma = Enable;
+}
+
+void SIM_USART_Transmit(USART_TypeDef *USARTx, uint8_t Data)
+{
+    (void)USARTx;
+
+    const uint64_t start = (gUartLineFree > gSimCycles) ? gUartLineFree : gSimCycles;
+    gUartLineFree = start + UartByteCycles();
+
+    if (!gUartEnabled)
+        return;
+
+    gSimStats.uartTxBytes++;
+
+    gUartCapture[gUartCaptureHead++ % UART_CAPTURE_SIZE] = Data;
+    if (gUartCaptureHead - gUartCaptureTail > UART_CAPTURE_SIZE)
+        gUartCaptureTail = gUartCaptureHead - UART_CAPTURE_SIZE;
+
+    if (gUartEcho)
+        fputc(Data, gUartEcho);
+}
+
+// TXE is set as soon as the data register moved into the shift register,
+// i.e. one byte time before the line goes idle.
+bool SIM_USART_IsTxEmpty(USART_TypeDef *USARTx)
+{
+    (void)USARTx;
+    SIM_AdvanceCycles(UART_POLL_CYCLES);
+    return UartTxe();
+}
+
+bool SIM_USART_IsTxComplete(USART_TypeDef *USARTx)
+{
+    (void)USARTx;
+    SIM_AdvanceCycles(UART_POLL_CYCLES);
+    return gUartLineFree <= gSimCycles;
+}
+
+static void UartRxByte(uint8_t Data)
+{
+    DmaChannel_t *ch = FindDmaChannel(LL_SYSCFG_DMA_MAP_USART1_RD);
+
+    if (!gUartEnabled || !gUartRxDma || ch == NULL || ch->reload == 0)
+        return;
+
+    *DmaPtr(ch, ch->reload - ch->length) = Data;
+    if (--ch->length == 0)
+        ch->length = (ch->config & LL_DMA_MODE_CIRCULAR) ? ch->reload : 0;
+    gSimStats.uartRxBytes++;
+}
+
+void SIM_UartInject(const void *pData, size_t Size)
+{
+    const uint8_t *p = pData;
+
+    for (size_t i = 0; i < Size; i++)
+        UartRxByte(p[i]);
+}
+
+void SIM_UartFeed(const void *pData, size_t Size)
+{
+    const uint8_t *p = pData;
+
+    if (gUartRxTail == gUartRxHead)
+        gUartRxNext = ((gUartRxNext > gSimCycles) ? gUartRxNext : gSimCycles) + UartByteCycles();
+
+    for (size_t i = 0; i < Size && gUartRxHead - gUartRxTail < UART_RX_QUEUE_SIZE; i++)
+        gUartRxQueue[gUartRxHead++ % UART_RX_QUEUE_SIZE] = p[i];
+}
+
+size_t SIM_UartFeedPending(void)
+{
+    return gUartRxHead - gUartRxTail;
+}
+
+size_t SIM_UartTake(void *pData, size_t Size)
+{
+    uint8_t *p = pData;
+    size_t   n = 0;
+
+    while (n < Size && gUartCaptureTail < gUartCaptureHead)
+        p[n++] = gUartCapture[gUartCaptureTail++ % UART_CAPTURE_SIZE];
+
+    return n;
+}
+
+void SIM_UartSetEcho(FILE *f)
+{
+    gUartEcho = f;
+}
+
+// ---------------------------------------------------------------------------
+// ADC, TIM
+
+uint16_t SIM_ADC_Read(void)
+{
+    SIM_AdvanceUs(5);
+    return gBatteryAdc;
+}
+
+void SIM_SetBatteryAdc(uint16_t Value)
+{
+    gBatteryAdc = Value;
+}
+
+static uint32_t gTimEnabled;
+
+void SIM_TIM_SetCounter(TIM_TypeDef *TIMx, bool Enable)
+{
+    const uint32_t bit = (TIMx == TIM7) ? 2u : 1u;
+    gTimEnabled = Enable ? (gTimEnabled | bit) : (gTimEnabled & ~bit);
+}
+
+uint32_t SIM_TIM_IsEnabledCounter(TIM_TypeDef *TIMx)
+{
+    return !!(gTimEnabled & ((TIMx == TIM7) ? 2u : 1u));
+}
+
+// ---------------------------------------------------------------------------
+
+void SIM_PeriphAdvance(void)
+{
+    SpiDmaAdvance();
+    UartAdvance();
+}
+
+uint64_t SIM_PeriphNextEvent(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned i = 0; i < 2; i++)
+        if (gSpiDma[i].wr && gSpiDma[i].next < next)
+            next = gSpiDma[i].next;
+
+    if (gUartTxeie && !UartTxe() && gUartLineFree - UartByteCycles() < next)
+        next = gUartLineFree - UartByteCycles();
+
+    if (gUartRxTail < gUartRxHead && gUartRxNext < next)
+        next = gUartRxNext;
+
+    return next;
+}
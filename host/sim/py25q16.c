@@ -0,0 +1,299 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// PY25Q16 SPI NOR flash, 2 MB, backed by an image file. Program clears
+// bits (AND) and wraps inside its 256-byte page, erase sets a 4 KB sector
+// to 0xFF; both need WEL and keep WIP set for the typical datasheet time.
+// Reads (0x03, and 0x0B with its dummy byte) are timed from chip select low
+// to high and counted by size in the stats.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim/sim.h"
+
+#define PAGE_PROGRAM_US   700u
+#define SECTOR_ERASE_US   45000u
+
+#define STATUS_WIP        0x01u
+#define STATUS_WEL        0x02u
+
+typedef enum
+{
+    FLASH_IDLE = 0,
+    FLASH_COMMAND,
+    FLASH_ADDRESS,
+    FLASH_DUMMY,
+    FLASH_READ,
+    FLASH_PROGRAM,
+    FLASH_STATUS,
+    FLASH_ID,
+    FLASH_IGNORE,
+} FlashState_t;
+
+static uint8_t      gImage[SIM_FLASH_SIZE];
+static const char  *gPath;
+
+static bool         gSelected;
+static FlashState_t gState;
+static uint8_t      gCommand;
+static unsigned     gCount;
+static uint32_t     gAddress;
+static uint8_t      gStatus;
+static uint64_t     gBusyUntil;
+static bool         gProgrammed;    // page program received data
+static uint64_t     gSelectCycle;   // chip select went low
+static uint64_t     gSelectBytes;   // flashReadBytes then
+static uint32_t     gWatchBegin;
+static uint32_t     gWatchEnd;
+static uint64_t     gCutOps;
+static void       (*gCutHook)(void);
+
+static bool Watched(uint32_t Address)
+{
+    return Address >= gWatchBegin && Address < gWatchEnd;
+}
+
+static bool Busy(void)
+{
+    return gBusyUntil > gSimCycles;
+}
+
+static void StartBusy(uint64_t Us)
+{
+    const uint64_t cycles = Us * SIM_CYCLES_PER_US;
+
+    gBusyUntil = gSimCycles + cycles;
+    gSimStats.flashBusyCycles += cycles;
+    gStatus &= ~STATUS_WEL;
+}
+
+uint64_t SIM_PY25Q16_PowerCut(uint64_t Ops, void (*pHook)(void))
+{
+    const uint64_t left = gCutHook ? gCutOps : 0;
+
+    gCutOps  = Ops;
+    gCutHook = Ops ? pHook : NULL;
+    return left;
+}
+
+static bool CutNow(void)
+{
+    return gCutHook && --gCutOps == 0;
+}
+
+static void PowerCut(void)
+{
+    void (*hook)(void) = gCutHook;
+
+    gCutHook    = NULL;
+    gSelected   = false;
+    gState      = FLASH_IDLE;
+    gStatus     = 0;
+    gBusyUntil  = 0;
+    gProgrammed = false;
+
+    SIM_PeriphPowerCut();
+    hook();
+}
+
+bool SIM_PY25Q16_Load(const char *pPath)
+{
+    memset(gImage, 0xFF, sizeof(gImage));
+    gPath = pPath;
+
+    if (pPath == NULL)
+        return true;
+
+    FILE *f = fopen(pPath, "rb");
+    if (f == NULL)
+        return true;    // new image
+
+    const size_t n = fread(gImage, 1, sizeof(gImage), f);
+    fclose(f);
+    return n <= sizeof(gImage);
+}
+
+bool SIM_PY25Q16_Save(void)
+{
+    if (gPath == NULL)
+        return true;
+
+    FILE *f = fopen(gPath, "wb");
+    if (f == NULL)
+        return false;
+
+    const size_t n = fwrite(gImage, 1, sizeof(gImage), f);
+    return (fclose(f) == 0) && n == sizeof(gImage);
+}
+
+uint8_t *SIM_PY25Q16_Image(void)
+{
+    return gImage;
+}
+
+void SIM_PY25Q16_Watch(uint32_t Begin, uint32_t End)
+{
+    gWatchBegin = Begin;
+    gWatchEnd   = End;
+}
+
+void SIM_PY25Q16_Select(bool Selected)
+{
+    if (Selected == gSelected)
+        return;
+
+    gSelected = Selected;
+
+    if (Selected)
+    {
+        gState       = FLASH_COMMAND;
+        gSelectCycle = gSimCycles;
+        gSelectBytes = gSimStats.flashReadBytes;
+        gSimStats.flashTransactions++;
+        return;
+    }
+
+    // Read latency by size: command, address and data, as seen on the bus
+    if ((gCommand == 0x03 || gCommand == 0x0B) && gState == FLASH_READ)
+    {
+        const uint64_t bytes = gSimStats.flashReadBytes - gSelectBytes;
+        unsigned       i     = 0;
+
+        while (i < SIM_FLASH_READ_SIZES - 1 && (2u << i) <= bytes)
+            i++;
+
+        gSimStats.flashReadsBySize[i]++;
+        gSimStats.flashReadCyclesBySize[i] += gSimCycles - gSelectCycle;
+    }
+
+    // Commands execute on CS rising
+    if (gState == FLASH_PROGRAM && gProgrammed)
+    {
+        gSimStats.flashPagePrograms++;
+        StartBusy(PAGE_PROGRAM_US);
+    }
+    else if (gCommand == 0x20 && gState == FLASH_IGNORE && gCount == 3)
+    {
+        if (gStatus & STATUS_WEL)
+        {
+            uint8_t *sector = &gImage[gAddress & (SIM_FLASH_SIZE - SIM_FLASH_SECTOR)];
+
+            if (CutNow())
+            {
+                for (unsigned i = 0; i < SIM_FLASH_SECTOR; i++)
+                    if (rand() & 1)
+                        sector[i] = 0xFF;
+                PowerCut();
+            }
+
+            memset(sector, 0xFF, SIM_FLASH_SECTOR);
+            gSimStats.flashSectorErases++;
+            if (gSimVerbose)
+                fprintf(stderr, "[sim] %8.3f ms: flash erase %06x\n", SIM_TimeUs() / 1000.0, gAddress & ~(SIM_FLASH_SECTOR - 1));
+            StartBusy(SECTOR_ERASE_US);
+        }
+    }
+
+    gState = FLASH_IDLE;
+}
+
+uint8_t SIM_PY25Q16_Exchange(uint8_t Data)
+{
+    uint8_t out = 0xFF;
+
+    if (!gSelected)
+        return out;
+
+    switch (gState)
+    {
+        case FLASH_COMMAND:
+            gCommand    = Data;
+            gCount      = 0;
+            gAddress    = 0;
+            gProgrammed = false;
+            gState      = FLASH_IGNORE;
+
+            if (Data == 0x05 || Data == 0x35 || Data == 0x15)
+            {
+                gState = FLASH_STATUS;
+                gSimStats.flashStatusPolls++;
+            }
+            else if (Busy())
+                break;      // only status reads are accepted while WIP
+            else if (Data == 0x03 || Data == 0x0B || Data == 0x02 || Data == 0x20)
+                gState = FLASH_ADDRESS;
+            else if (Data == 0x06)
+                gStatus |= STATUS_WEL;
+            else if (Data == 0x04)
+                gStatus &= ~STATUS_WEL;
+            else if (Data == 0x9F)
+                gState = FLASH_ID;
+
+            if (Data == 0x03 || Data == 0x0B)
+                gSimStats.flashReadCmds++;
+            break;
+
+        case FLASH_ADDRESS:
+            gAddress = ((gAddress << 8) | Data) & (SIM_FLASH_SIZE - 1);
+            if (++gCount == 3)
+            {
+                if ((gCommand == 0x03 || gCommand == 0x0B) && Watched(gAddress))
+                    gSimStats.flashWatchReads++;
+
+                if (gCommand == 0x03)
+                    gState = FLASH_READ;
+                else if (gCommand == 0x0B)
+                    gState = FLASH_DUMMY;
+                else if (gCommand == 0x02)
+                    gState = (gStatus & STATUS_WEL) ? FLASH_PROGRAM : FLASH_IGNORE;
+                else
+                    gState = FLASH_IGNORE;
+            }
+            break;
+
+        case FLASH_DUMMY:
+            gState = FLASH_READ;
+            break;
+
+        case FLASH_READ:
+            out = gImage[gAddress];
+            if (Watched(gAddress))
+                gSimStats.flashWatchBytes++;
+            gAddress = (gAddress + 1) & (SIM_FLASH_SIZE - 1);
+            gSimStats.flashReadBytes++;
+            break;
+
+        case FLASH_PROGRAM:
+            if (CutNow())
+            {
+                gImage[gAddress] &= Data | (uint8_t)rand();
+                PowerCut();
+            }
+
+            gImage[gAddress] &= Data;
+            gAddress = (gAddress & ~(SIM_FLASH_PAGE - 1)) | ((gAddress + 1) & (SIM_FLASH_PAGE - 1));
+            gProgrammed = true;
+            gSimStats.flashProgramBytes++;
+            break;
+
+        case FLASH_STATUS:
+            out = (gCommand == 0x05) ? (uint8_t)(gStatus | (Busy() ? STATUS_WIP : 0)) : 0x00;
+            break;
+
+        case FLASH_ID:
+            {
+                static const uint8_t id[3] = { 0x85, 0x20, 0x15 };
+                out = id[gCount < 3 ? gCount : 2];
+                gCount++;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return out;
+}
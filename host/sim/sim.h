@@ -0,0 +1,236 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// Host simulation of the UV-K1 / UV-K5 V3 board.
+//
+// Time is counted in CPU cycles of the 48 MHz core. Anything that would take
+// time on the radio (bit-banged BK4819 bus, SPI bytes, UART bytes, flash
+// erase/program, SysTick polling) advances the clock, and the SysTick
+// handler of the firmware is called synchronously every 10 ms of simulated
+// time, exactly as the interrupt would preempt the main loop. DMA transfers
+// on SPI1 and SPI2 run in the background the same way, one byte per SPI byte
+// time, and raise their completion interrupt when done.
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_CPU_HZ          48000000u
+#define SIM_CYCLES_PER_US   (SIM_CPU_HZ / 1000000u)
+
+#define SIM_FLASH_SIZE      0x200000u
+#define SIM_FLASH_SECTOR    0x1000u
+#define SIM_FLASH_PAGE      0x100u
+
+// Read transactions by size: 1, 2-3, 4-7... bytes, 512 and more in the last
+#define SIM_FLASH_READ_SIZES 10
+
+typedef struct
+{
+    // BK4819 3-wire bus
+    uint64_t bkWrites;
+    uint64_t bkReads;
+    uint64_t bkBusCycles;
+    uint64_t bkTunes;               // REG_38 (frequency low word) writes
+    uint64_t fskTxFrames;
+    uint64_t fskTxCycles;           // on air, preamble and sync included
+
+    // ST7565 on SPI1
+    uint64_t lcdTransactions;
+    uint64_t lcdCmdBytes;
+    uint64_t lcdDataBytes;
+
+    // PY25Q16 on SPI2
+    uint64_t flashTransactions;
+    uint64_t flashReadCmds;
+    uint64_t flashReadBytes;
+    uint64_t flashPagePrograms;
+    uint64_t flashProgramBytes;
+    uint64_t flashSectorErases;
+    uint64_t flashStatusPolls;
+    uint64_t flashBusyCycles;
+    uint64_t flashWatchReads;       // read commands starting in the watched range
+    uint64_t flashWatchBytes;       // bytes read from the watched range
+    uint64_t flashReadsBySize[SIM_FLASH_READ_SIZES];
+    uint64_t flashReadCyclesBySize[SIM_FLASH_READ_SIZES];  // chip select low to high
+
+    // USART1
+    uint64_t uartTxBytes;
+    uint64_t uartRxBytes;
+
+    // Main loop
+    uint64_t loopIterations;
+    uint64_t loopMaxGapCycles;
+    uint64_t sysTicks;
+} SIM_Stats_t;
+
+extern SIM_Stats_t gSimStats;
+extern uint64_t    gSimCycles;
+extern bool        gSimVerbose;
+
+// Called after every SysTick period, whatever the firmware is doing (main
+// loop, blocking delay, spectrum loop...). Used to drive scripts.
+extern void      (*gSimTickHook)(void);
+
+// ---------------------------------------------------------------------------
+// Time base (core.c)
+
+void     SIM_AdvanceCycles(uint64_t Cycles);
+void     SIM_AdvanceUs(uint64_t Us);
+void     SIM_AdvanceToNextTick(void);
+// Cycle count of SysTick_Config(): the time slices count from there
+uint64_t SIM_SysTickOrigin(void);
+uint64_t SIM_TimeUs(void);
+bool     SIM_InIsr(void);
+
+// Interrupt raised by a peripheral: the handler runs as soon as interrupts
+// are unmasked and no other handler is running
+void     SIM_RaiseIrq(void (*Handler)(void));
+void     SIM_ResetStats(void);
+void     SIM_PrintStats(FILE *f, const char *pTitle);
+void     SIM_Exit(int Status) __attribute__((noreturn));
+
+// ---------------------------------------------------------------------------
+// Board (periph.c)
+
+typedef enum
+{
+    SIM_PORT_A = 0,
+    SIM_PORT_B,
+    SIM_PORT_C,
+    SIM_PORT_F,
+    SIM_PORT_COUNT
+} SIM_Port_t;
+
+void     SIM_KeypadPress(int Key);     // KEY_Code_t, KEY_INVALID releases
+int      SIM_KeypadPressed(void);
+void     SIM_SetPtt(bool Pressed);
+void     SIM_SetBatteryAdc(uint16_t Value);
+void     SIM_UartInject(const void *pData, size_t Size);
+// Bytes arriving on RX at the line rate, after those fed before
+void     SIM_UartFeed(const void *pData, size_t Size);
+size_t   SIM_UartFeedPending(void);
+size_t   SIM_UartTake(void *pData, size_t Size);
+void     SIM_UartSetEcho(FILE *f);
+bool     SIM_GpioOutput(SIM_Port_t Port, unsigned Pin);
+
+// Background transfers (SPI DMA, UART transmit and receive) up to the
+// current time, called whenever the clock advances, and the cycle of their
+// next event
+void     SIM_PeriphAdvance(void);
+uint64_t SIM_PeriphNextEvent(void);
+// The flash lost power (SIM_PY25Q16_PowerCut): drop the SPI2 transfer
+void     SIM_PeriphPowerCut(void);
+
+// ---------------------------------------------------------------------------
+// BK4819 (bk4819.c)
+
+void     SIM_BK4819_Reset(void);
+void     SIM_BK4819_PinsChanged(bool Csn, bool Scl, bool Sda);
+bool     SIM_BK4819_Sda(void);
+uint16_t SIM_BK4819_GetRegister(uint8_t Register);
+void     SIM_BK4819_SetInput(uint8_t Register, uint16_t Value);
+void     SIM_BK4819_ClearInput(uint8_t Register);
+void     SIM_BK4819_SetRssi(uint16_t Rssi);
+
+// Synthetic band: REG_67 reads the noise floor, a little noise, and the
+// carriers around the frequency tuned in REG_38/39, each keyed for OnMs of
+// every PeriodMs; REG_63 (glitch) reads 255 for SettleUs after a REG_30
+// write restarts the receiver. The frequency scan (REG_32 bit 0) reports in
+// REG_0D/0E the strongest carrier within 1 MHz of the tuned frequency, or
+// noise, once per REG_32 period. Count 0 goes back to the fixed RSSI.
+#define SIM_BK4819_CARRIERS 16
+
+typedef struct
+{
+    uint32_t freq;              // 10 Hz units
+    uint32_t width;             // either side of freq
+    uint16_t rssi;
+    uint16_t onMs;              // 0: always on
+    uint16_t periodMs;
+    uint16_t phaseMs;
+} SIM_BK4819_Carrier_t;
+
+void     SIM_BK4819_SetBand(const SIM_BK4819_Carrier_t *pCarriers, size_t Count, uint16_t Floor,
+                            uint32_t SettleUs);
+// What the band holds at Frequency now, without the noise
+uint16_t SIM_BK4819_BandRssiAt(uint32_t Frequency);
+
+// Optional write trace, used to compare register sequences
+typedef struct
+{
+    uint8_t  reg;
+    uint16_t value;
+    uint64_t cycles;
+} SIM_BK4819_Write_t;
+
+// Interrupt events: from DueCycles on, REG_0C bit 0 reads set until the
+// firmware clears REG_02, which then reads Flags. Raised in due order, and
+// serviced in that order.
+#define SIM_BK4819_EVENTS 4096
+
+typedef struct
+{
+    uint64_t dueCycles;
+    uint64_t servicedCycles;    // REG_02 cleared
+    uint16_t flags;
+    uint16_t read;              // REG_02 read after the clear
+} SIM_BK4819_Event_t;
+
+bool     SIM_BK4819_RaiseInterrupt(uint64_t DueCycles, uint16_t Flags);
+const SIM_BK4819_Event_t *SIM_BK4819_Events(size_t *pCount, size_t *pServiced);
+void     SIM_BK4819_ClearEvents(void);
+
+// FSK: REG_5F writes fill the TX FIFO, REG_59 bit 11 sends it as one frame
+// of the REG_5D length, which takes the preamble and sync of REG_59 plus
+// the data at 1200 baud (REG_72 0x3065, the only rate the firmware uses);
+// TX finished is raised at the end and the frame handed to gSimFskTxHook.
+// SIM_BK4819_FskReceive() is a frame whose sync word goes by now: heard if
+// FSK RX is on (REG_59 bit 12) and not sending, it fills the RX FIFO, read
+// through REG_5F, with FIFO almost full every 4 words and RX finished after
+// the REG_5D length, the frame cut short or padded with noise to it.
+// Almost-full events due by the time the firmware gets to one are read as
+// one, as the chip has a single flag for them; clearing the RX FIFO drops
+// the rest of the frame.
+#define SIM_BK4819_FSK_BYTE_CYCLES (SIM_CPU_HZ / 1200u * 8u)
+#define SIM_BK4819_FSK_WORDS       128
+
+extern void (*gSimFskTxHook)(const uint16_t *pWords, size_t Count, uint64_t EndCycles);
+
+bool     SIM_BK4819_FskReceive(const uint16_t *pWords, size_t Count);
+
+void     SIM_BK4819_TraceStart(SIM_BK4819_Write_t *pBuffer, size_t Capacity);
+size_t   SIM_BK4819_TraceStop(void);
+
+// ---------------------------------------------------------------------------
+// ST7565 (st7565.c)
+
+void     SIM_ST7565_Select(bool Selected);
+void     SIM_ST7565_Byte(bool A0, uint8_t Data);
+void     SIM_ST7565_GetImage(uint8_t Pages[8][128]);
+int      SIM_ST7565_SelectedPage(void);    // last page addressed, -1 if not selected
+bool     SIM_WritePbm(const char *pPath, const uint8_t Pages[8][128]);
+
+// ---------------------------------------------------------------------------
+// PY25Q16 (py25q16.c)
+
+bool     SIM_PY25Q16_Load(const char *pPath);
+bool     SIM_PY25Q16_Save(void);
+void     SIM_PY25Q16_Select(bool Selected);
+uint8_t  SIM_PY25Q16_Exchange(uint8_t Data);
+uint8_t *SIM_PY25Q16_Image(void);
+void     SIM_PY25Q16_Watch(uint32_t Begin, uint32_t End);
+
+// Power cut: after Ops more programmed bytes or sector erases, the one in
+// progress is torn (random bits programmed, random bytes erased), the chip
+// is reset and pHook is called. pHook must not return (longjmp). Ops = 0
+// disarms. Returns the operations left of the previous setting.
+uint64_t SIM_PY25Q16_PowerCut(uint64_t Ops, void (*pHook)(void));
+
+#endif
@@ -0,0 +1,100 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// ST7565 display RAM behind SPI1: A0 low selects commands, A0 high writes
+// display data at the current page/column, the column auto-incrementing.
+// Only the commands the firmware uses to address the RAM are decoded.
+
+#include <string.h>
+
+#include "sim/sim.h"
+
+#define RAM_PAGES    9
+#define RAM_COLUMNS  132
+
+// driver/st7565.c offsets every column by 4 for the glass of the K1/K5 V3
+#define COLUMN_OFFSET 4
+
+static uint8_t  gRam[RAM_PAGES][RAM_COLUMNS];
+static uint8_t  gPage;
+static uint8_t  gColumn;
+static bool     gSelected;
+static bool     gParameter;     // next command byte is an operand
+
+void SIM_ST7565_Select(bool Selected)
+{
+    if (Selected && !gSelected)
+        gSimStats.lcdTransactions++;
+
+    gSelected  = Selected;
+    gParameter = false;
+}
+
+void SIM_ST7565_Byte(bool A0, uint8_t Data)
+{
+    if (!gSelected)
+        return;
+
+    if (A0)
+    {
+        gSimStats.lcdDataBytes++;
+        if (gPage < RAM_PAGES && gColumn < RAM_COLUMNS)
+            gRam[gPage][gColumn] = Data;
+        gColumn++;
+        return;
+    }
+
+    gSimStats.lcdCmdBytes++;
+
+    if (gParameter)
+    {
+        gParameter = false;
+        return;
+    }
+
+    if ((Data & 0xF0) == 0xB0)
+        gPage = Data & 0x0F;
+    else if ((Data & 0xF0) == 0x10)
+        gColumn = (uint8_t)((gColumn & 0x0F) | ((Data & 0x0F) << 4));
+    else if ((Data & 0xF0) == 0x00)
+        gColumn = (uint8_t)((gColumn & 0xF0) | (Data & 0x0F));
+    else if (Data == 0x81)
+        gParameter = true;
+    else if (Data == 0xE2)
+        gParameter = false;
+}
+
+int SIM_ST7565_SelectedPage(void)
+{
+    return gSelected ? gPage : -1;
+}
+
+void SIM_ST7565_GetImage(uint8_t Pages[8][128])
+{
+    for (unsigned page = 0; page < 8; page++)
+        memcpy(Pages[page], &gRam[page][COLUMN_OFFSET], 128);
+}
+
+bool SIM_WritePbm(const char *pPath, const uint8_t Pages[8][128])
+{
+    FILE *f = fopen(pPath, "wb");
+    if (f == NULL)
+        return false;
+
+    fprintf(f, "P4\n128 64\n");
+
+    for (unsigned y = 0; y < 64; y++)
+    {
+        uint8_t row[16] = {0};
+
+        for (unsigned x = 0; x < 128; x++)
+            if (Pages[y / 8][x] & (1u << (y % 8)))
+                row[x / 8] |= 0x80u >> (x % 8);
+
+        fwrite(row, 1, sizeof(row), f);
+    }
+
+    return fclose(f) == 0;
+}
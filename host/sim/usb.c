@@ -0,0 +1,27 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// USB device that is never enumerated: the K5Viewer code always references
+// the VCP, the host build models the radio with no USB cable plugged in.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool VCP_K5ViewerPing(void)
+{
+    return false;
+}
+
+void cdc_acm_data_send_with_dtr(const uint8_t *buf, uint32_t size)
+{
+    (void)buf;
+    (void)size;
+}
+
+void cdc_acm_data_send_with_dtr_async(const uint8_t *buf, uint32_t size)
+{
+    (void)buf;
+    (void)size;
+}
@@ -0,0 +1,223 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+// Reference codec of the K5Viewer screen frames. A packed payload is a
+// signed chunk offset S and ops walking the chunks, in index order or from
+// the last one down when S < 0:
+//
+//   0x00 + n   skip n + 1 chunks
+//   0x40 + n   n + 1 packed chunks follow: mask byte, bit k set when byte k
+//              repeats byte k - 1 (byte -1 being 0x00), then the other bytes
+//   0x80 + n   n + 1 chunks take the chunk S further on, as it is on the
+//              screen at that point of the walk
+//   0xC0 + h   first op only: start from history[h]
+//
+// The screen is pushed to the history after every packed frame.
+
+#include <string.h>
+
+#include "viewer.h"
+
+#define OP_SKIP     0x00
+#define OP_LITERAL  0x40
+#define OP_SHIFT    0x80
+#define OP_RECALL   0xC0
+#define RUN_MAX     64
+
+// Largest shift tried by the encoder, in pixel rows
+#define SHIFT_ROWS  16
+
+static unsigned Walk(int Shift, unsigned i)
+{
+    return (Shift < 0) ? VIEWER_CHUNKS - 1 - i : i;
+}
+
+static void PushHistory(VIEWER_Screen_t *pScreen)
+{
+    memmove(pScreen->history[1], pScreen->history[0],
+            sizeof(pScreen->history) - sizeof(pScreen->history[0]));
+    memcpy(pScreen->history[0], pScreen->chunks, sizeof(pScreen->chunks));
+}
+
+static bool ApplyPacked(VIEWER_Screen_t *pScreen, const uint8_t *pPayload, unsigned Length)
+{
+    unsigned pos = 0;
+    unsigned i   = 0;
+
+    if (Length < 1)
+        return false;
+
+    const int shift = (int8_t)pPayload[pos++];
+
+    if (pos < Length && (pPayload[pos] & 0xC0) == OP_RECALL)
+    {
+        const unsigned h = pPayload[pos++] & 0x3F;
+
+        if (h >= VIEWER_HISTORY)
+            return false;
+        memcpy(pScreen->chunks, pScreen->history[h], sizeof(pScreen->chunks));
+    }
+
+    while (pos < Length)
+    {
+        const uint8_t  op  = pPayload[pos] & 0xC0;
+        const unsigned run = (pPayload[pos++] & 0x3F) + 1;
+
+        if (op == OP_RECALL || i + run > VIEWER_CHUNKS)
+            return false;
+
+        for (unsigned n = 0; n < run; n++, i++)
+        {
+            uint8_t *pChunk = pScreen->chunks[Walk(shift, i)];
+
+            if (op == OP_SHIFT)
+            {
+                const int source = (int)Walk(shift, i) + shift;
+
+                if (shift == 0 || source < 0 || source >= VIEWER_CHUNKS)
+                    return false;
+                memcpy(pChunk, pScreen->chunks[source], 8);
+            }
+            else if (op == OP_LITERAL)
+            {
+                if (pos >= Length)
+                    return false;
+
+                const uint8_t mask = pPayload[pos++];
+                uint8_t       prev = 0;
+
+                for (unsigned k = 0; k < 8; k++)
+                {
+                    if (!(mask & (1u << k)))
+                    {
+                        if (pos >= Length)
+                            return false;
+                        prev = pPayload[pos++];
+                    }
+                    pChunk[k] = prev;
+                }
+            }
+        }
+    }
+
+    PushHistory(pScreen);
+    return true;
+}
+
+bool VIEWER_Apply(VIEWER_Screen_t *pScreen, uint8_t Type, const uint8_t *pPayload, unsigned Length)
+{
+    if (Type == VIEWER_TYPE_PACKED)
+        return ApplyPacked(pScreen, pPayload, Length);
+
+    if (Type != VIEWER_TYPE_DIFF || Length % 9 != 0)
+        return false;
+
+    for (unsigned pos = 0; pos < Length; pos += 9)
+    {
+        if (pPayload[pos] >= VIEWER_CHUNKS)
+            return false;
+        memcpy(pScreen->chunks[pPayload[pos]], &pPayload[pos + 1], 8);
+    }
+    return true;
+}
+
+static unsigned PackChunk(const uint8_t *pChunk, uint8_t *pDest)
+{
+    unsigned len  = 1;
+    uint8_t  mask = 0;
+    uint8_t  prev = 0;
+
+    for (unsigned k = 0; k < 8; k++)
+    {
+        if (pChunk[k] == prev)
+            mask |= 1u << k;
+        else
+            pDest[len++] = pChunk[k];
+        prev = pChunk[k];
+    }
+    pDest[0] = mask;
+    return len;
+}
+
+// Payload with one given shift, following the screen through the walk
+static unsigned PackShift(const VIEWER_Screen_t *pScreen, const uint8_t Chunks[VIEWER_CHUNKS][8],
+                          int Shift, uint8_t *pPayload)
+{
+    uint8_t  live[VIEWER_CHUNKS][8];
+    uint8_t  ops[VIEWER_CHUNKS];
+    unsigned len = 0;
+
+    memcpy(live, pScreen->chunks, sizeof(live));
+
+    for (unsigned i = 0; i < VIEWER_CHUNKS; i++)
+    {
+        const unsigned c      = Walk(Shift, i);
+        const int      source = (int)c + Shift;
+
+        if (memcmp(live[c], Chunks[c], 8) == 0)
+            ops[i] = OP_SKIP;
+        else if (Shift != 0 && source >= 0 && source < VIEWER_CHUNKS &&
+                 memcmp(live[source], Chunks[c], 8) == 0)
+            ops[i] = OP_SHIFT;
+        else
+            ops[i] = OP_LITERAL;
+        memcpy(live[c], Chunks[c], 8);
+    }
+
+    unsigned last = VIEWER_CHUNKS;
+
+    while (last > 0 && ops[last - 1] == OP_SKIP)
+        last--;
+
+    pPayload[len++] = (uint8_t)(int8_t)Shift;
+
+    for (unsigned i = 0; i < last; )
+    {
+        unsigned run = 1;
+
+        while (i + run < last && run < RUN_MAX && ops[i + run] == ops[i])
+            run++;
+
+        pPayload[len++] = (uint8_t)(ops[i] | (run - 1));
+        for (unsigned n = 0; n < run; n++, i++)
+            if (ops[i] == OP_LITERAL)
+                len += PackChunk(Chunks[Walk(Shift, i)], &pPayload[len]);
+    }
+
+    return len;
+}
+
+unsigned VIEWER_Pack(const VIEWER_Screen_t *pScreen, const uint8_t Chunks[VIEWER_CHUNKS][8],
+                     uint8_t *pPayload)
+{
+    uint8_t  payload[VIEWER_PAYLOAD_MAX];
+    unsigned best = PackShift(pScreen, Chunks, 0, pPayload);
+
+    for (int rows = -SHIFT_ROWS; rows <= SHIFT_ROWS; rows++)
+    {
+        if (rows == 0)
+            continue;
+
+        const unsigned len = PackShift(pScreen, Chunks, 2 * rows, payload);
+
+        if (len < best)
+        {
+            memcpy(pPayload, payload, len);
+            best = len;
+        }
+    }
+
+    for (unsigned h = 1; h < VIEWER_HISTORY && best > 2; h++)
+    {
+        if (memcmp(pScreen->history[h], Chunks, sizeof(pScreen->history[h])) == 0)
+        {
+            pPayload[0] = 0;
+            pPayload[1] = (uint8_t)(OP_RECALL | h);
+            best = 2;
+        }
+    }
+
+    return best;
+}
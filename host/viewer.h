@@ -0,0 +1,38 @@
+/* Copyright 2026
+ *
+ * Licensed under the Apache License, Version 2.0.
+ */
+
+#ifndef HOST_VIEWER_H
+#define HOST_VIEWER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Reference codec of the K5Viewer screen frames, the way a viewer keeps the
+// screen: the diff frames (type 0x02) and the packed frames (type 0x07, see
+// App/k5viewer.c). The encoder works on full copies of the screens instead
+// of fingerprints and tries every shift, it gives the size the firmware
+// could reach.
+
+#define VIEWER_CHUNKS       128
+#define VIEWER_HISTORY      8
+#define VIEWER_TYPE_DIFF    0x02
+#define VIEWER_TYPE_PACKED  0x07
+#define VIEWER_PAYLOAD_MAX  2048
+
+typedef struct
+{
+    uint8_t chunks[VIEWER_CHUNKS][8];
+    // Screens left by the last packed frames, newest first
+    uint8_t history[VIEWER_HISTORY][VIEWER_CHUNKS][8];
+} VIEWER_Screen_t;
+
+// Apply the payload of a frame, false if it is malformed
+bool     VIEWER_Apply(VIEWER_Screen_t *pScreen, uint8_t Type, const uint8_t *pPayload, unsigned Length);
+
+// Payload of the smallest packed frame taking pScreen to Chunks
+unsigned VIEWER_Pack(const VIEWER_Screen_t *pScreen, const uint8_t Chunks[VIEWER_CHUNKS][8],
+                     uint8_t *pPayload);
+
+#endif
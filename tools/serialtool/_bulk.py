@@ -0,0 +1,134 @@
+# Copyright (c) 2026
+#
+# Licensed under the MIT License (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at the root of this repository.
+#
+#     Unless required by applicable law or agreed to in writing, software
+#     distributed under the License is distributed on an "AS IS" BASIS,
+#     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#     See the License for the specific language governing permissions and
+#     limitations under the License.
+#
+
+"""
+Bulk transfers: blocks of up to 128 bytes read (0x0541) or written (0x0543)
+with several requests in flight. Each reply names its block, read replies
+carry a CRC of the data. Firmware without them does not answer, see probe().
+"""
+
+from time import monotonic
+import msg as mm
+
+MSG_BULK_READ = 0x0541
+MSG_BULK_READ_RESP = 0x0542
+MSG_BULK_WRITE = 0x0543
+MSG_BULK_WRITE_RESP = 0x0544
+
+STATUS_OK = 0
+STATUS_LOCKED = 1
+STATUS_BAD_SIZE = 2
+
+READ_BLOCK = 128
+# Replies that fit the radio's 512-byte UART transmit ring
+READ_WINDOW = 3
+
+WRITE_BLOCK = 96
+# Frames that fit the radio's 256-byte UART receive buffer
+WRITE_WINDOW = 2
+
+# A reply later than this is taken as lost and its block sent again
+TIMEOUT = 0.5
+RETRIES = 5
+
+# Answer to probe(), if any
+PROBE_TIMEOUT = 0.3
+
+
+def make_read(offset: int, size: int, timestamp: int) -> mm.Msg:
+    msg = mm.Msg.make(MSG_BULK_READ, 8)
+    msg.set_hw_LE(4, offset)
+    msg.set_hw_LE(6, size)
+    msg.set_word_LE(8, timestamp)
+    return msg
+
+
+def make_write(offset: int, data: bytes, timestamp: int) -> mm.Msg:
+    msg = mm.Msg.make(MSG_BULK_WRITE, 12 + len(data))
+    msg.set_hw_LE(4, offset)
+    msg.set_hw_LE(6, len(data))
+    msg.buf[8] = 1  # allow password
+    msg.set_word_LE(12, timestamp)
+    msg.buf[16:] = data
+    return msg
+
+
+def probe(timestamp: int) -> mm.Msg:
+    """A read of nothing: firmware with bulk transfers answers it"""
+    return make_read(0, 0, timestamp)
+
+
+def parse_read(msg: mm.Msg) -> tuple[int, int, bytes | None]:
+    """(offset, status, data), data None if its CRC is wrong"""
+    offset = msg.get_hw_LE(4)
+    size = msg.get_hw_LE(6)
+    crc = msg.get_hw_LE(8)
+    status = msg.buf[10]
+    data = bytes(msg.buf[12 : 12 + size])
+    if len(data) != size or mm.calc_CRC(data, 0, size) != crc:
+        data = None
+    return offset, status, data
+
+
+def parse_write(msg: mm.Msg) -> tuple[int, int]:
+    """(offset, status)"""
+    return msg.get_hw_LE(4), msg.buf[8]
+
+
+def split(offset: int, size: int, block: int) -> list[tuple[int, int]]:
+    return [(off, min(block, offset + size - off)) for off in range(offset, offset + size, block)]
+
+
+class Window:
+    """Blocks in flight, up to the window size"""
+
+    def __init__(self, count: int, size: int):
+        self.count = count
+        self.size = size
+        self.next = 0
+        self.done = 0
+        self.in_flight = {}  # block index -> time sent
+        self.tries = {}
+
+    def to_send(self) -> list[int]:
+        """Late blocks again, then new ones while there is room"""
+
+        now = monotonic()
+        out = []
+
+        for i, sent in self.in_flight.items():
+            if now - sent > TIMEOUT:
+                self.tries[i] = self.tries.get(i, 0) + 1
+                if self.tries[i] > RETRIES:
+                    raise TimeoutError(f"no reply for block {i}")
+                out.append(i)
+
+        for i in out:
+            self.in_flight[i] = now
+
+        while self.next < self.count and len(self.in_flight) < self.size:
+            self.in_flight[self.next] = now
+            out.append(self.next)
+            self.next += 1
+
+        return out
+
+    def ack(self, i: int) -> bool:
+        """False for a reply to a block that was answered already"""
+        if self.in_flight.pop(i, None) is None:
+            return False
+        self.done += 1
+        return True
+
+    def finished(self) -> bool:
+        return self.done == self.count
@@ -15,7 +15,9 @@
 
 from serial import Serial
 from datetime import datetime
+from time import monotonic
 import msg as mm
+import _bulk as bb
 
 DUMP_CONFIG = 1
 DUMP_CALIB = 2
@@ -24,10 +26,11 @@ DUMP_ALL = 0xFF
 
 class EepromDump:
 
-    def __init__(self, ser: Serial, dump_what: int, dump_file: str):
+    def __init__(self, ser: Serial, dump_what: int, dump_file: str, bulk: bool = True):
         self._ser = ser
         self._dump_what = dump_what
         self._dump_file = dump_file
+        self._bulk = bulk
         self._state = _Init(self)
         # self._dev_info = None
 
@@ -153,7 +156,9 @@ class _DeviceInfo(_State):
         )
 
         # return _AccessRequest(self.dump, dev_info, self.timestamp)
-        return _DumpEeprom(self.dump, self.timestamp)
+        if not self.dump._bulk:
+            return _DumpEeprom(self.dump, self.timestamp)
+        return _Probe(self.dump, self.timestamp)
 
     def send_request(self):
 
@@ -209,22 +214,102 @@ class _AccessRequest(_State):
         self.send_msg(msg)
 
 
+class _Probe(_State):
+
+    def __init__(self, dump, timestamp: int):
+        super().__init__(dump)
+        self.timestamp = timestamp
+        self.sent_at = None
+
+    def loop(self) -> _State:
+
+        if self.sent_at is None:
+            self.send_msg(bb.probe(self.timestamp))
+            self.sent_at = monotonic()
+            return
+
+        msg = self.recv_msg()
+        if msg and bb.MSG_BULK_READ_RESP == msg.get_msg_type():
+            print("Bulk transfers supported")
+            return _BulkDump(self.dump, self.timestamp)
+
+        if monotonic() - self.sent_at > bb.PROBE_TIMEOUT:
+            return _DumpEeprom(self.dump, self.timestamp)
+
+
+def _dump_range(what: int) -> tuple[int, int]:
+    if DUMP_CONFIG == what:
+        return 0, 0x1E00
+    elif DUMP_CALIB == what:
+        return 0x1E00, 0x2000 - 0x1E00
+    else:
+        return 0, 0x2000
+
+
+class _BulkDump(_State):
+
+    def __init__(self, dump: EepromDump, timestamp: int):
+        super().__init__(dump)
+        self.timestamp = timestamp
+
+        off, size = _dump_range(dump._dump_what)
+        self.blocks = bb.split(off, size, bb.READ_BLOCK)
+        self.index = {b[0]: i for i, b in enumerate(self.blocks)}
+        self.window = bb.Window(len(self.blocks), bb.READ_WINDOW)
+        self.data = bytearray(size)
+        self.offset = off
+
+    def loop(self) -> bool | _State:
+
+        try:
+            for i in self.window.to_send():
+                off, size = self.blocks[i]
+                self.send_msg(bb.make_read(off, size, self.timestamp))
+        except TimeoutError as e:
+            print("Device not responding: " + str(e))
+            return False
+
+        msg = self.recv_msg()
+        if not msg or bb.MSG_BULK_READ_RESP != msg.get_msg_type():
+            return
+
+        off, status, data = bb.parse_read(msg)
+        if bb.STATUS_OK != status:
+            print(f"Read refused at {off:04x}: status {status}")
+            return False
+
+        i = self.index.get(off)
+        if i is None or data is None or len(data) != self.blocks[i][1]:
+            # Bad CRC: the block goes again once its reply is late
+            return
+
+        if not self.window.ack(i):
+            return
+
+        self.data[off - self.offset : off - self.offset + len(data)] = data
+        per = self.window.done * 100 // self.window.count
+        print(f"Fetching data.. {per}%")
+
+        if not self.window.finished():
+            return
+
+        # Finished ------
+
+        print("Done")
+
+        file = self.dump._dump_file
+        open(file, "wb").write(self.data)
+        print("Data successfully saved to " + file)
+        return False
+
+
 class _DumpEeprom(_State):
 
     def __init__(self, dump: EepromDump, timestamp: int):
         super().__init__(dump)
         self.timestamp = timestamp
 
-        what = dump._dump_what
-        if DUMP_CONFIG == what:
-            off = 0
-            size = 0x1E00
-        elif DUMP_CALIB == what:
-            off = 0x1E00
-            size = 0x2000 - 0x1E00
-        else:
-            off = 0
-            size = 0x2000
+        off, size = _dump_range(dump._dump_what)
 
         self.offset = off
         self.size = size
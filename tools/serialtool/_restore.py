@@ -15,7 +15,9 @@
 
 from serial import Serial
 from datetime import datetime
+from time import monotonic
 import msg as mm
+import _bulk as bb
 
 DUMP_CONFIG = 1
 DUMP_CALIB = 2
@@ -24,10 +26,11 @@ DUMP_ALL = 0xFF
 
 class EepromDump:
 
-    def __init__(self, ser: Serial, dump_what: int, dump_file: str):
+    def __init__(self, ser: Serial, dump_what: int, dump_file: str, bulk: bool = True):
         self._ser = ser
         self._dump_what = dump_what
         self._dump_file = dump_file
+        self._bulk = bulk
         self._state = _Init(self)
         # self._dev_info = None
 
@@ -153,6 +156,9 @@ class _DeviceInfo(_State):
         )
 
         # return _AccessRequest(self.dump, dev_info, self.timestamp)
+        if self.dump._bulk:
+            return _Probe(self.dump, self.timestamp)
+
         try:
             return _DumpEeprom(self.dump, self.timestamp)
         except:
@@ -218,22 +224,148 @@ class _AccessRequest(_State):
         self.send_msg(msg)
 
 
-class _DumpEeprom(_State):
+class _Probe(_State):
+
+    def __init__(self, dump, timestamp: int):
+        super().__init__(dump)
+        self.timestamp = timestamp
+        self.sent_at = None
+
+    def loop(self) -> _State | bool:
+
+        if self.sent_at is None:
+            self.send_msg(bb.probe(self.timestamp))
+            self.sent_at = monotonic()
+            return
+
+        msg = self.recv_msg()
+        bulk = msg and bb.MSG_BULK_READ_RESP == msg.get_msg_type()
+
+        if not bulk and monotonic() - self.sent_at <= bb.PROBE_TIMEOUT:
+            return
+
+        try:
+            if bulk:
+                print("Bulk transfers supported")
+                return _BulkRestore(self.dump, self.timestamp)
+            return _DumpEeprom(self.dump, self.timestamp)
+        except:
+            #
+            return False
+
+
+def _load_dump(dump: EepromDump) -> tuple[int, bytes]:
+
+    what = dump._dump_what
+    if DUMP_CONFIG == what:
+        off = 0
+        size = 0x1E00
+    elif DUMP_CALIB == what:
+        off = 0x1E00
+        size = 0x2000 - 0x1E00
+    else:
+        off = 0
+        size = 0x2000
+
+    file = dump._dump_file
+    try:
+        data = open(file, "rb").read()
+    except Exception as e:
+        print("Error loading dump file: " + str(e))
+        raise OSError()
+
+    if len(data) != size:
+        print("Dump file size error: expect {} actually {}".format(size, len(data)))
+        raise OSError()
+
+    return off, data
+
+
+# AES key, written last: it makes the radio reload its settings
+_AES_KEY = 0x0F30
+_AES_KEY_END = 0x0F40
+
+
+class _BulkRestore(_State):
 
     def __init__(self, dump: EepromDump, timestamp: int):
         super().__init__(dump)
         self.timestamp = timestamp
 
-        what = dump._dump_what
-        if DUMP_CONFIG == what:
-            off = 0
-            size = 0x1E00
-        elif DUMP_CALIB == what:
-            off = 0x1E00
-            size = 0x2000 - 0x1E00
+        off, data = _load_dump(dump)
+        end = off + len(data)
+        self.offset = off
+        self.data = data
+
+        phases = []
+        if off < _AES_KEY_END and end > _AES_KEY:
+            phases.append(
+                bb.split(off, _AES_KEY - off, bb.WRITE_BLOCK)
+                + bb.split(_AES_KEY_END, end - _AES_KEY_END, bb.WRITE_BLOCK)
+            )
+            phases.append([(_AES_KEY, _AES_KEY_END - _AES_KEY)])
         else:
-            off = 0
-            size = 0x2000
+            phases.append(bb.split(off, len(data), bb.WRITE_BLOCK))
+
+        self.phases = phases
+        self.total = sum(len(p) for p in phases)
+        self.written = 0
+        self._next_phase()
+
+    def _next_phase(self):
+        self.blocks = self.phases.pop(0)
+        self.index = {b[0]: i for i, b in enumerate(self.blocks)}
+        self.window = bb.Window(len(self.blocks), bb.WRITE_WINDOW)
+
+    def loop(self) -> bool | _State:
+
+        try:
+            for i in self.window.to_send():
+                off, size = self.blocks[i]
+                data = self.data[off - self.offset : off - self.offset + size]
+                self.send_msg(bb.make_write(off, data, self.timestamp))
+        except TimeoutError as e:
+            print("Device not responding: " + str(e))
+            return False
+
+        msg = self.recv_msg()
+        if not msg or bb.MSG_BULK_WRITE_RESP != msg.get_msg_type():
+            return
+
+        off, status = bb.parse_write(msg)
+        if bb.STATUS_OK != status:
+            print(f"Write refused at {off:04x}: status {status}")
+            return False
+
+        i = self.index.get(off)
+        if i is None or not self.window.ack(i):
+            return
+
+        self.written += 1
+        per = self.written * 100 // self.total
+        print(f"Writting data.. {per}%")
+
+        if not self.window.finished():
+            return
+
+        if self.phases:
+            self._next_phase()
+            return
+
+        # Finished ------
+
+        print("Done")
+        return _Reboot(self.dump)
+
+
+class _DumpEeprom(_State):
+
+    def __init__(self, dump: EepromDump, timestamp: int):
+        super().__init__(dump)
+        self.timestamp = timestamp
+
+        off, data1 = _load_dump(dump)
+        size = len(data1)
 
         self.offset = off
         self.size = size
@@ -241,19 +373,6 @@ class _DumpEeprom(_State):
         data = bytearray()
         self.data = data
 
-        file = dump._dump_file
-        try:
-            data1 = open(file, "rb").read()
-        except Exception as e:
-            print("Error loading dump file: " + str(e))
-            raise OSError()
-
-        if len(data1) != size:
-            print(
-                "Dump file size error: expect {} actually {}".format(size, len(data1))
-            )
-            raise OSError()
-
         data.extend(data1)
 
         self.expect_resp = False
@@ -67,7 +67,7 @@ def main_dump(args, ser):
 
     signal.signal(signal.SIGINT, quit_handler)
 
-    dump = dd.EepromDump(ser, dump_what, dump_file)
+    dump = dd.EepromDump(ser, dump_what, dump_file, not args.legacy)
     while (not quit_flag) and dump.loop():
         sleep(0)
 
@@ -102,7 +102,7 @@ def main_restore(args, ser):
 
     signal.signal(signal.SIGINT, quit_handler)
 
-    dump = rr.EepromDump(ser, dump_what, dump_file)
+    dump = rr.EepromDump(ser, dump_what, dump_file, not args.legacy)
     while (not quit_flag) and dump.loop():
         sleep(0)
 
@@ -198,8 +198,8 @@ def main():
     # Usage:
     # serialtool.py --port <port> subcmd ..
     # serialtool.py .. flash [--bl-ver <ver>] <file>
-    # serialtool.py .. dump {--config | --calib [| --all]} file
-    # serialtool.py .. restore {--config | --calib [| --all]} file
+    # serialtool.py .. dump {--config | --calib [| --all]} [--legacy] file
+    # serialtool.py .. restore {--config | --calib [| --all]} [--legacy] file
     # serialtool.py decode <packed.bin> [raw.bin]
     ap = argparse.ArgumentParser(description="UV-K5 V2 serial tool")
 
@@ -234,6 +234,11 @@ def main():
         action="store_true",
         help="dump both configuration and calibration data. This is default",
     )
+    ap_dump.add_argument(
+        "--legacy",
+        action="store_true",
+        help="read 16 bytes at a time (0x051B) even if the radio has bulk transfers",
+    )
     ap_dump.add_argument("file", help="output dump file")
 
     ap_restore = sp.add_parser(
@@ -251,6 +256,11 @@ def main():
         action="store_true",
         help="restore both configuration and calibration data. This is default",
     )
+    ap_restore.add_argument(
+        "--legacy",
+        action="store_true",
+        help="write 16 bytes at a time (0x051D) even if the radio has bulk transfers",
+    )
     ap_restore.add_argument("file", help="input dump file")
 
     ap_decode = sp.add_parser(
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026
+#
+# Licensed under the MIT License (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at the root of this repository.
+#
+#     Unless required by applicable law or agreed to in writing, software
+#     distributed under the License is distributed on an "AS IS" BASIS,
+#     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#     See the License for the specific language governing permissions and
+#     limitations under the License.
+#
+
+"""
+Loopback test on Linux: dump and restore against the firmware running in the
+host simulator (k5sim --pty, see host/main.c), in bulk and legacy transfers.
+Checks that both dumps agree and that each restore reads back, and prints
+the time and throughput of each, handshake included.
+
+    cmake -S host -B build/host && cmake --build build/host
+    python3 tools/serialtool/loopback.py [--sim build/host/k5sim]
+"""
+
+import argparse
+import contextlib
+import io
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from time import monotonic, sleep
+
+import serial
+
+import _dump as dd
+import _restore as rr
+
+
+class _Radio:
+    """k5sim on a pseudo-terminal, until the restore reboots it"""
+
+    def __init__(self, sim: str, image: str, channels: int):
+        args = [sim, "--flash", image, "--pty", "--run", "wait 600000; exit"]
+        if channels:
+            args[3:3] = ["--channels", str(channels)]
+
+        self.proc = subprocess.Popen(args, stderr=subprocess.PIPE, text=True)
+        line = self.proc.stderr.readline()
+        m = re.search(r"(/dev/pts/\d+)", line)
+        if not m:
+            raise RuntimeError("k5sim: " + line.strip())
+
+        self.ser = serial.Serial(m.group(1), baudrate=38400, timeout=0.0001, write_timeout=None)
+        # Boot, and the K5Viewer frames sent at boot
+        sleep(3)
+
+    def close(self):
+        self.ser.close()
+        try:
+            self.proc.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+            self.proc.wait()
+
+
+def _run(job) -> float:
+    start = monotonic()
+    with contextlib.redirect_stdout(io.StringIO()) as out:
+        while job.loop():
+            sleep(0)
+    elapsed = monotonic() - start
+
+    if "Done" not in out.getvalue():
+        sys.stdout.write(out.getvalue())
+        raise RuntimeError("transfer failed")
+    return elapsed
+
+
+def _report(what: str, size: int, elapsed: float):
+    print(f"{what:16} {size:6} bytes {elapsed:7.2f} s {size / elapsed:7.0f} bytes/s")
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap = argparse.ArgumentParser(description="serialtool loopback test against k5sim")
+    ap.add_argument(
+        "--sim",
+        default=os.path.join(here, "..", "..", "build", "host", "k5sim"),
+        help="k5sim binary",
+    )
+    args = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        image = os.path.join(tmp, "flash.bin")
+        files = {name: os.path.join(tmp, name + ".bin") for name in ("bulk", "legacy", "check")}
+
+        radio = _Radio(args.sim, image, 200)
+        try:
+            for name in ("bulk", "legacy"):
+                job = dd.EepromDump(radio.ser, dd.DUMP_ALL, files[name], name == "bulk")
+                _report("dump " + name, 0x2000, _run(job))
+        finally:
+            # Still running: no reboot after a dump
+            radio.proc.terminate()
+            radio.close()
+
+        dump = open(files["bulk"], "rb").read()
+        if dump != open(files["legacy"], "rb").read():
+            print("FAIL: bulk and legacy dumps differ")
+            return 1
+
+        for name in ("bulk", "legacy"):
+            # Every channel record changed
+            data = bytearray(dump)
+            for off in range(0, 0x1E00, 16):
+                data[off + 4] ^= 0x5A if name == "bulk" else 0xA5
+            open(files[name], "wb").write(data)
+
+            radio = _Radio(args.sim, image, 0)
+            try:
+                job = rr.EepromDump(radio.ser, rr.DUMP_ALL, files[name], name == "bulk")
+                _report("restore " + name, 0x2000, _run(job))
+            finally:
+                radio.close()
+
+            radio = _Radio(args.sim, image, 0)
+            try:
+                _run(dd.EepromDump(radio.ser, dd.DUMP_ALL, files["check"]))
+            finally:
+                radio.proc.terminate()
+                radio.close()
+
+            if open(files["check"], "rb").read() != data:
+                print(f"FAIL: radio does not hold the {name} restore")
+                return 1
+
+    print("OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
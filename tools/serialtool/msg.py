@@ -86,6 +86,10 @@ def fetch(buf: bytearray) -> Msg | None:
     msg_len = _get_hw_LE(buf, pack_begin + 2)
     pack_end = pack_begin + 6 + msg_len
 
+    if len(buf) < pack_end + 2:
+        # Rest of the packet still on its way
+        return None
+
     if not buf.startswith(b"\xdc\xba", pack_end):
         # We've got wrong beginning
         del buf[: pack_begin + 2]